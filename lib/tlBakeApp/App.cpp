@@ -6,6 +6,7 @@
 
 #include <tlTimelineGL/Render.h>
 
+#include <tlIO/DiskCache.h>
 #include <tlIO/System.h>
 
 #include <tlGL/GL.h>
@@ -18,6 +19,9 @@
 #include <tlCore/StringFormat.h>
 #include <tlCore/Time.h>
 
+#include <algorithm>
+#include <cstring>
+
 namespace tl
 {
     namespace bake
@@ -94,8 +98,38 @@ namespace tl
                     app::CmdLineValueOption<int>::create(
                         _options.sequenceThreadCount,
                         { "-sequenceThreadCount" },
-                        "Number of threads for image sequence I/O.",
+                        "Number of threads for image sequence I/O. A value of zero adjusts the number of threads automatically.",
                         string::Format("{0}").arg(_options.sequenceThreadCount)),
+                    app::CmdLineValueOption<int>::create(
+                        _options.sequenceWriteThreadCount,
+                        { "-sequenceWriteThreadCount" },
+                        "Number of threads for writing image sequences. A value of zero writes on the calling thread.",
+                        string::Format("{0}").arg(_options.sequenceWriteThreadCount)),
+                    app::CmdLineValueOption<size_t>::create(
+                        _options.diskCache,
+                        { "-diskCache" },
+                        "Disk cache size in gigabytes. Frames evicted from the memory cache are written to the disk cache. A size of zero disables the disk cache.",
+                        string::Format("{0}").arg(_options.diskCache)),
+                    app::CmdLineValueOption<std::string>::create(
+                        _options.diskCachePath,
+                        { "-diskCachePath" },
+                        "Disk cache directory.",
+                        file::getTemp()),
+                    app::CmdLineValueOption<int>::create(
+                        _options.requestCount,
+                        { "-requestCount" },
+                        "Number of timeline video requests in flight.",
+                        string::Format("{0}").arg(_options.requestCount)),
+                    app::CmdLineValueOption<int>::create(
+                        _options.readbackCount,
+                        { "-readbackCount" },
+                        "Number of pixel buffers used to read back rendered frames.",
+                        string::Format("{0}").arg(_options.readbackCount)),
+                    app::CmdLineValueOption<int>::create(
+                        _options.writeQueueSize,
+                        { "-writeQueueSize" },
+                        "Maximum number of frames waiting to be written.",
+                        string::Format("{0}").arg(_options.writeQueueSize)),
 #if defined(TLRENDER_EXR)
                     app::CmdLineValueOption<exr::Compression>::create(
                         _options.exrCompression,
@@ -108,6 +142,11 @@ namespace tl
                         { "-exrDWACompressionLevel" },
                         "OpenEXR DWA compression level.",
                         string::Format("{0}").arg(_options.exrDWACompressionLevel)),
+                    app::CmdLineValueOption<int>::create(
+                        _options.exrThreadCount,
+                        { "-exrThreadCount" },
+                        "Number of threads for OpenEXR to decode each image.",
+                        string::Format("{0}").arg(_options.exrThreadCount)),
 #endif // TLRENDER_EXR
 #if defined(TLRENDER_FFMPEG)
                     app::CmdLineValueOption<std::string>::create(
@@ -167,7 +206,17 @@ namespace tl
         {}
 
         App::~App()
-        {}
+        {
+            if (_writeThread.joinable())
+            {
+                {
+                    std::unique_lock<std::mutex> lock(_writeQueue.mutex);
+                    _writeQueue.finish = true;
+                }
+                _writeQueue.cv.notify_all();
+                _writeThread.join();
+            }
+        }
 
         std::shared_ptr<App> App::create(
             const std::vector<std::string>& argv,
@@ -191,6 +240,16 @@ namespace tl
                     _context,
                     static_cast<int>(gl::GLFWWindowOptions::MakeCurrent));
 
+                // Create the disk cache.
+                if (_options.diskCache > 0)
+                {
+                    auto diskCache = io::DiskCache::create(
+                        !_options.diskCachePath.empty() ? _options.diskCachePath : file::getTemp(),
+                        _options.diskCache * memory::gigabyte);
+                    _context->getSystem<io::System>()->getCache()->setDiskCache(diskCache);
+                    _print(string::Format("Disk cache: {0}").arg(diskCache->getPath()));
+                }
+
                 // Read the timeline.
                 timeline::Options options;
                 options.ioOptions = _getIOOptions();
@@ -210,6 +269,7 @@ namespace tl
                     arg(_timeRange.start_time().value()).
                     arg(_timeRange.end_time_inclusive().value()));
                 _inputTime = _timeRange.start_time();
+                _requestTime = _timeRange.start_time();
                 _outputTime = otime::RationalTime(0.0, _timeRange.duration().rate());
 
                 // Render information.
@@ -249,21 +309,56 @@ namespace tl
                 _print(string::Format("Output info: {0} {1}").
                     arg(_outputInfo.size).
                     arg(_outputInfo.pixelType));
-                _outputImage = image::Image::create(_outputInfo);
                 ioInfo.video.push_back(_outputInfo);
                 ioInfo.videoTime = _timeRange;
-                _writer = _writerPlugin->write(file::Path(_output), ioInfo);
+                _writer = _writerPlugin->write(file::Path(_output), ioInfo, _getIOOptions());
                 if (!_writer)
                 {
                     throw std::runtime_error(string::Format("{0}: Cannot open").arg(_output));
                 }
 
+                // Create the read back buffers.
+                _readPixelsFormat = gl::getReadPixelsFormat(_outputInfo.pixelType);
+                _readPixelsType = gl::getReadPixelsType(_outputInfo.pixelType);
+                if (GL_NONE == _readPixelsFormat || GL_NONE == _readPixelsType)
+                {
+                    throw std::runtime_error(string::Format("{0}: Cannot open").arg(_output));
+                }
+#if defined(TLRENDER_API_GL_4_1)
+                _readbackBuffers.resize(std::max(_options.readbackCount, 1));
+                _readbackTimes.resize(_readbackBuffers.size(), time::invalidTime);
+                glGenBuffers(static_cast<GLsizei>(_readbackBuffers.size()), _readbackBuffers.data());
+                for (const auto pbo : _readbackBuffers)
+                {
+                    glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
+                    glBufferData(
+                        GL_PIXEL_PACK_BUFFER,
+                        image::getDataByteCount(_outputInfo),
+                        NULL,
+                        GL_STREAM_READ);
+                }
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+#endif // TLRENDER_API_GL_4_1
+
+                // Start the write thread.
+                _writeThread = std::thread(
+                    [this]
+                    {
+                        _writeRun();
+                    });
+
                 // Start the main loop.
                 gl::OffscreenBufferBinding binding(_buffer);
                 while (_running)
                 {
                     _tick();
                 }
+                _readbackFlush();
+                _writeFinish();
+#if defined(TLRENDER_API_GL_4_1)
+                glDeleteBuffers(static_cast<GLsizei>(_readbackBuffers.size()), _readbackBuffers.data());
+                _readbackBuffers.clear();
+#endif // TLRENDER_API_GL_4_1
 
                 const auto now = std::chrono::steady_clock::now();
                 const std::chrono::duration<float> diff = now - _startTime;
@@ -287,6 +382,11 @@ namespace tl
                 ss << _options.sequenceThreadCount;
                 out["SequenceIO/ThreadCount"] = ss.str();
             }
+            {
+                std::stringstream ss;
+                ss << _options.sequenceWriteThreadCount;
+                out["SequenceIO/WriteThreadCount"] = ss.str();
+            }
 
 #if defined(TLRENDER_EXR)
             {
@@ -299,6 +399,11 @@ namespace tl
                 ss << _options.exrDWACompressionLevel;
                 out["OpenEXR/DWACompressionLevel"] = ss.str();
             }
+            {
+                std::stringstream ss;
+                ss << _options.exrThreadCount;
+                out["OpenEXR/ThreadCount"] = ss.str();
+            }
 #endif // TLRENDER_EXR
 
 #if defined(TLRENDER_FFMPEG)
@@ -360,44 +465,218 @@ namespace tl
 
             _printProgress();
 
+            // Keep requests in flight so the timeline reads ahead of the
+            // render.
+            const size_t requestCount = std::max(_options.requestCount, 1);
+            while (_videoRequests.size() < requestCount &&
+                _requestTime <= _timeRange.end_time_inclusive())
+            {
+                _videoRequests.push_back(_timeline->getVideo(_requestTime));
+                _requestTime += otime::RationalTime(1, _requestTime.rate());
+            }
+
             // Render the video.
             _render->begin(_renderSize);
             _render->setOCIOOptions(_options.ocioOptions);
             _render->setLUTOptions(_options.lutOptions);
-            const auto videoData = _timeline->getVideo(_inputTime).future.get();
+            const auto videoData = _videoRequests.front().future.get();
+            _videoRequests.pop_front();
             _render->drawVideo(
                 { videoData },
                 { math::Box2i(0, 0, _renderSize.w, _renderSize.h) });
             _render->end();
 
-            // Write the frame.
+            // Read back the frame.
+            _readback();
+
+            // Advance the time.
+            _inputTime += otime::RationalTime(1, _inputTime.rate());
+            if (_inputTime > _timeRange.end_time_inclusive())
+            {
+                _running = false;
+            }
+            _outputTime += otime::RationalTime(1, _outputTime.rate());
+        }
+
+        void App::_readback()
+        {
             glPixelStorei(GL_PACK_ALIGNMENT, _outputInfo.layout.alignment);
 #if defined(TLRENDER_API_GL_4_1)
             glPixelStorei(GL_PACK_SWAP_BYTES, _outputInfo.layout.endian != memory::getEndian());
-#endif // TLRENDER_API_GL_4_1
-            const GLenum format = gl::getReadPixelsFormat(_outputInfo.pixelType);
-            const GLenum type = gl::getReadPixelsType(_outputInfo.pixelType);
-            if (GL_NONE == format || GL_NONE == type)
+
+            // Start an asynchronous read into the next buffer in the ring.
+            // The buffer is mapped when the ring comes back around to it,
+            // giving the transfer time to finish.
+            const size_t index = _readbackIndex;
+            if (time::isValid(_readbackTimes[index]))
             {
-                throw std::runtime_error(string::Format("{0}: Cannot open").arg(_output));
+                _readbackWrite(index);
             }
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, _readbackBuffers[index]);
             glReadPixels(
                 0,
                 0,
                 _outputInfo.size.w,
                 _outputInfo.size.h,
-                format,
-                type,
-                _outputImage->getData());
-            _writer->writeVideo(_outputTime, _outputImage);
+                _readPixelsFormat,
+                _readPixelsType,
+                NULL);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            _readbackTimes[index] = _outputTime;
+            _readbackIndex = (index + 1) % _readbackBuffers.size();
+#elif defined(TLRENDER_API_GLES_2)
+            auto image = _getImage();
+            glReadPixels(
+                0,
+                0,
+                _outputInfo.size.w,
+                _outputInfo.size.h,
+                _readPixelsFormat,
+                _readPixelsType,
+                image->getData());
+            _write(_outputTime, image);
+#endif // TLRENDER_API_GL_4_1
+        }
 
-            // Advance the time.
-            _inputTime += otime::RationalTime(1, _inputTime.rate());
-            if (_inputTime > _timeRange.end_time_inclusive())
+        void App::_readbackWrite(size_t index)
+        {
+#if defined(TLRENDER_API_GL_4_1)
+            auto image = _getImage();
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, _readbackBuffers[index]);
+            void* p = glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+            if (!p)
             {
-                _running = false;
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+                throw std::runtime_error(string::Format("{0}: Cannot map the pixel buffer").arg(_output));
             }
-            _outputTime += otime::RationalTime(1, _outputTime.rate());
+            memcpy(image->getData(), p, image->getDataByteCount());
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            _write(_readbackTimes[index], image);
+            _readbackTimes[index] = time::invalidTime;
+#endif // TLRENDER_API_GL_4_1
+        }
+
+        void App::_readbackFlush()
+        {
+            for (size_t i = 0; i < _readbackBuffers.size(); ++i)
+            {
+                const size_t index = (_readbackIndex + i) % _readbackBuffers.size();
+                if (time::isValid(_readbackTimes[index]))
+                {
+                    _readbackWrite(index);
+                }
+            }
+        }
+
+        std::shared_ptr<image::Image> App::_getImage()
+        {
+            // Re-use the images that have already been written.
+            std::shared_ptr<image::Image> out;
+            {
+                std::unique_lock<std::mutex> lock(_writeQueue.mutex);
+                if (!_writeQueue.images.empty())
+                {
+                    out = _writeQueue.images.back();
+                    _writeQueue.images.pop_back();
+                }
+            }
+            if (!out)
+            {
+                out = image::Image::create(_outputInfo);
+            }
+            return out;
+        }
+
+        void App::_write(
+            const otime::RationalTime& time,
+            const std::shared_ptr<image::Image>& image)
+        {
+            // Wait for room in the queue so the render does not get too
+            // far ahead of the writer.
+            const size_t writeQueueSize = std::max(_options.writeQueueSize, 1);
+            std::unique_lock<std::mutex> lock(_writeQueue.mutex);
+            _writeQueue.cv.wait(
+                lock,
+                [this, writeQueueSize]
+                {
+                    return
+                        _writeQueue.frames.size() < writeQueueSize ||
+                        !_writeQueue.error.empty();
+                });
+            if (!_writeQueue.error.empty())
+            {
+                throw std::runtime_error(_writeQueue.error);
+            }
+            _writeQueue.frames.push_back(std::make_pair(time, image));
+            lock.unlock();
+            _writeQueue.cv.notify_all();
+        }
+
+        void App::_writeRun()
+        {
+            while (true)
+            {
+                std::pair<otime::RationalTime, std::shared_ptr<image::Image> > frame;
+                {
+                    std::unique_lock<std::mutex> lock(_writeQueue.mutex);
+                    _writeQueue.cv.wait(
+                        lock,
+                        [this]
+                        {
+                            return
+                                !_writeQueue.frames.empty() ||
+                                _writeQueue.finish;
+                        });
+                    if (_writeQueue.frames.empty())
+                    {
+                        break;
+                    }
+                    frame = _writeQueue.frames.front();
+                    _writeQueue.frames.pop_front();
+                }
+                _writeQueue.cv.notify_all();
+
+                try
+                {
+                    _writer->writeVideo(frame.first, frame.second);
+                }
+                catch (const std::exception& e)
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(_writeQueue.mutex);
+                        _writeQueue.error = e.what();
+                        _writeQueue.frames.clear();
+                    }
+                    _writeQueue.cv.notify_all();
+                    break;
+                }
+
+                // Re-use the image unless the writer is still holding it.
+                if (1 == frame.second.use_count())
+                {
+                    std::unique_lock<std::mutex> lock(_writeQueue.mutex);
+                    _writeQueue.images.push_back(frame.second);
+                }
+            }
+        }
+
+        void App::_writeFinish()
+        {
+            {
+                std::unique_lock<std::mutex> lock(_writeQueue.mutex);
+                _writeQueue.finish = true;
+            }
+            _writeQueue.cv.notify_all();
+            if (_writeThread.joinable())
+            {
+                _writeThread.join();
+            }
+            if (!_writeQueue.error.empty())
+            {
+                throw std::runtime_error(_writeQueue.error);
+            }
+            _writer->flush();
         }
 
         void App::_printProgress()
@@ -20,6 +20,11 @@
 #include <tlIO/USD.h>
 #endif // TLRENDER_USD
 
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <thread>
+
 namespace tl
 {
     namespace gl
@@ -40,10 +45,17 @@ namespace tl
             timeline::LUTOptions lutOptions;
             float sequenceDefaultSpeed = io::sequenceDefaultSpeed;
             int sequenceThreadCount = io::sequenceThreadCount;
+            int sequenceWriteThreadCount = 4;
+            size_t diskCache = 0;
+            std::string diskCachePath;
+            int requestCount = 16;
+            int readbackCount = 3;
+            int writeQueueSize = 16;
 
 #if defined(TLRENDER_EXR)
             exr::Compression exrCompression = exr::Compression::ZIP;
             float exrDWACompressionLevel = 45.F;
+            int exrThreadCount = exr::threadCount;
 #endif // TLRENDER_EXR
 
 #if defined(TLRENDER_FFMPEG)
@@ -88,6 +100,13 @@ namespace tl
             io::Options _getIOOptions() const;
 
             void _tick();
+            void _readback();
+            void _readbackWrite(size_t);
+            void _readbackFlush();
+            std::shared_ptr<image::Image> _getImage();
+            void _write(const otime::RationalTime&, const std::shared_ptr<image::Image>&);
+            void _writeRun();
+            void _writeFinish();
             void _printProgress();
 
             std::string _input;
@@ -100,15 +119,32 @@ namespace tl
             otime::TimeRange _timeRange = time::invalidTimeRange;
             otime::RationalTime _inputTime = time::invalidTime;
             otime::RationalTime _outputTime = time::invalidTime;
+            otime::RationalTime _requestTime = time::invalidTime;
+            std::list<timeline::VideoRequest> _videoRequests;
 
             std::shared_ptr<gl::GLFWWindow> _window;
             std::shared_ptr<io::IPlugin> _usdPlugin;
             std::shared_ptr<timeline::IRender> _render;
             std::shared_ptr<gl::OffscreenBuffer> _buffer;
+            unsigned int _readPixelsFormat = 0;
+            unsigned int _readPixelsType = 0;
+            std::vector<unsigned int> _readbackBuffers;
+            std::vector<otime::RationalTime> _readbackTimes;
+            size_t _readbackIndex = 0;
 
             std::shared_ptr<io::IPlugin> _writerPlugin;
             std::shared_ptr<io::IWrite> _writer;
-            std::shared_ptr<image::Image> _outputImage;
+            struct WriteQueue
+            {
+                std::list<std::pair<otime::RationalTime, std::shared_ptr<image::Image> > > frames;
+                std::vector<std::shared_ptr<image::Image> > images;
+                bool finish = false;
+                std::string error;
+                std::mutex mutex;
+                std::condition_variable cv;
+            };
+            WriteQueue _writeQueue;
+            std::thread _writeThread;
 
             bool _running = true;
             std::chrono::steady_clock::time_point _startTime;
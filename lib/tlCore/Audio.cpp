@@ -4,6 +4,7 @@
 
 #include <tlCore/Audio.h>
 
+#include <tlCore/AudioPrivate.h>
 #include <tlCore/Error.h>
 #include <tlCore/String.h>
 
@@ -134,27 +135,6 @@ namespace tl
                     outP[i] = math::clamp(v, min, max);
                 }
             }
-
-            template<typename T>
-            void mixF(
-                const uint8_t** in,
-                size_t inCount,
-                uint8_t* out,
-                float volume,
-                size_t size)
-            {
-                const T** const inP = reinterpret_cast<const T**>(in);
-                T* const outP = reinterpret_cast<T*>(out);
-                for (size_t i = 0; i < size; ++i)
-                {
-                    T v = static_cast<T>(0);
-                    for (size_t j = 0; j < inCount; ++j)
-                    {
-                        v += inP[j][i] * volume;
-                    }
-                    outP[i] = v;
-                }
-            }
         }
 
         void mix(
@@ -173,16 +153,16 @@ namespace tl
                 mixI<int8_t, int16_t>(in, inCount, out, volume, size);
                 break;
             case DataType::S16:
-                mixI<int16_t, int32_t>(in, inCount, out, volume, size);
+                getAudioKernels().mixS16(in, inCount, out, volume, size);
                 break;
             case DataType::S32:
                 mixI<int32_t, int64_t>(in, inCount, out, volume, size);
                 break;
             case DataType::F32:
-                mixF<float>(in, inCount, out, volume, size);
+                getAudioKernels().mixF32(in, inCount, out, volume, size);
                 break;
             case DataType::F64:
-                mixF<double>(in, inCount, out, volume, size);
+                getAudioKernels().mixF64(in, inCount, out, volume, size);
                 break;
             default: break;
             }
@@ -230,7 +210,12 @@ namespace tl
                     {
                     case DataType::S8:  _CONVERT(S16, S8);  break;
                     case DataType::S32: _CONVERT(S16, S32); break;
-                    case DataType::F32: _CONVERT(S16, F32); break;
+                    case DataType::F32:
+                        getAudioKernels().convertS16ToF32(
+                            in->getData(),
+                            out->getData(),
+                            sampleCount * channelCount);
+                        break;
                     case DataType::F64: _CONVERT(S16, F64); break;
                     default: break;
                     }
@@ -249,9 +234,19 @@ namespace tl
                     switch (type)
                     {
                     case DataType::S8:  _CONVERT(F32, S8);  break;
-                    case DataType::S16: _CONVERT(F32, S16); break;
+                    case DataType::S16:
+                        getAudioKernels().convertF32ToS16(
+                            in->getData(),
+                            out->getData(),
+                            sampleCount * channelCount);
+                        break;
                     case DataType::S32: _CONVERT(F32, S32); break;
-                    case DataType::F64: _CONVERT(F32, F64); break;
+                    case DataType::F64:
+                        getAudioKernels().convertF32ToF64(
+                            in->getData(),
+                            out->getData(),
+                            sampleCount * channelCount);
+                        break;
                     default: break;
                     }
                     break;
@@ -261,7 +256,12 @@ namespace tl
                     case DataType::S8:  _CONVERT(F64, S8);  break;
                     case DataType::S16: _CONVERT(F64, S16); break;
                     case DataType::S32: _CONVERT(F64, S32); break;
-                    case DataType::F32: _CONVERT(F64, F32); break;
+                    case DataType::F32:
+                        getAudioKernels().convertF64ToF32(
+                            in->getData(),
+                            out->getData(),
+                            sampleCount * channelCount);
+                        break;
                     default: break;
                     }
                     break;
@@ -294,6 +294,22 @@ namespace tl
         std::shared_ptr<Audio> planarInterleave(const std::shared_ptr<Audio>& value)
         {
             auto out = Audio::create(value->getInfo(), value->getSampleCount());
+            const size_t byteCount = audio::getByteCount(value->getDataType());
+            if (2 == value->getChannelCount() && (2 == byteCount || 4 == byteCount))
+            {
+                const size_t sampleCount = value->getSampleCount();
+                const uint8_t* in0 = value->getData();
+                const uint8_t* in1 = value->getData() + sampleCount * byteCount;
+                if (2 == byteCount)
+                {
+                    getAudioKernels().interleave2x16(in0, in1, out->getData(), sampleCount);
+                }
+                else
+                {
+                    getAudioKernels().interleave2x32(in0, in1, out->getData(), sampleCount);
+                }
+                return out;
+            }
             switch (value->getDataType())
             {
             case DataType::S8: _planarInterleave<int8_t>(value, out); break;
@@ -371,6 +387,23 @@ namespace tl
             return out;
         }
 
+        void reverse(const std::shared_ptr<Audio>& value)
+        {
+            const size_t byteCount = value->getInfo().getByteCount();
+            const size_t sampleCount = value->getSampleCount();
+            if (sampleCount < 2)
+                return;
+            std::vector<uint8_t> tmp(byteCount);
+            uint8_t* a = value->getData();
+            uint8_t* b = value->getData() + (sampleCount - 1) * byteCount;
+            for (size_t i = 0; i < sampleCount / 2; ++i, a += byteCount, b -= byteCount)
+            {
+                std::memcpy(tmp.data(), a, byteCount);
+                std::memcpy(a, b, byteCount);
+                std::memcpy(b, tmp.data(), byteCount);
+            }
+        }
+
         size_t getSampleCount(const std::list<std::shared_ptr<audio::Audio> >& value)
         {
             size_t out = 0;
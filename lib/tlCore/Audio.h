@@ -175,6 +175,37 @@ namespace tl
             std::vector<uint8_t> _data;
         };
 
+        //! \name SIMD
+        ///@{
+
+        //! SIMD instruction sets used to process audio data.
+        enum class SIMD
+        {
+            None,
+            SSE2,
+            AVX2,
+            NEON,
+
+            Count,
+            First = None
+        };
+        TLRENDER_ENUM(SIMD);
+        TLRENDER_ENUM_SERIALIZE(SIMD);
+
+        //! Get whether a SIMD instruction set is supported.
+        bool isSIMDSupported(SIMD);
+
+        //! Get the SIMD instruction set used to process audio data. By
+        //! default the best supported instruction set is used.
+        SIMD getSIMD();
+
+        //! Set the SIMD instruction set used to process audio data. This is
+        //! intended for testing and benchmarking, unsupported instruction
+        //! sets are ignored.
+        void setSIMD(SIMD);
+
+        ///@}
+
         //! \name Utility
         ///@{
 
@@ -205,6 +236,9 @@ namespace tl
         //! De-interleave audio data.
         std::shared_ptr<Audio> planarDeinterleave(const std::shared_ptr<Audio>&);
 
+        //! Reverse the order of the audio samples.
+        void reverse(const std::shared_ptr<Audio>&);
+
         //! Get the total sample count from a list of audio data.
         size_t getSampleCount(const std::list<std::shared_ptr<audio::Audio> >&);
 
@@ -0,0 +1,294 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlCore/AudioPeaks.h>
+
+#include <tlCore/FileIO.h>
+
+#include <cmath>
+#include <limits>
+
+namespace tl
+{
+    namespace audio
+    {
+        namespace
+        {
+            const uint32_t fileMagic = 0x4b506c74; // "tlPK"
+            const uint32_t fileVersion = 1;
+
+            struct PeakAccum
+            {
+                float min = std::numeric_limits<float>::max();
+                float max = std::numeric_limits<float>::lowest();
+                double sum2 = 0.0;
+                size_t count = 0;
+
+                void add(const Peak& peak, size_t peakCount)
+                {
+                    min = std::min(min, peak.min);
+                    max = std::max(max, peak.max);
+                    sum2 += static_cast<double>(peak.rms) * peak.rms * peakCount;
+                    count += peakCount;
+                }
+
+                Peak get() const
+                {
+                    Peak out;
+                    if (count > 0)
+                    {
+                        out.min = min;
+                        out.max = max;
+                        out.rms = std::sqrt(sum2 / count);
+                    }
+                    return out;
+                }
+            };
+        }
+
+        struct AudioPeaks::Private
+        {
+            size_t sampleRate = 0;
+            size_t blockSize = 0;
+            size_t sampleCount = 0;
+            double sum2 = 0.0;
+            std::vector<std::vector<Peak> > levels;
+        };
+
+        void AudioPeaks::_init(size_t sampleRate, size_t blockSize)
+        {
+            TLRENDER_P();
+            p.sampleRate = sampleRate;
+            p.blockSize = std::max(blockSize, static_cast<size_t>(1));
+            p.levels.resize(1);
+        }
+
+        AudioPeaks::AudioPeaks() :
+            _p(new Private)
+        {}
+
+        AudioPeaks::~AudioPeaks()
+        {}
+
+        std::shared_ptr<AudioPeaks> AudioPeaks::create(
+            size_t sampleRate,
+            size_t blockSize)
+        {
+            auto out = std::shared_ptr<AudioPeaks>(new AudioPeaks);
+            out->_init(sampleRate, blockSize);
+            return out;
+        }
+
+        size_t AudioPeaks::getSampleRate() const
+        {
+            return _p->sampleRate;
+        }
+
+        size_t AudioPeaks::getBlockSize() const
+        {
+            return _p->blockSize;
+        }
+
+        size_t AudioPeaks::getSampleCount() const
+        {
+            return _p->sampleCount;
+        }
+
+        size_t AudioPeaks::getLevelCount() const
+        {
+            return _p->levels.size();
+        }
+
+        const std::vector<Peak>& AudioPeaks::getLevel(size_t value) const
+        {
+            return _p->levels[value];
+        }
+
+        size_t AudioPeaks::getByteCount() const
+        {
+            TLRENDER_P();
+            size_t out = 0;
+            for (const auto& level : p.levels)
+            {
+                out += level.size() * sizeof(Peak);
+            }
+            return out;
+        }
+
+        void AudioPeaks::add(const std::shared_ptr<Audio>& audio)
+        {
+            TLRENDER_P();
+            if (!audio || !audio->isValid())
+                return;
+            const auto f32 = audio->getDataType() != DataType::F32 ?
+                convert(audio, DataType::F32) :
+                audio;
+            const size_t channelCount = f32->getChannelCount();
+            const size_t sampleCount = f32->getSampleCount();
+            if (0 == sampleCount)
+                return;
+
+            const size_t index = p.sampleCount / p.blockSize;
+            auto& level = p.levels[0];
+            const F32_T* data = reinterpret_cast<const F32_T*>(f32->getData());
+            for (size_t i = 0; i < sampleCount; ++i, data += channelCount)
+            {
+                const F32_T v = *data;
+                if (0 == p.sampleCount % p.blockSize)
+                {
+                    level.push_back(Peak{ v, v, 0.F });
+                    p.sum2 = 0.0;
+                }
+                Peak& peak = level.back();
+                peak.min = std::min(peak.min, v);
+                peak.max = std::max(peak.max, v);
+                p.sum2 += static_cast<double>(v) * v;
+                ++p.sampleCount;
+                if (0 == p.sampleCount % p.blockSize)
+                {
+                    peak.rms = std::sqrt(p.sum2 / p.blockSize);
+                }
+            }
+            if (const size_t partial = p.sampleCount % p.blockSize)
+            {
+                level.back().rms = std::sqrt(p.sum2 / partial);
+            }
+            _levelsUpdate(index);
+        }
+
+        std::vector<Peak> AudioPeaks::getPeaks(
+            int64_t start,
+            int64_t sampleCount,
+            size_t columnCount) const
+        {
+            TLRENDER_P();
+            std::vector<Peak> out(columnCount);
+            if (0 == columnCount || sampleCount <= 0 || 0 == p.sampleCount)
+                return out;
+
+            // Find the coarsest level that still has at least one peak per
+            // column.
+            const double samplesPerColumn = sampleCount / static_cast<double>(columnCount);
+            size_t level = 0;
+            while (level + 1 < p.levels.size() &&
+                (p.blockSize << (level + 1)) <= samplesPerColumn)
+            {
+                ++level;
+            }
+            const auto& peaks = p.levels[level];
+            const int64_t levelBlockSize = p.blockSize << level;
+
+            const int64_t columnCount64 = static_cast<int64_t>(columnCount);
+            for (int64_t c = 0; c < columnCount64; ++c)
+            {
+                int64_t s0 = start + c * sampleCount / columnCount64;
+                int64_t s1 = std::max(start + (c + 1) * sampleCount / columnCount64, s0 + 1);
+                s0 = std::max(s0, static_cast<int64_t>(0));
+                s1 = std::min(s1, static_cast<int64_t>(p.sampleCount));
+                if (s0 < s1)
+                {
+                    PeakAccum accum;
+                    const size_t i1 = (s1 - 1) / levelBlockSize;
+                    for (size_t i = s0 / levelBlockSize; i <= i1; ++i)
+                    {
+                        accum.add(peaks[i], _getCount(level, i));
+                    }
+                    out[c] = accum.get();
+                }
+            }
+            return out;
+        }
+
+        void AudioPeaks::write(const std::shared_ptr<file::FileIO>& io) const
+        {
+            TLRENDER_P();
+            io->writeU32(fileMagic);
+            io->writeU32(fileVersion);
+            const uint64_t header[3] =
+            {
+                p.sampleRate,
+                p.blockSize,
+                p.sampleCount
+            };
+            io->write(header, 3 * sizeof(uint64_t));
+            io->write(&p.sum2, sizeof(double));
+            const auto& level = p.levels[0];
+            if (!level.empty())
+            {
+                io->writeF32(&level[0].min, level.size() * 3);
+            }
+        }
+
+        std::shared_ptr<AudioPeaks> AudioPeaks::read(const std::shared_ptr<file::FileIO>& io)
+        {
+            uint32_t magic = 0;
+            io->readU32(&magic);
+            uint32_t version = 0;
+            io->readU32(&version);
+            if (magic != fileMagic || version != fileVersion)
+            {
+                throw std::runtime_error("Invalid audio peaks");
+            }
+            uint64_t header[3] = { 0, 0, 0 };
+            io->read(header, 3 * sizeof(uint64_t));
+            auto out = AudioPeaks::create(header[0], header[1]);
+            auto& p = *out->_p;
+            if (p.blockSize != header[1])
+            {
+                throw std::runtime_error("Invalid audio peaks");
+            }
+            p.sampleCount = header[2];
+            io->read(&p.sum2, sizeof(double));
+            const size_t peakCount = (p.sampleCount + p.blockSize - 1) / p.blockSize;
+            if (io->getPos() + peakCount * sizeof(Peak) > io->getSize())
+            {
+                throw std::runtime_error("Invalid audio peaks");
+            }
+            auto& level = p.levels[0];
+            level.resize(peakCount);
+            if (!level.empty())
+            {
+                io->readF32(&level[0].min, level.size() * 3);
+            }
+            out->_levelsUpdate(0);
+            return out;
+        }
+
+        size_t AudioPeaks::_getCount(size_t level, size_t index) const
+        {
+            TLRENDER_P();
+            const size_t levelBlockSize = p.blockSize << level;
+            return std::min(levelBlockSize, p.sampleCount - index * levelBlockSize);
+        }
+
+        void AudioPeaks::_levelsUpdate(size_t index)
+        {
+            TLRENDER_P();
+
+            // Update the peaks that changed in each level, starting from the
+            // given index in the first level.
+            for (size_t level = 1; p.levels[level - 1].size() > 1; ++level)
+            {
+                if (level >= p.levels.size())
+                {
+                    p.levels.push_back(std::vector<Peak>());
+                }
+                const auto& prev = p.levels[level - 1];
+                auto& peaks = p.levels[level];
+                index /= 2;
+                peaks.resize((prev.size() + 1) / 2);
+                for (size_t i = index; i < peaks.size(); ++i)
+                {
+                    PeakAccum accum;
+                    accum.add(prev[i * 2], _getCount(level - 1, i * 2));
+                    if (i * 2 + 1 < prev.size())
+                    {
+                        accum.add(prev[i * 2 + 1], _getCount(level - 1, i * 2 + 1));
+                    }
+                    peaks[i] = accum.get();
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlCore/Audio.h>
+
+namespace tl
+{
+    namespace file
+    {
+        class FileIO;
+    }
+
+    namespace audio
+    {
+        //! Audio peak.
+        struct Peak
+        {
+            float min = 0.F;
+            float max = 0.F;
+            float rms = 0.F;
+
+            bool operator == (const Peak&) const;
+            bool operator != (const Peak&) const;
+        };
+
+        //! Audio peaks.
+        //!
+        //! The peaks are stored as a pyramid. The first level has the
+        //! minimum, maximum, and RMS of each block of samples, and each
+        //! following level combines pairs of peaks from the level below.
+        //! Waveforms can then be drawn at any zoom level by combining the
+        //! peaks from the level closest to the number of samples per column,
+        //! instead of scanning the samples.
+        class AudioPeaks
+        {
+            TLRENDER_NON_COPYABLE(AudioPeaks);
+
+        protected:
+            void _init(size_t sampleRate, size_t blockSize);
+
+            AudioPeaks();
+
+        public:
+            ~AudioPeaks();
+
+            //! Default number of samples in each block of the first level.
+            static const size_t defaultBlockSize = 256;
+
+            //! Create new audio peaks.
+            static std::shared_ptr<AudioPeaks> create(
+                size_t sampleRate,
+                size_t blockSize = defaultBlockSize);
+
+            //! Get the sample rate.
+            size_t getSampleRate() const;
+
+            //! Get the number of samples in each block of the first level.
+            size_t getBlockSize() const;
+
+            //! Get the number of samples.
+            size_t getSampleCount() const;
+
+            //! Get the number of levels.
+            size_t getLevelCount() const;
+
+            //! Get the peaks for a level.
+            const std::vector<Peak>& getLevel(size_t) const;
+
+            //! Get the size of the peaks in bytes.
+            size_t getByteCount() const;
+
+            //! Add samples. The peaks are computed from the first channel,
+            //! so multi-channel audio should be mixed down first.
+            void add(const std::shared_ptr<Audio>&);
+
+            //! Get the peaks for a range of samples divided into the given
+            //! number of columns. Columns that are narrower than a block
+            //! return the peaks of the block.
+            std::vector<Peak> getPeaks(
+                int64_t start,
+                int64_t sampleCount,
+                size_t columnCount) const;
+
+            //! Write the peaks.
+            void write(const std::shared_ptr<file::FileIO>&) const;
+
+            //! Read peaks.
+            static std::shared_ptr<AudioPeaks> read(const std::shared_ptr<file::FileIO>&);
+
+        private:
+            size_t _getCount(size_t level, size_t index) const;
+            void _levelsUpdate(size_t index);
+
+            TLRENDER_PRIVATE();
+        };
+    }
+}
+
+#include <tlCore/AudioPeaksInline.h>
@@ -0,0 +1,22 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+namespace tl
+{
+    namespace audio
+    {
+        inline bool Peak::operator == (const Peak& other) const
+        {
+            return
+                min == other.min &&
+                max == other.max &&
+                rms == other.rms;
+        }
+
+        inline bool Peak::operator != (const Peak& other) const
+        {
+            return !(*this == other);
+        }
+    }
+}
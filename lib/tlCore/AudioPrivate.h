@@ -0,0 +1,35 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlCore/Audio.h>
+
+namespace tl
+{
+    namespace audio
+    {
+        //! Audio processing kernels. The sizes are the number of values
+        //! (the sample count multiplied by the channel count), except for
+        //! interleaving where they are the number of samples.
+        struct AudioKernels
+        {
+            void (*mixS16)(const uint8_t** in, size_t inCount, uint8_t* out, float volume, size_t size);
+            void (*mixF32)(const uint8_t** in, size_t inCount, uint8_t* out, float volume, size_t size);
+            void (*mixF64)(const uint8_t** in, size_t inCount, uint8_t* out, float volume, size_t size);
+
+            void (*convertS16ToF32)(const uint8_t* in, uint8_t* out, size_t size);
+            void (*convertF32ToS16)(const uint8_t* in, uint8_t* out, size_t size);
+            void (*convertF32ToF64)(const uint8_t* in, uint8_t* out, size_t size);
+            void (*convertF64ToF32)(const uint8_t* in, uint8_t* out, size_t size);
+
+            void (*interleave2x16)(const uint8_t* in0, const uint8_t* in1, uint8_t* out, size_t sampleCount);
+            void (*interleave2x32)(const uint8_t* in0, const uint8_t* in1, uint8_t* out, size_t sampleCount);
+        };
+
+        //! Get the audio processing kernels for the current SIMD
+        //! instruction set.
+        const AudioKernels& getAudioKernels();
+    }
+}
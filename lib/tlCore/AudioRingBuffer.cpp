@@ -0,0 +1,161 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlCore/AudioRingBuffer.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace tl
+{
+    namespace audio
+    {
+        struct AudioRingBuffer::Private
+        {
+            audio::Info info;
+            size_t byteCount = 0;
+            size_t sampleCount = 0;
+            std::vector<uint8_t> data;
+
+            // The positions are incremented without wrapping, and the
+            // difference is the number of samples available for reading.
+            std::atomic<size_t> readPos;
+            std::atomic<size_t> writePos;
+
+            // The number of samples the reads are behind the clock. This is
+            // only used by the consumer thread.
+            size_t underrun = 0;
+        };
+
+        void AudioRingBuffer::_init(const audio::Info& info, size_t sampleCount)
+        {
+            TLRENDER_P();
+            p.info = info;
+            p.byteCount = info.getByteCount();
+            p.sampleCount = sampleCount;
+            p.data.resize(sampleCount * p.byteCount);
+            p.readPos = 0;
+            p.writePos = 0;
+        }
+
+        AudioRingBuffer::AudioRingBuffer() :
+            _p(new Private)
+        {}
+
+        AudioRingBuffer::~AudioRingBuffer()
+        {}
+
+        std::shared_ptr<AudioRingBuffer> AudioRingBuffer::create(
+            const audio::Info& info,
+            size_t sampleCount)
+        {
+            auto out = std::shared_ptr<AudioRingBuffer>(new AudioRingBuffer);
+            out->_init(info, sampleCount);
+            return out;
+        }
+
+        const audio::Info& AudioRingBuffer::getInfo() const
+        {
+            return _p->info;
+        }
+
+        size_t AudioRingBuffer::getSampleCount() const
+        {
+            return _p->sampleCount;
+        }
+
+        size_t AudioRingBuffer::getReadAvailable() const
+        {
+            TLRENDER_P();
+            return p.writePos.load(std::memory_order_acquire) -
+                p.readPos.load(std::memory_order_relaxed);
+        }
+
+        size_t AudioRingBuffer::getWriteAvailable() const
+        {
+            TLRENDER_P();
+            return p.sampleCount - (
+                p.writePos.load(std::memory_order_relaxed) -
+                p.readPos.load(std::memory_order_acquire));
+        }
+
+        size_t AudioRingBuffer::write(const uint8_t* in, size_t sampleCount)
+        {
+            TLRENDER_P();
+            const size_t writePos = p.writePos.load(std::memory_order_relaxed);
+            const size_t readPos = p.readPos.load(std::memory_order_acquire);
+            const size_t size = std::min(sampleCount, p.sampleCount - (writePos - readPos));
+            if (size > 0)
+            {
+                const size_t index = writePos % p.sampleCount;
+                const size_t size0 = std::min(size, p.sampleCount - index);
+                std::memcpy(
+                    p.data.data() + index * p.byteCount,
+                    in,
+                    size0 * p.byteCount);
+                std::memcpy(
+                    p.data.data(),
+                    in + size0 * p.byteCount,
+                    (size - size0) * p.byteCount);
+                p.writePos.store(writePos + size, std::memory_order_release);
+            }
+            return size;
+        }
+
+        size_t AudioRingBuffer::read(uint8_t* out, size_t sampleCount)
+        {
+            TLRENDER_P();
+            const size_t readPos = p.readPos.load(std::memory_order_relaxed);
+            const size_t writePos = p.writePos.load(std::memory_order_acquire);
+            const size_t size = std::min(sampleCount, writePos - readPos);
+            if (size > 0)
+            {
+                const size_t index = readPos % p.sampleCount;
+                const size_t size0 = std::min(size, p.sampleCount - index);
+                std::memcpy(
+                    out,
+                    p.data.data() + index * p.byteCount,
+                    size0 * p.byteCount);
+                std::memcpy(
+                    out + size0 * p.byteCount,
+                    p.data.data(),
+                    (size - size0) * p.byteCount);
+                p.readPos.store(readPos + size, std::memory_order_release);
+            }
+            return size;
+        }
+
+        size_t AudioRingBuffer::skip(size_t sampleCount)
+        {
+            TLRENDER_P();
+            const size_t readPos = p.readPos.load(std::memory_order_relaxed);
+            const size_t writePos = p.writePos.load(std::memory_order_acquire);
+            const size_t size = std::min(sampleCount, writePos - readPos);
+            p.readPos.store(readPos + size, std::memory_order_release);
+            return size;
+        }
+
+        size_t AudioRingBuffer::readSync(uint8_t* out, size_t sampleCount)
+        {
+            TLRENDER_P();
+            p.underrun -= skip(p.underrun);
+            const size_t size = out ? read(out, sampleCount) : skip(sampleCount);
+            p.underrun += sampleCount - size;
+            return size;
+        }
+
+        size_t AudioRingBuffer::getUnderrun() const
+        {
+            return _p->underrun;
+        }
+
+        void AudioRingBuffer::clear()
+        {
+            TLRENDER_P();
+            p.readPos.store(p.writePos.load(std::memory_order_acquire), std::memory_order_release);
+            p.underrun = 0;
+        }
+    }
+}
@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlCore/Audio.h>
+
+namespace tl
+{
+    namespace audio
+    {
+        //! Audio ring buffer.
+        //!
+        //! The ring buffer is lock-free for one producer thread and one
+        //! consumer thread. The memory is allocated when the ring buffer is
+        //! created, so reading and writing do not allocate or block and can
+        //! be used from a real-time audio callback.
+        class AudioRingBuffer
+        {
+            TLRENDER_NON_COPYABLE(AudioRingBuffer);
+
+        protected:
+            void _init(const audio::Info&, size_t sampleCount);
+
+            AudioRingBuffer();
+
+        public:
+            ~AudioRingBuffer();
+
+            //! Create a new ring buffer.
+            static std::shared_ptr<AudioRingBuffer> create(
+                const audio::Info&,
+                size_t sampleCount);
+
+            //! Get the audio information.
+            const audio::Info& getInfo() const;
+
+            //! Get the maximum number of samples.
+            size_t getSampleCount() const;
+
+            //! Get the number of samples that can be read.
+            size_t getReadAvailable() const;
+
+            //! Get the number of samples that can be written.
+            size_t getWriteAvailable() const;
+
+            //! Write samples. Returns the number of samples written. This
+            //! should only be called by the producer thread.
+            size_t write(const uint8_t*, size_t sampleCount);
+
+            //! Read samples. Returns the number of samples read. This should
+            //! only be called by the consumer thread.
+            size_t read(uint8_t*, size_t sampleCount);
+
+            //! Discard samples. Returns the number of samples discarded. This
+            //! should only be called by the consumer thread.
+            size_t skip(size_t sampleCount);
+
+            //! Read samples, keeping the read position in sync with a clock
+            //! that does not wait for the data. Samples that are not
+            //! available are counted as an underrun, and are discarded when
+            //! they are written. Pass null to discard the samples instead of
+            //! reading them. Returns the number of samples read. This should
+            //! only be called by the consumer thread.
+            size_t readSync(uint8_t*, size_t sampleCount);
+
+            //! Get the number of samples that are still to be discarded
+            //! because of underruns.
+            size_t getUnderrun() const;
+
+            //! Discard all of the samples and reset the underrun. This
+            //! should only be called by the consumer thread.
+            void clear();
+
+        private:
+            TLRENDER_PRIVATE();
+        };
+    }
+}
@@ -0,0 +1,842 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlCore/AudioPrivate.h>
+
+#include <tlCore/Error.h>
+#include <tlCore/String.h>
+
+#include <array>
+#include <atomic>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__)
+#define TLRENDER_SSE2
+#define TLRENDER_AVX2
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif // _MSC_VER
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define TLRENDER_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(TLRENDER_AVX2) && (defined(__GNUC__) || defined(__clang__))
+#define TLRENDER_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TLRENDER_TARGET_AVX2
+#endif
+
+namespace tl
+{
+    namespace audio
+    {
+        TLRENDER_ENUM_IMPL(
+            SIMD,
+            "None",
+            "SSE2",
+            "AVX2",
+            "NEON");
+        TLRENDER_ENUM_SERIALIZE_IMPL(SIMD);
+
+        namespace
+        {
+            // The kernels must give the same results as the scalar code, so
+            // the operations are done in the same order and with the same
+            // precision. Clamping floating point values before truncating
+            // them gives the same result as clamping the truncated integers.
+
+            inline int16_t mixS16Value(const int16_t** in, size_t inCount, float volume, size_t i)
+            {
+                int32_t v = 0;
+                for (size_t j = 0; j < inCount; ++j)
+                {
+                    v += math::clamp(
+                        static_cast<int32_t>(in[j][i] * volume),
+                        static_cast<int32_t>(S16Range.getMin()),
+                        static_cast<int32_t>(S16Range.getMax()));
+                }
+                return math::clamp(
+                    v,
+                    static_cast<int32_t>(S16Range.getMin()),
+                    static_cast<int32_t>(S16Range.getMax()));
+            }
+
+            template<typename T>
+            inline T mixFValue(const T** in, size_t inCount, float volume, size_t i)
+            {
+                T v = static_cast<T>(0);
+                for (size_t j = 0; j < inCount; ++j)
+                {
+                    v += in[j][i] * volume;
+                }
+                return v;
+            }
+
+            void mixS16None(const uint8_t** in, size_t inCount, uint8_t* out, float volume, size_t size)
+            {
+                const int16_t** inP = reinterpret_cast<const int16_t**>(in);
+                int16_t* outP = reinterpret_cast<int16_t*>(out);
+                for (size_t i = 0; i < size; ++i)
+                {
+                    outP[i] = mixS16Value(inP, inCount, volume, i);
+                }
+            }
+
+            void mixF32None(const uint8_t** in, size_t inCount, uint8_t* out, float volume, size_t size)
+            {
+                const float** inP = reinterpret_cast<const float**>(in);
+                float* outP = reinterpret_cast<float*>(out);
+                for (size_t i = 0; i < size; ++i)
+                {
+                    outP[i] = mixFValue(inP, inCount, volume, i);
+                }
+            }
+
+            void mixF64None(const uint8_t** in, size_t inCount, uint8_t* out, float volume, size_t size)
+            {
+                const double** inP = reinterpret_cast<const double**>(in);
+                double* outP = reinterpret_cast<double*>(out);
+                for (size_t i = 0; i < size; ++i)
+                {
+                    outP[i] = mixFValue(inP, inCount, volume, i);
+                }
+            }
+
+#define _CONVERT_NONE(a, b) \
+    void convert##a##To##b##None(const uint8_t* in, uint8_t* out, size_t size) \
+    { \
+        const a##_T* inP = reinterpret_cast<const a##_T*>(in); \
+        b##_T* outP = reinterpret_cast<b##_T*>(out); \
+        for (size_t i = 0; i < size; ++i) \
+        { \
+            a##To##b(inP[i], outP[i]); \
+        } \
+    }
+
+            _CONVERT_NONE(S16, F32);
+            _CONVERT_NONE(F32, S16);
+            _CONVERT_NONE(F32, F64);
+            _CONVERT_NONE(F64, F32);
+
+            template<typename T>
+            void interleave2None(const uint8_t* in0, const uint8_t* in1, uint8_t* out, size_t sampleCount)
+            {
+                const T* in0P = reinterpret_cast<const T*>(in0);
+                const T* in1P = reinterpret_cast<const T*>(in1);
+                T* outP = reinterpret_cast<T*>(out);
+                for (size_t i = 0; i < sampleCount; ++i)
+                {
+                    outP[i * 2] = in0P[i];
+                    outP[i * 2 + 1] = in1P[i];
+                }
+            }
+
+#if defined(TLRENDER_SSE2)
+            void mixS16SSE2(const uint8_t** in, size_t inCount, uint8_t* out, float volume, size_t size)
+            {
+                const int16_t** inP = reinterpret_cast<const int16_t**>(in);
+                int16_t* outP = reinterpret_cast<int16_t*>(out);
+                const __m128 v = _mm_set1_ps(volume);
+                const __m128 min = _mm_set1_ps(S16Range.getMin());
+                const __m128 max = _mm_set1_ps(S16Range.getMax());
+                size_t i = 0;
+                for (; i + 8 <= size; i += 8)
+                {
+                    __m128i a0 = _mm_setzero_si128();
+                    __m128i a1 = _mm_setzero_si128();
+                    for (size_t j = 0; j < inCount; ++j)
+                    {
+                        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP[j] + i));
+                        const __m128i x0 = _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16);
+                        const __m128i x1 = _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16);
+                        const __m128 f0 = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(x0), v), min), max);
+                        const __m128 f1 = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(x1), v), min), max);
+                        a0 = _mm_add_epi32(a0, _mm_cvttps_epi32(f0));
+                        a1 = _mm_add_epi32(a1, _mm_cvttps_epi32(f1));
+                    }
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(outP + i), _mm_packs_epi32(a0, a1));
+                }
+                for (; i < size; ++i)
+                {
+                    outP[i] = mixS16Value(inP, inCount, volume, i);
+                }
+            }
+
+            void mixF32SSE2(const uint8_t** in, size_t inCount, uint8_t* out, float volume, size_t size)
+            {
+                const float** inP = reinterpret_cast<const float**>(in);
+                float* outP = reinterpret_cast<float*>(out);
+                const __m128 v = _mm_set1_ps(volume);
+                size_t i = 0;
+                for (; i + 4 <= size; i += 4)
+                {
+                    __m128 a = _mm_setzero_ps();
+                    for (size_t j = 0; j < inCount; ++j)
+                    {
+                        a = _mm_add_ps(a, _mm_mul_ps(_mm_loadu_ps(inP[j] + i), v));
+                    }
+                    _mm_storeu_ps(outP + i, a);
+                }
+                for (; i < size; ++i)
+                {
+                    outP[i] = mixFValue(inP, inCount, volume, i);
+                }
+            }
+
+            void mixF64SSE2(const uint8_t** in, size_t inCount, uint8_t* out, float volume, size_t size)
+            {
+                const double** inP = reinterpret_cast<const double**>(in);
+                double* outP = reinterpret_cast<double*>(out);
+                const __m128d v = _mm_set1_pd(volume);
+                size_t i = 0;
+                for (; i + 2 <= size; i += 2)
+                {
+                    __m128d a = _mm_setzero_pd();
+                    for (size_t j = 0; j < inCount; ++j)
+                    {
+                        a = _mm_add_pd(a, _mm_mul_pd(_mm_loadu_pd(inP[j] + i), v));
+                    }
+                    _mm_storeu_pd(outP + i, a);
+                }
+                for (; i < size; ++i)
+                {
+                    outP[i] = mixFValue(inP, inCount, volume, i);
+                }
+            }
+
+            void convertS16ToF32SSE2(const uint8_t* in, uint8_t* out, size_t size)
+            {
+                const int16_t* inP = reinterpret_cast<const int16_t*>(in);
+                float* outP = reinterpret_cast<float*>(out);
+                const __m128 d = _mm_set1_ps(S16Range.getMax());
+                size_t i = 0;
+                for (; i + 8 <= size; i += 8)
+                {
+                    const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP + i));
+                    const __m128i x0 = _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16);
+                    const __m128i x1 = _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16);
+                    _mm_storeu_ps(outP + i, _mm_div_ps(_mm_cvtepi32_ps(x0), d));
+                    _mm_storeu_ps(outP + i + 4, _mm_div_ps(_mm_cvtepi32_ps(x1), d));
+                }
+                for (; i < size; ++i)
+                {
+                    S16ToF32(inP[i], outP[i]);
+                }
+            }
+
+            void convertF32ToS16SSE2(const uint8_t* in, uint8_t* out, size_t size)
+            {
+                const float* inP = reinterpret_cast<const float*>(in);
+                int16_t* outP = reinterpret_cast<int16_t*>(out);
+                const __m128 m = _mm_set1_ps(S16Range.getMax());
+                const __m128 min = _mm_set1_ps(S16Range.getMin());
+                const __m128 max = _mm_set1_ps(S16Range.getMax());
+                size_t i = 0;
+                for (; i + 8 <= size; i += 8)
+                {
+                    const __m128 f0 = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(inP + i), m), min), max);
+                    const __m128 f1 = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(inP + i + 4), m), min), max);
+                    _mm_storeu_si128(
+                        reinterpret_cast<__m128i*>(outP + i),
+                        _mm_packs_epi32(_mm_cvttps_epi32(f0), _mm_cvttps_epi32(f1)));
+                }
+                for (; i < size; ++i)
+                {
+                    F32ToS16(inP[i], outP[i]);
+                }
+            }
+
+            void convertF32ToF64SSE2(const uint8_t* in, uint8_t* out, size_t size)
+            {
+                const float* inP = reinterpret_cast<const float*>(in);
+                double* outP = reinterpret_cast<double*>(out);
+                size_t i = 0;
+                for (; i + 4 <= size; i += 4)
+                {
+                    const __m128 x = _mm_loadu_ps(inP + i);
+                    _mm_storeu_pd(outP + i, _mm_cvtps_pd(x));
+                    _mm_storeu_pd(outP + i + 2, _mm_cvtps_pd(_mm_movehl_ps(x, x)));
+                }
+                for (; i < size; ++i)
+                {
+                    F32ToF64(inP[i], outP[i]);
+                }
+            }
+
+            void convertF64ToF32SSE2(const uint8_t* in, uint8_t* out, size_t size)
+            {
+                const double* inP = reinterpret_cast<const double*>(in);
+                float* outP = reinterpret_cast<float*>(out);
+                size_t i = 0;
+                for (; i + 4 <= size; i += 4)
+                {
+                    const __m128 x0 = _mm_cvtpd_ps(_mm_loadu_pd(inP + i));
+                    const __m128 x1 = _mm_cvtpd_ps(_mm_loadu_pd(inP + i + 2));
+                    _mm_storeu_ps(outP + i, _mm_movelh_ps(x0, x1));
+                }
+                for (; i < size; ++i)
+                {
+                    F64ToF32(inP[i], outP[i]);
+                }
+            }
+
+            void interleave2x16SSE2(const uint8_t* in0, const uint8_t* in1, uint8_t* out, size_t sampleCount)
+            {
+                size_t i = 0;
+                for (; i + 8 <= sampleCount; i += 8)
+                {
+                    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in0 + i * 2));
+                    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in1 + i * 2));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 4), _mm_unpacklo_epi16(a, b));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 4 + 16), _mm_unpackhi_epi16(a, b));
+                }
+                interleave2None<int16_t>(in0 + i * 2, in1 + i * 2, out + i * 4, sampleCount - i);
+            }
+
+            void interleave2x32SSE2(const uint8_t* in0, const uint8_t* in1, uint8_t* out, size_t sampleCount)
+            {
+                size_t i = 0;
+                for (; i + 4 <= sampleCount; i += 4)
+                {
+                    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in0 + i * 4));
+                    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in1 + i * 4));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 8), _mm_unpacklo_epi32(a, b));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 8 + 16), _mm_unpackhi_epi32(a, b));
+                }
+                interleave2None<int32_t>(in0 + i * 4, in1 + i * 4, out + i * 8, sampleCount - i);
+            }
+#endif // TLRENDER_SSE2
+
+#if defined(TLRENDER_AVX2)
+            TLRENDER_TARGET_AVX2
+            void mixS16AVX2(const uint8_t** in, size_t inCount, uint8_t* out, float volume, size_t size)
+            {
+                const int16_t** inP = reinterpret_cast<const int16_t**>(in);
+                int16_t* outP = reinterpret_cast<int16_t*>(out);
+                const __m256 v = _mm256_set1_ps(volume);
+                const __m256 min = _mm256_set1_ps(S16Range.getMin());
+                const __m256 max = _mm256_set1_ps(S16Range.getMax());
+                size_t i = 0;
+                for (; i + 16 <= size; i += 16)
+                {
+                    __m256i a0 = _mm256_setzero_si256();
+                    __m256i a1 = _mm256_setzero_si256();
+                    for (size_t j = 0; j < inCount; ++j)
+                    {
+                        const __m256i x0 = _mm256_cvtepi16_epi32(
+                            _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP[j] + i)));
+                        const __m256i x1 = _mm256_cvtepi16_epi32(
+                            _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP[j] + i + 8)));
+                        const __m256 f0 = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(x0), v), min), max);
+                        const __m256 f1 = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(x1), v), min), max);
+                        a0 = _mm256_add_epi32(a0, _mm256_cvttps_epi32(f0));
+                        a1 = _mm256_add_epi32(a1, _mm256_cvttps_epi32(f1));
+                    }
+                    // Packing works within 128-bit lanes, so the result
+                    // needs to be reordered.
+                    _mm256_storeu_si256(
+                        reinterpret_cast<__m256i*>(outP + i),
+                        _mm256_permute4x64_epi64(_mm256_packs_epi32(a0, a1), 0xd8));
+                }
+                for (; i < size; ++i)
+                {
+                    outP[i] = mixS16Value(inP, inCount, volume, i);
+                }
+            }
+
+            TLRENDER_TARGET_AVX2
+            void mixF32AVX2(const uint8_t** in, size_t inCount, uint8_t* out, float volume, size_t size)
+            {
+                const float** inP = reinterpret_cast<const float**>(in);
+                float* outP = reinterpret_cast<float*>(out);
+                const __m256 v = _mm256_set1_ps(volume);
+                size_t i = 0;
+                for (; i + 8 <= size; i += 8)
+                {
+                    __m256 a = _mm256_setzero_ps();
+                    for (size_t j = 0; j < inCount; ++j)
+                    {
+                        a = _mm256_add_ps(a, _mm256_mul_ps(_mm256_loadu_ps(inP[j] + i), v));
+                    }
+                    _mm256_storeu_ps(outP + i, a);
+                }
+                for (; i < size; ++i)
+                {
+                    outP[i] = mixFValue(inP, inCount, volume, i);
+                }
+            }
+
+            TLRENDER_TARGET_AVX2
+            void mixF64AVX2(const uint8_t** in, size_t inCount, uint8_t* out, float volume, size_t size)
+            {
+                const double** inP = reinterpret_cast<const double**>(in);
+                double* outP = reinterpret_cast<double*>(out);
+                const __m256d v = _mm256_set1_pd(volume);
+                size_t i = 0;
+                for (; i + 4 <= size; i += 4)
+                {
+                    __m256d a = _mm256_setzero_pd();
+                    for (size_t j = 0; j < inCount; ++j)
+                    {
+                        a = _mm256_add_pd(a, _mm256_mul_pd(_mm256_loadu_pd(inP[j] + i), v));
+                    }
+                    _mm256_storeu_pd(outP + i, a);
+                }
+                for (; i < size; ++i)
+                {
+                    outP[i] = mixFValue(inP, inCount, volume, i);
+                }
+            }
+
+            TLRENDER_TARGET_AVX2
+            void convertS16ToF32AVX2(const uint8_t* in, uint8_t* out, size_t size)
+            {
+                const int16_t* inP = reinterpret_cast<const int16_t*>(in);
+                float* outP = reinterpret_cast<float*>(out);
+                const __m256 d = _mm256_set1_ps(S16Range.getMax());
+                size_t i = 0;
+                for (; i + 8 <= size; i += 8)
+                {
+                    const __m256i x = _mm256_cvtepi16_epi32(
+                        _mm_loadu_si128(reinterpret_cast<const __m128i*>(inP + i)));
+                    _mm256_storeu_ps(outP + i, _mm256_div_ps(_mm256_cvtepi32_ps(x), d));
+                }
+                for (; i < size; ++i)
+                {
+                    S16ToF32(inP[i], outP[i]);
+                }
+            }
+
+            TLRENDER_TARGET_AVX2
+            void convertF32ToS16AVX2(const uint8_t* in, uint8_t* out, size_t size)
+            {
+                const float* inP = reinterpret_cast<const float*>(in);
+                int16_t* outP = reinterpret_cast<int16_t*>(out);
+                const __m256 m = _mm256_set1_ps(S16Range.getMax());
+                const __m256 min = _mm256_set1_ps(S16Range.getMin());
+                const __m256 max = _mm256_set1_ps(S16Range.getMax());
+                size_t i = 0;
+                for (; i + 16 <= size; i += 16)
+                {
+                    const __m256 f0 = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(inP + i), m), min), max);
+                    const __m256 f1 = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(inP + i + 8), m), min), max);
+                    _mm256_storeu_si256(
+                        reinterpret_cast<__m256i*>(outP + i),
+                        _mm256_permute4x64_epi64(
+                            _mm256_packs_epi32(_mm256_cvttps_epi32(f0), _mm256_cvttps_epi32(f1)),
+                            0xd8));
+                }
+                for (; i < size; ++i)
+                {
+                    F32ToS16(inP[i], outP[i]);
+                }
+            }
+
+            TLRENDER_TARGET_AVX2
+            void convertF32ToF64AVX2(const uint8_t* in, uint8_t* out, size_t size)
+            {
+                const float* inP = reinterpret_cast<const float*>(in);
+                double* outP = reinterpret_cast<double*>(out);
+                size_t i = 0;
+                for (; i + 4 <= size; i += 4)
+                {
+                    _mm256_storeu_pd(outP + i, _mm256_cvtps_pd(_mm_loadu_ps(inP + i)));
+                }
+                for (; i < size; ++i)
+                {
+                    F32ToF64(inP[i], outP[i]);
+                }
+            }
+
+            TLRENDER_TARGET_AVX2
+            void convertF64ToF32AVX2(const uint8_t* in, uint8_t* out, size_t size)
+            {
+                const double* inP = reinterpret_cast<const double*>(in);
+                float* outP = reinterpret_cast<float*>(out);
+                size_t i = 0;
+                for (; i + 4 <= size; i += 4)
+                {
+                    _mm_storeu_ps(outP + i, _mm256_cvtpd_ps(_mm256_loadu_pd(inP + i)));
+                }
+                for (; i < size; ++i)
+                {
+                    F64ToF32(inP[i], outP[i]);
+                }
+            }
+
+            TLRENDER_TARGET_AVX2
+            void interleave2x16AVX2(const uint8_t* in0, const uint8_t* in1, uint8_t* out, size_t sampleCount)
+            {
+                size_t i = 0;
+                for (; i + 16 <= sampleCount; i += 16)
+                {
+                    const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in0 + i * 2));
+                    const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in1 + i * 2));
+                    const __m256i lo = _mm256_unpacklo_epi16(a, b);
+                    const __m256i hi = _mm256_unpackhi_epi16(a, b);
+                    _mm256_storeu_si256(
+                        reinterpret_cast<__m256i*>(out + i * 4),
+                        _mm256_permute2x128_si256(lo, hi, 0x20));
+                    _mm256_storeu_si256(
+                        reinterpret_cast<__m256i*>(out + i * 4 + 32),
+                        _mm256_permute2x128_si256(lo, hi, 0x31));
+                }
+                interleave2None<int16_t>(in0 + i * 2, in1 + i * 2, out + i * 4, sampleCount - i);
+            }
+
+            TLRENDER_TARGET_AVX2
+            void interleave2x32AVX2(const uint8_t* in0, const uint8_t* in1, uint8_t* out, size_t sampleCount)
+            {
+                size_t i = 0;
+                for (; i + 8 <= sampleCount; i += 8)
+                {
+                    const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in0 + i * 4));
+                    const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in1 + i * 4));
+                    const __m256i lo = _mm256_unpacklo_epi32(a, b);
+                    const __m256i hi = _mm256_unpackhi_epi32(a, b);
+                    _mm256_storeu_si256(
+                        reinterpret_cast<__m256i*>(out + i * 8),
+                        _mm256_permute2x128_si256(lo, hi, 0x20));
+                    _mm256_storeu_si256(
+                        reinterpret_cast<__m256i*>(out + i * 8 + 32),
+                        _mm256_permute2x128_si256(lo, hi, 0x31));
+                }
+                interleave2None<int32_t>(in0 + i * 4, in1 + i * 4, out + i * 8, sampleCount - i);
+            }
+#endif // TLRENDER_AVX2
+
+#if defined(TLRENDER_NEON)
+            void mixS16NEON(const uint8_t** in, size_t inCount, uint8_t* out, float volume, size_t size)
+            {
+                const int16_t** inP = reinterpret_cast<const int16_t**>(in);
+                int16_t* outP = reinterpret_cast<int16_t*>(out);
+                const float32x4_t v = vdupq_n_f32(volume);
+                const float32x4_t min = vdupq_n_f32(S16Range.getMin());
+                const float32x4_t max = vdupq_n_f32(S16Range.getMax());
+                size_t i = 0;
+                for (; i + 8 <= size; i += 8)
+                {
+                    int32x4_t a0 = vdupq_n_s32(0);
+                    int32x4_t a1 = vdupq_n_s32(0);
+                    for (size_t j = 0; j < inCount; ++j)
+                    {
+                        const int16x8_t x = vld1q_s16(inP[j] + i);
+                        const float32x4_t f0 = vminq_f32(vmaxq_f32(vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(x))), v), min), max);
+                        const float32x4_t f1 = vminq_f32(vmaxq_f32(vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(x))), v), min), max);
+                        a0 = vaddq_s32(a0, vcvtq_s32_f32(f0));
+                        a1 = vaddq_s32(a1, vcvtq_s32_f32(f1));
+                    }
+                    vst1q_s16(outP + i, vcombine_s16(vqmovn_s32(a0), vqmovn_s32(a1)));
+                }
+                for (; i < size; ++i)
+                {
+                    outP[i] = mixS16Value(inP, inCount, volume, i);
+                }
+            }
+
+            void mixF32NEON(const uint8_t** in, size_t inCount, uint8_t* out, float volume, size_t size)
+            {
+                const float** inP = reinterpret_cast<const float**>(in);
+                float* outP = reinterpret_cast<float*>(out);
+                const float32x4_t v = vdupq_n_f32(volume);
+                size_t i = 0;
+                for (; i + 4 <= size; i += 4)
+                {
+                    float32x4_t a = vdupq_n_f32(0.F);
+                    for (size_t j = 0; j < inCount; ++j)
+                    {
+                        a = vaddq_f32(a, vmulq_f32(vld1q_f32(inP[j] + i), v));
+                    }
+                    vst1q_f32(outP + i, a);
+                }
+                for (; i < size; ++i)
+                {
+                    outP[i] = mixFValue(inP, inCount, volume, i);
+                }
+            }
+
+            void mixF64NEON(const uint8_t** in, size_t inCount, uint8_t* out, float volume, size_t size)
+            {
+                const double** inP = reinterpret_cast<const double**>(in);
+                double* outP = reinterpret_cast<double*>(out);
+                const float64x2_t v = vdupq_n_f64(volume);
+                size_t i = 0;
+                for (; i + 2 <= size; i += 2)
+                {
+                    float64x2_t a = vdupq_n_f64(0.0);
+                    for (size_t j = 0; j < inCount; ++j)
+                    {
+                        a = vaddq_f64(a, vmulq_f64(vld1q_f64(inP[j] + i), v));
+                    }
+                    vst1q_f64(outP + i, a);
+                }
+                for (; i < size; ++i)
+                {
+                    outP[i] = mixFValue(inP, inCount, volume, i);
+                }
+            }
+
+            void convertS16ToF32NEON(const uint8_t* in, uint8_t* out, size_t size)
+            {
+                const int16_t* inP = reinterpret_cast<const int16_t*>(in);
+                float* outP = reinterpret_cast<float*>(out);
+                const float32x4_t d = vdupq_n_f32(S16Range.getMax());
+                size_t i = 0;
+                for (; i + 8 <= size; i += 8)
+                {
+                    const int16x8_t x = vld1q_s16(inP + i);
+                    vst1q_f32(outP + i, vdivq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(x))), d));
+                    vst1q_f32(outP + i + 4, vdivq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(x))), d));
+                }
+                for (; i < size; ++i)
+                {
+                    S16ToF32(inP[i], outP[i]);
+                }
+            }
+
+            void convertF32ToS16NEON(const uint8_t* in, uint8_t* out, size_t size)
+            {
+                const float* inP = reinterpret_cast<const float*>(in);
+                int16_t* outP = reinterpret_cast<int16_t*>(out);
+                const float32x4_t m = vdupq_n_f32(S16Range.getMax());
+                const float32x4_t min = vdupq_n_f32(S16Range.getMin());
+                const float32x4_t max = vdupq_n_f32(S16Range.getMax());
+                size_t i = 0;
+                for (; i + 8 <= size; i += 8)
+                {
+                    const float32x4_t f0 = vminq_f32(vmaxq_f32(vmulq_f32(vld1q_f32(inP + i), m), min), max);
+                    const float32x4_t f1 = vminq_f32(vmaxq_f32(vmulq_f32(vld1q_f32(inP + i + 4), m), min), max);
+                    vst1q_s16(outP + i, vcombine_s16(
+                        vqmovn_s32(vcvtq_s32_f32(f0)),
+                        vqmovn_s32(vcvtq_s32_f32(f1))));
+                }
+                for (; i < size; ++i)
+                {
+                    F32ToS16(inP[i], outP[i]);
+                }
+            }
+
+            void convertF32ToF64NEON(const uint8_t* in, uint8_t* out, size_t size)
+            {
+                const float* inP = reinterpret_cast<const float*>(in);
+                double* outP = reinterpret_cast<double*>(out);
+                size_t i = 0;
+                for (; i + 4 <= size; i += 4)
+                {
+                    const float32x4_t x = vld1q_f32(inP + i);
+                    vst1q_f64(outP + i, vcvt_f64_f32(vget_low_f32(x)));
+                    vst1q_f64(outP + i + 2, vcvt_high_f64_f32(x));
+                }
+                for (; i < size; ++i)
+                {
+                    F32ToF64(inP[i], outP[i]);
+                }
+            }
+
+            void convertF64ToF32NEON(const uint8_t* in, uint8_t* out, size_t size)
+            {
+                const double* inP = reinterpret_cast<const double*>(in);
+                float* outP = reinterpret_cast<float*>(out);
+                size_t i = 0;
+                for (; i + 4 <= size; i += 4)
+                {
+                    const float32x2_t x0 = vcvt_f32_f64(vld1q_f64(inP + i));
+                    vst1q_f32(outP + i, vcvt_high_f32_f64(x0, vld1q_f64(inP + i + 2)));
+                }
+                for (; i < size; ++i)
+                {
+                    F64ToF32(inP[i], outP[i]);
+                }
+            }
+
+            void interleave2x16NEON(const uint8_t* in0, const uint8_t* in1, uint8_t* out, size_t sampleCount)
+            {
+                const int16_t* in0P = reinterpret_cast<const int16_t*>(in0);
+                const int16_t* in1P = reinterpret_cast<const int16_t*>(in1);
+                int16_t* outP = reinterpret_cast<int16_t*>(out);
+                size_t i = 0;
+                for (; i + 8 <= sampleCount; i += 8)
+                {
+                    int16x8x2_t x;
+                    x.val[0] = vld1q_s16(in0P + i);
+                    x.val[1] = vld1q_s16(in1P + i);
+                    vst2q_s16(outP + i * 2, x);
+                }
+                interleave2None<int16_t>(in0 + i * 2, in1 + i * 2, out + i * 4, sampleCount - i);
+            }
+
+            void interleave2x32NEON(const uint8_t* in0, const uint8_t* in1, uint8_t* out, size_t sampleCount)
+            {
+                const int32_t* in0P = reinterpret_cast<const int32_t*>(in0);
+                const int32_t* in1P = reinterpret_cast<const int32_t*>(in1);
+                int32_t* outP = reinterpret_cast<int32_t*>(out);
+                size_t i = 0;
+                for (; i + 4 <= sampleCount; i += 4)
+                {
+                    int32x4x2_t x;
+                    x.val[0] = vld1q_s32(in0P + i);
+                    x.val[1] = vld1q_s32(in1P + i);
+                    vst2q_s32(outP + i * 2, x);
+                }
+                interleave2None<int32_t>(in0 + i * 4, in1 + i * 4, out + i * 8, sampleCount - i);
+            }
+#endif // TLRENDER_NEON
+
+            const AudioKernels kernelsNone =
+            {
+                mixS16None,
+                mixF32None,
+                mixF64None,
+                convertS16ToF32None,
+                convertF32ToS16None,
+                convertF32ToF64None,
+                convertF64ToF32None,
+                interleave2None<int16_t>,
+                interleave2None<int32_t>
+            };
+
+#if defined(TLRENDER_SSE2)
+            const AudioKernels kernelsSSE2 =
+            {
+                mixS16SSE2,
+                mixF32SSE2,
+                mixF64SSE2,
+                convertS16ToF32SSE2,
+                convertF32ToS16SSE2,
+                convertF32ToF64SSE2,
+                convertF64ToF32SSE2,
+                interleave2x16SSE2,
+                interleave2x32SSE2
+            };
+#endif // TLRENDER_SSE2
+
+#if defined(TLRENDER_AVX2)
+            const AudioKernels kernelsAVX2 =
+            {
+                mixS16AVX2,
+                mixF32AVX2,
+                mixF64AVX2,
+                convertS16ToF32AVX2,
+                convertF32ToS16AVX2,
+                convertF32ToF64AVX2,
+                convertF64ToF32AVX2,
+                interleave2x16AVX2,
+                interleave2x32AVX2
+            };
+#endif // TLRENDER_AVX2
+
+#if defined(TLRENDER_NEON)
+            const AudioKernels kernelsNEON =
+            {
+                mixS16NEON,
+                mixF32NEON,
+                mixF64NEON,
+                convertS16ToF32NEON,
+                convertF32ToS16NEON,
+                convertF32ToF64NEON,
+                convertF64ToF32NEON,
+                interleave2x16NEON,
+                interleave2x32NEON
+            };
+#endif // TLRENDER_NEON
+
+            bool isAVX2Supported()
+            {
+                bool out = false;
+#if defined(TLRENDER_AVX2)
+#if defined(_MSC_VER)
+                int info[4] = { 0, 0, 0, 0 };
+                __cpuid(info, 1);
+                const bool osxsave = (info[2] & (1 << 27)) != 0;
+                const bool avx = (info[2] & (1 << 28)) != 0;
+                if (osxsave && avx && (_xgetbv(0) & 6) == 6)
+                {
+                    __cpuidex(info, 7, 0);
+                    out = (info[1] & (1 << 5)) != 0;
+                }
+#else // _MSC_VER
+                out = __builtin_cpu_supports("avx2");
+#endif // _MSC_VER
+#endif // TLRENDER_AVX2
+                return out;
+            }
+
+            const std::array<bool, static_cast<size_t>(SIMD::Count)>& getSupported()
+            {
+                static const std::array<bool, static_cast<size_t>(SIMD::Count)> supported =
+                {
+                    true,
+#if defined(TLRENDER_SSE2)
+                    true,
+#else // TLRENDER_SSE2
+                    false,
+#endif // TLRENDER_SSE2
+                    isAVX2Supported(),
+#if defined(TLRENDER_NEON)
+                    true
+#else // TLRENDER_NEON
+                    false
+#endif // TLRENDER_NEON
+                };
+                return supported;
+            }
+
+            SIMD getDefaultSIMD()
+            {
+                SIMD out = SIMD::None;
+                for (auto simd : { SIMD::SSE2, SIMD::AVX2, SIMD::NEON })
+                {
+                    if (isSIMDSupported(simd))
+                    {
+                        out = simd;
+                    }
+                }
+                return out;
+            }
+
+            std::atomic<SIMD>& getCurrentSIMD()
+            {
+                static std::atomic<SIMD> simd(getDefaultSIMD());
+                return simd;
+            }
+        }
+
+        bool isSIMDSupported(SIMD value)
+        {
+            return value < SIMD::Count && getSupported()[static_cast<size_t>(value)];
+        }
+
+        SIMD getSIMD()
+        {
+            return getCurrentSIMD();
+        }
+
+        void setSIMD(SIMD value)
+        {
+            if (isSIMDSupported(value))
+            {
+                getCurrentSIMD() = value;
+            }
+        }
+
+        const AudioKernels& getAudioKernels()
+        {
+            switch (getCurrentSIMD().load())
+            {
+#if defined(TLRENDER_SSE2)
+            case SIMD::SSE2: return kernelsSSE2;
+#endif // TLRENDER_SSE2
+#if defined(TLRENDER_AVX2)
+            case SIMD::AVX2: return kernelsAVX2;
+#endif // TLRENDER_AVX2
+#if defined(TLRENDER_NEON)
+            case SIMD::NEON: return kernelsNEON;
+#endif // TLRENDER_NEON
+            default: break;
+            }
+            return kernelsNone;
+        }
+    }
+}
@@ -0,0 +1,251 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlCore/AudioTimeStretch.h>
+
+#include <tlCore/Math.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace tl
+{
+    namespace audio
+    {
+        namespace
+        {
+            //! Window size in seconds.
+            const double windowSeconds = .04;
+
+            //! Search range in seconds.
+            const double searchSeconds = .01;
+        }
+
+        struct AudioTimeStretch::Private
+        {
+            audio::Info info;
+            double speed = 1.0;
+            size_t windowSize = 0;
+            size_t hopSize = 0;
+            size_t searchSize = 0;
+            std::vector<float> window;
+
+            // Interleaved input samples, and a mono mix used for the
+            // similarity search.
+            std::vector<float> input;
+            std::vector<float> inputMono;
+
+            // Position of the next window in the input, and the position of
+            // the previous window. The previous window position may be
+            // negative after the input has been discarded.
+            double inputPos = 0.0;
+            bool prevValid = false;
+            int64_t prevPos = 0;
+
+            // Second half of the previous window to overlap-add.
+            std::vector<float> overlap;
+
+            size_t search(size_t pos) const;
+        };
+
+        size_t AudioTimeStretch::Private::search(size_t pos) const
+        {
+            // Find the position where the new window best matches the
+            // natural continuation of the previous window.
+            const float* a = inputMono.data() + prevPos + hopSize;
+            const size_t min = pos > searchSize ? (pos - searchSize) : 0;
+            const size_t max = pos + searchSize;
+            auto score = [this, a](size_t k, size_t step)
+            {
+                const float* b = inputMono.data() + k;
+                double ab = 0.0;
+                double bb = 0.0;
+                for (size_t i = 0; i < hopSize; i += step)
+                {
+                    ab += a[i] * b[i];
+                    bb += b[i] * b[i];
+                }
+                return ab / std::sqrt(bb + 1.0e-9);
+            };
+
+            // Search coarsely, then refine around the best match.
+            size_t out = pos;
+            double outScore = score(pos, 2);
+            for (size_t k = min; k <= max; k += 2)
+            {
+                const double s = score(k, 2);
+                if (s > outScore)
+                {
+                    out = k;
+                    outScore = s;
+                }
+            }
+            const size_t coarse = out;
+            outScore = score(coarse, 1);
+            for (size_t k : { coarse - 1, coarse + 1 })
+            {
+                if (k >= min && k <= max)
+                {
+                    const double s = score(k, 1);
+                    if (s > outScore)
+                    {
+                        out = k;
+                        outScore = s;
+                    }
+                }
+            }
+            return out;
+        }
+
+        void AudioTimeStretch::_init(const audio::Info& info)
+        {
+            TLRENDER_P();
+            p.info = info;
+            p.hopSize = std::max(
+                static_cast<size_t>(info.sampleRate * windowSeconds / 2.0),
+                static_cast<size_t>(1));
+            p.windowSize = p.hopSize * 2;
+            p.searchSize = info.sampleRate * searchSeconds;
+            p.window.resize(p.windowSize);
+            for (size_t i = 0; i < p.windowSize; ++i)
+            {
+                // A periodic Hann window sums to one when the windows
+                // overlap by half.
+                p.window[i] = .5F - .5F * std::cos(math::pi2 * i / p.windowSize);
+            }
+            p.overlap.resize(p.hopSize * info.channelCount, 0.F);
+        }
+
+        AudioTimeStretch::AudioTimeStretch() :
+            _p(new Private)
+        {}
+
+        AudioTimeStretch::~AudioTimeStretch()
+        {}
+
+        std::shared_ptr<AudioTimeStretch> AudioTimeStretch::create(const audio::Info& info)
+        {
+            auto out = std::shared_ptr<AudioTimeStretch>(new AudioTimeStretch);
+            out->_init(info);
+            return out;
+        }
+
+        const audio::Info& AudioTimeStretch::getInfo() const
+        {
+            return _p->info;
+        }
+
+        double AudioTimeStretch::getSpeed() const
+        {
+            return _p->speed;
+        }
+
+        void AudioTimeStretch::setSpeed(double value)
+        {
+            TLRENDER_P();
+            const double speed = math::clamp(value, timeStretchSpeedMin, timeStretchSpeedMax);
+            if (speed == p.speed)
+                return;
+            p.speed = speed;
+            flush();
+        }
+
+        std::shared_ptr<Audio> AudioTimeStretch::process(const std::shared_ptr<Audio>& value)
+        {
+            TLRENDER_P();
+            if (!value || 1.0 == p.speed)
+                return value;
+
+            // Append the input samples.
+            const size_t channelCount = p.info.channelCount;
+            const auto f32 = convert(value, DataType::F32);
+            const float* f32P = reinterpret_cast<const float*>(f32->getData());
+            const size_t sampleCount = f32->getSampleCount();
+            const size_t inputSize = p.inputMono.size();
+            p.input.insert(p.input.end(), f32P, f32P + sampleCount * channelCount);
+            p.inputMono.resize(inputSize + sampleCount);
+            for (size_t i = 0; i < sampleCount; ++i)
+            {
+                float v = 0.F;
+                for (size_t c = 0; c < channelCount; ++c)
+                {
+                    v += f32P[i * channelCount + c];
+                }
+                p.inputMono[inputSize + i] = v;
+            }
+
+            // Overlap-add windows while there is enough input.
+            std::vector<float> output;
+            while (1)
+            {
+                const size_t pos = static_cast<size_t>(std::round(p.inputPos));
+                if (pos + p.searchSize + p.windowSize > p.inputMono.size() ||
+                    (p.prevValid && p.prevPos + p.hopSize + p.hopSize > p.inputMono.size()))
+                    break;
+                const size_t best = p.prevValid ? p.search(pos) : pos;
+
+                const size_t outputSize = output.size();
+                output.resize(outputSize + p.hopSize * channelCount);
+                float* outputP = output.data() + outputSize;
+                const float* inputP = p.input.data() + best * channelCount;
+                for (size_t i = 0; i < p.hopSize; ++i)
+                {
+                    const float w0 = p.window[i];
+                    const float w1 = p.window[p.hopSize + i];
+                    for (size_t c = 0; c < channelCount; ++c)
+                    {
+                        const size_t j = i * channelCount + c;
+                        outputP[j] = p.overlap[j] + inputP[j] * w0;
+                        p.overlap[j] = inputP[p.hopSize * channelCount + j] * w1;
+                    }
+                }
+
+                p.prevValid = true;
+                p.prevPos = best;
+                p.inputPos += p.hopSize * p.speed;
+            }
+
+            // Discard input that is no longer needed.
+            if (p.prevValid)
+            {
+                const double searchMin = p.inputPos - p.searchSize;
+                const size_t discard = std::min(
+                    static_cast<size_t>(p.prevPos + p.hopSize),
+                    static_cast<size_t>(std::max(searchMin, 0.0)));
+                if (discard > 0)
+                {
+                    p.input.erase(p.input.begin(), p.input.begin() + discard * channelCount);
+                    p.inputMono.erase(p.inputMono.begin(), p.inputMono.begin() + discard);
+                    p.inputPos -= discard;
+                    p.prevPos -= discard;
+                }
+            }
+
+            // Convert the output samples.
+            const Info f32Info(channelCount, DataType::F32, p.info.sampleRate);
+            auto out = Audio::create(f32Info, output.size() / std::max(channelCount, static_cast<size_t>(1)));
+            if (!output.empty())
+            {
+                std::memcpy(out->getData(), output.data(), output.size() * sizeof(float));
+            }
+            if (p.info.dataType != DataType::F32)
+            {
+                out = convert(out, p.info.dataType);
+            }
+            return out;
+        }
+
+        void AudioTimeStretch::flush()
+        {
+            TLRENDER_P();
+            p.input.clear();
+            p.inputMono.clear();
+            p.inputPos = 0.0;
+            p.prevValid = false;
+            p.prevPos = 0;
+            std::fill(p.overlap.begin(), p.overlap.end(), 0.F);
+        }
+    }
+}
@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlCore/Audio.h>
+
+namespace tl
+{
+    namespace audio
+    {
+        //! Minimum time stretch speed.
+        const double timeStretchSpeedMin = .25;
+
+        //! Maximum time stretch speed.
+        const double timeStretchSpeedMax = 4.0;
+
+        //! Change the speed of audio data without changing the pitch.
+        //!
+        //! This uses WSOLA (waveform similarity overlap-add). Windows of the
+        //! input are taken at the speed and overlap-added at a fixed rate.
+        //! Each window position is adjusted within a small range to best
+        //! match the previous window, which avoids phase cancellation.
+        class AudioTimeStretch
+        {
+            TLRENDER_NON_COPYABLE(AudioTimeStretch);
+
+        protected:
+            void _init(const audio::Info&);
+
+            AudioTimeStretch();
+
+        public:
+            ~AudioTimeStretch();
+
+            //! Create a new time stretch.
+            static std::shared_ptr<AudioTimeStretch> create(const audio::Info&);
+
+            //! Get the audio information.
+            const audio::Info& getInfo() const;
+
+            //! Get the speed.
+            double getSpeed() const;
+
+            //! Set the speed. The speed is clamped to the range
+            //! timeStretchSpeedMin to timeStretchSpeedMax. Setting the speed
+            //! also flushes any remaining data.
+            void setSpeed(double);
+
+            //! Time stretch audio data. The output may be delayed relative to
+            //! the input by the window size.
+            std::shared_ptr<Audio> process(const std::shared_ptr<Audio>&);
+
+            //! Flush any remaining data.
+            void flush();
+
+        private:
+            TLRENDER_PRIVATE();
+        };
+    }
+}
@@ -0,0 +1,295 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlCore/BufferPool.h>
+
+#include <algorithm>
+#include <list>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif // __linux__
+
+namespace tl
+{
+    namespace memory
+    {
+        namespace
+        {
+            const size_t hugePageSize = 2 * megabyte;
+
+            uint8_t* allocate(size_t size)
+            {
+#if defined(__linux__)
+                if (size >= hugePageSize)
+                {
+                    // Map extra memory so that the buffer can be aligned to
+                    // a huge page, then unmap the extra memory.
+                    const size_t mapSize = size + hugePageSize;
+                    void* p = mmap(
+                        nullptr,
+                        mapSize,
+                        PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS,
+                        -1,
+                        0);
+                    if (MAP_FAILED == p)
+                    {
+                        throw std::bad_alloc();
+                    }
+                    const uintptr_t begin = reinterpret_cast<uintptr_t>(p);
+                    const uintptr_t end = begin + mapSize;
+                    const uintptr_t alignedBegin = (begin + hugePageSize - 1) & ~(hugePageSize - 1);
+                    const uintptr_t alignedEnd = alignedBegin + size;
+                    if (alignedBegin > begin)
+                    {
+                        munmap(p, alignedBegin - begin);
+                    }
+                    if (end > alignedEnd)
+                    {
+                        munmap(reinterpret_cast<void*>(alignedEnd), end - alignedEnd);
+                    }
+#if defined(MADV_HUGEPAGE)
+                    madvise(reinterpret_cast<void*>(alignedBegin), size, MADV_HUGEPAGE);
+#endif // MADV_HUGEPAGE
+                    return reinterpret_cast<uint8_t*>(alignedBegin);
+                }
+#endif // __linux__
+                return static_cast<uint8_t*>(::operator new(size));
+            }
+
+            void deallocate(uint8_t* data, size_t size)
+            {
+#if defined(__linux__)
+                if (size >= hugePageSize)
+                {
+                    munmap(data, size);
+                    return;
+                }
+#endif // __linux__
+                ::operator delete(data);
+            }
+        }
+
+        Buffer::Buffer(
+            uint8_t* data,
+            size_t size,
+            size_t capacity,
+            const std::shared_ptr<BufferPool>& pool) :
+            _data(data),
+            _size(size),
+            _capacity(capacity),
+            _pool(pool)
+        {}
+
+        Buffer::~Buffer()
+        {
+            if (_pool)
+            {
+                _pool->_release(_data, _capacity);
+            }
+            else
+            {
+                deallocate(_data, _capacity);
+            }
+        }
+
+        struct BufferPool::Private
+        {
+            struct FreeBuffer
+            {
+                uint8_t* data = nullptr;
+                size_t capacity = 0;
+            };
+            typedef std::list<FreeBuffer> FreeList;
+
+            size_t maxFreeByteCount = 0;
+
+            // The free buffers are kept in a list with the most recently
+            // returned at the front, and indexed by size class.
+            FreeList freeList;
+            std::unordered_map<size_t, std::vector<FreeList::iterator> > freeClasses;
+
+            BufferPoolStats stats;
+            std::mutex mutex;
+
+            void trim(size_t max, std::vector<FreeBuffer>&);
+        };
+
+        void BufferPool::Private::trim(size_t max, std::vector<FreeBuffer>& out)
+        {
+            while (stats.freeByteCount > max && !freeList.empty())
+            {
+                const FreeBuffer& buffer = freeList.back();
+                const auto i = freeClasses.find(buffer.capacity);
+                if (i != freeClasses.end())
+                {
+                    // The least recently returned buffer of a size class is
+                    // at the front of the vector.
+                    i->second.erase(i->second.begin());
+                    if (i->second.empty())
+                    {
+                        freeClasses.erase(i);
+                    }
+                }
+                stats.freeByteCount -= buffer.capacity;
+                ++stats.releaseCount;
+                out.push_back(buffer);
+                freeList.pop_back();
+            }
+        }
+
+        void BufferPool::_init(size_t maxFreeByteCount)
+        {
+            _p->maxFreeByteCount = maxFreeByteCount;
+        }
+
+        BufferPool::BufferPool() :
+            _p(new Private)
+        {}
+
+        BufferPool::~BufferPool()
+        {
+            TLRENDER_P();
+            for (const auto& i : p.freeList)
+            {
+                deallocate(i.data, i.capacity);
+            }
+        }
+
+        std::shared_ptr<BufferPool> BufferPool::create(size_t maxFreeByteCount)
+        {
+            auto out = std::shared_ptr<BufferPool>(new BufferPool);
+            out->_init(maxFreeByteCount);
+            return out;
+        }
+
+        const std::shared_ptr<BufferPool>& BufferPool::getGlobal()
+        {
+            static const std::shared_ptr<BufferPool> pool = create();
+            return pool;
+        }
+
+        size_t BufferPool::getSizeClass(size_t value)
+        {
+            if (value < minSize)
+                return value;
+
+            // There are eight size classes for each power of two.
+            size_t p = 1;
+            while (p <= value / 2)
+            {
+                p *= 2;
+            }
+            const size_t step = p / 8;
+            return (value + step - 1) / step * step;
+        }
+
+        size_t BufferPool::getMaxFreeByteCount() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.maxFreeByteCount;
+        }
+
+        void BufferPool::setMaxFreeByteCount(size_t value)
+        {
+            TLRENDER_P();
+            std::vector<Private::FreeBuffer> release;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.maxFreeByteCount = value;
+                p.trim(p.maxFreeByteCount, release);
+            }
+            for (const auto& i : release)
+            {
+                deallocate(i.data, i.capacity);
+            }
+        }
+
+        std::shared_ptr<Buffer> BufferPool::getBuffer(size_t size)
+        {
+            TLRENDER_P();
+            const size_t capacity = getSizeClass(size);
+            if (size < minSize)
+            {
+                return std::make_shared<Buffer>(allocate(capacity), size, capacity, nullptr);
+            }
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                const auto i = p.freeClasses.find(capacity);
+                if (i != p.freeClasses.end())
+                {
+                    const auto j = i->second.back();
+                    uint8_t* data = j->data;
+                    i->second.pop_back();
+                    if (i->second.empty())
+                    {
+                        p.freeClasses.erase(i);
+                    }
+                    p.freeList.erase(j);
+                    ++p.stats.reuseCount;
+                    p.stats.freeByteCount -= capacity;
+                    p.stats.usedByteCount += capacity;
+                    return std::make_shared<Buffer>(data, size, capacity, shared_from_this());
+                }
+            }
+
+            // Allocate the memory without holding the lock.
+            uint8_t* data = allocate(capacity);
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                ++p.stats.allocCount;
+                p.stats.usedByteCount += capacity;
+                p.stats.peakByteCount = std::max(
+                    p.stats.peakByteCount,
+                    p.stats.usedByteCount + p.stats.freeByteCount);
+            }
+            return std::make_shared<Buffer>(data, size, capacity, shared_from_this());
+        }
+
+        BufferPoolStats BufferPool::getStats() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.stats;
+        }
+
+        void BufferPool::clear()
+        {
+            TLRENDER_P();
+            std::vector<Private::FreeBuffer> release;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.trim(0, release);
+            }
+            for (const auto& i : release)
+            {
+                deallocate(i.data, i.capacity);
+            }
+        }
+
+        void BufferPool::_release(uint8_t* data, size_t capacity)
+        {
+            TLRENDER_P();
+            std::vector<Private::FreeBuffer> release;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.stats.usedByteCount -= capacity;
+                p.stats.freeByteCount += capacity;
+                p.freeList.push_front(Private::FreeBuffer{ data, capacity });
+                p.freeClasses[capacity].push_back(p.freeList.begin());
+                p.trim(p.maxFreeByteCount, release);
+            }
+            for (const auto& i : release)
+            {
+                deallocate(i.data, i.capacity);
+            }
+        }
+    }
+}
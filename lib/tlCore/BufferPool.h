@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlCore/Memory.h>
+
+#include <memory>
+
+namespace tl
+{
+    namespace memory
+    {
+        class BufferPool;
+
+        //! Buffer pool statistics.
+        struct BufferPoolStats
+        {
+            size_t allocCount     = 0; //!< Buffers allocated from the system
+            size_t reuseCount     = 0; //!< Buffers reused from the pool
+            size_t releaseCount   = 0; //!< Buffers released to the system
+            size_t usedByteCount  = 0; //!< Bytes in buffers that are in use
+            size_t freeByteCount  = 0; //!< Bytes in buffers that are free
+            size_t peakByteCount  = 0; //!< Peak of the used and free bytes
+
+            bool operator == (const BufferPoolStats&) const;
+            bool operator != (const BufferPoolStats&) const;
+        };
+
+        //! Memory buffer from a buffer pool. The memory is returned to the
+        //! pool when the buffer is destroyed. The memory is not initialized.
+        class Buffer
+        {
+            TLRENDER_NON_COPYABLE(Buffer);
+
+        public:
+            Buffer(
+                uint8_t* data,
+                size_t size,
+                size_t capacity,
+                const std::shared_ptr<BufferPool>&);
+
+            ~Buffer();
+
+            //! Get the data.
+            uint8_t* getData() const;
+
+            //! Get the requested size in bytes.
+            size_t getSize() const;
+
+            //! Get the allocated size in bytes.
+            size_t getCapacity() const;
+
+        private:
+            uint8_t* _data = nullptr;
+            size_t _size = 0;
+            size_t _capacity = 0;
+            std::shared_ptr<BufferPool> _pool;
+        };
+
+        //! Buffer pool.
+        //!
+        //! Buffer sizes are rounded up to size classes, and buffers that are
+        //! returned to the pool are reused for requests in the same class.
+        //! This avoids allocating and page faulting new memory when buffers
+        //! of similar size are allocated repeatedly, like video frames during
+        //! playback. Large buffers are allocated with huge pages when the
+        //! operating system supports them. The least recently returned free
+        //! buffers are released to the system to keep the free memory within
+        //! the maximum.
+        class BufferPool : public std::enable_shared_from_this<BufferPool>
+        {
+            TLRENDER_NON_COPYABLE(BufferPool);
+
+        protected:
+            void _init(size_t maxFreeByteCount);
+
+            BufferPool();
+
+        public:
+            ~BufferPool();
+
+            //! Default maximum number of free bytes kept in the pool. This
+            //! is enough for a few large video frames; the free buffers are
+            //! not counted in the cache budgets.
+            static const size_t defaultMaxFreeByteCount = 128 * megabyte;
+
+            //! Create a new buffer pool.
+            static std::shared_ptr<BufferPool> create(size_t maxFreeByteCount = defaultMaxFreeByteCount);
+
+            //! Get the global buffer pool.
+            static const std::shared_ptr<BufferPool>& getGlobal();
+
+            //! Get the size class for the given size. Sizes below the
+            //! minimum are not pooled.
+            static size_t getSizeClass(size_t);
+
+            //! Minimum size of pooled buffers.
+            static const size_t minSize = 64 * kilobyte;
+
+            //! Get the maximum number of free bytes kept in the pool.
+            size_t getMaxFreeByteCount() const;
+
+            //! Set the maximum number of free bytes kept in the pool.
+            void setMaxFreeByteCount(size_t);
+
+            //! Get a buffer.
+            std::shared_ptr<Buffer> getBuffer(size_t size);
+
+            //! Get the statistics.
+            BufferPoolStats getStats() const;
+
+            //! Release the free buffers to the system.
+            void clear();
+
+        private:
+            void _release(uint8_t*, size_t capacity);
+
+            friend class Buffer;
+
+            TLRENDER_PRIVATE();
+        };
+    }
+}
+
+#include <tlCore/BufferPoolInline.h>
@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+namespace tl
+{
+    namespace memory
+    {
+        inline bool BufferPoolStats::operator == (const BufferPoolStats& other) const
+        {
+            return
+                allocCount == other.allocCount &&
+                reuseCount == other.reuseCount &&
+                releaseCount == other.releaseCount &&
+                usedByteCount == other.usedByteCount &&
+                freeByteCount == other.freeByteCount &&
+                peakByteCount == other.peakByteCount;
+        }
+
+        inline bool BufferPoolStats::operator != (const BufferPoolStats& other) const
+        {
+            return !(*this == other);
+        }
+
+        inline uint8_t* Buffer::getData() const
+        {
+            return _data;
+        }
+
+        inline size_t Buffer::getSize() const
+        {
+            return _size;
+        }
+
+        inline size_t Buffer::getCapacity() const
+        {
+            return _capacity;
+        }
+    }
+}
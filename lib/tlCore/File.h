@@ -17,6 +17,9 @@ namespace tl
         //! Remove a file.
         bool rm(const std::string&);
 
+        //! Set the modification time of a file to the current time.
+        bool touch(const std::string&);
+
         //! Create a directory.
         bool mkdir(const std::string&);
 
@@ -31,5 +34,8 @@ namespace tl
 
         //! Create a temporary directory.
         std::string createTempDir();
+
+        //! Create a temporary directory inside the given directory.
+        std::string createTempDir(const std::string&);
     }
 }
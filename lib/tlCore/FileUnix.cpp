@@ -11,6 +11,7 @@
 #include <limits.h>
 #include <stdlib.h>
 #include <unistd.h>
+#include <utime.h>
 
 #if defined(__APPLE__)
 #define _STAT struct ::stat
@@ -36,6 +37,11 @@ namespace tl
             return 0 == ::remove(fileName.c_str());
         }
 
+        bool touch(const std::string& fileName)
+        {
+            return 0 == ::utime(fileName.c_str(), nullptr);
+        }
+
         bool mkdir(const std::string& fileName)
         {
             return 0 == ::mkdir(fileName.c_str(), S_IRWXU | S_IRWXG);
@@ -93,9 +99,14 @@ namespace tl
 		}
 
 		std::string createTempDir()
+		{
+			return createTempDir(getTemp());
+		}
+
+		std::string createTempDir(const std::string& dir)
 		{
 		    std::string out;
-			const std::string path = getTemp() + "/XXXXXX";
+			const std::string path = dir + "/XXXXXX";
 			const size_t size = path.size();
 			std::vector<char> buf(size + 1);
 			std::memcpy(buf.data(), path.c_str(), size);
@@ -12,6 +12,8 @@
 #include <windows.h>
 #include <combaseapi.h>
 
+#include <sys/utime.h>
+
 #include <cstring>
 
 #define _STAT     struct _stati64
@@ -33,6 +35,11 @@ namespace tl
             return 0 == _wremove(string::toWide(fileName).c_str());
         }
 
+        bool touch(const std::string& fileName)
+        {
+            return 0 == _wutime(string::toWide(fileName).c_str(), nullptr);
+        }
+
         bool mkdir(const std::string& fileName)
         {
             return 0 == _wmkdir(string::toWide(fileName).c_str());
@@ -80,7 +87,22 @@ namespace tl
             DWORD r = GetTempPath(MAX_PATH, path);
             if (r)
             {
-                out = std::string(path);
+                out = createTempDir(std::string(path));
+            }
+
+            return out;
+        }
+
+        std::string createTempDir(const std::string& dir)
+        {
+            std::string out;
+            if (!dir.empty())
+            {
+                out = dir;
+                if (out.back() != '\\' && out.back() != '/')
+                {
+                    out += '\\';
+                }
 
                 // Create a unique name from a GUID.
                 GUID guid;
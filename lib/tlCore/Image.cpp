@@ -5,6 +5,7 @@
 #include <tlCore/Image.h>
 
 #include <tlCore/Assert.h>
+#include <tlCore/BufferPool.h>
 #include <tlCore/Error.h>
 #include <tlCore/String.h>
 
@@ -303,12 +304,25 @@ namespace tl
         {
             _info = info;
             _dataByteCount = image::getDataByteCount(info);
-            // Use reserve() instead of resize() which can be faster since it
-            // does not initialize the data.
+            // The data is allocated from the buffer pool so that the memory
+            // can be reused by the following images, and is not initialized.
             // 
             //! \bug Allocate a bit of extra space since FFmpeg sws_scale()
             //! seems to be reading past the end?
-            _data.reserve(_dataByteCount + 16);
+            auto buffer = memory::BufferPool::getGlobal()->getBuffer(_dataByteCount + 16);
+            _dataP = buffer->getData();
+            _dataOwner = buffer;
+        }
+
+        void Image::_init(
+            const Info& info,
+            uint8_t* data,
+            const std::shared_ptr<void>& dataOwner)
+        {
+            _info = info;
+            _dataByteCount = image::getDataByteCount(info);
+            _dataP = data;
+            _dataOwner = dataOwner;
         }
 
         Image::Image()
@@ -334,6 +348,16 @@ namespace tl
             return create(Info(w, h, pixelType));
         }
 
+        std::shared_ptr<Image> Image::create(
+            const Info& info,
+            uint8_t* data,
+            const std::shared_ptr<void>& dataOwner)
+        {
+            auto out = std::shared_ptr<Image>(new Image);
+            out->_init(info, data, dataOwner);
+            return out;
+        }
+
         void Image::setTags(const Tags& value)
         {
             _tags = value;
@@ -341,7 +365,7 @@ namespace tl
 
         void Image::zero()
         {
-            std::memset(_data.data(), 0, _dataByteCount);
+            std::memset(_dataP, 0, _dataByteCount);
         }
 
         void to_json(nlohmann::json& json, const Size& value)
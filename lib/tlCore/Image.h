@@ -270,13 +270,18 @@ namespace tl
 
         protected:
             void _init(const Info&);
+            void _init(
+                const Info&,
+                uint8_t* data,
+                const std::shared_ptr<void>& dataOwner);
 
             Image();
 
         public:
             ~Image();
 
-            //! Create a new image.
+            //! Create a new image. The image data is allocated from the
+            //! global buffer pool.
             static std::shared_ptr<Image> create(const Info&);
 
             //! Create a new image.
@@ -285,6 +290,14 @@ namespace tl
             //! Create a new image.
             static std::shared_ptr<Image> create(int w, int h, PixelType);
 
+            //! Create a new image that references external data instead of
+            //! allocating it. The data owner is kept until the image is
+            //! destroyed, and must keep the data valid until then.
+            static std::shared_ptr<Image> create(
+                const Info&,
+                uint8_t* data,
+                const std::shared_ptr<void>& dataOwner);
+
             //! Get the image information.
             const Info& getInfo() const;
 
@@ -328,7 +341,8 @@ namespace tl
             Info _info;
             Tags _tags;
             size_t _dataByteCount = 0;
-            std::vector<uint8_t> _data;
+            uint8_t* _dataP = nullptr;
+            std::shared_ptr<void> _dataOwner;
         };
 
         //! \name Serialize
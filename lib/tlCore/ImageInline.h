@@ -198,12 +198,12 @@ namespace tl
 
         inline const uint8_t* Image::getData() const
         {
-            return _data.data();
+            return _dataP;
         }
 
         inline uint8_t* Image::getData()
         {
-            return _data.data();
+            return _dataP;
         }
     }
 }
@@ -0,0 +1,541 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlCore/ImageResize.h>
+
+#include <tlCore/Error.h>
+#include <tlCore/Math.h>
+#include <tlCore/String.h>
+#include <tlCore/StringFormat.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__)
+#define TLRENDER_SSE2
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define TLRENDER_NEON
+#include <arm_neon.h>
+#endif
+
+namespace tl
+{
+    namespace image
+    {
+        TLRENDER_ENUM_IMPL(
+            ResizeFilter,
+            "Box",
+            "Lanczos3");
+        TLRENDER_ENUM_SERIALIZE_IMPL(ResizeFilter);
+
+        namespace
+        {
+            // Filter weights for resampling one dimension. Every output
+            // sample uses the same number of input samples, so the inner
+            // loops do not need to handle the edges.
+            struct Weights
+            {
+                int taps = 0;
+                std::vector<int> start;
+                std::vector<float> values;
+            };
+
+            inline float sinc(float x)
+            {
+                if (0.F == x)
+                    return 1.F;
+                x *= math::pi;
+                return std::sin(x) / x;
+            }
+
+            Weights getWeights(int inSize, int outSize, ResizeFilter filter)
+            {
+                Weights out;
+                const float scale = inSize / static_cast<float>(outSize);
+                const float filterScale = std::max(scale, 1.F);
+                const float support = ResizeFilter::Box == filter ?
+                    (filterScale / 2.F) :
+                    (3.F * filterScale);
+
+                out.start.resize(outSize);
+                for (int i = 0; i < outSize; ++i)
+                {
+                    const float center = (i + .5F) * scale;
+                    const int left = std::max(
+                        static_cast<int>(std::floor(center - support)),
+                        0);
+                    const int right = std::min(
+                        static_cast<int>(std::ceil(center + support)),
+                        inSize);
+                    out.start[i] = left;
+                    out.taps = std::max(out.taps, right - left);
+                }
+                out.taps = math::clamp(out.taps, 1, inSize);
+
+                out.values.resize(outSize * out.taps);
+                for (int i = 0; i < outSize; ++i)
+                {
+                    const float center = (i + .5F) * scale;
+                    out.start[i] = std::min(out.start[i], inSize - out.taps);
+                    float* values = out.values.data() + i * out.taps;
+                    float sum = 0.F;
+                    for (int j = 0; j < out.taps; ++j)
+                    {
+                        const float x = static_cast<float>(out.start[i] + j);
+                        float v = 0.F;
+                        switch (filter)
+                        {
+                        case ResizeFilter::Box:
+                            // Weight the input samples by how much they
+                            // overlap the output sample.
+                            v = std::max(
+                                std::min(x + 1.F, center + support) -
+                                std::max(x, center - support),
+                                0.F);
+                            break;
+                        case ResizeFilter::Lanczos3:
+                        {
+                            const float d = (x + .5F - center) / filterScale;
+                            v = d > -3.F && d < 3.F ? (sinc(d) * sinc(d / 3.F)) : 0.F;
+                            break;
+                        }
+                        default: break;
+                        }
+                        values[j] = v;
+                        sum += v;
+                    }
+                    if (sum != 0.F)
+                    {
+                        for (int j = 0; j < out.taps; ++j)
+                        {
+                            values[j] /= sum;
+                        }
+                    }
+                    else
+                    {
+                        const int j = math::clamp(
+                            static_cast<int>(center) - out.start[i],
+                            0,
+                            out.taps - 1);
+                        values[j] = 1.F;
+                    }
+                }
+                return out;
+            }
+
+            inline float toFloat(U8_T value)
+            {
+                return value / 255.F;
+            }
+
+            inline float toFloat(U16_T value)
+            {
+                return value / 65535.F;
+            }
+
+            inline float toFloat(U32_T value)
+            {
+                return static_cast<float>(value / 4294967295.0);
+            }
+
+            inline float toFloat(F16_T value)
+            {
+                return static_cast<float>(value);
+            }
+
+            inline float toFloat(F32_T value)
+            {
+                return value;
+            }
+
+            // The channels are expanded to RGBA the same way as the
+            // renderer shaders.
+            template<typename T, int C>
+            void convertRow(const uint8_t* in, int w, bool mirrorX, float* out)
+            {
+                const T* inP = reinterpret_cast<const T*>(in);
+                for (int x = 0; x < w; ++x, out += 4)
+                {
+                    const T* p = inP + (mirrorX ? (w - 1 - x) : x) * C;
+                    switch (C)
+                    {
+                    case 1:
+                        out[0] = out[1] = out[2] = toFloat(p[0]);
+                        out[3] = 1.F;
+                        break;
+                    case 2:
+                        out[0] = out[1] = out[2] = toFloat(p[0]);
+                        out[3] = toFloat(p[1]);
+                        break;
+                    case 3:
+                        out[0] = toFloat(p[0]);
+                        out[1] = toFloat(p[1]);
+                        out[2] = toFloat(p[2]);
+                        out[3] = 1.F;
+                        break;
+                    case 4:
+                        out[0] = toFloat(p[0]);
+                        out[1] = toFloat(p[1]);
+                        out[2] = toFloat(p[2]);
+                        out[3] = toFloat(p[3]);
+                        break;
+                    default: break;
+                    }
+                }
+            }
+
+            void convertRowU10(const uint8_t* in, int w, bool mirrorX, float* out)
+            {
+                const U10* inP = reinterpret_cast<const U10*>(in);
+                for (int x = 0; x < w; ++x, out += 4)
+                {
+                    const U10& p = inP[mirrorX ? (w - 1 - x) : x];
+                    out[0] = p.r / 1023.F;
+                    out[1] = p.g / 1023.F;
+                    out[2] = p.b / 1023.F;
+                    out[3] = 1.F;
+                }
+            }
+
+            template<typename T>
+            void convertRowYUV(const Info& info, const uint8_t* data, int y, float* out)
+            {
+                const int w = info.size.w;
+                const int h = info.size.h;
+                int cw = w;
+                int ch = h;
+                switch (info.pixelType)
+                {
+                case PixelType::YUV_420P_U8:
+                case PixelType::YUV_420P_U16:
+                    cw = w / 2;
+                    ch = h / 2;
+                    break;
+                case PixelType::YUV_422P_U8:
+                case PixelType::YUV_422P_U16:
+                    cw = w / 2;
+                    break;
+                default: break;
+                }
+                const int cy = std::min(y * ch / h, ch - 1);
+                const T* yP = reinterpret_cast<const T*>(data) + y * w;
+                const T* uP = reinterpret_cast<const T*>(data) + w * h + cy * cw;
+                const T* vP = reinterpret_cast<const T*>(data) + w * h + cw * ch + cy * cw;
+                const math::Vector4f c = getYUVCoefficients(info.yuvCoefficients);
+                const bool legalRange = VideoLevels::LegalRange == info.videoLevels;
+                const bool mirrorX = info.layout.mirror.x;
+                for (int x = 0; x < w; ++x, out += 4)
+                {
+                    const int ix = mirrorX ? (w - 1 - x) : x;
+                    const int cx = std::min(ix * cw / w, cw - 1);
+                    float yv = toFloat(yP[ix]);
+                    float cb = toFloat(uP[cx]);
+                    float cr = toFloat(vP[cx]);
+                    if (legalRange)
+                    {
+                        yv = (yv - (16.F / 255.F)) * (255.F / (235.F - 16.F));
+                        cb = (cb - (16.F / 255.F)) * (255.F / (240.F - 16.F)) - .5F;
+                        cr = (cr - (16.F / 255.F)) * (255.F / (240.F - 16.F)) - .5F;
+                    }
+                    else
+                    {
+                        cb -= .5F;
+                        cr -= .5F;
+                    }
+                    out[0] = yv + (c.x * cr);
+                    out[1] = yv - (c.y * cr) - (c.z * cb);
+                    out[2] = yv + (c.w * cb);
+                    out[3] = 1.F;
+                }
+            }
+
+            size_t getRowByteCount(const Info& info)
+            {
+                const int bytes = PixelType::RGB_U10 == info.pixelType ?
+                    4 :
+                    (getChannelCount(info.pixelType) * getBitDepth(info.pixelType) / 8);
+                return getAlignedByteCount(info.size.w * bytes, info.layout.alignment);
+            }
+
+            void convertRow(
+                const Info& info,
+                const uint8_t* data,
+                size_t rowByteCount,
+                int y,
+                float* out)
+            {
+                const int w = info.size.w;
+                const bool mirrorX = info.layout.mirror.x;
+                const uint8_t* row = data + y * rowByteCount;
+                switch (info.pixelType)
+                {
+                case PixelType::L_U8: convertRow<U8_T, 1>(row, w, mirrorX, out); break;
+                case PixelType::L_U16: convertRow<U16_T, 1>(row, w, mirrorX, out); break;
+                case PixelType::L_U32: convertRow<U32_T, 1>(row, w, mirrorX, out); break;
+                case PixelType::L_F16: convertRow<F16_T, 1>(row, w, mirrorX, out); break;
+                case PixelType::L_F32: convertRow<F32_T, 1>(row, w, mirrorX, out); break;
+
+                case PixelType::LA_U8: convertRow<U8_T, 2>(row, w, mirrorX, out); break;
+                case PixelType::LA_U16: convertRow<U16_T, 2>(row, w, mirrorX, out); break;
+                case PixelType::LA_U32: convertRow<U32_T, 2>(row, w, mirrorX, out); break;
+                case PixelType::LA_F16: convertRow<F16_T, 2>(row, w, mirrorX, out); break;
+                case PixelType::LA_F32: convertRow<F32_T, 2>(row, w, mirrorX, out); break;
+
+                case PixelType::RGB_U8: convertRow<U8_T, 3>(row, w, mirrorX, out); break;
+                case PixelType::RGB_U10: convertRowU10(row, w, mirrorX, out); break;
+                case PixelType::RGB_U16: convertRow<U16_T, 3>(row, w, mirrorX, out); break;
+                case PixelType::RGB_U32: convertRow<U32_T, 3>(row, w, mirrorX, out); break;
+                case PixelType::RGB_F16: convertRow<F16_T, 3>(row, w, mirrorX, out); break;
+                case PixelType::RGB_F32: convertRow<F32_T, 3>(row, w, mirrorX, out); break;
+
+                case PixelType::RGBA_U8: convertRow<U8_T, 4>(row, w, mirrorX, out); break;
+                case PixelType::RGBA_U16: convertRow<U16_T, 4>(row, w, mirrorX, out); break;
+                case PixelType::RGBA_U32: convertRow<U32_T, 4>(row, w, mirrorX, out); break;
+                case PixelType::RGBA_F16: convertRow<F16_T, 4>(row, w, mirrorX, out); break;
+                case PixelType::RGBA_F32: convertRow<F32_T, 4>(row, w, mirrorX, out); break;
+
+                case PixelType::YUV_420P_U8:
+                case PixelType::YUV_422P_U8:
+                case PixelType::YUV_444P_U8:
+                    convertRowYUV<U8_T>(info, data, y, out);
+                    break;
+                case PixelType::YUV_420P_U16:
+                case PixelType::YUV_422P_U16:
+                case PixelType::YUV_444P_U16:
+                    convertRowYUV<U16_T>(info, data, y, out);
+                    break;
+
+                default: break;
+                }
+
+                // Legal range YUV data is handled by the conversion above.
+                if (VideoLevels::LegalRange == info.videoLevels &&
+                    info.pixelType < PixelType::YUV_420P_U8)
+                {
+                    // Luminance images use the luminance scale for all of
+                    // the channels, since the renderer scales them before
+                    // copying them.
+                    const float gbScale = getChannelCount(info.pixelType) < 3 ?
+                        (255.F / (235.F - 16.F)) :
+                        (255.F / (240.F - 16.F));
+                    for (int x = 0; x < w; ++x, out += 4)
+                    {
+                        out[0] = (out[0] - (16.F / 255.F)) * (255.F / (235.F - 16.F));
+                        out[1] = (out[1] - (16.F / 255.F)) * gbScale;
+                        out[2] = (out[2] - (16.F / 255.F)) * gbScale;
+                    }
+                }
+            }
+
+            // Filter one RGBA pixel from consecutive input pixels.
+            inline void filterPixel(
+                const float* in,
+                const float* weights,
+                int taps,
+                float* out)
+            {
+#if defined(TLRENDER_SSE2)
+                __m128 v = _mm_setzero_ps();
+                for (int i = 0; i < taps; ++i, in += 4)
+                {
+                    v = _mm_add_ps(v, _mm_mul_ps(_mm_loadu_ps(in), _mm_set1_ps(weights[i])));
+                }
+                _mm_storeu_ps(out, v);
+#elif defined(TLRENDER_NEON)
+                float32x4_t v = vdupq_n_f32(0.F);
+                for (int i = 0; i < taps; ++i, in += 4)
+                {
+                    v = vmlaq_n_f32(v, vld1q_f32(in), weights[i]);
+                }
+                vst1q_f32(out, v);
+#else
+                std::array<float, 4> v = { 0.F, 0.F, 0.F, 0.F };
+                for (int i = 0; i < taps; ++i, in += 4)
+                {
+                    v[0] += in[0] * weights[i];
+                    v[1] += in[1] * weights[i];
+                    v[2] += in[2] * weights[i];
+                    v[3] += in[3] * weights[i];
+                }
+                std::copy(v.begin(), v.end(), out);
+#endif
+            }
+
+            // Add a weighted row of values.
+            inline void filterRow(
+                const float* in,
+                float weight,
+                size_t size,
+                float* out)
+            {
+                size_t i = 0;
+#if defined(TLRENDER_SSE2)
+                const __m128 w = _mm_set1_ps(weight);
+                for (; i + 4 <= size; i += 4)
+                {
+                    _mm_storeu_ps(
+                        out + i,
+                        _mm_add_ps(_mm_loadu_ps(out + i), _mm_mul_ps(_mm_loadu_ps(in + i), w)));
+                }
+#elif defined(TLRENDER_NEON)
+                for (; i + 4 <= size; i += 4)
+                {
+                    vst1q_f32(out + i, vmlaq_n_f32(vld1q_f32(out + i), vld1q_f32(in + i), weight));
+                }
+#endif
+                for (; i < size; ++i)
+                {
+                    out[i] += in[i] * weight;
+                }
+            }
+
+            // Convert values to 8-bit, clamping them to the zero to one range.
+            inline void toU8(const float* in, size_t size, uint8_t* out)
+            {
+                size_t i = 0;
+#if defined(TLRENDER_SSE2)
+                const __m128 zero = _mm_setzero_ps();
+                const __m128 one = _mm_set1_ps(1.F);
+                const __m128 scale = _mm_set1_ps(255.F);
+                const __m128 round = _mm_set1_ps(.5F);
+                for (; i + 16 <= size; i += 16)
+                {
+                    __m128i v[4];
+                    for (size_t j = 0; j < 4; ++j)
+                    {
+                        const __m128 f = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(in + i + j * 4), zero), one);
+                        v[j] = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(f, scale), round));
+                    }
+                    _mm_storeu_si128(
+                        reinterpret_cast<__m128i*>(out + i),
+                        _mm_packus_epi16(
+                            _mm_packs_epi32(v[0], v[1]),
+                            _mm_packs_epi32(v[2], v[3])));
+                }
+#elif defined(TLRENDER_NEON)
+                const float32x4_t zero = vdupq_n_f32(0.F);
+                const float32x4_t one = vdupq_n_f32(1.F);
+                const float32x4_t scale = vdupq_n_f32(255.F);
+                const float32x4_t round = vdupq_n_f32(.5F);
+                for (; i + 16 <= size; i += 16)
+                {
+                    uint16x4_t v[4];
+                    for (size_t j = 0; j < 4; ++j)
+                    {
+                        const float32x4_t f = vminq_f32(vmaxq_f32(vld1q_f32(in + i + j * 4), zero), one);
+                        v[j] = vmovn_u32(vcvtq_u32_f32(vaddq_f32(vmulq_f32(f, scale), round)));
+                    }
+                    vst1q_u8(
+                        out + i,
+                        vcombine_u8(
+                            vmovn_u16(vcombine_u16(v[0], v[1])),
+                            vmovn_u16(vcombine_u16(v[2], v[3]))));
+                }
+#endif
+                for (; i < size; ++i)
+                {
+                    out[i] = static_cast<uint8_t>(math::clamp(in[i], 0.F, 1.F) * 255.F + .5F);
+                }
+            }
+        }
+
+        bool isResizeSupported(const Info& info)
+        {
+            bool out = info.isValid();
+            if (out)
+            {
+                switch (info.pixelType)
+                {
+                case PixelType::YUV_420P_U8:
+                case PixelType::YUV_420P_U16:
+                    out = info.size.w > 1 && info.size.h > 1;
+                    break;
+                case PixelType::YUV_422P_U8:
+                case PixelType::YUV_422P_U16:
+                    out = info.size.w > 1;
+                    break;
+                case PixelType::ARGB_4444_Premult:
+                    out = false;
+                    break;
+                default: break;
+                }
+                if (getBitDepth(info.pixelType) > 8 &&
+                    info.layout.endian != memory::getEndian())
+                {
+                    out = false;
+                }
+            }
+            return out;
+        }
+
+        std::shared_ptr<Image> resize(
+            const std::shared_ptr<Image>& image,
+            const Size& size,
+            ResizeFilter filter)
+        {
+            const Info& info = image->getInfo();
+            if (!isResizeSupported(info) || !size.isValid())
+            {
+                throw std::runtime_error(string::Format("Cannot resize image: {0} to {1}x{2}").
+                    arg(getLabel(info.pixelType)).
+                    arg(size.w).
+                    arg(size.h));
+            }
+            const int inW = info.size.w;
+            const int inH = info.size.h;
+            const int outW = size.w;
+            const int outH = size.h;
+            const Weights xWeights = getWeights(inW, outW, filter);
+            const Weights yWeights = getWeights(inH, outH, filter);
+
+            // Convert the input rows and resample them horizontally.
+            const uint8_t* data = image->getData();
+            const size_t rowByteCount = getRowByteCount(info);
+            const size_t tmpRowSize = static_cast<size_t>(outW) * 4;
+            std::vector<float> row(static_cast<size_t>(inW) * 4);
+            std::vector<float> tmp(tmpRowSize * inH);
+            for (int y = 0; y < inH; ++y)
+            {
+                convertRow(
+                    info,
+                    data,
+                    rowByteCount,
+                    info.layout.mirror.y ? (inH - 1 - y) : y,
+                    row.data());
+                float* tmpP = tmp.data() + y * tmpRowSize;
+                for (int x = 0; x < outW; ++x)
+                {
+                    filterPixel(
+                        row.data() + xWeights.start[x] * 4,
+                        xWeights.values.data() + x * xWeights.taps,
+                        xWeights.taps,
+                        tmpP + x * 4);
+                }
+            }
+
+            // Resample the rows vertically and convert them to 8-bit.
+            auto out = Image::create(outW, outH, PixelType::RGBA_U8);
+            uint8_t* outP = out->getData();
+            std::vector<float> acc(tmpRowSize);
+            for (int y = 0; y < outH; ++y)
+            {
+                std::fill(acc.begin(), acc.end(), 0.F);
+                const float* weights = yWeights.values.data() + y * yWeights.taps;
+                for (int i = 0; i < yWeights.taps; ++i)
+                {
+                    filterRow(
+                        tmp.data() + (yWeights.start[y] + i) * tmpRowSize,
+                        weights[i],
+                        tmpRowSize,
+                        acc.data());
+                }
+                toU8(acc.data(), tmpRowSize, outP + y * tmpRowSize);
+            }
+            return out;
+        }
+    }
+}
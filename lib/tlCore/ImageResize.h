@@ -0,0 +1,37 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlCore/Image.h>
+
+namespace tl
+{
+    namespace image
+    {
+        //! Image resize filters.
+        enum class ResizeFilter
+        {
+            Box,
+            Lanczos3,
+
+            Count,
+            First = Box
+        };
+        TLRENDER_ENUM(ResizeFilter);
+        TLRENDER_ENUM_SERIALIZE(ResizeFilter);
+
+        //! Get whether the image can be resized on the CPU.
+        bool isResizeSupported(const Info&);
+
+        //! Resize an image on the CPU. The output is RGBA_U8 with the
+        //! default layout, so the mirroring, video levels, and YUV
+        //! conversion are applied the same way as when the image is drawn
+        //! with the renderer and read back.
+        std::shared_ptr<Image> resize(
+            const std::shared_ptr<Image>&,
+            const Size&,
+            ResizeFilter = ResizeFilter::Box);
+    }
+}
@@ -5,14 +5,32 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
+#include <list>
 #include <map>
+#include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 namespace tl
 {
     namespace memory
     {
+        //! Whether a type can be used as a key for a hash map.
+        template<typename T, typename = void>
+        struct IsHashable : std::false_type {};
+
+        //! Whether a type can be used as a key for a hash map.
+        template<typename T>
+        struct IsHashable<T, std::void_t<decltype(std::hash<T>()(std::declval<const T&>()))> > :
+            std::true_type {};
+
         //! Least recently used (LRU) cache.
+        //!
+        //! Items are stored in a recency list with the most recently used
+        //! item at the front, and indexed by a hash map (or an ordered map
+        //! for keys without a std::hash specialization). Getting, adding,
+        //! and evicting items are constant time operations.
         template<typename T, typename U>
         class LRUCache
         {
@@ -35,6 +53,15 @@ namespace tl
             bool contains(const T& key) const;
             bool get(const T& key, U& value) const;
 
+            //! Get a value without updating the recency.
+            bool peek(const T& key, U& value) const;
+
+            //! Mark a value as the most recently used.
+            void touch(const T& key) const;
+
+            //! Get the least recently used key.
+            bool getOldest(T& key) const;
+
             void add(const T& key, const U& value, size_t size = 1);
             void remove(const T& key);
             void clear();
@@ -47,10 +74,22 @@ namespace tl
         private:
             void _maxUpdate();
 
+            struct Item
+            {
+                T key;
+                U value;
+                size_t size = 0;
+            };
+            typedef std::list<Item> List;
+            typedef typename std::conditional<
+                IsHashable<T>::value,
+                std::unordered_map<T, typename List::iterator>,
+                std::map<T, typename List::iterator> >::type Map;
+
             size_t _max = 10000;
-            std::map<T, std::pair<U, size_t> > _map;
-            mutable std::map<T, int64_t> _counts;
-            mutable int64_t _counter = 0;
+            size_t _size = 0;
+            mutable List _list;
+            Map _map;
         };
     }
 }
@@ -17,12 +17,7 @@ namespace tl
         template<typename T, typename U>
         inline std::size_t LRUCache<T, U>::getSize() const
         {
-            size_t out = 0;
-            for (const auto& i : _map)
-            {
-                out += i.second.second;
-            }
-            return out;
+            return _size;
         }
 
         template<typename T, typename U>
@@ -34,7 +29,7 @@ namespace tl
         template<typename T, typename U>
         inline float LRUCache<T, U>::getPercentage() const
         {
-            return getSize() / static_cast<float>(_max) * 100.F;
+            return _size / static_cast<float>(_max) * 100.F;
         }
 
         template<typename T, typename U>
@@ -55,27 +50,66 @@ namespace tl
         template<typename T, typename U>
         inline bool LRUCache<T, U>::get(const T& key, U& value) const
         {
-            auto i = _map.find(key);
+            const auto i = _map.find(key);
             if (i != _map.end())
             {
-                value = i->second.first;
-                auto j = _counts.find(key);
-                if (j != _counts.end())
-                {
-                    ++_counter;
-                    j->second = _counter;
-                }
+                value = i->second->value;
+                _list.splice(_list.begin(), _list, i->second);
+                return true;
+            }
+            return false;
+        }
+
+        template<typename T, typename U>
+        inline bool LRUCache<T, U>::peek(const T& key, U& value) const
+        {
+            const auto i = _map.find(key);
+            if (i != _map.end())
+            {
+                value = i->second->value;
                 return true;
             }
-            return i != _map.end();
+            return false;
+        }
+
+        template<typename T, typename U>
+        inline void LRUCache<T, U>::touch(const T& key) const
+        {
+            const auto i = _map.find(key);
+            if (i != _map.end())
+            {
+                _list.splice(_list.begin(), _list, i->second);
+            }
+        }
+
+        template<typename T, typename U>
+        inline bool LRUCache<T, U>::getOldest(T& key) const
+        {
+            if (!_list.empty())
+            {
+                key = _list.back().key;
+                return true;
+            }
+            return false;
         }
 
         template<typename T, typename U>
         inline void LRUCache<T, U>::add(const T& key, const U& value, size_t size)
         {
-            _map[key] = std::make_pair(value, size);
-            ++_counter;
-            _counts[key] = _counter;
+            const auto i = _map.find(key);
+            if (i != _map.end())
+            {
+                _size -= i->second->size;
+                i->second->value = value;
+                i->second->size = size;
+                _list.splice(_list.begin(), _list, i->second);
+            }
+            else
+            {
+                _list.push_front(Item{ key, value, size });
+                _map[key] = _list.begin();
+            }
+            _size += size;
             _maxUpdate();
         }
 
@@ -85,40 +119,54 @@ namespace tl
             const auto i = _map.find(key);
             if (i != _map.end())
             {
+                _size -= i->second->size;
+                _list.erase(i->second);
                 _map.erase(i);
             }
-            const auto j = _counts.find(key);
-            if (j != _counts.end())
-            {
-                _counts.erase(j);
-            }
-            _maxUpdate();
         }
 
         template<typename T, typename U>
         inline void LRUCache<T, U>::clear()
         {
             _map.clear();
+            _list.clear();
+            _size = 0;
         }
 
         template<typename T, typename U>
         inline std::vector<T> LRUCache<T, U>::getKeys() const
         {
             std::vector<T> out;
-            for (const auto& i : _map)
+            out.reserve(_list.size());
+            for (const auto& i : _list)
             {
-                out.push_back(i.first);
+                out.push_back(i.key);
             }
+            std::sort(out.begin(), out.end());
             return out;
         }
 
         template<typename T, typename U>
         inline std::vector<U> LRUCache<T, U>::getValues() const
         {
+            std::vector<const Item*> items;
+            items.reserve(_list.size());
+            for (const auto& i : _list)
+            {
+                items.push_back(&i);
+            }
+            std::sort(
+                items.begin(),
+                items.end(),
+                [](const Item* a, const Item* b)
+                {
+                    return a->key < b->key;
+                });
             std::vector<U> out;
-            for (const auto& i : _map)
+            out.reserve(items.size());
+            for (const auto& i : items)
             {
-                out.push_back(i.second.first);
+                out.push_back(i->value);
             }
             return out;
         }
@@ -126,29 +174,12 @@ namespace tl
         template<typename T, typename U>
         inline void LRUCache<T, U>::_maxUpdate()
         {
-            size_t size = getSize();
-            if (size > _max)
+            while (_size > _max && !_list.empty())
             {
-                std::map<int64_t, T> sorted;
-                for (const auto& i : _counts)
-                {
-                    sorted[i.second] = i.first;
-                }
-                while (getSize() > _max)
-                {
-                    auto begin = sorted.begin();
-                    auto i = _map.find(begin->second);
-                    if (i != _map.end())
-                    {
-                        _map.erase(i);
-                    }
-                    auto j = _counts.find(begin->second);
-                    if (j != _counts.end())
-                    {
-                        _counts.erase(j);
-                    }
-                    sorted.erase(begin);
-                }
+                const Item& item = _list.back();
+                _size -= item.size;
+                _map.erase(item.key);
+                _list.pop_back();
             }
         }
     }
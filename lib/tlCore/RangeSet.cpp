@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlCore/RangeSet.h>
+
+#include <algorithm>
+
+namespace tl
+{
+    namespace math
+    {
+        bool Int64RangeSet::isEmpty() const
+        {
+            return _ranges.empty();
+        }
+
+        size_t Int64RangeSet::getRangeCount() const
+        {
+            return _ranges.size();
+        }
+
+        std::vector<Range<int64_t> > Int64RangeSet::getRanges() const
+        {
+            std::vector<Range<int64_t> > out;
+            out.reserve(_ranges.size());
+            for (const auto& i : _ranges)
+            {
+                out.push_back(Range<int64_t>(i.first, i.second));
+            }
+            return out;
+        }
+
+        bool Int64RangeSet::contains(int64_t value) const
+        {
+            auto i = _ranges.upper_bound(value);
+            if (i == _ranges.begin())
+                return false;
+            --i;
+            return value <= i->second;
+        }
+
+        void Int64RangeSet::insert(int64_t value)
+        {
+            insert(Range<int64_t>(value, value));
+        }
+
+        void Int64RangeSet::insert(const Range<int64_t>& range)
+        {
+            int64_t min = range.getMin();
+            int64_t max = range.getMax();
+
+            // Merge with a previous range that overlaps or is adjacent.
+            auto i = _ranges.upper_bound(min);
+            if (i != _ranges.begin())
+            {
+                auto prev = std::prev(i);
+                if (prev->second >= min - 1)
+                {
+                    if (prev->second >= max)
+                        return;
+                    min = prev->first;
+                    i = prev;
+                }
+            }
+
+            // Merge with the following ranges that overlap or are adjacent.
+            while (i != _ranges.end() && i->first <= max + 1)
+            {
+                max = std::max(max, i->second);
+                i = _ranges.erase(i);
+            }
+
+            _ranges[min] = max;
+        }
+
+        void Int64RangeSet::remove(int64_t value)
+        {
+            remove(Range<int64_t>(value, value));
+        }
+
+        void Int64RangeSet::remove(const Range<int64_t>& range)
+        {
+            const int64_t min = range.getMin();
+            const int64_t max = range.getMax();
+
+            // Split a previous range that overlaps.
+            auto i = _ranges.upper_bound(min);
+            if (i != _ranges.begin())
+            {
+                auto prev = std::prev(i);
+                if (prev->second >= min)
+                {
+                    const int64_t prevMax = prev->second;
+                    if (prev->first < min)
+                    {
+                        prev->second = min - 1;
+                    }
+                    else
+                    {
+                        _ranges.erase(prev);
+                    }
+                    if (prevMax > max)
+                    {
+                        _ranges[max + 1] = prevMax;
+                        return;
+                    }
+                }
+            }
+
+            // Remove or trim the following ranges that overlap.
+            while (i != _ranges.end() && i->first <= max)
+            {
+                const int64_t rangeMax = i->second;
+                i = _ranges.erase(i);
+                if (rangeMax > max)
+                {
+                    _ranges[max + 1] = rangeMax;
+                    break;
+                }
+            }
+        }
+
+        void Int64RangeSet::clear()
+        {
+            _ranges.clear();
+        }
+
+        bool Int64RangeSet::operator == (const Int64RangeSet& other) const
+        {
+            return _ranges == other._ranges;
+        }
+
+        bool Int64RangeSet::operator != (const Int64RangeSet& other) const
+        {
+            return !(*this == other);
+        }
+    }
+}
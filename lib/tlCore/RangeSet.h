@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlCore/Range.h>
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace tl
+{
+    namespace math
+    {
+        //! Set of integer values stored as ranges. Adjacent and overlapping
+        //! ranges are merged, so inserting or removing a value is
+        //! logarithmic in the number of ranges.
+        class Int64RangeSet
+        {
+        public:
+            //! Is the set empty?
+            bool isEmpty() const;
+
+            //! Get the number of ranges.
+            size_t getRangeCount() const;
+
+            //! Get the ranges in ascending order.
+            std::vector<Range<int64_t> > getRanges() const;
+
+            //! Does the set contain the given value?
+            bool contains(int64_t) const;
+
+            //! Insert a value.
+            void insert(int64_t);
+
+            //! Insert a range of values.
+            void insert(const Range<int64_t>&);
+
+            //! Remove a value.
+            void remove(int64_t);
+
+            //! Remove a range of values.
+            void remove(const Range<int64_t>&);
+
+            //! Remove all of the values.
+            void clear();
+
+            bool operator == (const Int64RangeSet&) const;
+            bool operator != (const Int64RangeSet&) const;
+
+        private:
+            // Map of the range minimums to the range maximums.
+            std::map<int64_t, int64_t> _ranges;
+        };
+    }
+}
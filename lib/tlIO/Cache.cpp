@@ -4,68 +4,338 @@
 
 #include <tlIO/Cache.h>
 
+#include <tlIO/DiskCache.h>
+
 #include <tlCore/LRUCache.h>
-#include <tlCore/String.h>
-#include <tlCore/StringFormat.h>
 
+#include <atomic>
+#include <limits>
 #include <mutex>
+#include <shared_mutex>
 
 namespace tl
 {
     namespace io
     {
-        std::string getCacheKey(
-            const file::Path& path,
-            const otime::RationalTime& time,
-            const Options& initOptions,
-            const Options& frameOptions)
+        namespace
         {
-            std::vector<std::string> s;
-            s.push_back(path.get());
-            s.push_back(path.getNumber());
-            s.push_back(string::Format("{0}").arg(time));
-            for (const auto& i : initOptions)
+            const uint64_t fnvOffset = 14695981039346656037ULL;
+            const uint64_t fnvPrime = 1099511628211ULL;
+
+            inline uint64_t fnv(uint64_t hash, const std::string& value)
             {
-                s.push_back(string::Format("{0}:{1}").arg(i.first).arg(i.second));
+                for (const char c : value)
+                {
+                    hash ^= static_cast<uint8_t>(c);
+                    hash *= fnvPrime;
+                }
+                // Terminate each string so that adjacent fields cannot run
+                // together.
+                hash ^= 0xff;
+                hash *= fnvPrime;
+                return hash;
             }
-            for (const auto& i : frameOptions)
+        }
+
+        uint64_t getCacheHash(const file::Path& path)
+        {
+            uint64_t out = fnvOffset;
+            out = fnv(out, path.getProtocol());
+            out = fnv(out, path.getDirectory());
+            out = fnv(out, path.getBaseName());
+            out = fnv(out, path.getNumber());
+            out = combineCacheHash(out, path.getPadding());
+            out = fnv(out, path.getExtension());
+            out = fnv(out, path.getRequest());
+            return out;
+        }
+
+        uint64_t getCacheHash(const Options& options)
+        {
+            uint64_t out = fnvOffset;
+            for (const auto& i : options)
             {
-                s.push_back(string::Format("{0}:{1}").arg(i.first).arg(i.second));
+                out = fnv(out, i.first);
+                out = fnv(out, i.second);
             }
-            return string::join(s, ';');
+            return out;
         }
 
-        std::string getCacheKey(
+        CacheKey getCacheKey(
+            const file::Path& path,
+            const otime::RationalTime& time,
+            const Options& initOptions,
+            const Options& frameOptions)
+        {
+            return CacheKey(
+                getCacheHash(path),
+                time,
+                combineCacheHash(getCacheHash(initOptions), getCacheHash(frameOptions)));
+        }
+
+        CacheKey getCacheKey(
             const file::Path& path,
             const otime::TimeRange& timeRange,
             const Options& initOptions,
             const Options& frameOptions)
         {
-            std::vector<std::string> s;
-            s.push_back(path.get());
-            s.push_back(path.getNumber());
-            s.push_back(string::Format("{0}").arg(timeRange));
-            for (const auto& i : initOptions)
+            return CacheKey(
+                getCacheHash(path),
+                timeRange,
+                combineCacheHash(getCacheHash(initOptions), getCacheHash(frameOptions)));
+        }
+
+        bool CacheShardStats::operator == (const CacheShardStats& other) const
+        {
+            return
+                videoHits == other.videoHits &&
+                videoMisses == other.videoMisses &&
+                audioHits == other.audioHits &&
+                audioMisses == other.audioMisses &&
+                diskHits == other.diskHits &&
+                contention == other.contention;
+        }
+
+        bool CacheShardStats::operator != (const CacheShardStats& other) const
+        {
+            return !(*this == other);
+        }
+
+        namespace
+        {
+            // Cache items are stamped each time they are used so that the
+            // least recently used item can be found across all of the
+            // shards.
+            template<typename T>
+            struct Item
+            {
+                T data;
+                uint64_t stamp = 0;
+            };
+
+            size_t getByteCount(const VideoData& value)
+            {
+                return value.image ? value.image->getDataByteCount() : 1;
+            }
+
+            size_t getByteCount(const AudioData& value)
             {
-                s.push_back(string::Format("{0}:{1}").arg(i.first).arg(i.second));
+                return value.audio ? value.audio->getByteCount() : 1;
             }
-            for (const auto& i : frameOptions)
+
+            struct Shard
+            {
+                memory::LRUCache<CacheKey, Item<VideoData> > video;
+                memory::LRUCache<CacheKey, Item<AudioData> > audio;
+                std::atomic<size_t> videoHits;
+                std::atomic<size_t> videoMisses;
+                std::atomic<size_t> audioHits;
+                std::atomic<size_t> audioMisses;
+                std::atomic<size_t> diskHits;
+                std::atomic<size_t> contention;
+                std::shared_mutex mutex;
+
+                Shard() :
+                    videoHits(0),
+                    videoMisses(0),
+                    audioHits(0),
+                    audioMisses(0),
+                    diskHits(0),
+                    contention(0)
+                {
+                    // The size is limited by the cache, not the shard.
+                    video.setMax(std::numeric_limits<size_t>::max());
+                    audio.setMax(std::numeric_limits<size_t>::max());
+                }
+
+                std::shared_lock<std::shared_mutex> readLock()
+                {
+                    std::shared_lock<std::shared_mutex> lock(mutex, std::try_to_lock);
+                    if (!lock.owns_lock())
+                    {
+                        ++contention;
+                        lock.lock();
+                    }
+                    return lock;
+                }
+
+                std::unique_lock<std::shared_mutex> writeLock()
+                {
+                    std::unique_lock<std::shared_mutex> lock(mutex, std::try_to_lock);
+                    if (!lock.owns_lock())
+                    {
+                        ++contention;
+                        lock.lock();
+                    }
+                    return lock;
+                }
+            };
+
+            template<typename T>
+            bool getOldest(
+                const memory::LRUCache<CacheKey, Item<T> >& cache,
+                const CacheKey& keep,
+                CacheKey& key,
+                uint64_t& stamp)
             {
-                s.push_back(string::Format("{0}:{1}").arg(i.first).arg(i.second));
+                Item<T> item;
+                const bool out =
+                    cache.getOldest(key) &&
+                    key != keep &&
+                    cache.peek(key, item);
+                if (out)
+                {
+                    stamp = item.stamp;
+                }
+                return out;
+            }
+
+            // Evict the least recently used items across all of the shards
+            // until the size is within the budget. The item that was just
+            // added is never evicted.
+            template<typename T>
+            void evict(
+                const std::vector<std::unique_ptr<Shard> >& shards,
+                memory::LRUCache<CacheKey, Item<T> > Shard::* cache,
+                std::atomic<size_t>& size,
+                size_t max,
+                const CacheKey& keep,
+                std::vector<std::pair<CacheKey, T> >* evicted = nullptr)
+            {
+                while (size > max)
+                {
+                    Shard* oldest = nullptr;
+                    CacheKey oldestKey;
+                    uint64_t oldestStamp = std::numeric_limits<uint64_t>::max();
+                    for (const auto& shard : shards)
+                    {
+                        auto lock = shard->readLock();
+                        CacheKey key;
+                        uint64_t stamp = 0;
+                        if (getOldest((*shard).*cache, keep, key, stamp) &&
+                            stamp < oldestStamp)
+                        {
+                            oldest = shard.get();
+                            oldestKey = key;
+                            oldestStamp = stamp;
+                        }
+                    }
+                    if (!oldest)
+                        break;
+
+                    auto lock = oldest->writeLock();
+                    auto& shardCache = (*oldest).*cache;
+                    Item<T> item;
+                    if (shardCache.peek(oldestKey, item) &&
+                        item.stamp == oldestStamp)
+                    {
+                        const size_t shardSize = shardCache.getSize();
+                        shardCache.remove(oldestKey);
+                        size -= shardSize - shardCache.getSize();
+                        if (evicted)
+                        {
+                            evicted->push_back(std::make_pair(oldestKey, item.data));
+                        }
+                    }
+                }
             }
-            return string::join(s, ';');
         }
 
         struct Cache::Private
         {
             size_t max = memory::gigabyte;
-            memory::LRUCache<std::string, VideoData> video;
-            memory::LRUCache<std::string, AudioData> audio;
-            std::mutex mutex;
+            std::vector<std::unique_ptr<Shard> > shards;
+            std::shared_ptr<DiskCache> diskCache;
+
+            // The byte budget is shared by all of the shards so that items
+            // larger than a single shard's share can still be cached.
+            std::atomic<size_t> videoMax;
+            std::atomic<size_t> audioMax;
+            std::atomic<size_t> videoSize;
+            std::atomic<size_t> audioSize;
+            std::atomic<uint64_t> stamp;
+
+            Private() :
+                videoMax(0),
+                audioMax(0),
+                videoSize(0),
+                audioSize(0),
+                stamp(0)
+            {}
+
+            Shard& getShard(const CacheKey& key) const
+            {
+                return *shards[std::hash<CacheKey>()(key) % shards.size()];
+            }
+
+            template<typename T>
+            void add(
+                Shard& shard,
+                memory::LRUCache<CacheKey, Item<T> >& cache,
+                std::atomic<size_t>& size,
+                const CacheKey& key,
+                const T& value)
+            {
+                auto lock = shard.writeLock();
+                const size_t prevSize = cache.getSize();
+                cache.add(key, Item<T>{ value, ++stamp }, getByteCount(value));
+                size += cache.getSize();
+                size -= prevSize;
+            }
+
+            template<typename T>
+            bool get(
+                Shard& shard,
+                memory::LRUCache<CacheKey, Item<T> >& cache,
+                const CacheKey& key,
+                T& value)
+            {
+                Item<T> item;
+                bool out = false;
+                {
+                    auto lock = shard.readLock();
+                    out = cache.peek(key, item);
+                }
+                if (out)
+                {
+                    value = item.data;
+                    std::unique_lock<std::shared_mutex> lock(shard.mutex, std::try_to_lock);
+                    if (lock.owns_lock() && cache.contains(key))
+                    {
+                        cache.add(key, Item<T>{ item.data, ++stamp }, getByteCount(item.data));
+                    }
+                }
+                return out;
+            }
+
+            void addVideo(const CacheKey&, const VideoData&);
         };
 
-        void Cache::_init()
+        void Cache::Private::addVideo(const CacheKey& key, const VideoData& videoData)
+        {
+            auto& shard = getShard(key);
+            add(shard, shard.video, videoSize, key, videoData);
+            std::vector<std::pair<CacheKey, VideoData> > evicted;
+            evict(shards, &Shard::video, videoSize, videoMax, key, &evicted);
+            if (!evicted.empty())
+            {
+                if (auto diskCache = std::atomic_load(&this->diskCache))
+                {
+                    for (const auto& i : evicted)
+                    {
+                        diskCache->addVideo(i.first, i.second);
+                    }
+                }
+            }
+        }
+
+        void Cache::_init(size_t shardCount)
         {
+            TLRENDER_P();
+            for (size_t i = 0; i < std::max(shardCount, static_cast<size_t>(1)); ++i)
+            {
+                p.shards.push_back(std::unique_ptr<Shard>(new Shard));
+            }
             _maxUpdate();
         }
 
@@ -76,13 +346,18 @@ namespace tl
         Cache::~Cache()
         {}
 
-        std::shared_ptr<Cache> Cache::create()
+        std::shared_ptr<Cache> Cache::create(size_t shardCount)
         {
             auto out = std::shared_ptr<Cache>(new Cache);
-            out->_init();
+            out->_init(shardCount);
             return out;
         }
 
+        size_t Cache::getShardCount() const
+        {
+            return _p->shards.size();
+        }
+
         size_t Cache::getMax() const
         {
             return _p->max;
@@ -100,81 +375,161 @@ namespace tl
         size_t Cache::getSize() const
         {
             TLRENDER_P();
-            std::unique_lock<std::mutex> lock(p.mutex);
-            return p.video.getSize() + p.audio.getSize();
+            return p.videoSize + p.audioSize;
         }
 
         float Cache::getPercentage() const
         {
             TLRENDER_P();
-            std::unique_lock<std::mutex> lock(p.mutex);
-            return
-                (p.video.getSize() + p.audio.getSize()) /
-                static_cast<float>(p.video.getMax() + p.audio.getMax()) * 100.F;
+            return (p.videoSize + p.audioSize) /
+                static_cast<float>(p.videoMax + p.audioMax) * 100.F;
         }
 
-        void Cache::addVideo(const std::string& key, const VideoData& videoData)
+        std::shared_ptr<DiskCache> Cache::getDiskCache() const
         {
-            TLRENDER_P();
-            std::unique_lock<std::mutex> lock(p.mutex);
-            p.video.add(
-                key,
-                videoData,
-                videoData.image ? videoData.image->getDataByteCount() : 1);
+            return std::atomic_load(&_p->diskCache);
         }
 
-        bool Cache::containsVideo(const std::string& key) const
+        void Cache::setDiskCache(const std::shared_ptr<DiskCache>& value)
         {
-            TLRENDER_P();
-            std::unique_lock<std::mutex> lock(p.mutex);
-            return p.video.contains(key);
+            std::atomic_store(&_p->diskCache, value);
         }
 
-        bool Cache::getVideo(const std::string& key, VideoData& videoData) const
+        void Cache::addVideo(const CacheKey& key, const VideoData& videoData)
+        {
+            _p->addVideo(key, videoData);
+        }
+
+        bool Cache::containsVideo(const CacheKey& key) const
         {
             TLRENDER_P();
-            std::unique_lock<std::mutex> lock(p.mutex);
-            return p.video.get(key, videoData);
+            auto& shard = p.getShard(key);
+            {
+                auto lock = shard.readLock();
+                if (shard.video.contains(key))
+                    return true;
+            }
+            auto diskCache = std::atomic_load(&p.diskCache);
+            return diskCache && diskCache->containsVideo(key);
         }
 
-        void Cache::addAudio(const std::string& key, const AudioData& audioData)
+        bool Cache::getVideo(const CacheKey& key, VideoData& videoData) const
+        {
+            auto& shard = _p->getShard(key);
+            bool out = _p->get(shard, shard.video, key, videoData);
+            if (out)
+            {
+                ++shard.videoHits;
+            }
+            else if (auto diskCache = std::atomic_load(&_p->diskCache))
+            {
+                out = diskCache->getVideo(key, videoData);
+                if (out)
+                {
+                    ++shard.diskHits;
+                    _p->addVideo(key, videoData);
+                }
+                else
+                {
+                    ++shard.videoMisses;
+                }
+            }
+            else
+            {
+                ++shard.videoMisses;
+            }
+            return out;
+        }
+
+        void Cache::addAudio(const CacheKey& key, const AudioData& audioData)
         {
             TLRENDER_P();
-            std::unique_lock<std::mutex> lock(p.mutex);
-            p.audio.add(
-                key,
-                audioData,
-                audioData.audio ? audioData.audio->getByteCount() : 1);
+            auto& shard = p.getShard(key);
+            p.add(shard, shard.audio, p.audioSize, key, audioData);
+            evict(p.shards, &Shard::audio, p.audioSize, p.audioMax, key);
+        }
+
+        bool Cache::containsAudio(const CacheKey& key) const
+        {
+            auto& shard = _p->getShard(key);
+            auto lock = shard.readLock();
+            return shard.audio.contains(key);
         }
 
-        bool Cache::containsAudio(const std::string& key) const
+        bool Cache::getAudio(const CacheKey& key, AudioData& audioData) const
+        {
+            auto& shard = _p->getShard(key);
+            const bool out = _p->get(shard, shard.audio, key, audioData);
+            if (out)
+            {
+                ++shard.audioHits;
+            }
+            else
+            {
+                ++shard.audioMisses;
+            }
+            return out;
+        }
+
+        void Cache::clear()
         {
             TLRENDER_P();
-            std::unique_lock<std::mutex> lock(p.mutex);
-            return p.audio.contains(key);
+            for (const auto& shard : p.shards)
+            {
+                auto lock = shard->writeLock();
+                p.videoSize -= shard->video.getSize();
+                p.audioSize -= shard->audio.getSize();
+                shard->video.clear();
+                shard->audio.clear();
+            }
+            if (auto diskCache = std::atomic_load(&p.diskCache))
+            {
+                diskCache->clear();
+            }
         }
 
-        bool Cache::getAudio(const std::string& key, AudioData& audioData) const
+        std::vector<CacheShardStats> Cache::getShardStats() const
         {
             TLRENDER_P();
-            std::unique_lock<std::mutex> lock(p.mutex);
-            return p.audio.get(key, audioData);
+            std::vector<CacheShardStats> out;
+            for (const auto& shard : p.shards)
+            {
+                CacheShardStats stats;
+                stats.videoHits = shard->videoHits;
+                stats.videoMisses = shard->videoMisses;
+                stats.audioHits = shard->audioHits;
+                stats.audioMisses = shard->audioMisses;
+                stats.diskHits = shard->diskHits;
+                stats.contention = shard->contention;
+                out.push_back(stats);
+            }
+            return out;
         }
 
-        void Cache::clear()
+        void Cache::resetShardStats()
         {
             TLRENDER_P();
-            std::unique_lock<std::mutex> lock(p.mutex);
-            p.video.clear();
-            p.audio.clear();
+            for (const auto& shard : p.shards)
+            {
+                shard->videoHits = 0;
+                shard->videoMisses = 0;
+                shard->audioHits = 0;
+                shard->audioMisses = 0;
+                shard->diskHits = 0;
+                shard->contention = 0;
+            }
         }
 
         void Cache::_maxUpdate()
         {
             TLRENDER_P();
-            std::unique_lock<std::mutex> lock(p.mutex);
-            p.video.setMax(p.max * .9F);
-            p.audio.setMax(p.max * .1F);
+            p.videoMax = p.max * .9F;
+            p.audioMax = p.max * .1F;
+
+            // Don't write to the disk cache when the size is changed, the
+            // frames are dropped instead.
+            evict<VideoData>(p.shards, &Shard::video, p.videoSize, p.videoMax, CacheKey());
+            evict<AudioData>(p.shards, &Shard::audio, p.audioSize, p.audioMax, CacheKey());
         }
     }
 }
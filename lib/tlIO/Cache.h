@@ -8,31 +8,99 @@
 
 #include <tlCore/Path.h>
 
+#include <functional>
+#include <tuple>
+
 namespace tl
 {
     namespace io
     {
+        //! I/O cache key.
+        //!
+        //! Cache keys are fixed size and built from hashes so that per-frame
+        //! lookups do not allocate.
+        struct CacheKey
+        {
+            CacheKey() = default;
+            CacheKey(
+                uint64_t path,
+                const otime::RationalTime&,
+                uint64_t options);
+            CacheKey(
+                uint64_t path,
+                const otime::TimeRange&,
+                uint64_t options);
+
+            uint64_t path     = 0;
+            uint64_t options  = 0;
+            double   value    = 0.0;
+            double   duration = 0.0;
+            double   rate     = 0.0;
+
+            bool operator == (const CacheKey&) const;
+            bool operator != (const CacheKey&) const;
+            bool operator < (const CacheKey&) const;
+        };
+
+        //! Get a cache hash for a path.
+        uint64_t getCacheHash(const file::Path&);
+
+        //! Get a cache hash for options.
+        uint64_t getCacheHash(const Options&);
+
+        //! Combine cache hashes.
+        constexpr uint64_t combineCacheHash(uint64_t, uint64_t);
+
         //! Get a cache key.
-        std::string getCacheKey(
+        CacheKey getCacheKey(
             const file::Path&,
             const otime::RationalTime&,
             const Options& initOptions,
             const Options& frameOptions);
 
         //! Get a cache key.
-        std::string getCacheKey(
+        CacheKey getCacheKey(
             const file::Path&,
             const otime::TimeRange&,
             const Options& initOptions,
             const Options& frameOptions);
 
+        class DiskCache;
+
+        //! I/O cache shard statistics.
+        struct CacheShardStats
+        {
+            size_t videoHits = 0;
+            size_t videoMisses = 0;
+            size_t audioHits = 0;
+            size_t audioMisses = 0;
+            size_t diskHits = 0;
+            size_t contention = 0;
+
+            bool operator == (const CacheShardStats&) const;
+            bool operator != (const CacheShardStats&) const;
+        };
+
+        //! Default number of I/O cache shards.
+        const size_t cacheShardCount = 16;
+
         //! I/O cache.
+        //!
+        //! The cache is split into independently locked shards selected by
+        //! the key hash. Lookups take a shared lock so they do not serialize
+        //! with each other, and the recency is only updated when the shard
+        //! is not busy. The shards share a single byte budget, and the least
+        //! recently used items across all of the shards are evicted first.
+        //!
+        //! An optional disk cache can be used as a second tier. Video that is
+        //! evicted from memory is written to the disk cache, and video that
+        //! is found in the disk cache is moved back into memory.
         class Cache : public std::enable_shared_from_this<Cache>
         {
             TLRENDER_NON_COPYABLE(Cache);
 
         protected:
-            void _init();
+            void _init(size_t shardCount);
 
             Cache();
 
@@ -40,7 +108,10 @@ namespace tl
             ~Cache();
 
             //! Create a new cache.
-            static std::shared_ptr<Cache> create();
+            static std::shared_ptr<Cache> create(size_t shardCount = cacheShardCount);
+
+            //! Get the number of shards.
+            size_t getShardCount() const;
 
             //! Get the maximum cache size in bytes.
             size_t getMax() const;
@@ -54,27 +125,39 @@ namespace tl
             //! Get the current cache size as a percentage.
             float getPercentage() const;
 
+            //! Get the disk cache.
+            std::shared_ptr<DiskCache> getDiskCache() const;
+
+            //! Set the disk cache. Set to null to disable the disk cache.
+            void setDiskCache(const std::shared_ptr<DiskCache>&);
+
             //! Add video to the cache.
-            void addVideo(const std::string& key, const VideoData&);
+            void addVideo(const CacheKey& key, const VideoData&);
 
             //! Get whether the cache contains video.
-            bool containsVideo(const std::string& key) const;
+            bool containsVideo(const CacheKey& key) const;
 
             //! Get video from the cache.
-            bool getVideo(const std::string& key, VideoData&) const;
+            bool getVideo(const CacheKey& key, VideoData&) const;
 
             //! Add audio to the cache.
-            void addAudio(const std::string& key, const AudioData&);
+            void addAudio(const CacheKey& key, const AudioData&);
 
             //! Get whether the cache contains audio.
-            bool containsAudio(const std::string& key) const;
+            bool containsAudio(const CacheKey& key) const;
 
             //! Get audio from the cache.
-            bool getAudio(const std::string& key, AudioData&) const;
+            bool getAudio(const CacheKey& key, AudioData&) const;
 
             //! Clear the cache.
             void clear();
 
+            //! Get the shard statistics.
+            std::vector<CacheShardStats> getShardStats() const;
+
+            //! Reset the shard statistics.
+            void resetShardStats();
+
         private:
             void _maxUpdate();
 
@@ -82,3 +165,14 @@ namespace tl
         };
     }
 }
+
+namespace std
+{
+    template<>
+    struct hash<tl::io::CacheKey>
+    {
+        std::size_t operator() (const tl::io::CacheKey&) const noexcept;
+    };
+}
+
+#include <tlIO/CacheInline.h>
@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+namespace tl
+{
+    namespace io
+    {
+        inline CacheKey::CacheKey(
+            uint64_t path,
+            const otime::RationalTime& time,
+            uint64_t options) :
+            path(path),
+            options(options),
+            value(time.value()),
+            rate(time.rate())
+        {}
+
+        inline CacheKey::CacheKey(
+            uint64_t path,
+            const otime::TimeRange& timeRange,
+            uint64_t options) :
+            path(path),
+            options(options),
+            value(timeRange.start_time().value()),
+            duration(timeRange.duration().value()),
+            rate(timeRange.duration().rate())
+        {}
+
+        inline bool CacheKey::operator == (const CacheKey& other) const
+        {
+            return
+                path == other.path &&
+                options == other.options &&
+                value == other.value &&
+                duration == other.duration &&
+                rate == other.rate;
+        }
+
+        inline bool CacheKey::operator != (const CacheKey& other) const
+        {
+            return !(*this == other);
+        }
+
+        inline bool CacheKey::operator < (const CacheKey& other) const
+        {
+            return
+                std::tie(path, options, value, duration, rate) <
+                std::tie(other.path, other.options, other.value, other.duration, other.rate);
+        }
+
+        constexpr uint64_t combineCacheHash(uint64_t a, uint64_t b)
+        {
+            return a ^ (b + 0x9e3779b97f4a7c15ULL + (a << 6) + (a >> 2));
+        }
+    }
+}
+
+namespace std
+{
+    inline std::size_t hash<tl::io::CacheKey>::operator() (
+        const tl::io::CacheKey& key) const noexcept
+    {
+        uint64_t out = tl::io::combineCacheHash(key.path, key.options);
+        out = tl::io::combineCacheHash(out, std::hash<double>()(key.value));
+        out = tl::io::combineCacheHash(out, std::hash<double>()(key.duration));
+        out = tl::io::combineCacheHash(out, std::hash<double>()(key.rate));
+        return static_cast<std::size_t>(out);
+    }
+}
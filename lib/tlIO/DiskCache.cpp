@@ -0,0 +1,436 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlIO/DiskCache.h>
+
+#include <tlCore/File.h>
+#include <tlCore/FileIO.h>
+#include <tlCore/LRUCache.h>
+#include <tlCore/StringFormat.h>
+
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <thread>
+
+namespace tl
+{
+    namespace io
+    {
+        namespace
+        {
+            const uint32_t fileMagic = 0x43446c74; // "tlDC"
+            const uint32_t fileVersion = 2;
+
+            // The image data is aligned in the file so the memory-map can be
+            // used as the image data.
+            const size_t dataAlignment = 64;
+
+            // Maximum amount of video waiting to be written.
+            const size_t writeQueueMax = 256 * memory::megabyte;
+
+            struct DiskCacheItem
+            {
+                ~DiskCacheItem()
+                {
+                    file::rm(fileName);
+                }
+
+                std::string fileName;
+            };
+
+            void writeString(const std::shared_ptr<file::FileIO>& io, const std::string& value)
+            {
+                io->writeU32(static_cast<uint32_t>(value.size()));
+                io->write(value);
+            }
+
+            std::string readString(const std::shared_ptr<file::FileIO>& io)
+            {
+                uint32_t size = 0;
+                io->readU32(&size);
+                std::string out(size, 0);
+                if (size > 0)
+                {
+                    io->read(&out[0], size);
+                }
+                return out;
+            }
+
+            void writeVideo(const std::string& fileName, const VideoData& videoData)
+            {
+                auto io = file::FileIO::create(fileName, file::Mode::Write);
+                io->writeU32(fileMagic);
+                io->writeU32(fileVersion);
+
+                const double time[2] = { videoData.time.value(), videoData.time.rate() };
+                io->write(time, 2 * sizeof(double));
+                io->writeU16(&videoData.layer, 1);
+
+                const auto& image = videoData.image;
+                const image::Info& info = image->getInfo();
+                writeString(io, info.name);
+                io->writeU32(info.size.w);
+                io->writeU32(info.size.h);
+                io->writeF32(info.size.pixelAspectRatio);
+                io->writeU32(static_cast<uint32_t>(info.pixelType));
+                io->writeU32(static_cast<uint32_t>(info.videoLevels));
+                io->writeU32(static_cast<uint32_t>(info.yuvCoefficients));
+                io->writeU8(info.layout.mirror.x);
+                io->writeU8(info.layout.mirror.y);
+                io->writeU32(info.layout.alignment);
+                io->writeU32(static_cast<uint32_t>(info.layout.endian));
+
+                const auto& tags = image->getTags();
+                io->writeU32(static_cast<uint32_t>(tags.size()));
+                for (const auto& tag : tags)
+                {
+                    writeString(io, tag.first);
+                    writeString(io, tag.second);
+                }
+
+                const uint64_t byteCount = image->getDataByteCount();
+                io->write(&byteCount, sizeof(uint64_t));
+                const size_t pos = io->getPos();
+                const size_t padding = (dataAlignment - pos % dataAlignment) % dataAlignment;
+                const uint8_t zero[dataAlignment] = {};
+                io->write(zero, padding);
+                io->write(image->getData(), byteCount);
+            }
+
+            VideoData readVideo(const std::string& fileName)
+            {
+                VideoData out;
+                auto io = file::FileIO::create(
+                    fileName,
+                    file::Mode::Read,
+                    file::ReadType::MemoryMapped);
+                uint32_t magic = 0;
+                io->readU32(&magic);
+                uint32_t version = 0;
+                io->readU32(&version);
+                if (magic != fileMagic || version != fileVersion)
+                {
+                    throw std::runtime_error(string::Format("{0}: Invalid disk cache file").
+                        arg(fileName));
+                }
+
+                double time[2] = { 0.0, 0.0 };
+                io->read(time, 2 * sizeof(double));
+                out.time = otime::RationalTime(time[0], time[1]);
+                io->readU16(&out.layer);
+
+                image::Info info;
+                info.name = readString(io);
+                uint32_t u32 = 0;
+                io->readU32(&u32);
+                info.size.w = u32;
+                io->readU32(&u32);
+                info.size.h = u32;
+                io->readF32(&info.size.pixelAspectRatio);
+                io->readU32(&u32);
+                info.pixelType = static_cast<image::PixelType>(u32);
+                io->readU32(&u32);
+                info.videoLevels = static_cast<image::VideoLevels>(u32);
+                io->readU32(&u32);
+                info.yuvCoefficients = static_cast<image::YUVCoefficients>(u32);
+                uint8_t u8 = 0;
+                io->readU8(&u8);
+                info.layout.mirror.x = u8;
+                io->readU8(&u8);
+                info.layout.mirror.y = u8;
+                io->readU32(&u32);
+                info.layout.alignment = u32;
+                io->readU32(&u32);
+                info.layout.endian = static_cast<memory::Endian>(u32);
+
+                image::Tags tags;
+                uint32_t tagCount = 0;
+                io->readU32(&tagCount);
+                for (uint32_t i = 0; i < tagCount; ++i)
+                {
+                    const std::string key = readString(io);
+                    tags[key] = readString(io);
+                }
+
+                uint64_t byteCount = 0;
+                io->read(&byteCount, sizeof(uint64_t));
+                io->seek((dataAlignment - io->getPos() % dataAlignment) % dataAlignment);
+                if (byteCount != image::getDataByteCount(info) ||
+                    io->getPos() + byteCount > io->getSize())
+                {
+                    throw std::runtime_error(string::Format("{0}: Invalid disk cache file").
+                        arg(fileName));
+                }
+                if (const uint8_t* p = io->getMemoryP())
+                {
+                    // Use the memory-map as the image data. The map is
+                    // read-only, and cached images are not modified.
+                    out.image = image::Image::create(
+                        info,
+                        const_cast<uint8_t*>(p),
+                        io);
+                }
+                else
+                {
+                    out.image = image::Image::create(info);
+                    io->read(out.image->getData(), byteCount);
+                }
+                out.image->setTags(tags);
+                return out;
+            }
+        }
+
+        struct DiskCache::Private
+        {
+            std::string path;
+            uint64_t fileCounter = 0;
+            memory::LRUCache<CacheKey, std::shared_ptr<DiskCacheItem> > items;
+
+            // Video is written to the disk by a separate thread, so the
+            // callers do not wait for the file to be written. Video that is
+            // waiting to be written can still be read.
+            std::list<std::pair<CacheKey, VideoData> > writeQueue;
+            size_t writeQueueSize = 0;
+            bool running = true;
+            std::condition_variable cv;
+            std::thread thread;
+
+            mutable std::mutex mutex;
+
+            void writeThread();
+        };
+
+        void DiskCache::Private::writeThread()
+        {
+            while (true)
+            {
+                std::pair<CacheKey, VideoData> write;
+                std::shared_ptr<DiskCacheItem> item;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    cv.wait(
+                        lock,
+                        [this]
+                        {
+                            return !running || !writeQueue.empty();
+                        });
+                    if (!running)
+                        break;
+                    write = writeQueue.front();
+                    item = std::make_shared<DiskCacheItem>();
+                    item->fileName = string::Format("{0}/{1}.img").
+                        arg(path).
+                        arg(fileCounter++);
+                }
+
+                // Write the file without holding the lock.
+                bool valid = true;
+                try
+                {
+                    writeVideo(item->fileName, write.second);
+                }
+                catch (const std::exception&)
+                {
+                    valid = false;
+                }
+
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    if (!writeQueue.empty() && writeQueue.front().first == write.first)
+                    {
+                        writeQueue.pop_front();
+                        writeQueueSize -= write.second.image->getDataByteCount();
+                        if (valid)
+                        {
+                            items.add(write.first, item, write.second.image->getDataByteCount());
+                        }
+                    }
+                }
+                cv.notify_all();
+            }
+        }
+
+        void DiskCache::_init(
+            const std::string& path,
+            size_t max)
+        {
+            TLRENDER_P();
+            p.path = file::createTempDir(path);
+            if (p.path.empty())
+            {
+                throw std::runtime_error(string::Format("{0}: Cannot create disk cache directory").
+                    arg(path));
+            }
+            p.items.setMax(max);
+            p.thread = std::thread(
+                [this]
+                {
+                    _p->writeThread();
+                });
+        }
+
+        DiskCache::DiskCache() :
+            _p(new Private)
+        {}
+
+        DiskCache::~DiskCache()
+        {
+            TLRENDER_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.running = false;
+            }
+            p.cv.notify_all();
+            if (p.thread.joinable())
+            {
+                p.thread.join();
+            }
+            p.items.clear();
+            file::rmdir(p.path);
+        }
+
+        std::shared_ptr<DiskCache> DiskCache::create(
+            const std::string& path,
+            size_t max)
+        {
+            auto out = std::shared_ptr<DiskCache>(new DiskCache);
+            out->_init(path, max);
+            return out;
+        }
+
+        const std::string& DiskCache::getPath() const
+        {
+            return _p->path;
+        }
+
+        size_t DiskCache::getMax() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.items.getMax();
+        }
+
+        void DiskCache::setMax(size_t value)
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.items.setMax(value);
+        }
+
+        size_t DiskCache::getSize() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.items.getSize();
+        }
+
+        float DiskCache::getPercentage() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.items.getPercentage();
+        }
+
+        void DiskCache::addVideo(const CacheKey& key, const VideoData& videoData)
+        {
+            TLRENDER_P();
+            if (!videoData.image)
+                return;
+            const size_t byteCount = videoData.image->getDataByteCount();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                if (p.items.contains(key))
+                {
+                    p.items.touch(key);
+                    return;
+                }
+                for (const auto& i : p.writeQueue)
+                {
+                    if (key == i.first)
+                        return;
+                }
+
+                // The video is dropped when it is too large, or when the
+                // writes are not keeping up.
+                if (byteCount > p.items.getMax() ||
+                    (!p.writeQueue.empty() && p.writeQueueSize + byteCount > writeQueueMax))
+                    return;
+                p.writeQueue.push_back(std::make_pair(key, videoData));
+                p.writeQueueSize += byteCount;
+            }
+            p.cv.notify_all();
+        }
+
+        bool DiskCache::containsVideo(const CacheKey& key) const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            if (p.items.contains(key))
+                return true;
+            for (const auto& i : p.writeQueue)
+            {
+                if (key == i.first)
+                    return true;
+            }
+            return false;
+        }
+
+        bool DiskCache::getVideo(const CacheKey& key, VideoData& videoData) const
+        {
+            TLRENDER_P();
+            std::shared_ptr<DiskCacheItem> item;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                if (!p.items.get(key, item))
+                {
+                    for (const auto& i : p.writeQueue)
+                    {
+                        if (key == i.first)
+                        {
+                            videoData = i.second;
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+            }
+
+            // The item keeps the file from being removed while it is read.
+            try
+            {
+                videoData = readVideo(item->fileName);
+            }
+            catch (const std::exception&)
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.items.remove(key);
+                return false;
+            }
+            return true;
+        }
+
+        void DiskCache::flush()
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.cv.wait(
+                lock,
+                [this]
+                {
+                    return _p->writeQueue.empty();
+                });
+        }
+
+        void DiskCache::clear()
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.writeQueue.clear();
+            p.writeQueueSize = 0;
+            p.items.clear();
+            p.cv.notify_all();
+        }
+    }
+}
@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlIO/Cache.h>
+
+namespace tl
+{
+    namespace io
+    {
+        //! Disk cache.
+        //!
+        //! The disk cache is a second tier below the memory cache. Video
+        //! frames are stored one per file as raw image data with a small
+        //! header, and read back with memory-mapping so that a cached frame
+        //! does not need to be decoded or copied again. The files are
+        //! written by a separate thread with a bounded queue, and video is
+        //! dropped instead of blocking the caller when the queue is full.
+        class DiskCache : public std::enable_shared_from_this<DiskCache>
+        {
+            TLRENDER_NON_COPYABLE(DiskCache);
+
+        protected:
+            void _init(
+                const std::string& path,
+                size_t max);
+
+            DiskCache();
+
+        public:
+            ~DiskCache();
+
+            //! Create a new disk cache. The cache files are stored in a new
+            //! temporary directory inside the given path, and are removed
+            //! when the cache is destroyed.
+            static std::shared_ptr<DiskCache> create(
+                const std::string& path,
+                size_t max);
+
+            //! Get the cache directory.
+            const std::string& getPath() const;
+
+            //! Get the maximum cache size in bytes.
+            size_t getMax() const;
+
+            //! Set the maximum cache size in bytes.
+            void setMax(size_t);
+
+            //! Get the current cache size in bytes.
+            size_t getSize() const;
+
+            //! Get the current cache size as a percentage.
+            float getPercentage() const;
+
+            //! Add video to the cache.
+            void addVideo(const CacheKey& key, const VideoData&);
+
+            //! Get whether the cache contains video.
+            bool containsVideo(const CacheKey& key) const;
+
+            //! Get video from the cache.
+            bool getVideo(const CacheKey& key, VideoData&) const;
+
+            //! Wait for the queued video to be written.
+            void flush();
+
+            //! Clear the cache.
+            void clear();
+
+        private:
+            TLRENDER_PRIVATE();
+        };
+    }
+}
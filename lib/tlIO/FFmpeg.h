@@ -71,6 +71,13 @@ namespace tl
         std::string getErrorLabel(int);
 
         //! FFmpeg reader
+        //!
+        //! Setting "FFmpeg/VideoDecoderCount" to more than one opens a pool
+        //! of video decoders that each run on their own thread. Requests are
+        //! routed to a decoder that can reach them without seeking, and
+        //! otherwise the requests from one GOP are given to an idle decoder,
+        //! so that different GOPs are decoded in parallel. This makes random
+        //! access and reverse playback of long-GOP media faster.
         class Read : public io::IRead
         {
         protected:
@@ -104,14 +111,19 @@ namespace tl
             std::future<io::Info> getInfo() override;
             std::future<io::VideoData> readVideo(
                 const otime::RationalTime&,
-                const io::Options& = io::Options()) override;
+                const io::Options& = io::Options(),
+                const std::shared_ptr<io::ReadRequest>& = nullptr) override;
             std::future<io::AudioData> readAudio(
                 const otime::TimeRange&,
-                const io::Options& = io::Options()) override;
+                const io::Options& = io::Options(),
+                const std::shared_ptr<io::ReadRequest>& = nullptr) override;
             void cancelRequests() override;
+            size_t getOpenFileCount() const override;
+            size_t getByteCount() const override;
 
         private:
             void _videoThread();
+            void _videoDecode(size_t decoder);
             void _audioThread();
             void _cancelVideoRequests();
             void _cancelAudioRequests();
@@ -14,6 +14,8 @@ extern "C"
 
 } // extern "C"
 
+#include <algorithm>
+
 namespace tl
 {
     namespace ffmpeg
@@ -122,6 +124,19 @@ namespace tl
                 std::stringstream ss(i->second);
                 ss >> p.options.audioBufferSize;
             }
+            i = options.find("FFmpeg/VideoDecoderCount");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.options.videoDecoderCount;
+            }
+            i = options.find("ReducedHeight");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.options.reducedHeight;
+            }
+            p.fileName = path.get(-1, path.isFileProtocol() ? file::PathType::Path : file::PathType::Full);
 
             p.videoThread.running = true;
             p.audioThread.running = true;
@@ -131,20 +146,22 @@ namespace tl
                     TLRENDER_P();
                     try
                     {
-                        p.readVideo = std::make_shared<ReadVideo>(
-                            path.get(-1, path.isFileProtocol() ? file::PathType::Path : file::PathType::Full),
+                        auto videoDecoder = std::make_shared<Private::VideoDecoder>();
+                        videoDecoder->readVideo = std::make_shared<ReadVideo>(
+                            p.fileName,
                             _memory,
                             p.options);
-                        const auto& videoInfo = p.readVideo->getInfo();
+                        p.videoDecoders.push_back(videoDecoder);
+                        const auto& videoInfo = videoDecoder->readVideo->getInfo();
                         if (videoInfo.isValid())
                         {
                             p.info.video.push_back(videoInfo);
-                            p.info.videoTime = p.readVideo->getTimeRange();
-                            p.info.tags = p.readVideo->getTags();
+                            p.info.videoTime = videoDecoder->readVideo->getTimeRange();
+                            p.info.tags = videoDecoder->readVideo->getTags();
                         }
 
                         p.readAudio = std::make_shared<ReadAudio>(
-                            path.get(-1, path.isFileProtocol() ? file::PathType::Path : file::PathType::Full),
+                            p.fileName,
                             _memory,
                             p.info.videoTime.duration().rate(),
                             p.options);
@@ -277,12 +294,14 @@ namespace tl
 
         std::future<io::VideoData> Read::readVideo(
             const otime::RationalTime& time,
-            const io::Options& options)
+            const io::Options& options,
+            const std::shared_ptr<io::ReadRequest>& readRequest)
         {
             TLRENDER_P();
             auto request = std::make_shared<Private::VideoRequest>();
             request->time = time;
             request->options = io::merge(options, _options);
+            request->readRequest = readRequest;
             auto future = request->promise.get_future();
             bool valid = false;
             {
@@ -295,23 +314,26 @@ namespace tl
             }
             if (valid)
             {
-                p.videoThread.cv.notify_one();
+                p.videoThread.cv.notify_all();
             }
             else
             {
                 request->promise.set_value(io::VideoData());
+                io::finished(request->readRequest);
             }
             return future;
         }
 
         std::future<io::AudioData> Read::readAudio(
             const otime::TimeRange& timeRange,
-            const io::Options& options)
+            const io::Options& options,
+            const std::shared_ptr<io::ReadRequest>& readRequest)
         {
             TLRENDER_P();
             auto request = std::make_shared<Private::AudioRequest>();
             request->timeRange = timeRange;
             request->options = io::merge(options, _options);
+            request->readRequest = readRequest;
             auto future = request->promise.get_future();
             bool valid = false;
             {
@@ -329,6 +351,7 @@ namespace tl
             else
             {
                 request->promise.set_value(io::AudioData());
+                io::finished(request->readRequest);
             }
             return future;
         }
@@ -339,36 +362,221 @@ namespace tl
             _cancelAudioRequests();
         }
 
+        size_t Read::getOpenFileCount() const
+        {
+            return _p->openFileCount;
+        }
+
+        size_t Read::getByteCount() const
+        {
+            return _p->byteCount;
+        }
+
+        otime::RationalTime Read::Private::getKeyFrame(const otime::RationalTime& value) const
+        {
+            otime::RationalTime out = value;
+            const auto i = std::upper_bound(keyFrames.begin(), keyFrames.end(), value);
+            if (i != keyFrames.begin())
+            {
+                out = *(i - 1);
+            }
+            return out;
+        }
+
+        bool Read::Private::isContinuation(
+            const otime::RationalTime& decoderTime,
+            const otime::RationalTime& value) const
+        {
+            // The decoder can reach the time without seeking if there are
+            // no key frames in between.
+            return
+                time::isValid(decoderTime) &&
+                value >= decoderTime &&
+                (value.strictly_equal(decoderTime) || getKeyFrame(value) <= decoderTime);
+        }
+
+        bool Read::Private::getVideoRequests(
+            size_t decoder,
+            std::vector<std::shared_ptr<VideoRequest> >& out,
+            bool& seek)
+        {
+            // Take the requests that the decoder can reach without seeking.
+            const otime::RationalTime decoderTime = videoMutex.decoderTimes[decoder];
+            for (auto i = videoMutex.videoRequests.begin(); i != videoMutex.videoRequests.end();)
+            {
+                if (isContinuation(decoderTime, (*i)->time))
+                {
+                    out.push_back(*i);
+                    i = videoMutex.videoRequests.erase(i);
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+            seek = false;
+
+            // Otherwise take the oldest request that is not reachable by
+            // another decoder, and the other requests in the same GOP.
+            if (out.empty())
+            {
+                otime::RationalTime keyFrame = time::invalidTime;
+                for (auto i = videoMutex.videoRequests.begin(); i != videoMutex.videoRequests.end();)
+                {
+                    bool take = false;
+                    if (!time::isValid(keyFrame))
+                    {
+                        take = true;
+                        for (size_t j = 0; j < videoMutex.decoderTimes.size(); ++j)
+                        {
+                            if (j != decoder &&
+                                isContinuation(videoMutex.decoderTimes[j], (*i)->time))
+                            {
+                                take = false;
+                                break;
+                            }
+                        }
+                        if (take)
+                        {
+                            keyFrame = getKeyFrame((*i)->time);
+                        }
+                    }
+                    else
+                    {
+                        take = getKeyFrame((*i)->time).strictly_equal(keyFrame);
+                    }
+                    if (take)
+                    {
+                        out.push_back(*i);
+                        i = videoMutex.videoRequests.erase(i);
+                    }
+                    else
+                    {
+                        ++i;
+                    }
+                }
+                seek = true;
+            }
+
+            if (!out.empty())
+            {
+                std::stable_sort(
+                    out.begin(),
+                    out.end(),
+                    [](const std::shared_ptr<VideoRequest>& a, const std::shared_ptr<VideoRequest>& b)
+                    {
+                        return a->time < b->time;
+                    });
+
+                // Reserve the rest of the GOP for this decoder.
+                videoMutex.decoderTimes[decoder] =
+                    out.back()->time +
+                    otime::RationalTime(1.0, info.videoTime.duration().rate());
+            }
+            return !out.empty();
+        }
+
         void Read::_videoThread()
         {
             TLRENDER_P();
-            p.videoThread.currentTime = p.info.videoTime.start_time();
-            p.readVideo->start();
+
+            // Start the additional decoders.
+            const size_t decoderCount = std::max(p.options.videoDecoderCount, static_cast<size_t>(1));
+            {
+                std::unique_lock<std::mutex> lock(p.videoMutex.mutex);
+                p.videoMutex.decoderTimes.resize(decoderCount, time::invalidTime);
+            }
+
+            // Each video decoder opens the file and buffers frames, and the
+            // audio reader opens the file once.
+            p.openFileCount = decoderCount + 1;
+            if (!p.info.video.empty())
+            {
+                p.byteCount =
+                    decoderCount *
+                    p.options.videoBufferSize *
+                    image::getDataByteCount(p.info.video[0]);
+            }
+            p.keyFrames = p.videoDecoders[0]->readVideo->getKeyFrames();
             p.videoThread.logTimer = std::chrono::steady_clock::now();
+            for (size_t i = 1; i < decoderCount; ++i)
+            {
+                p.videoDecoders.push_back(std::make_shared<Private::VideoDecoder>());
+            }
+            for (size_t i = 1; i < decoderCount; ++i)
+            {
+                p.videoDecoders[i]->thread = std::thread(
+                    [this, i]
+                    {
+                        TLRENDER_P();
+                        try
+                        {
+                            p.videoDecoders[i]->readVideo = std::make_shared<ReadVideo>(
+                                p.fileName,
+                                _memory,
+                                p.options);
+                            _videoDecode(i);
+                        }
+                        catch (const std::exception& e)
+                        {
+                            {
+                                std::unique_lock<std::mutex> lock(p.videoMutex.mutex);
+                                p.videoMutex.decoderTimes[i] = time::invalidTime;
+                            }
+                            if (auto logSystem = _logSystem.lock())
+                            {
+                                const std::string id = string::Format("tl::io::ffmpeg::Read ({0}: {1})").
+                                    arg(__FILE__).
+                                    arg(__LINE__);
+                                logSystem->print(id, string::Format("{0}: {1}").
+                                    arg(_path.get()).
+                                    arg(e.what()),
+                                    log::Type::Error);
+                            }
+                        }
+                    });
+            }
+
+            _videoDecode(0);
+
+            for (size_t i = 1; i < p.videoDecoders.size(); ++i)
+            {
+                if (p.videoDecoders[i]->thread.joinable())
+                {
+                    p.videoDecoders[i]->thread.join();
+                }
+            }
+        }
+
+        void Read::_videoDecode(size_t decoder)
+        {
+            TLRENDER_P();
+            auto& videoDecoder = p.videoDecoders[decoder];
+            const otime::RationalTime frameTime(1.0, p.info.videoTime.duration().rate());
+            videoDecoder->currentTime = p.info.videoTime.start_time();
+            videoDecoder->readVideo->start();
+            {
+                std::unique_lock<std::mutex> lock(p.videoMutex.mutex);
+                p.videoMutex.decoderTimes[decoder] = videoDecoder->currentTime;
+            }
             while (p.videoThread.running)
             {
                 // Check requests.
                 std::list<std::shared_ptr<Private::InfoRequest> > infoRequests;
-                std::shared_ptr<Private::VideoRequest> videoRequest;
+                std::vector<std::shared_ptr<Private::VideoRequest> > videoRequests;
+                bool seek = false;
                 {
                     std::unique_lock<std::mutex> lock(p.videoMutex.mutex);
-                    if (p.videoThread.cv.wait_for(
+                    p.videoThread.cv.wait_for(
                         lock,
                         std::chrono::milliseconds(p.options.requestTimeout),
-                        [this]
+                        [this, decoder, &videoRequests, &seek]
                         {
                             return
                                 !_p->videoMutex.infoRequests.empty() ||
-                                !_p->videoMutex.videoRequests.empty();
-                        }))
-                    {
-                        infoRequests = std::move(p.videoMutex.infoRequests);
-                        if (!p.videoMutex.videoRequests.empty())
-                        {
-                            videoRequest = p.videoMutex.videoRequests.front();
-                            p.videoMutex.videoRequests.pop_front();
-                        }
-                    }
+                                _p->getVideoRequests(decoder, videoRequests, seek);
+                        });
+                    infoRequests = std::move(p.videoMutex.infoRequests);
                 }
 
                 // Information requests.
@@ -377,63 +585,85 @@ namespace tl
                     request->promise.set_value(p.info);
                 }
 
-                // Check the cache.
-                io::VideoData videoData;
-                if (videoRequest && _cache)
+                for (const auto& videoRequest : videoRequests)
                 {
-                    const std::string cacheKey = io::getCacheKey(
-                        _path,
-                        videoRequest->time,
-                        _options,
-                        videoRequest->options);
-                    if (_cache->getVideo(cacheKey, videoData))
+                    // Skip the requests that have been canceled.
+                    if (io::isCanceled(videoRequest->readRequest))
                     {
+                        io::VideoData videoData;
+                        videoData.time = videoRequest->time;
+                        videoData.canceled = true;
                         videoRequest->promise.set_value(videoData);
-                        videoRequest.reset();
+                        io::finished(videoRequest->readRequest);
+                        continue;
                     }
-                }
 
-                // Seek.
-                if (videoRequest &&
-                    !videoRequest->time.strictly_equal(p.videoThread.currentTime))
-                {
-                    p.videoThread.currentTime = videoRequest->time;
-                    p.readVideo->seek(p.videoThread.currentTime);
-                }
+                    // Check the cache.
+                    io::VideoData videoData;
+                    if (_cache)
+                    {
+                        const io::CacheKey cacheKey = _getCacheKey(
+                            videoRequest->time,
+                            videoRequest->options);
+                        if (_cache->getVideo(cacheKey, videoData))
+                        {
+                            videoRequest->promise.set_value(videoData);
+                            io::finished(videoRequest->readRequest);
+                            continue;
+                        }
+                    }
 
-                // Process.
-                while (
-                    videoRequest &&
-                    p.readVideo->isBufferEmpty() &&
-                    p.readVideo->isValid() &&
-                    _p->readVideo->process(p.videoThread.currentTime))
-                    ;
+                    // Seek, or skip ahead to the requested time.
+                    if (!videoRequest->time.strictly_equal(videoDecoder->currentTime))
+                    {
+                        if (seek || videoRequest->time < videoDecoder->currentTime)
+                        {
+                            videoDecoder->readVideo->seek(videoRequest->time);
+                            seek = false;
+                        }
+                        else
+                        {
+                            videoDecoder->readVideo->skipBuffer(videoRequest->time);
+                        }
+                        videoDecoder->currentTime = videoRequest->time;
+                    }
+                    seek = false;
 
-                // Handle request.
-                if (videoRequest)
-                {
+                    // Process.
+                    while (
+                        videoDecoder->readVideo->isBufferEmpty() &&
+                        videoDecoder->readVideo->isValid() &&
+                        videoDecoder->readVideo->process(videoDecoder->currentTime))
+                        ;
+
+                    // Handle request.
                     io::VideoData data;
                     data.time = videoRequest->time;
-                    if (!p.readVideo->isBufferEmpty())
+                    if (!videoDecoder->readVideo->isBufferEmpty())
                     {
-                        data.image = p.readVideo->popBuffer();
+                        data.image = videoDecoder->readVideo->popBuffer();
                     }
                     videoRequest->promise.set_value(data);
-                    
+                    io::finished(videoRequest->readRequest);
+
                     if (_cache)
                     {
-                        const std::string cacheKey = io::getCacheKey(
-                            _path,
+                        const io::CacheKey cacheKey = _getCacheKey(
                             videoRequest->time,
-                            _options,
                             videoRequest->options);
                         _cache->addVideo(cacheKey, data);
                     }
 
-                    p.videoThread.currentTime += otime::RationalTime(1.0, p.info.videoTime.duration().rate());
+                    videoDecoder->currentTime += frameTime;
+                }
+                if (!videoRequests.empty())
+                {
+                    std::unique_lock<std::mutex> lock(p.videoMutex.mutex);
+                    p.videoMutex.decoderTimes[decoder] = videoDecoder->currentTime;
                 }
 
                 // Logging.
+                if (0 == decoder)
                 {
                     const auto now = std::chrono::steady_clock::now();
                     const std::chrono::duration<float> diff = now - p.videoThread.logTimer;
@@ -451,9 +681,11 @@ namespace tl
                             logSystem->print(id, string::Format(
                                 "\n"
                                 "    Path: {0}\n"
-                                "    Video requests: {1}").
+                                "    Video requests: {1}\n"
+                                "    Video decoders: {2}").
                                 arg(_path.get()).
-                                arg(requestsSize));
+                                arg(requestsSize).
+                                arg(p.videoDecoders.size()));
                         }
                     }
                 }
@@ -470,6 +702,7 @@ namespace tl
             {
                 // Check requests.
                 std::shared_ptr<Private::AudioRequest> request;
+                std::vector<std::shared_ptr<Private::AudioRequest> > canceledRequests;
                 size_t requestSampleCount = 0;
                 bool seek = false;
                 {
@@ -482,6 +715,13 @@ namespace tl
                             return !_p->audioMutex.requests.empty();
                         }))
                     {
+                        // Skip the requests that have been canceled.
+                        while (!p.audioMutex.requests.empty() &&
+                            io::isCanceled(p.audioMutex.requests.front()->readRequest))
+                        {
+                            canceledRequests.push_back(p.audioMutex.requests.front());
+                            p.audioMutex.requests.pop_front();
+                        }
                         if (!p.audioMutex.requests.empty())
                         {
                             request = p.audioMutex.requests.front();
@@ -496,18 +736,25 @@ namespace tl
                     }
                 }
 
+                for (auto& canceledRequest : canceledRequests)
+                {
+                    io::AudioData audioData;
+                    audioData.time = canceledRequest->timeRange.start_time();
+                    canceledRequest->promise.set_value(audioData);
+                    io::finished(canceledRequest->readRequest);
+                }
+
                 // Check the cache.
                 io::AudioData audioData;
                 if (request && _cache)
                 {
-                    const std::string cacheKey = io::getCacheKey(
-                        _path,
+                    const io::CacheKey cacheKey = _getCacheKey(
                         request->timeRange,
-                        _options,
                         request->options);
                     if (_cache->getAudio(cacheKey, audioData))
                     {
                         request->promise.set_value(audioData);
+                        io::finished(request->readRequest);
                         request.reset();
                     }
                 }
@@ -555,13 +802,12 @@ namespace tl
                             audioData.audio->getSampleCount() - offset);
                     }
                     request->promise.set_value(audioData);
+                    io::finished(request->readRequest);
 
                     if (_cache)
                     {
-                        const std::string cacheKey = io::getCacheKey(
-                            _path,
+                        const io::CacheKey cacheKey = _getCacheKey(
                             request->timeRange,
-                            _options,
                             request->options);
                         _cache->addAudio(cacheKey, audioData);
                     }
@@ -612,7 +858,11 @@ namespace tl
             }
             for (auto& request : videoRequests)
             {
-                request->promise.set_value(io::VideoData());
+                io::VideoData videoData;
+                videoData.time = request->time;
+                videoData.canceled = true;
+                request->promise.set_value(videoData);
+                io::finished(request->readRequest);
             }
         }
 
@@ -627,6 +877,7 @@ namespace tl
             for (auto& request : requests)
             {
                 request->promise.set_value(io::AudioData());
+                io::finished(request->readRequest);
             }
         }
     }
@@ -44,6 +44,8 @@ namespace tl
             size_t threadCount = ffmpeg::threadCount;
             size_t requestTimeout = 5;
             size_t videoBufferSize = 4;
+            size_t videoDecoderCount = 1;
+            int reducedHeight = 0;
             otime::RationalTime audioBufferSize = otime::RationalTime(2.0, 1.0);
         };
 
@@ -61,16 +63,20 @@ namespace tl
             const image::Info& getInfo() const;
             const otime::TimeRange& getTimeRange() const;
             const image::Tags& getTags() const;
+            const std::vector<otime::RationalTime>& getKeyFrames() const;
 
             void start();
             void seek(const otime::RationalTime&);
             bool process(const otime::RationalTime& currentTime);
 
             bool isBufferEmpty() const;
+            void skipBuffer(const otime::RationalTime&);
             std::shared_ptr<image::Image> popBuffer();
 
         private:
+            static int _getBuffer(AVCodecContext*, AVFrame*, int flags);
             int _decode(const otime::RationalTime& currentTime);
+            std::shared_ptr<image::Image> _wrap();
             void _copy(const std::shared_ptr<image::Image>&);
 
             std::string _fileName;
@@ -78,6 +84,7 @@ namespace tl
             image::Info _info;
             otime::TimeRange _timeRange = time::invalidTimeRange;
             image::Tags _tags;
+            std::vector<otime::RationalTime> _keyFrames;
 
             AVFormatContext* _avFormatContext = nullptr;
             AVIOBufferData _avIOBufferData;
@@ -91,8 +98,10 @@ namespace tl
             AVFrame* _avFrame2 = nullptr;
             AVPixelFormat _avInputPixelFormat = AV_PIX_FMT_NONE;
             AVPixelFormat _avOutputPixelFormat = AV_PIX_FMT_NONE;
+            bool _avZeroCopy = false;
+            AVBufferPool* _avBufferPool = nullptr;
             SwsContext* _swsContext = nullptr;
-            std::list<std::shared_ptr<image::Image> > _buffer;
+            std::list<io::VideoData> _buffer;
             bool _eof = false;
         };
 
@@ -146,11 +155,21 @@ namespace tl
         struct Read::Private
         {
             Options options;
+            std::string fileName;
 
-            std::shared_ptr<ReadVideo> readVideo;
+            struct VideoDecoder
+            {
+                std::shared_ptr<ReadVideo> readVideo;
+                otime::RationalTime currentTime = time::invalidTime;
+                std::thread thread;
+            };
+            std::vector<std::shared_ptr<VideoDecoder> > videoDecoders;
+            std::vector<otime::RationalTime> keyFrames;
             std::shared_ptr<ReadAudio> readAudio;
 
             io::Info info;
+            std::atomic<size_t> openFileCount{ 0 };
+            std::atomic<size_t> byteCount{ 0 };
             struct InfoRequest
             {
                 std::promise<io::Info> promise;
@@ -160,6 +179,7 @@ namespace tl
             {
                 otime::RationalTime time = time::invalidTime;
                 io::Options options;
+                std::shared_ptr<io::ReadRequest> readRequest;
                 std::promise<io::VideoData> promise;
             };
             struct VideoMutex
@@ -167,13 +187,23 @@ namespace tl
                 std::list<std::shared_ptr<InfoRequest> > infoRequests;
                 std::list<std::shared_ptr<VideoRequest> > videoRequests;
                 //std::shared_ptr<VideoRequest> videoRequest;
+                std::vector<otime::RationalTime> decoderTimes;
                 bool stopped = false;
                 std::mutex mutex;
             };
             VideoMutex videoMutex;
+
+            otime::RationalTime getKeyFrame(const otime::RationalTime&) const;
+            bool isContinuation(
+                const otime::RationalTime& decoderTime,
+                const otime::RationalTime&) const;
+            bool getVideoRequests(
+                size_t decoder,
+                std::vector<std::shared_ptr<VideoRequest> >&,
+                bool& seek);
+
             struct VideoThread
             {
-                otime::RationalTime currentTime = time::invalidTime;
                 std::chrono::steady_clock::time_point logTimer;
                 std::condition_variable cv;
                 std::thread thread;
@@ -185,6 +215,7 @@ namespace tl
             {
                 otime::TimeRange timeRange = time::invalidTimeRange;
                 io::Options options;
+                std::shared_ptr<io::ReadRequest> readRequest;
                 std::promise<io::AudioData> promise;
             };
             struct AudioMutex
@@ -13,10 +13,26 @@ extern "C"
 
 } // extern "C"
 
+#include <algorithm>
+
 namespace tl
 {
     namespace ffmpeg
     {
+        namespace
+        {
+            bool canWrap(AVPixelFormat in, AVPixelFormat out)
+            {
+                return in == out &&
+                    (AV_PIX_FMT_YUV420P     == in ||
+                     AV_PIX_FMT_YUV422P     == in ||
+                     AV_PIX_FMT_YUV444P     == in ||
+                     AV_PIX_FMT_YUV420P16LE == in ||
+                     AV_PIX_FMT_YUV422P16LE == in ||
+                     AV_PIX_FMT_YUV444P16LE == in);
+            }
+        }
+
         ReadVideo::ReadVideo(
             const std::string& fileName,
             const std::vector<file::MemoryRead>& memory,
@@ -121,14 +137,31 @@ namespace tl
                 }
                 _avCodecContext[_avStream]->thread_count = options.threadCount;
                 _avCodecContext[_avStream]->thread_type = FF_THREAD_FRAME;
+                _avCodecContext[_avStream]->opaque = this;
+                _avCodecContext[_avStream]->get_buffer2 = _getBuffer;
+
+                // Decode at a reduced resolution if the codec supports it,
+                // while the height is at least the reduced height.
+                if (options.reducedHeight > 0)
+                {
+                    int lowres = 0;
+                    while (lowres < avVideoCodec->max_lowres &&
+                        (avVideoCodecParameters->height >> (lowres + 1)) >= options.reducedHeight)
+                    {
+                        ++lowres;
+                    }
+                    _avCodecContext[_avStream]->lowres = lowres;
+                }
+
                 r = avcodec_open2(_avCodecContext[_avStream], avVideoCodec, 0);
                 if (r < 0)
                 {
                     throw std::runtime_error(string::Format("{0}: {1}").arg(fileName).arg(getErrorLabel(r)));
                 }
 
-                _info.size.w = _avCodecParameters[_avStream]->width;
-                _info.size.h = _avCodecParameters[_avStream]->height;
+                const int lowres = _avCodecContext[_avStream]->lowres;
+                _info.size.w = AV_CEIL_RSHIFT(_avCodecParameters[_avStream]->width, lowres);
+                _info.size.h = AV_CEIL_RSHIFT(_avCodecParameters[_avStream]->height, lowres);
                 if (_avCodecParameters[_avStream]->sample_aspect_ratio.den > 0 &&
                     _avCodecParameters[_avStream]->sample_aspect_ratio.num > 0)
                 {
@@ -278,6 +311,40 @@ namespace tl
                 {
                     _info.videoLevels = image::VideoLevels::LegalRange;
                 }
+
+                // Planar YUV frames can be decoded directly into buffers
+                // with the same layout as image::Image, and then used
+                // without copying. This requires that the decoder accepts
+                // the tightly packed line sizes of the image.
+                if (canWrap(_avInputPixelFormat, _avOutputPixelFormat) &&
+                    (avVideoCodec->capabilities & AV_CODEC_CAP_DR1) &&
+                    0 == _info.size.w % 2 &&
+                    0 == _info.size.h % 2)
+                {
+                    int w = _info.size.w;
+                    int h = _info.size.h;
+                    int linesizeAlign[AV_NUM_DATA_POINTERS];
+                    avcodec_align_dimensions2(_avCodecContext[_avStream], &w, &h, linesizeAlign);
+                    int linesize[4] = { 0, 0, 0, 0 };
+                    _avZeroCopy =
+                        w == _info.size.w &&
+                        av_image_fill_linesizes(linesize, _avInputPixelFormat, _info.size.w) >= 0;
+                    for (int i = 0; i < 4 && _avZeroCopy; ++i)
+                    {
+                        _avZeroCopy = 0 == linesize[i] % linesizeAlign[i];
+                    }
+                    if (_avZeroCopy)
+                    {
+                        // Add padding for decoders that read past the end
+                        // of the frame.
+                        _avBufferPool = av_buffer_pool_init(
+                            image::getDataByteCount(_info) +
+                            (h - _info.size.h) * linesize[0] +
+                            AV_INPUT_BUFFER_PADDING_SIZE,
+                            nullptr);
+                        _avZeroCopy = _avBufferPool != nullptr;
+                    }
+                }
                 switch (_avCodecParameters[_avStream]->color_space)
                 {
                 case AVCOL_SPC_BT2020_NCL:
@@ -347,6 +414,28 @@ namespace tl
                     startTime,
                     otime::RationalTime(sequenceSize, speed));
 
+                // Get the key frames from the index. Not all formats have
+                // a complete index, so the list may be empty.
+                const int indexCount = avformat_index_get_entries_count(avVideoStream);
+                for (int i = 0; i < indexCount; ++i)
+                {
+                    const AVIndexEntry* entry = avformat_index_get_entry(avVideoStream, i);
+                    if (entry && (entry->flags & AVINDEX_KEYFRAME))
+                    {
+                        _keyFrames.push_back(otime::RationalTime(
+                            _timeRange.start_time().value() +
+                            av_rescale_q(
+                                entry->timestamp,
+                                avVideoStream->time_base,
+                                swap(avVideoStream->r_frame_rate)),
+                            _timeRange.duration().rate()));
+                    }
+                }
+                std::sort(_keyFrames.begin(), _keyFrames.end());
+                _keyFrames.erase(
+                    std::unique(_keyFrames.begin(), _keyFrames.end()),
+                    _keyFrames.end());
+
                 for (const auto& i : tags)
                 {
                     _tags[i.first] = i.second;
@@ -433,6 +522,11 @@ namespace tl
             {
                 avformat_close_input(&_avFormatContext);
             }
+            if (_avBufferPool)
+            {
+                // The pool is freed when the last buffer is released.
+                av_buffer_pool_uninit(&_avBufferPool);
+            }
         }
 
         bool ReadVideo::isValid() const
@@ -455,6 +549,11 @@ namespace tl
             return _tags;
         }
 
+        const std::vector<otime::RationalTime>& ReadVideo::getKeyFrames() const
+        {
+            return _keyFrames;
+        }
+
         namespace
         {
             bool canCopy(AVPixelFormat in, AVPixelFormat out)
@@ -512,11 +611,11 @@ namespace tl
                         throw std::runtime_error(string::Format("{0}: Cannot allocate context").arg(_fileName));
                     }
                     av_opt_set_defaults(_swsContext);
-                    int r = av_opt_set_int(_swsContext, "srcw", _avCodecParameters[_avStream]->width, AV_OPT_SEARCH_CHILDREN);
-                    r = av_opt_set_int(_swsContext, "srch", _avCodecParameters[_avStream]->height, AV_OPT_SEARCH_CHILDREN);
+                    int r = av_opt_set_int(_swsContext, "srcw", _info.size.w, AV_OPT_SEARCH_CHILDREN);
+                    r = av_opt_set_int(_swsContext, "srch", _info.size.h, AV_OPT_SEARCH_CHILDREN);
                     r = av_opt_set_int(_swsContext, "src_format", _avInputPixelFormat, AV_OPT_SEARCH_CHILDREN);
-                    r = av_opt_set_int(_swsContext, "dstw", _avCodecParameters[_avStream]->width, AV_OPT_SEARCH_CHILDREN);
-                    r = av_opt_set_int(_swsContext, "dsth", _avCodecParameters[_avStream]->height, AV_OPT_SEARCH_CHILDREN);
+                    r = av_opt_set_int(_swsContext, "dstw", _info.size.w, AV_OPT_SEARCH_CHILDREN);
+                    r = av_opt_set_int(_swsContext, "dsth", _info.size.h, AV_OPT_SEARCH_CHILDREN);
                     r = av_opt_set_int(_swsContext, "dst_format", _avOutputPixelFormat, AV_OPT_SEARCH_CHILDREN);
                     r = av_opt_set_int(_swsContext, "sws_flags", swsScaleFlags, AV_OPT_SEARCH_CHILDREN);
                     r = av_opt_set_int(_swsContext, "threads", _options.threadCount, AV_OPT_SEARCH_CHILDREN);
@@ -667,17 +766,55 @@ namespace tl
             return _buffer.empty();
         }
 
+        void ReadVideo::skipBuffer(const otime::RationalTime& time)
+        {
+            while (!_buffer.empty() && _buffer.front().time < time)
+            {
+                _buffer.pop_front();
+            }
+        }
+
         std::shared_ptr<image::Image> ReadVideo::popBuffer()
         {
             std::shared_ptr<image::Image> out;
             if (!_buffer.empty())
             {
-                out = _buffer.front();
+                out = _buffer.front().image;
                 _buffer.pop_front();
             }
             return out;
         }
 
+        int ReadVideo::_getBuffer(AVCodecContext* avCodecContext, AVFrame* avFrame, int flags)
+        {
+            auto readVideo = static_cast<ReadVideo*>(avCodecContext->opaque);
+            if (readVideo->_avBufferPool &&
+                readVideo->_avInputPixelFormat == avFrame->format &&
+                readVideo->_info.size.w == avFrame->width &&
+                readVideo->_info.size.h == avFrame->height)
+            {
+                AVBufferRef* avBuffer = av_buffer_pool_get(readVideo->_avBufferPool);
+                if (!avBuffer)
+                {
+                    return AVERROR(ENOMEM);
+                }
+                av_image_fill_linesizes(
+                    avFrame->linesize,
+                    readVideo->_avInputPixelFormat,
+                    avFrame->width);
+                av_image_fill_pointers(
+                    avFrame->data,
+                    readVideo->_avInputPixelFormat,
+                    avFrame->height,
+                    avBuffer->data,
+                    avFrame->linesize);
+                avFrame->buf[0] = avBuffer;
+                avFrame->extended_data = avFrame->data;
+                return 0;
+            }
+            return avcodec_default_get_buffer2(avCodecContext, avFrame, flags);
+        }
+
         int ReadVideo::_decode(const otime::RationalTime& currentTime)
         {
             int out = 0;
@@ -703,8 +840,17 @@ namespace tl
                 if (time >= currentTime)
                 {
                     //std::cout << "video time: " << time << std::endl;
-                    auto image = image::Image::create(_info);
-                    
+                    std::shared_ptr<image::Image> image;
+                    if (_avZeroCopy)
+                    {
+                        image = _wrap();
+                    }
+                    const bool copy = !image;
+                    if (copy)
+                    {
+                        image = image::Image::create(_info);
+                    }
+
                     auto tags = _tags;
                     AVDictionaryEntry* tag = nullptr;
                     while ((tag = av_dict_get(_avFrame->metadata, "", tag, AV_DICT_IGNORE_SUFFIX)))
@@ -716,8 +862,14 @@ namespace tl
                     tags["hdr"] = nlohmann::json(hdrData).dump();
                     image->setTags(tags);
 
-                    _copy(image);
-                    _buffer.push_back(image);
+                    if (copy)
+                    {
+                        _copy(image);
+                    }
+                    io::VideoData videoData;
+                    videoData.time = time;
+                    videoData.image = image;
+                    _buffer.push_back(videoData);
                     out = 1;
                     break;
                 }
@@ -725,6 +877,57 @@ namespace tl
             return out;
         }
 
+        std::shared_ptr<image::Image> ReadVideo::_wrap()
+        {
+            std::shared_ptr<image::Image> out;
+
+            // Check that the frame is a single buffer with the same layout
+            // as the image. Frames that were cropped or allocated by the
+            // decoder are copied instead.
+            if (!_avFrame->buf[0] ||
+                _avFrame->buf[1] ||
+                _avFrame->width != _info.size.w ||
+                _avFrame->height != _info.size.h ||
+                static_cast<size_t>(_avFrame->buf[0]->size) < image::getDataByteCount(_info))
+            {
+                return out;
+            }
+            uint8_t* data[4] = { nullptr, nullptr, nullptr, nullptr };
+            int linesize[4] = { 0, 0, 0, 0 };
+            av_image_fill_linesizes(linesize, _avInputPixelFormat, _info.size.w);
+            av_image_fill_pointers(
+                data,
+                _avInputPixelFormat,
+                _info.size.h,
+                _avFrame->buf[0]->data,
+                linesize);
+            for (int i = 0; i < 3; ++i)
+            {
+                if (data[i] != _avFrame->data[i] ||
+                    linesize[i] != _avFrame->linesize[i])
+                {
+                    return out;
+                }
+            }
+
+            // The image keeps a reference to the buffer so that it is not
+            // re-used by the decoder.
+            AVBufferRef* avBuffer = av_buffer_ref(_avFrame->buf[0]);
+            if (avBuffer)
+            {
+                out = image::Image::create(
+                    _info,
+                    avBuffer->data,
+                    std::shared_ptr<AVBufferRef>(
+                        avBuffer,
+                        [](AVBufferRef* value)
+                        {
+                            av_buffer_unref(&value);
+                        }));
+            }
+            return out;
+        }
+
         void ReadVideo::_copy(const std::shared_ptr<image::Image>& image)
         {
             const auto& info = image->getInfo();
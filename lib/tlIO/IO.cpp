@@ -4,6 +4,9 @@
 
 #include <tlIO/IO.h>
 
+#include <cmath>
+#include <limits>
+
 namespace tl
 {
     namespace io
@@ -17,5 +20,40 @@ namespace tl
             }
             return out;
         }
+
+        double getPriority(const PlaybackHint& hint, const otime::RationalTime& time)
+        {
+            double out = 0.0;
+            if (time::isValid(hint.time))
+            {
+                const double d = time.rescaled_to(hint.time.rate()).value() - hint.time.value();
+                if (0 == hint.direction)
+                {
+                    out = std::fabs(d);
+                }
+                else
+                {
+                    const double a = d * hint.direction;
+                    // Times behind the playback direction come after all of
+                    // the times ahead.
+                    out = a >= 0.0 ? a : (std::numeric_limits<float>::max() - a);
+                }
+            }
+            return out;
+        }
+
+        bool contains(const PlaybackHint& hint, const otime::RationalTime& time)
+        {
+            bool out = hint.ranges.empty();
+            for (const auto& range : hint.ranges)
+            {
+                if (range.contains(time))
+                {
+                    out = true;
+                    break;
+                }
+            }
+            return out;
+        }
     }
 }
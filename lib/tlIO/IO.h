@@ -8,6 +8,9 @@
 #include <tlCore/Image.h>
 #include <tlCore/Time.h>
 
+#include <atomic>
+#include <functional>
+
 namespace tl
 {
     //! Audio and video I/O.
@@ -60,6 +63,9 @@ namespace tl
             uint16_t                      layer = 0;
             std::shared_ptr<image::Image> image;
 
+            //! Whether the read was canceled before the image was read.
+            bool                          canceled = false;
+
             bool operator == (const VideoData&) const;
             bool operator != (const VideoData&) const;
             bool operator < (const VideoData&) const;
@@ -81,7 +87,58 @@ namespace tl
             bool operator < (const AudioData&) const;
         };
 
+        //! Playback hint used to prioritize read requests.
+        struct PlaybackHint
+        {
+            //! The current playback time.
+            otime::RationalTime time = time::invalidTime;
+
+            //! The playback direction; 1 for forward, -1 for reverse, or 0
+            //! when stopped.
+            int direction = 0;
+
+            //! The time ranges being cached. Requests outside of these
+            //! ranges may be canceled.
+            std::vector<otime::TimeRange> ranges;
+
+            bool operator == (const PlaybackHint&) const;
+            bool operator != (const PlaybackHint&) const;
+        };
+
+        //! Get the priority of a request for the given time. Lower values
+        //! have a higher priority; the current time is first, then the
+        //! times in the playback direction, then the times behind.
+        double getPriority(const PlaybackHint&, const otime::RationalTime&);
+
+        //! Get whether the given time is inside the playback hint ranges.
+        bool contains(const PlaybackHint&, const otime::RationalTime&);
+
+        //! Read request state shared between the caller and the reader.
+        struct ReadRequest
+        {
+            //! Set by the caller when the request is no longer needed.
+            //! Readers finish canceled requests with empty data instead of
+            //! reading them.
+            std::atomic<bool> canceled{ false };
+
+            //! Called by the reader after the data has been set. The
+            //! callback may be called from any thread.
+            std::function<void(void)> callback;
+        };
+
+        //! Get whether a read request has been canceled.
+        bool isCanceled(const std::shared_ptr<ReadRequest>&);
+
+        //! Call the read request callback.
+        void finished(const std::shared_ptr<ReadRequest>&);
+
         //! Options.
+        //!
+        //! Setting "ReducedHeight" allows readers to decode the video at a
+        //! reduced resolution that is at least the given height, when the
+        //! format supports it (JPEG DCT scaling, OpenEXR mipmap and ripmap
+        //! levels, FFmpeg codecs with low resolution decoding). The image
+        //! size may then differ from the size in the information.
         typedef std::map<std::string, std::string> Options;
 
         //! Merge options.
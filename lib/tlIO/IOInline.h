@@ -38,7 +38,8 @@ namespace tl
             return
                 time.strictly_equal(other.time) &&
                 layer == other.layer &&
-                image == other.image;
+                image == other.image &&
+                canceled == other.canceled;
         }
 
         inline bool VideoData::operator != (const VideoData& other) const
@@ -77,5 +78,36 @@ namespace tl
         {
             return time < other.time;
         }
+
+        inline bool PlaybackHint::operator == (const PlaybackHint& other) const
+        {
+            bool out =
+                time.strictly_equal(other.time) &&
+                direction == other.direction &&
+                ranges.size() == other.ranges.size();
+            for (size_t i = 0; out && i < ranges.size(); ++i)
+            {
+                out = time::compareExact(ranges[i], other.ranges[i]);
+            }
+            return out;
+        }
+
+        inline bool PlaybackHint::operator != (const PlaybackHint& other) const
+        {
+            return !(*this == other);
+        }
+
+        inline bool isCanceled(const std::shared_ptr<ReadRequest>& value)
+        {
+            return value && value->canceled;
+        }
+
+        inline void finished(const std::shared_ptr<ReadRequest>& value)
+        {
+            if (value && value->callback)
+            {
+                value->callback();
+            }
+        }
     }
 }
@@ -7,6 +7,7 @@
 #include <tlCore/String.h>
 #include <tlCore/StringFormat.h>
 
+#include <cstdlib>
 #include <cstring>
 
 namespace tl
@@ -27,9 +28,29 @@ namespace tl
                 return true;
             }
 
+            // Use the DCT scaling to decode a smaller image that is at
+            // least the reduced height.
+            void jpegScale(
+                jpeg_decompress_struct* decompress,
+                int reducedHeight)
+            {
+                if (reducedHeight > 0)
+                {
+                    unsigned int denom = 1;
+                    while (denom < 8 &&
+                        decompress->image_height / (denom * 2) >= static_cast<unsigned int>(reducedHeight))
+                    {
+                        denom *= 2;
+                    }
+                    decompress->scale_num = 1;
+                    decompress->scale_denom = denom;
+                }
+            }
+
             bool jpegOpen(
                 FILE* f,
                 jpeg_decompress_struct* decompress,
+                int reducedHeight,
                 ErrorStruct* error)
             {
                 if (::setjmp(error->jump))
@@ -42,6 +63,7 @@ namespace tl
                 {
                     return false;
                 }
+                jpegScale(decompress, reducedHeight);
                 if (!jpeg_start_decompress(decompress))
                 {
                     return false;
@@ -53,6 +75,7 @@ namespace tl
                 const uint8_t* memoryPtr,
                 size_t memorySize,
                 jpeg_decompress_struct* decompress,
+                int reducedHeight,
                 ErrorStruct* error)
             {
                 if (::setjmp(error->jump))
@@ -65,6 +88,7 @@ namespace tl
                 {
                     return false;
                 }
+                jpegScale(decompress, reducedHeight);
                 if (!jpeg_start_decompress(decompress))
                 {
                     return false;
@@ -106,8 +130,16 @@ namespace tl
             public:
                 File(
                     const std::string& fileName,
-                    const file::MemoryRead* memory)
+                    const file::MemoryRead* memory,
+                    const io::Options& options)
                 {
+                    int reducedHeight = 0;
+                    const auto i = options.find("ReducedHeight");
+                    if (i != options.end())
+                    {
+                        reducedHeight = std::atoi(i->second.c_str());
+                    }
+
                     std::memset(&_jpeg.decompress, 0, sizeof(jpeg_decompress_struct));
 
                     _jpeg.decompress.err = jpeg_std_error(&_error.pub);
@@ -119,7 +151,7 @@ namespace tl
                     }
                     if (memory)
                     {
-                        if (!jpegOpen(memory->p, memory->size, &_jpeg.decompress, &_error))
+                        if (!jpegOpen(memory->p, memory->size, &_jpeg.decompress, reducedHeight, &_error))
                         {
                             throw std::runtime_error(string::Format("{0}: Cannot open").arg(fileName));
                         }
@@ -138,7 +170,7 @@ namespace tl
                         {
                             throw std::runtime_error(string::Format("{0}: Cannot open").arg(fileName));
                         }
-                        if (!jpegOpen(_f.p, &_jpeg.decompress, &_error))
+                        if (!jpegOpen(_f.p, &_jpeg.decompress, reducedHeight, &_error))
                         {
                             throw std::runtime_error(string::Format("{0}: Cannot open").arg(fileName));
                         }
@@ -275,7 +307,7 @@ namespace tl
             const std::string& fileName,
             const file::MemoryRead* memory)
         {
-            io::Info out = File(fileName, memory).getInfo();
+            io::Info out = File(fileName, memory, _options).getInfo();
             out.videoTime = otime::TimeRange::range_from_start_end_time_inclusive(
                 otime::RationalTime(_startFrame, _defaultSpeed),
                 otime::RationalTime(_endFrame, _defaultSpeed));
@@ -286,9 +318,9 @@ namespace tl
             const std::string& fileName,
             const file::MemoryRead* memory,
             const otime::RationalTime& time,
-            const io::Options&)
+            const io::Options& options)
         {
-            return File(fileName, memory).read(fileName, time);
+            return File(fileName, memory, options).read(fileName, time);
         }
     }
 }
@@ -18,6 +18,7 @@
 #include <ImfThreading.h>
 
 #include <array>
+#include <mutex>
 
 namespace tl
 {
@@ -823,6 +824,16 @@ namespace tl
             }
         }
 
+        void reserveGlobalThreads(size_t value)
+        {
+            static std::mutex mutex;
+            std::unique_lock<std::mutex> lock(mutex);
+            if (static_cast<int>(value) > Imf::globalThreadCount())
+            {
+                Imf::setGlobalThreadCount(static_cast<int>(value));
+            }
+        }
+
         math::Box2i fromImath(const Imath::Box2i& value)
         {
             return math::Box2i(math::Vector2i(value.min.x, value.min.y), math::Vector2i(value.max.x, value.max.y));
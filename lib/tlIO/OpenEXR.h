@@ -11,6 +11,11 @@ namespace tl
     //! OpenEXR image I/O.
     namespace exr
     {
+        //! Default number of threads used by OpenEXR to decode each image.
+        //! Zero disables the OpenEXR threading, and the images are only
+        //! decoded in parallel by the sequence reader.
+        const size_t threadCount = 0;
+
         //! Channel grouping.
         enum class ChannelGrouping
         {
@@ -45,6 +50,10 @@ namespace tl
         TLRENDER_ENUM_SERIALIZE(Compression);
 
         //! OpenEXR reader.
+        //!
+        //! Each part of a multi-part file is read separately, so requests
+        //! for layers in different parts only decode their own part and can
+        //! run in parallel.
         class Read : public io::ISequenceRead
         {
         protected:
@@ -87,6 +96,7 @@ namespace tl
 
         private:
             ChannelGrouping _channelGrouping = ChannelGrouping::Known;
+            size_t _threadCount = exr::threadCount;
         };
 
         //! OpenEXR writer.
@@ -66,6 +66,10 @@ namespace tl
         //! \todo Write all the tags that are handled by readTags().
         void writeTags(const image::Tags&, double speed, Imf::Header&);
 
+        //! Make sure the OpenEXR global thread pool has at least the given
+        //! number of threads.
+        void reserveGlobalThreads(size_t);
+
         //! Convert an Imath box type.
         math::Box2i fromImath(const Imath::Box2i&);
 
@@ -9,7 +9,11 @@
 #include <tlCore/StringFormat.h>
 
 #include <ImfChannelList.h>
+#include <ImfInputPart.h>
+#include <ImfMultiPartInputFile.h>
+#include <ImfPartType.h>
 #include <ImfRgbaFile.h>
+#include <ImfTiledInputPart.h>
 
 #include <array>
 #include <cstring>
@@ -134,6 +138,11 @@ namespace tl
                 return data[value];
             }
 
+            // Number of scanlines read at a time when the data window is
+            // not inside the display window. This is a multiple of the
+            // scanlines per chunk of all of the compression types.
+            const int scanlineChunk = 256;
+
             class File
             {
             public:
@@ -141,6 +150,7 @@ namespace tl
                     const std::string& fileName,
                     const file::MemoryRead* memory,
                     ChannelGrouping channelGrouping,
+                    size_t threadCount,
                     const std::weak_ptr<log::System>& logSystemWeak)
                 {
                     // Open the file.
@@ -152,13 +162,12 @@ namespace tl
                     {
                         _s.reset(new IStream(fileName.c_str()));
                     }
-                    _f.reset(new Imf::InputFile(*_s));
+                    _f.reset(new Imf::MultiPartInputFile(*_s, static_cast<int>(threadCount)));
 
-                    // Get the display and data windows.
-                    _displayWindow = fromImath(_f->header().displayWindow());
-                    _dataWindow = fromImath(_f->header().dataWindow());
-                    _intersectedWindow = _displayWindow.intersect(_dataWindow);
-                    _fast = _displayWindow == _dataWindow;
+                    // Get the display window. The display window is the
+                    // same for all of the parts.
+                    const Imf::Header& header = _f->header(0);
+                    _displayWindow = fromImath(header.displayWindow());
 
                     if (auto logSystem = logSystemWeak.lock())
                     {
@@ -168,39 +177,60 @@ namespace tl
                             "\n"
                             "    file name: {0}\n"
                             "    display window {1}\n"
-                            "    data window: {2}\n"
-                            "    compression: {3}").
+                            "    parts: {2}").
                             arg(fileName).
                             arg(_displayWindow).
-                            arg(_dataWindow).
-                            arg(getLabel(_f->header().compression())));
-                        const auto& channels = _f->header().channels();
-                        for (auto i = channels.begin(); i != channels.end(); ++i)
+                            arg(_f->parts()));
+                        for (int part = 0; part < _f->parts(); ++part)
                         {
-                            std::stringstream ss2;
-                            ss2 << "    channel " << i.name() << ": " << getLabel(i.channel().type) << ", " << i.channel().xSampling << "x" << i.channel().ySampling;
-                            s.push_back(ss2.str());
+                            const Imf::Header& partHeader = _f->header(part);
+                            s.push_back(string::Format(
+                                "    part {0} data window: {1}\n"
+                                "    part {2} compression: {3}").
+                                arg(part).
+                                arg(fromImath(partHeader.dataWindow())).
+                                arg(part).
+                                arg(getLabel(partHeader.compression())));
+                            const auto& channels = partHeader.channels();
+                            for (auto i = channels.begin(); i != channels.end(); ++i)
+                            {
+                                std::stringstream ss2;
+                                ss2 << "    part " << part << " channel " << i.name() << ": " << getLabel(i.channel().type) << ", " << i.channel().xSampling << "x" << i.channel().ySampling;
+                                s.push_back(ss2.str());
+                            }
                         }
                         logSystem->print(id, string::join(s, '\n'));
                     }
 
                     // Get the tags.
-                    readTags(_f->header(), _info.tags);
+                    readTags(header, _info.tags);
 
-                    // Get the layers.
-                    _layers = getLayers(_f->header().channels(), channelGrouping);
+                    // Get the layers. Each part of a multi-part file has
+                    // its own layers, and deep parts are skipped.
+                    for (int part = 0; part < _f->parts(); ++part)
+                    {
+                        const Imf::Header& partHeader = _f->header(part);
+                        if (partHeader.hasType() && Imf::isDeepData(partHeader.type()))
+                            continue;
+                        for (auto layer : getLayers(partHeader.channels(), channelGrouping))
+                        {
+                            if (layer.name.empty() && _f->parts() > 1 && partHeader.hasName())
+                            {
+                                layer.name = partHeader.name();
+                            }
+                            _layers.push_back(layer);
+                            _layerParts.push_back(part);
+                        }
+                    }
                     _info.video.resize(_layers.size());
                     for (size_t i = 0; i < _layers.size(); ++i)
                     {
                         const auto& layer = _layers[i];
-                        const math::Vector2i sampling(layer.channels[0].sampling.x, layer.channels[0].sampling.y);
-                        if (sampling.x != 1 || sampling.y != 1)
-                            _fast = false;
                         auto& info = _info.video[i];
                         info.name = layer.name;
                         info.size.w = _displayWindow.w();
                         info.size.h = _displayWindow.h();
-                        info.size.pixelAspectRatio = _f->header().pixelAspectRatio();
+                        info.size.pixelAspectRatio = header.pixelAspectRatio();
                         switch (layer.channels[0].pixelType)
                         {
                         case Imf::PixelType::HALF:
@@ -241,6 +271,34 @@ namespace tl
                             std::atoi(i->second.c_str()),
                             static_cast<int>(_info.video.size()) - 1);
                     }
+                    int reducedHeight = 0;
+                    const auto j = options.find("ReducedHeight");
+                    if (j != options.end())
+                    {
+                        reducedHeight = std::atoi(j->second.c_str());
+                    }
+
+                    // Only the part that contains the layer is read.
+                    const Imf::Header& header = _f->header(_layerParts[layer]);
+                    const math::Box2i dataWindow = fromImath(header.dataWindow());
+                    const math::Box2i intersectedWindow = _displayWindow.intersect(dataWindow);
+                    bool subsampled = false;
+                    for (const auto& channel : _layers[layer].channels)
+                    {
+                        if (channel.sampling.x != 1 || channel.sampling.y != 1)
+                        {
+                            subsampled = true;
+                        }
+                    }
+                    if (reducedHeight > 0 &&
+                        !subsampled &&
+                        dataWindow == _displayWindow &&
+                        header.hasTileDescription() &&
+                        header.tileDescription().mode != Imf::ONE_LEVEL)
+                    {
+                        return _readLevel(layer, reducedHeight);
+                    }
+
                     image::Info imageInfo = _info.video[layer];
                     out.image = image::Image::create(imageInfo);
                     out.image->setTags(_info.tags);
@@ -248,31 +306,91 @@ namespace tl
                     const size_t channelByteCount = image::getBitDepth(imageInfo.pixelType) / 8;
                     const size_t cb = channels * channelByteCount;
                     const size_t scb = imageInfo.size.w * channels * channelByteCount;
-                    if (_fast)
+                    Imf::InputPart part(*_f, _layerParts[layer]);
+
+                    if (!subsampled && _displayWindow.contains(dataWindow))
                     {
+                        // Read the data window directly into the image
+                        // with a single call, and clear the rest of the
+                        // display window.
+                        uint8_t* data = out.image->getData();
+                        if (dataWindow != _displayWindow)
+                        {
+                            _clear(data, dataWindow, cb, scb);
+                        }
+                        char* base =
+                            reinterpret_cast<char*>(data) -
+                            _displayWindow.min.x * static_cast<ptrdiff_t>(cb) -
+                            _displayWindow.min.y * static_cast<ptrdiff_t>(scb);
                         Imf::FrameBuffer frameBuffer;
                         for (size_t c = 0; c < channels; ++c)
                         {
-                            const std::string& name = _layers[layer].channels[c].name;
-                            const math::Vector2i& sampling = _layers[layer].channels[c].sampling;
                             frameBuffer.insert(
-                                name.c_str(),
+                                _layers[layer].channels[c].name.c_str(),
                                 Imf::Slice(
                                     _layers[layer].channels[c].pixelType,
-                                    reinterpret_cast<char*>(out.image->getData()) + (c * channelByteCount),
+                                    base + (c * channelByteCount),
                                     cb,
                                     scb,
-                                    sampling.x,
-                                    sampling.y,
+                                    1,
+                                    1,
                                     0.F));
                         }
-                        _f->setFrameBuffer(frameBuffer);
-                        _f->readPixels(_displayWindow.min.y, _displayWindow.max.y);
+                        part.setFrameBuffer(frameBuffer);
+                        part.readPixels(dataWindow.min.y, dataWindow.max.y);
+                    }
+                    else if (!subsampled)
+                    {
+                        // Read the scanlines that intersect the display
+                        // window in chunks, so the chunks can be decoded
+                        // in parallel, and copy them into the image.
+                        uint8_t* data = out.image->getData();
+                        _clear(data, intersectedWindow, cb, scb);
+                        if (_displayWindow.intersects(dataWindow))
+                        {
+                            const size_t bufScb = dataWindow.w() * cb;
+                            std::vector<char> buf(scanlineChunk * bufScb);
+                            for (int y = intersectedWindow.min.y; y <= intersectedWindow.max.y; y += scanlineChunk)
+                            {
+                                const int y2 = std::min(y + scanlineChunk - 1, intersectedWindow.max.y);
+                                char* base =
+                                    buf.data() -
+                                    dataWindow.min.x * static_cast<ptrdiff_t>(cb) -
+                                    y * static_cast<ptrdiff_t>(bufScb);
+                                Imf::FrameBuffer frameBuffer;
+                                for (size_t c = 0; c < channels; ++c)
+                                {
+                                    frameBuffer.insert(
+                                        _layers[layer].channels[c].name.c_str(),
+                                        Imf::Slice(
+                                            _layers[layer].channels[c].pixelType,
+                                            base + (c * channelByteCount),
+                                            cb,
+                                            bufScb,
+                                            1,
+                                            1,
+                                            0.F));
+                                }
+                                part.setFrameBuffer(frameBuffer);
+                                part.readPixels(y, y2);
+                                for (int j = y; j <= y2; ++j)
+                                {
+                                    std::memcpy(
+                                        data +
+                                        (j - _displayWindow.min.y) * scb +
+                                        (intersectedWindow.min.x - _displayWindow.min.x) * cb,
+                                        buf.data() +
+                                        (j - y) * bufScb +
+                                        (intersectedWindow.min.x - dataWindow.min.x) * cb,
+                                        intersectedWindow.w() * cb);
+                                }
+                            }
+                        }
                     }
                     else
                     {
                         Imf::FrameBuffer frameBuffer;
-                        std::vector<char> buf(_dataWindow.w() * cb);
+                        std::vector<char> buf(dataWindow.w() * cb);
                         for (int c = 0; c < channels; ++c)
                         {
                             const std::string& name = _layers[layer].channels[c].name;
@@ -281,28 +399,28 @@ namespace tl
                                 name.c_str(),
                                 Imf::Slice(
                                     _layers[layer].channels[c].pixelType,
-                                    buf.data() - (_dataWindow.min.x * cb) + (c * channelByteCount),
+                                    buf.data() - (dataWindow.min.x * cb) + (c * channelByteCount),
                                     cb,
                                     0,
                                     sampling.x,
                                     sampling.y,
                                     0.F));
                         }
-                        _f->setFrameBuffer(frameBuffer);
+                        part.setFrameBuffer(frameBuffer);
                         for (int y = _displayWindow.min.y; y <= _displayWindow.max.y; ++y)
                         {
                             uint8_t* p = out.image->getData() + ((y - _displayWindow.min.y) * scb);
                             uint8_t* end = p + scb;
-                            if (y >= _intersectedWindow.min.y && y <= _intersectedWindow.max.y)
+                            if (y >= intersectedWindow.min.y && y <= intersectedWindow.max.y)
                             {
-                                size_t size = (_intersectedWindow.min.x - _displayWindow.min.x) * cb;
+                                size_t size = (intersectedWindow.min.x - _displayWindow.min.x) * cb;
                                 std::memset(p, 0, size);
                                 p += size;
-                                size = _intersectedWindow.w() * cb;
-                                _f->readPixels(y, y);
+                                size = intersectedWindow.w() * cb;
+                                part.readPixels(y, y);
                                 std::memcpy(
                                     p,
-                                    buf.data() + std::max(_displayWindow.min.x - _dataWindow.min.x, 0) * cb,
+                                    buf.data() + std::max(_displayWindow.min.x - dataWindow.min.x, 0) * cb,
                                     size);
                                 p += size;
                             }
@@ -313,15 +431,85 @@ namespace tl
                 }
 
             private:
-                ChannelGrouping                 _channelGrouping = ChannelGrouping::Known;
-                std::unique_ptr<Imf::IStream>   _s;
-                std::unique_ptr<Imf::InputFile> _f;
-                math::Box2i                    _displayWindow;
-                math::Box2i                    _dataWindow;
-                math::Box2i                    _intersectedWindow;
-                std::vector<Layer>              _layers;
-                bool                            _fast = false;
-                io::Info                        _info;
+                // Read the smallest mipmap or ripmap level that is at least
+                // the reduced height.
+                io::VideoData _readLevel(int layer, int reducedHeight)
+                {
+                    Imf::TiledInputPart part(*_f, _layerParts[layer]);
+                    int ly = 0;
+                    while (ly + 1 < part.numYLevels() && part.levelHeight(ly + 1) >= reducedHeight)
+                    {
+                        ++ly;
+                    }
+                    const int lx = std::min(ly, part.numXLevels() - 1);
+
+                    io::VideoData out;
+                    image::Info imageInfo = _info.video[layer];
+                    imageInfo.size.w = part.levelWidth(lx);
+                    imageInfo.size.h = part.levelHeight(ly);
+                    out.image = image::Image::create(imageInfo);
+                    out.image->setTags(_info.tags);
+                    const size_t channels = image::getChannelCount(imageInfo.pixelType);
+                    const size_t channelByteCount = image::getBitDepth(imageInfo.pixelType) / 8;
+                    const size_t cb = channels * channelByteCount;
+                    const size_t scb = imageInfo.size.w * channels * channelByteCount;
+
+                    const math::Box2i levelWindow = fromImath(part.dataWindowForLevel(lx, ly));
+                    char* base =
+                        reinterpret_cast<char*>(out.image->getData()) -
+                        levelWindow.min.x * static_cast<ptrdiff_t>(cb) -
+                        levelWindow.min.y * static_cast<ptrdiff_t>(scb);
+                    Imf::FrameBuffer frameBuffer;
+                    for (size_t c = 0; c < channels; ++c)
+                    {
+                        frameBuffer.insert(
+                            _layers[layer].channels[c].name.c_str(),
+                            Imf::Slice(
+                                _layers[layer].channels[c].pixelType,
+                                base + (c * channelByteCount),
+                                cb,
+                                scb,
+                                1,
+                                1,
+                                0.F));
+                    }
+                    part.setFrameBuffer(frameBuffer);
+                    part.readTiles(
+                        0,
+                        part.numXTiles(lx) - 1,
+                        0,
+                        part.numYTiles(ly) - 1,
+                        lx,
+                        ly);
+                    return out;
+                }
+
+                // Clear the parts of the image outside of the given window.
+                void _clear(uint8_t* data, const math::Box2i& window, size_t cb, size_t scb)
+                {
+                    for (int y = _displayWindow.min.y; y <= _displayWindow.max.y; ++y)
+                    {
+                        uint8_t* p = data + (y - _displayWindow.min.y) * scb;
+                        if (_displayWindow.intersects(window) && y >= window.min.y && y <= window.max.y)
+                        {
+                            const size_t left = (window.min.x - _displayWindow.min.x) * cb;
+                            const size_t right = (_displayWindow.max.x - window.max.x) * cb;
+                            std::memset(p, 0, left);
+                            std::memset(p + scb - right, 0, right);
+                        }
+                        else
+                        {
+                            std::memset(p, 0, scb);
+                        }
+                    }
+                }
+
+                std::unique_ptr<Imf::IStream>               _s;
+                std::unique_ptr<Imf::MultiPartInputFile>    _f;
+                math::Box2i                                 _displayWindow;
+                std::vector<Layer>                          _layers;
+                std::vector<int>                            _layerParts;
+                io::Info                                    _info;
             };
         }
 
@@ -340,6 +528,13 @@ namespace tl
                 std::stringstream ss(option->second);
                 ss >> _channelGrouping;
             }
+            option = options.find("OpenEXR/ThreadCount");
+            if (option != options.end())
+            {
+                std::stringstream ss(option->second);
+                ss >> _threadCount;
+            }
+            reserveGlobalThreads(_threadCount);
         }
 
         Read::Read()
@@ -377,7 +572,7 @@ namespace tl
             const std::string& fileName,
             const file::MemoryRead* memory)
         {
-            io::Info out = File(fileName, memory, _channelGrouping, _logSystem.lock()).getInfo();
+            io::Info out = File(fileName, memory, _channelGrouping, _threadCount, _logSystem).getInfo();
             float speed = _defaultSpeed;
             const auto i = out.tags.find("Frame Per Second");
             if (i != out.tags.end())
@@ -396,7 +591,10 @@ namespace tl
             const otime::RationalTime& time,
             const io::Options& options)
         {
-            return File(fileName, memory, _channelGrouping, _logSystem).read(fileName, time, options);
+            // The file information is only logged by _getInfo(), so it is
+            // not logged for every frame.
+            return File(fileName, memory, _channelGrouping, _threadCount, std::weak_ptr<log::System>()).
+                read(fileName, time, options);
         }
     }
 }
@@ -0,0 +1,625 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlIO/PersistentCache.h>
+
+#include <tlCore/File.h>
+#include <tlCore/FileIO.h>
+#include <tlCore/FileInfo.h>
+#include <tlCore/StringFormat.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <iomanip>
+#include <mutex>
+#include <random>
+#include <sstream>
+
+namespace tl
+{
+    namespace io
+    {
+        namespace
+        {
+            const uint32_t fileMagic = 0x43506c74; // "tlPC"
+            const uint32_t fileVersion = 1;
+
+            // Temporary files may still be in use by other processes, so
+            // they are only removed when they are older than this (in
+            // seconds).
+            const time_t tmpFileAge = 60 * 60;
+
+            void invalidFile(const std::shared_ptr<file::FileIO>& io)
+            {
+                throw std::runtime_error(string::Format("{0}: Invalid persistent cache file").
+                    arg(io->getFileName()));
+            }
+
+            void checkSize(const std::shared_ptr<file::FileIO>& io, uint64_t byteCount)
+            {
+                if (io->getPos() + byteCount > io->getSize())
+                {
+                    invalidFile(io);
+                }
+            }
+
+            void writeString(const std::shared_ptr<file::FileIO>& io, const std::string& value)
+            {
+                io->writeU32(static_cast<uint32_t>(value.size()));
+                io->write(value);
+            }
+
+            std::string readString(const std::shared_ptr<file::FileIO>& io)
+            {
+                uint32_t size = 0;
+                io->readU32(&size);
+                checkSize(io, size);
+                std::string out(size, 0);
+                if (size > 0)
+                {
+                    io->read(&out[0], size);
+                }
+                return out;
+            }
+
+            void writeKey(const std::shared_ptr<file::FileIO>& io, const CacheKey& key)
+            {
+                const uint64_t hashes[2] = { key.path, key.options };
+                io->write(hashes, 2 * sizeof(uint64_t));
+                const double time[3] = { key.value, key.duration, key.rate };
+                io->write(time, 3 * sizeof(double));
+            }
+
+            CacheKey readKey(const std::shared_ptr<file::FileIO>& io)
+            {
+                CacheKey out;
+                uint64_t hashes[2] = { 0, 0 };
+                io->read(hashes, 2 * sizeof(uint64_t));
+                out.path = hashes[0];
+                out.options = hashes[1];
+                double time[3] = { 0.0, 0.0, 0.0 };
+                io->read(time, 3 * sizeof(double));
+                out.value = time[0];
+                out.duration = time[1];
+                out.rate = time[2];
+                return out;
+            }
+
+            void writeTimeRange(
+                const std::shared_ptr<file::FileIO>& io,
+                const otime::TimeRange& value)
+            {
+                const double time[4] =
+                {
+                    value.start_time().value(),
+                    value.start_time().rate(),
+                    value.duration().value(),
+                    value.duration().rate()
+                };
+                io->write(time, 4 * sizeof(double));
+            }
+
+            otime::TimeRange readTimeRange(const std::shared_ptr<file::FileIO>& io)
+            {
+                double time[4] = { 0.0, 0.0, 0.0, 0.0 };
+                io->read(time, 4 * sizeof(double));
+                return otime::TimeRange(
+                    otime::RationalTime(time[0], time[1]),
+                    otime::RationalTime(time[2], time[3]));
+            }
+
+            void writeTags(const std::shared_ptr<file::FileIO>& io, const image::Tags& tags)
+            {
+                io->writeU32(static_cast<uint32_t>(tags.size()));
+                for (const auto& tag : tags)
+                {
+                    writeString(io, tag.first);
+                    writeString(io, tag.second);
+                }
+            }
+
+            image::Tags readTags(const std::shared_ptr<file::FileIO>& io)
+            {
+                image::Tags out;
+                uint32_t tagCount = 0;
+                io->readU32(&tagCount);
+                for (uint32_t i = 0; i < tagCount; ++i)
+                {
+                    const std::string key = readString(io);
+                    out[key] = readString(io);
+                }
+                return out;
+            }
+
+            void writeImageInfo(const std::shared_ptr<file::FileIO>& io, const image::Info& info)
+            {
+                writeString(io, info.name);
+                io->writeU32(info.size.w);
+                io->writeU32(info.size.h);
+                io->writeF32(info.size.pixelAspectRatio);
+                io->writeU32(static_cast<uint32_t>(info.pixelType));
+                io->writeU32(static_cast<uint32_t>(info.videoLevels));
+                io->writeU32(static_cast<uint32_t>(info.yuvCoefficients));
+                io->writeU8(info.layout.mirror.x);
+                io->writeU8(info.layout.mirror.y);
+                io->writeU32(info.layout.alignment);
+                io->writeU32(static_cast<uint32_t>(info.layout.endian));
+            }
+
+            image::Info readImageInfo(const std::shared_ptr<file::FileIO>& io)
+            {
+                image::Info out;
+                out.name = readString(io);
+                uint32_t u32 = 0;
+                io->readU32(&u32);
+                out.size.w = u32;
+                io->readU32(&u32);
+                out.size.h = u32;
+                io->readF32(&out.size.pixelAspectRatio);
+                io->readU32(&u32);
+                if (u32 >= static_cast<uint32_t>(image::PixelType::Count))
+                {
+                    invalidFile(io);
+                }
+                out.pixelType = static_cast<image::PixelType>(u32);
+                io->readU32(&u32);
+                out.videoLevels = static_cast<image::VideoLevels>(u32);
+                io->readU32(&u32);
+                out.yuvCoefficients = static_cast<image::YUVCoefficients>(u32);
+                uint8_t u8 = 0;
+                io->readU8(&u8);
+                out.layout.mirror.x = u8;
+                io->readU8(&u8);
+                out.layout.mirror.y = u8;
+                io->readU32(&u32);
+                out.layout.alignment = u32;
+                io->readU32(&u32);
+                out.layout.endian = static_cast<memory::Endian>(u32);
+                return out;
+            }
+
+            std::string getFileName(
+                const std::string& path,
+                const CacheKey& key,
+                const std::string& extension)
+            {
+                std::stringstream ss;
+                ss << std::hex << std::setfill('0') << std::setw(16) <<
+                    static_cast<uint64_t>(std::hash<CacheKey>()(key));
+                return string::Format("{0}/{1}.{2}").
+                    arg(path).
+                    arg(ss.str()).
+                    arg(extension);
+            }
+
+            // Images without transparency are stored without the alpha
+            // channel, which makes thumbnails a quarter smaller.
+            bool isOpaque(const std::shared_ptr<image::Image>& image)
+            {
+                const image::Info& info = image->getInfo();
+                const size_t pixelCount =
+                    static_cast<size_t>(info.size.w) * static_cast<size_t>(info.size.h);
+                bool out =
+                    image::PixelType::RGBA_U8 == info.pixelType &&
+                    image->getDataByteCount() == pixelCount * 4;
+                const uint8_t* p = image->getData();
+                for (size_t i = 0; out && i < pixelCount; ++i, p += 4)
+                {
+                    out = 255 == p[3];
+                }
+                return out;
+            }
+        }
+
+        struct PersistentCache::Private
+        {
+            std::string path;
+            size_t max = 0;
+            size_t size = 0;
+            mutable std::mutex mutex;
+        };
+
+        void PersistentCache::_init(
+            const std::string& path,
+            size_t max)
+        {
+            TLRENDER_P();
+            if (!file::exists(path))
+            {
+                file::mkdir(path);
+            }
+            if (!file::exists(path))
+            {
+                throw std::runtime_error(string::Format("{0}: Cannot create persistent cache directory").
+                    arg(path));
+            }
+            p.path = path;
+            p.max = max;
+            trim();
+        }
+
+        PersistentCache::PersistentCache() :
+            _p(new Private)
+        {}
+
+        PersistentCache::~PersistentCache()
+        {}
+
+        std::shared_ptr<PersistentCache> PersistentCache::create(
+            const std::string& path,
+            size_t max)
+        {
+            auto out = std::shared_ptr<PersistentCache>(new PersistentCache);
+            out->_init(path, max);
+            return out;
+        }
+
+        CacheKey PersistentCache::getFileKey(const CacheKey& key, const file::Path& path)
+        {
+            const file::FileInfo fileInfo(path);
+            CacheKey out = key;
+            out.options = combineCacheHash(
+                combineCacheHash(key.options, fileInfo.getSize()),
+                fileInfo.getTime());
+            return out;
+        }
+
+        const std::string& PersistentCache::getPath() const
+        {
+            return _p->path;
+        }
+
+        size_t PersistentCache::getMax() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.max;
+        }
+
+        void PersistentCache::setMax(size_t value)
+        {
+            TLRENDER_P();
+            bool trim = false;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.max = value;
+                trim = p.size > p.max;
+            }
+            if (trim)
+            {
+                this->trim();
+            }
+        }
+
+        size_t PersistentCache::getSize() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.size;
+        }
+
+        void PersistentCache::addInfo(const CacheKey& key, const Info& info)
+        {
+            _write(
+                key,
+                "info",
+                [&info](const std::shared_ptr<file::FileIO>& io)
+                {
+                    io->writeU32(static_cast<uint32_t>(info.video.size()));
+                    for (const auto& video : info.video)
+                    {
+                        writeImageInfo(io, video);
+                    }
+                    writeTimeRange(io, info.videoTime);
+                    writeString(io, info.audio.name);
+                    io->writeU32(static_cast<uint32_t>(info.audio.channelCount));
+                    io->writeU32(static_cast<uint32_t>(info.audio.dataType));
+                    io->writeU32(static_cast<uint32_t>(info.audio.sampleRate));
+                    writeTimeRange(io, info.audioTime);
+                    writeTags(io, info.tags);
+                });
+        }
+
+        bool PersistentCache::getInfo(const CacheKey& key, Info& info) const
+        {
+            return _read(
+                key,
+                "info",
+                [&info](const std::shared_ptr<file::FileIO>& io)
+                {
+                    Info out;
+                    uint32_t videoCount = 0;
+                    io->readU32(&videoCount);
+                    for (uint32_t i = 0; i < videoCount; ++i)
+                    {
+                        out.video.push_back(readImageInfo(io));
+                    }
+                    out.videoTime = readTimeRange(io);
+                    out.audio.name = readString(io);
+                    uint32_t u32 = 0;
+                    io->readU32(&u32);
+                    out.audio.channelCount = u32;
+                    io->readU32(&u32);
+                    out.audio.dataType = static_cast<audio::DataType>(u32);
+                    io->readU32(&u32);
+                    out.audio.sampleRate = u32;
+                    out.audioTime = readTimeRange(io);
+                    out.tags = readTags(io);
+                    info = out;
+                });
+        }
+
+        void PersistentCache::addImage(
+            const CacheKey& key,
+            const std::shared_ptr<image::Image>& image)
+        {
+            if (!image)
+                return;
+            _write(
+                key,
+                "image",
+                [&image](const std::shared_ptr<file::FileIO>& io)
+                {
+                    writeImageInfo(io, image->getInfo());
+                    writeTags(io, image->getTags());
+                    const bool opaque = isOpaque(image);
+                    io->writeU8(opaque);
+                    if (opaque)
+                    {
+                        const size_t pixelCount = image->getDataByteCount() / 4;
+                        std::vector<uint8_t> rgb(pixelCount * 3);
+                        const uint8_t* in = image->getData();
+                        uint8_t* out = rgb.data();
+                        for (size_t i = 0; i < pixelCount; ++i, in += 4, out += 3)
+                        {
+                            out[0] = in[0];
+                            out[1] = in[1];
+                            out[2] = in[2];
+                        }
+                        io->write(rgb.data(), rgb.size());
+                    }
+                    else
+                    {
+                        const uint64_t byteCount = image->getDataByteCount();
+                        io->write(&byteCount, sizeof(uint64_t));
+                        io->write(image->getData(), byteCount);
+                    }
+                });
+        }
+
+        bool PersistentCache::getImage(
+            const CacheKey& key,
+            std::shared_ptr<image::Image>& image) const
+        {
+            return _read(
+                key,
+                "image",
+                [&image](const std::shared_ptr<file::FileIO>& io)
+                {
+                    const image::Info info = readImageInfo(io);
+                    const image::Tags tags = readTags(io);
+                    uint8_t opaque = 0;
+                    io->readU8(&opaque);
+                    auto out = image::Image::create(info);
+                    out->setTags(tags);
+                    if (opaque)
+                    {
+                        const size_t pixelCount =
+                            static_cast<size_t>(info.size.w) * static_cast<size_t>(info.size.h);
+                        if (info.pixelType != image::PixelType::RGBA_U8 ||
+                            out->getDataByteCount() != pixelCount * 4)
+                        {
+                            invalidFile(io);
+                        }
+                        checkSize(io, pixelCount * 3);
+                        std::vector<uint8_t> rgb(pixelCount * 3);
+                        io->read(rgb.data(), rgb.size());
+                        const uint8_t* in = rgb.data();
+                        uint8_t* p = out->getData();
+                        for (size_t i = 0; i < pixelCount; ++i, in += 3, p += 4)
+                        {
+                            p[0] = in[0];
+                            p[1] = in[1];
+                            p[2] = in[2];
+                            p[3] = 255;
+                        }
+                    }
+                    else
+                    {
+                        uint64_t byteCount = 0;
+                        io->read(&byteCount, sizeof(uint64_t));
+                        if (byteCount != out->getDataByteCount())
+                        {
+                            invalidFile(io);
+                        }
+                        checkSize(io, byteCount);
+                        io->read(out->getData(), byteCount);
+                    }
+                    image = out;
+                });
+        }
+
+        void PersistentCache::addPeaks(
+            const CacheKey& key,
+            const std::shared_ptr<audio::AudioPeaks>& peaks)
+        {
+            if (!peaks)
+                return;
+            _write(
+                key,
+                "peaks",
+                [&peaks](const std::shared_ptr<file::FileIO>& io)
+                {
+                    peaks->write(io);
+                });
+        }
+
+        bool PersistentCache::getPeaks(
+            const CacheKey& key,
+            std::shared_ptr<audio::AudioPeaks>& peaks) const
+        {
+            return _read(
+                key,
+                "peaks",
+                [&peaks](const std::shared_ptr<file::FileIO>& io)
+                {
+                    peaks = audio::AudioPeaks::read(io);
+                });
+        }
+
+        void PersistentCache::trim()
+        {
+            TLRENDER_P();
+
+            // Other processes may also be writing to the directory, so the
+            // size is computed from the files that are actually there.
+            std::vector<file::FileInfo> fileInfos;
+            file::ListOptions listOptions;
+            listOptions.sort = file::ListSort::Time;
+            listOptions.sequence = false;
+            file::list(p.path, fileInfos, listOptions);
+            size_t size = 0;
+            for (const auto& fileInfo : fileInfos)
+            {
+                if (file::Type::File == fileInfo.getType())
+                {
+                    size += fileInfo.getSize();
+                }
+            }
+
+            // Remove the oldest files until the cache is below the maximum
+            // by a margin, so that it is not trimmed again on the next write.
+            const size_t max = getMax();
+            if (size > max)
+            {
+                const size_t target = max / 10 * 9;
+                const time_t now = std::time(nullptr);
+                for (const auto& fileInfo : fileInfos)
+                {
+                    if (size <= target)
+                        break;
+                    if (fileInfo.getType() != file::Type::File)
+                        continue;
+                    if (".tmp" == fileInfo.getPath().getExtension() &&
+                        now - fileInfo.getTime() < tmpFileAge)
+                        continue;
+                    if (file::rm(fileInfo.getPath().get()))
+                    {
+                        size -= std::min(size, static_cast<size_t>(fileInfo.getSize()));
+                    }
+                }
+            }
+
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.size = size;
+        }
+
+        void PersistentCache::clear()
+        {
+            TLRENDER_P();
+            std::vector<file::FileInfo> fileInfos;
+            file::ListOptions listOptions;
+            listOptions.sequence = false;
+            file::list(p.path, fileInfos, listOptions);
+            for (const auto& fileInfo : fileInfos)
+            {
+                if (file::Type::File == fileInfo.getType())
+                {
+                    file::rm(fileInfo.getPath().get());
+                }
+            }
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.size = 0;
+        }
+
+        void PersistentCache::_write(
+            const CacheKey& key,
+            const std::string& extension,
+            const std::function<void(const std::shared_ptr<file::FileIO>&)>& callback)
+        {
+            TLRENDER_P();
+
+            // Write to a temporary file and rename it, so that other
+            // processes never read a partially written file. If several
+            // processes write the same item, the last rename wins.
+            const std::string fileName = getFileName(p.path, key, extension);
+            std::random_device rd;
+            const std::string tmpFileName = string::Format("{0}.{1}.tmp").
+                arg(fileName).
+                arg(rd());
+            int64_t byteCount = 0;
+            try
+            {
+                {
+                    auto io = file::FileIO::create(tmpFileName, file::Mode::Write);
+                    io->writeU32(fileMagic);
+                    io->writeU32(fileVersion);
+                    writeKey(io, key);
+                    callback(io);
+                    byteCount = io->getPos();
+                }
+                byteCount -= file::FileInfo(file::Path(fileName)).getSize();
+                if (std::rename(tmpFileName.c_str(), fileName.c_str()) != 0)
+                {
+                    file::rm(tmpFileName);
+                    return;
+                }
+            }
+            catch (const std::exception&)
+            {
+                file::rm(tmpFileName);
+                return;
+            }
+
+            bool trim = false;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.size = std::max(static_cast<int64_t>(p.size) + byteCount, int64_t(0));
+                trim = p.size > p.max;
+            }
+            if (trim)
+            {
+                this->trim();
+            }
+        }
+
+        bool PersistentCache::_read(
+            const CacheKey& key,
+            const std::string& extension,
+            const std::function<void(const std::shared_ptr<file::FileIO>&)>& callback) const
+        {
+            TLRENDER_P();
+            bool out = false;
+            const std::string fileName = getFileName(p.path, key, extension);
+            if (file::exists(fileName))
+            {
+                try
+                {
+                    auto io = file::FileIO::create(fileName, file::Mode::Read);
+                    uint32_t magic = 0;
+                    io->readU32(&magic);
+                    uint32_t version = 0;
+                    io->readU32(&version);
+                    if (fileMagic == magic &&
+                        fileVersion == version &&
+                        readKey(io) == key)
+                    {
+                        callback(io);
+                        out = true;
+                    }
+                }
+                catch (const std::exception&)
+                {}
+            }
+            if (out)
+            {
+                // Update the modification time so that the files that are
+                // read are trimmed last.
+                file::touch(fileName);
+            }
+            return out;
+        }
+    }
+}
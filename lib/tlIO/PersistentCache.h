@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlIO/Cache.h>
+
+#include <tlCore/AudioPeaks.h>
+
+#include <functional>
+
+namespace tl
+{
+    namespace io
+    {
+        //! Persistent cache.
+        //!
+        //! The persistent cache stores file information, thumbnail images,
+        //! and audio peaks in a directory that is kept between sessions.
+        //! Each item is stored in a file named by the hash of its key, and
+        //! the key is also stored in the file to check for collisions. Files
+        //! are written to a temporary file and then renamed, so several
+        //! processes can share the same directory. When the directory grows
+        //! larger than the maximum size, the least recently used files
+        //! are removed.
+        class PersistentCache : public std::enable_shared_from_this<PersistentCache>
+        {
+            TLRENDER_NON_COPYABLE(PersistentCache);
+
+        protected:
+            void _init(
+                const std::string& path,
+                size_t max);
+
+            PersistentCache();
+
+        public:
+            ~PersistentCache();
+
+            //! Create a new persistent cache. The directory is created if
+            //! it does not exist.
+            static std::shared_ptr<PersistentCache> create(
+                const std::string& path,
+                size_t max);
+
+            //! Get a key that also includes the size and modification time
+            //! of the file, so that items are not used after the file
+            //! changes.
+            static CacheKey getFileKey(const CacheKey&, const file::Path&);
+
+            //! Get the cache directory.
+            const std::string& getPath() const;
+
+            //! Get the maximum cache size in bytes.
+            size_t getMax() const;
+
+            //! Set the maximum cache size in bytes.
+            void setMax(size_t);
+
+            //! Get the current cache size in bytes. This includes the files
+            //! written by other processes the last time the directory was
+            //! scanned.
+            size_t getSize() const;
+
+            //! Add information to the cache.
+            void addInfo(const CacheKey&, const Info&);
+
+            //! Get information from the cache.
+            bool getInfo(const CacheKey&, Info&) const;
+
+            //! Add an image to the cache.
+            void addImage(const CacheKey&, const std::shared_ptr<image::Image>&);
+
+            //! Get an image from the cache.
+            bool getImage(const CacheKey&, std::shared_ptr<image::Image>&) const;
+
+            //! Add audio peaks to the cache.
+            void addPeaks(const CacheKey&, const std::shared_ptr<audio::AudioPeaks>&);
+
+            //! Get audio peaks from the cache.
+            bool getPeaks(const CacheKey&, std::shared_ptr<audio::AudioPeaks>&) const;
+
+            //! Remove the least recently used files until the cache is
+            //! within the maximum size.
+            void trim();
+
+            //! Remove all of the files from the cache.
+            void clear();
+
+        private:
+            void _write(
+                const CacheKey&,
+                const std::string& extension,
+                const std::function<void(const std::shared_ptr<file::FileIO>&)>&);
+            bool _read(
+                const CacheKey&,
+                const std::string& extension,
+                const std::function<void(const std::shared_ptr<file::FileIO>&)>&) const;
+
+            TLRENDER_PRIVATE();
+        };
+    }
+}
@@ -38,6 +38,8 @@ namespace tl
         {
             IIO::_init(path, options, cache, logSystem);
             _memory = memory;
+            _cachePathHash = getCacheHash(path);
+            _cacheOptionsHash = getCacheHash(options);
         }
 
         IRead::IRead()
@@ -48,18 +50,55 @@ namespace tl
 
         std::future<VideoData> IRead::readVideo(
             const otime::RationalTime&,
-            const Options&)
+            const Options&,
+            const std::shared_ptr<ReadRequest>& request)
         {
+            finished(request);
             return std::future<VideoData>();
         }
 
         std::future<AudioData> IRead::readAudio(
             const otime::TimeRange&,
-            const Options&)
+            const Options&,
+            const std::shared_ptr<ReadRequest>& request)
         {
+            finished(request);
             return std::future<AudioData>();
         }
 
+        void IRead::setPlaybackHint(const PlaybackHint&)
+        {}
+
+        size_t IRead::getOpenFileCount() const
+        {
+            return 0;
+        }
+
+        size_t IRead::getByteCount() const
+        {
+            return 0;
+        }
+
+        CacheKey IRead::_getCacheKey(
+            const otime::RationalTime& time,
+            const Options& frameOptions) const
+        {
+            return CacheKey(
+                _cachePathHash,
+                time,
+                combineCacheHash(_cacheOptionsHash, getCacheHash(frameOptions)));
+        }
+
+        CacheKey IRead::_getCacheKey(
+            const otime::TimeRange& timeRange,
+            const Options& frameOptions) const
+        {
+            return CacheKey(
+                _cachePathHash,
+                timeRange,
+                combineCacheHash(_cacheOptionsHash, getCacheHash(frameOptions)));
+        }
+
         void IWrite::_init(
             const file::Path& path,
             const Options& options,
@@ -76,6 +115,9 @@ namespace tl
         IWrite::~IWrite()
         {}
 
+        void IWrite::flush()
+        {}
+
         struct IPlugin::Private
         {
             std::string name;
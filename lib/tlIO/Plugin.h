@@ -72,21 +72,49 @@ namespace tl
             //! Get the information.
             virtual std::future<Info> getInfo() = 0;
 
-            //! Read video data.
+            //! Read video data. The optional request is used to cancel the
+            //! read and to be notified when it is finished.
             virtual std::future<VideoData> readVideo(
                 const otime::RationalTime&,
-                const Options& = Options());
+                const Options& = Options(),
+                const std::shared_ptr<ReadRequest>& = nullptr);
 
-            //! Read audio data.
+            //! Read audio data. The optional request is used to cancel the
+            //! read and to be notified when it is finished.
             virtual std::future<AudioData> readAudio(
                 const otime::TimeRange&,
-                const Options& = Options());
+                const Options& = Options(),
+                const std::shared_ptr<ReadRequest>& = nullptr);
 
             //! Cancel pending requests.
             virtual void cancelRequests() = 0;
 
+            //! Set the playback hint used to prioritize pending requests.
+            //! The times are in the media time of the reader.
+            virtual void setPlaybackHint(const PlaybackHint&);
+
+            //! Get an estimate of the number of files kept open by the
+            //! reader.
+            virtual size_t getOpenFileCount() const;
+
+            //! Get an estimate of the memory used by the reader in bytes.
+            virtual size_t getByteCount() const;
+
         protected:
+            //! Get a video cache key. The path and initialization options
+            //! hashes are computed once when the reader is created.
+            CacheKey _getCacheKey(
+                const otime::RationalTime&,
+                const Options& frameOptions) const;
+
+            //! Get an audio cache key.
+            CacheKey _getCacheKey(
+                const otime::TimeRange&,
+                const Options& frameOptions) const;
+
             std::vector<file::MemoryRead> _memory;
+            uint64_t _cachePathHash = 0;
+            uint64_t _cacheOptionsHash = 0;
         };
 
         //! Base class for writers.
@@ -110,6 +138,10 @@ namespace tl
                 const std::shared_ptr<image::Image>&,
                 const Options& = Options()) = 0;
 
+            //! Wait for pending writes to finish. An exception is thrown
+            //! if a write has failed.
+            virtual void flush();
+
         protected:
             Info _info;
         };
@@ -82,7 +82,9 @@ namespace tl
         {}
 
         Write::~Write()
-        {}
+        {
+            _finish();
+        }
 
         std::shared_ptr<Write> Write::create(
             const file::Path& path,
@@ -16,10 +16,38 @@ namespace tl
         //! Number of threads.
         const size_t sequenceThreadCount = 16;
 
+        //! Minimum number of threads when the number of threads is adjusted
+        //! automatically.
+        const size_t sequenceThreadCountMin = 1;
+
+        //! Maximum number of threads when the number of threads is adjusted
+        //! automatically.
+        const size_t sequenceThreadCountMax = 64;
+
+        //! Interval for measuring the throughput when the number of threads
+        //! is adjusted automatically.
+        const std::chrono::milliseconds sequenceThreadCountInterval(1000);
+
+        //! Number of threads for writing. A value of zero writes on the
+        //! calling thread.
+        const size_t sequenceWriteThreadCount = 0;
+
+        //! Maximum number of frames waiting to be written.
+        const size_t sequenceWriteQueueSize = 16;
+
         //! Timeout for requests.
         const std::chrono::milliseconds sequenceRequestTimeout(5);
 
         //! Base class for image sequence readers.
+        //!
+        //! Frames are read by a pool of threads. Pending requests are read in
+        //! order of priority given by the playback hint, and pending requests
+        //! outside of the playback hint ranges are canceled.
+        //!
+        //! Setting "SequenceIO/ThreadCount" to zero adjusts the number of
+        //! threads automatically. While the threads are kept busy the frame
+        //! throughput is measured, and the number of threads is moved in
+        //! the direction that increases it.
         class ISequenceRead : public IRead
         {
         protected:
@@ -38,8 +66,13 @@ namespace tl
             std::future<Info> getInfo() override;
             std::future<VideoData> readVideo(
                 const otime::RationalTime&,
-                const Options& = Options()) override;
+                const Options& = Options(),
+                const std::shared_ptr<ReadRequest>& = nullptr) override;
             void cancelRequests() override;
+            void setPlaybackHint(const PlaybackHint&) override;
+
+            //! Get the number of threads reading frames.
+            size_t getThreadCount() const;
 
         protected:
             virtual Info _getInfo(
@@ -60,13 +93,21 @@ namespace tl
 
         private:
             void _thread();
-            void _finishRequests();
+            void _worker(size_t index);
+            void _threadCountUpdate();
             void _cancelRequests();
 
             TLRENDER_PRIVATE();
         };
 
         //! Base class for image sequence writers.
+        //!
+        //! Each frame is written to a separate file, so frames can be written
+        //! in parallel by a pool of threads ("SequenceIO/WriteThreadCount").
+        //! The images are queued without copying and must not be modified
+        //! after they are written. When the queue is full writeVideo() blocks
+        //! until there is room. If a write fails the error is thrown from
+        //! the next call to writeVideo() or flush().
         class ISequenceWrite : public IWrite
         {
         protected:
@@ -85,6 +126,7 @@ namespace tl
                 const otime::RationalTime&,
                 const std::shared_ptr<image::Image>&,
                 const Options& = Options()) override;
+            void flush() override;
 
         protected:
             virtual void _writeVideo(
@@ -93,7 +135,12 @@ namespace tl
                 const std::shared_ptr<image::Image>&,
                 const Options&) = 0;
 
+            //! \bug This must be called in the sub-class destructor.
+            void _finish();
+
         private:
+            void _thread();
+
             TLRENDER_PRIVATE();
         };
     }
@@ -9,6 +9,7 @@
 #include <tlCore/LogSystem.h>
 #include <tlCore/StringFormat.h>
 
+#include <algorithm>
 #include <cstring>
 #include <sstream>
 
@@ -56,7 +57,17 @@ namespace tl
                 ss >> _defaultSpeed;
             }
 
+            if (0 == p.threadCount)
+            {
+                p.threadCount = sequenceThreadCount;
+                p.threadCountAuto = true;
+            }
+
             p.thread.running = true;
+            p.thread.activeWorkers = std::max(p.threadCount, static_cast<size_t>(1));
+            p.thread.frameCount = 0;
+            p.thread.frameMicroseconds = 0;
+            p.thread.idle = false;
             p.thread.thread = std::thread(
                 [this, path]
                 {
@@ -67,6 +78,14 @@ namespace tl
                             path.get(-1, file::PathType::Path),
                             !_memory.empty() ? &_memory[0] : nullptr);
                         p.addTags(p.info);
+                        for (size_t i = 0; i < p.thread.activeWorkers; ++i)
+                        {
+                            p.thread.workers.push_back(std::thread(
+                                [this, i]
+                                {
+                                    _worker(i);
+                                }));
+                        }
                         _thread();
                     }
                     catch (const std::exception& e)
@@ -83,7 +102,14 @@ namespace tl
                                 log::Type::Error);
                         }
                     }
-                    _finishRequests();
+                    p.thread.running = false;
+                    for (auto& worker : p.thread.workers)
+                    {
+                        if (worker.joinable())
+                        {
+                            worker.join();
+                        }
+                    }
                     {
                         std::unique_lock<std::mutex> lock(p.mutex.mutex);
                         p.mutex.stopped = true;
@@ -126,12 +152,14 @@ namespace tl
 
         std::future<VideoData> ISequenceRead::readVideo(
             const otime::RationalTime& time,
-            const Options& options)
+            const Options& options,
+            const std::shared_ptr<ReadRequest>& readRequest)
         {
             TLRENDER_P();
             auto request = std::make_shared<Private::VideoRequest>();
             request->time = time;
             request->options = merge(options, _options);
+            request->readRequest = readRequest;
             auto future = request->promise.get_future();
             bool valid = false;
             {
@@ -144,11 +172,12 @@ namespace tl
             }
             if (valid)
             {
-                p.thread.cv.notify_one();
+                p.thread.videoCV.notify_one();
             }
             else
             {
                 request->promise.set_value(VideoData());
+                finished(request->readRequest);
             }
             return future;
         }
@@ -158,6 +187,46 @@ namespace tl
             _cancelRequests();
         }
 
+        void ISequenceRead::setPlaybackHint(const PlaybackHint& value)
+        {
+            TLRENDER_P();
+            std::list<std::shared_ptr<Private::VideoRequest> > videoRequests;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                if (value == p.mutex.playbackHint)
+                    return;
+                p.mutex.playbackHint = value;
+
+                // Cancel the pending requests that are no longer needed.
+                auto i = p.mutex.videoRequests.begin();
+                while (i != p.mutex.videoRequests.end())
+                {
+                    if (!contains(value, (*i)->time))
+                    {
+                        videoRequests.push_back(*i);
+                        i = p.mutex.videoRequests.erase(i);
+                    }
+                    else
+                    {
+                        ++i;
+                    }
+                }
+            }
+            for (auto& request : videoRequests)
+            {
+                VideoData data;
+                data.time = request->time;
+                data.canceled = true;
+                request->promise.set_value(data);
+                finished(request->readRequest);
+            }
+        }
+
+        size_t ISequenceRead::getThreadCount() const
+        {
+            return _p->thread.activeWorkers;
+        }
+
         void ISequenceRead::_finish()
         {
             TLRENDER_P();
@@ -172,11 +241,11 @@ namespace tl
         {
             TLRENDER_P();
             p.thread.logTimer = std::chrono::steady_clock::now();
+            p.thread.throughputTimer = p.thread.logTimer;
             while (p.thread.running)
             {
                 // Check requests.
                 std::list<std::shared_ptr<Private::InfoRequest> > infoRequests;
-                std::list<std::shared_ptr<Private::VideoRequest> > videoRequests;
                 {
                     std::unique_lock<std::mutex> lock(p.mutex.mutex);
                     if (p.thread.cv.wait_for(
@@ -184,19 +253,10 @@ namespace tl
                         sequenceRequestTimeout,
                         [this]
                         {
-                            return
-                                !_p->mutex.infoRequests.empty() ||
-                                !_p->mutex.videoRequests.empty() ||
-                                !_p->thread.videoRequestsInProgress.empty();
+                            return !_p->mutex.infoRequests.empty();
                         }))
                     {
                         infoRequests = std::move(p.mutex.infoRequests);
-                        while (!p.mutex.videoRequests.empty() &&
-                            (p.thread.videoRequestsInProgress.size() + videoRequests.size()) < p.threadCount)
-                        {
-                            videoRequests.push_back(p.mutex.videoRequests.front());
-                            p.mutex.videoRequests.pop_front();
-                        }
                     }
                 }
 
@@ -206,93 +266,10 @@ namespace tl
                     request->promise.set_value(p.info);
                 }
 
-                // Initialize video requests.
-                while (!videoRequests.empty())
+                // Adjust the number of threads.
+                if (p.threadCountAuto)
                 {
-                    auto request = videoRequests.front();
-                    videoRequests.pop_front();
-
-                    VideoData videoData;
-                    const std::string cacheKey = getCacheKey(
-                        _path,
-                        request->time,
-                        _options,
-                        request->options);
-                    if (_cache && _cache->getVideo(cacheKey, videoData))
-                    {
-                        request->promise.set_value(videoData);
-                    }
-                    else
-                    {
-                        bool seq = false;
-                        std::string fileName;
-                        if (!_path.getNumber().empty())
-                        {
-                            seq = true;
-                            fileName = _path.get(
-                                static_cast<int>(request->time.value()),
-                                file::PathType::Path);
-                        }
-                        else
-                        {
-                            fileName = _path.get(-1, file::PathType::Path);
-                        }
-                        const otime::RationalTime time = request->time;
-                        const Options options = request->options;
-                        request->future = std::async(
-                            std::launch::async,
-                            [this, seq, fileName, time, options]
-                            {
-                                VideoData out;
-                                try
-                                {
-                                    const int64_t frame = time.value();
-                                    const int64_t memoryIndex = seq ? (frame - _startFrame) : 0;
-                                    out = _readVideo(
-                                        fileName,
-                                        memoryIndex >= 0 && memoryIndex < _memory.size() ? &_memory[memoryIndex] : nullptr,
-                                        time,
-                                        options);
-                                }
-                                catch (const std::exception&)
-                                {
-                                    //! \todo How should this be handled?
-                                }
-                                return out;
-                            });
-                        p.thread.videoRequestsInProgress.push_back(request);
-                    }
-                }
-
-                // Check for finished video requests.
-                //if (!p.thread.videoRequestsInProgress.empty())
-                //{
-                //    std::cout << "in progress: " << p.thread.videoRequestsInProgress.size() << std::endl;
-                //}
-                auto requestIt = p.thread.videoRequestsInProgress.begin();
-                while (requestIt != p.thread.videoRequestsInProgress.end())
-                {
-                    if ((*requestIt)->future.valid() &&
-                        (*requestIt)->future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
-                    {
-                        //std::cout << "finished: " << requestIt->time << std::endl;
-                        auto videoData = (*requestIt)->future.get();
-                        (*requestIt)->promise.set_value(videoData);
-                        
-                        if (_cache)
-                        {
-                            const std::string cacheKey = getCacheKey(
-                                _path,
-                                (*requestIt)->time,
-                                _options,
-                                (*requestIt)->options);
-                            _cache->addVideo(cacheKey, videoData);
-                        }
-
-                        requestIt = p.thread.videoRequestsInProgress.erase(requestIt);
-                        continue;
-                    }
-                    ++requestIt;
+                    _threadCountUpdate();
                 }
 
                 // Logging.
@@ -305,38 +282,227 @@ namespace tl
                         p.thread.logTimer = now;
                         const std::string id = string::Format("tl::io::ISequenceRead {0}").arg(this);
                         size_t requestsSize = 0;
+                        size_t requestsInProgress = 0;
                         {
                             std::unique_lock<std::mutex> lock(p.mutex.mutex);
                             requestsSize = p.mutex.videoRequests.size();
+                            requestsInProgress = p.mutex.videoRequestsInProgress;
                         }
                         logSystem->print(id, string::Format(
                             "\n"
                             "    Path: {0}\n"
                             "    Requests: {1}, {2} in progress\n"
-                            "    Thread count: {3}").
+                            "    Thread count: {3}{4}\n"
+                            "    Throughput: {5} FPS, {6}ms per frame").
                             arg(_path.get()).
                             arg(requestsSize).
-                            arg(p.thread.videoRequestsInProgress.size()).
-                            arg(p.threadCount));
+                            arg(requestsInProgress).
+                            arg(p.thread.activeWorkers.load()).
+                            arg(p.threadCountAuto ? " (automatic)" : "").
+                            arg(p.thread.throughput).
+                            arg(p.thread.frameTime));
                     }
                 }
             }
         }
 
-        void ISequenceRead::_finishRequests()
+        void ISequenceRead::_worker(size_t index)
         {
             TLRENDER_P();
-            for (auto& request : p.thread.videoRequestsInProgress)
+            while (p.thread.running)
             {
-                VideoData data;
-                data.time = request->time;
-                if (request->future.valid())
+                // Take the pending request with the highest priority.
+                std::shared_ptr<Private::VideoRequest> request;
+                std::vector<std::shared_ptr<Private::VideoRequest> > canceledRequests;
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    if (!p.thread.videoCV.wait_for(
+                        lock,
+                        sequenceRequestTimeout,
+                        [this, index]
+                        {
+                            return
+                                index < _p->thread.activeWorkers &&
+                                !_p->mutex.videoRequests.empty();
+                        }))
+                    {
+                        if (index < p.thread.activeWorkers)
+                        {
+                            p.thread.idle = true;
+                        }
+                    }
+                    else
+                    {
+                        // Remove the requests that have been canceled.
+                        auto i = p.mutex.videoRequests.begin();
+                        while (i != p.mutex.videoRequests.end())
+                        {
+                            if (isCanceled((*i)->readRequest))
+                            {
+                                canceledRequests.push_back(*i);
+                                i = p.mutex.videoRequests.erase(i);
+                            }
+                            else
+                            {
+                                ++i;
+                            }
+                        }
+
+                        const PlaybackHint& hint = p.mutex.playbackHint;
+                        const auto j = std::min_element(
+                            p.mutex.videoRequests.begin(),
+                            p.mutex.videoRequests.end(),
+                            [&hint](
+                                const std::shared_ptr<Private::VideoRequest>& a,
+                                const std::shared_ptr<Private::VideoRequest>& b)
+                            {
+                                return getPriority(hint, a->time) < getPriority(hint, b->time);
+                            });
+                        if (j != p.mutex.videoRequests.end())
+                        {
+                            request = *j;
+                            p.mutex.videoRequests.erase(j);
+                            ++p.mutex.videoRequestsInProgress;
+                        }
+                    }
+                }
+                for (auto& canceledRequest : canceledRequests)
                 {
-                    data = request->future.get();
+                    VideoData data;
+                    data.time = canceledRequest->time;
+                    data.canceled = true;
+                    canceledRequest->promise.set_value(data);
+                    finished(canceledRequest->readRequest);
+                }
+                if (!request)
+                    continue;
+
+                VideoData videoData;
+                const CacheKey cacheKey = _getCacheKey(
+                    request->time,
+                    request->options);
+                if (_cache && _cache->getVideo(cacheKey, videoData))
+                {
+                    request->promise.set_value(videoData);
+                    finished(request->readRequest);
+                }
+                else
+                {
+                    bool seq = false;
+                    std::string fileName;
+                    if (!_path.getNumber().empty())
+                    {
+                        seq = true;
+                        fileName = _path.get(
+                            static_cast<int>(request->time.value()),
+                            file::PathType::Path);
+                    }
+                    else
+                    {
+                        fileName = _path.get(-1, file::PathType::Path);
+                    }
+                    const auto t0 = std::chrono::steady_clock::now();
+                    try
+                    {
+                        const int64_t frame = request->time.value();
+                        const int64_t memoryIndex = seq ? (frame - _startFrame) : 0;
+                        videoData = _readVideo(
+                            fileName,
+                            memoryIndex >= 0 && memoryIndex < _memory.size() ? &_memory[memoryIndex] : nullptr,
+                            request->time,
+                            request->options);
+                    }
+                    catch (const std::exception&)
+                    {
+                        //! \todo How should this be handled?
+                    }
+                    const auto t1 = std::chrono::steady_clock::now();
+                    ++p.thread.frameCount;
+                    p.thread.frameMicroseconds += std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+                    request->promise.set_value(videoData);
+                    finished(request->readRequest);
+
+                    if (_cache)
+                    {
+                        _cache->addVideo(cacheKey, videoData);
+                    }
+                }
+
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    --p.mutex.videoRequestsInProgress;
                 }
-                request->promise.set_value(data);
             }
-            p.thread.videoRequestsInProgress.clear();
+        }
+
+        void ISequenceRead::_threadCountUpdate()
+        {
+            TLRENDER_P();
+            const auto now = std::chrono::steady_clock::now();
+            const auto diff = std::chrono::duration_cast<std::chrono::milliseconds>(
+                now - p.thread.throughputTimer);
+            if (diff < sequenceThreadCountInterval)
+                return;
+            p.thread.throughputTimer = now;
+            const size_t frameCount = p.thread.frameCount.exchange(0);
+            const uint64_t frameMicroseconds = p.thread.frameMicroseconds.exchange(0);
+            const bool idle = p.thread.idle.exchange(false);
+
+            // Only adjust the number of threads when they are kept busy,
+            // otherwise the throughput is limited by the requests.
+            if (idle || frameCount < 4)
+                return;
+
+            // Reverse the direction when the throughput gets worse.
+            const double throughput = frameCount / (diff.count() / 1000.0);
+            if (throughput < p.thread.throughput * .95)
+            {
+                p.thread.threadCountDirection = -p.thread.threadCountDirection;
+            }
+            p.thread.throughput = throughput;
+            p.thread.frameTime = frameMicroseconds / static_cast<double>(frameCount) / 1000.0;
+
+            const size_t activeWorkers = p.thread.activeWorkers;
+            const size_t step = std::max(activeWorkers / 8, static_cast<size_t>(1));
+            size_t threadCount = activeWorkers;
+            if (p.thread.threadCountDirection > 0)
+            {
+                threadCount = std::min(activeWorkers + step, sequenceThreadCountMax);
+            }
+            else
+            {
+                threadCount = activeWorkers > sequenceThreadCountMin + step ?
+                    (activeWorkers - step) :
+                    sequenceThreadCountMin;
+            }
+            if (threadCount == activeWorkers)
+            {
+                p.thread.threadCountDirection = -p.thread.threadCountDirection;
+                return;
+            }
+
+            for (size_t i = p.thread.workers.size(); i < threadCount; ++i)
+            {
+                p.thread.workers.push_back(std::thread(
+                    [this, i]
+                    {
+                        _worker(i);
+                    }));
+            }
+            p.thread.activeWorkers = threadCount;
+            p.thread.videoCV.notify_all();
+
+            if (auto logSystem = _logSystem.lock())
+            {
+                const std::string id = string::Format("tl::io::ISequenceRead {0}").arg(this);
+                logSystem->print(id, string::Format(
+                    "{0}: Thread count {1} -> {2}, {3} FPS, {4}ms per frame").
+                    arg(_path.get()).
+                    arg(activeWorkers).
+                    arg(threadCount).
+                    arg(throughput).
+                    arg(p.thread.frameTime));
+            }
         }
 
         void ISequenceRead::_cancelRequests()
@@ -355,7 +521,11 @@ namespace tl
             }
             for (auto& request : videoRequests)
             {
-                request->promise.set_value(VideoData());
+                VideoData data;
+                data.time = request->time;
+                data.canceled = true;
+                request->promise.set_value(data);
+                finished(request->readRequest);
             }
         }
 
@@ -21,6 +21,7 @@ namespace tl
             void addTags(Info&);
 
             size_t threadCount = sequenceThreadCount;
+            bool threadCountAuto = false;
 
             Info info;
 
@@ -39,14 +40,16 @@ namespace tl
 
                 otime::RationalTime time = time::invalidTime;
                 Options options;
+                std::shared_ptr<ReadRequest> readRequest;
                 std::promise<VideoData> promise;
-                std::future<VideoData> future;
             };
 
             struct Mutex
             {
                 std::list<std::shared_ptr<InfoRequest> > infoRequests;
                 std::list<std::shared_ptr<VideoRequest> > videoRequests;
+                size_t videoRequestsInProgress = 0;
+                PlaybackHint playbackHint;
                 bool stopped = false;
                 std::mutex mutex;
             };
@@ -54,11 +57,25 @@ namespace tl
 
             struct Thread
             {
-                std::list<std::shared_ptr<VideoRequest> > videoRequestsInProgress;
                 std::chrono::steady_clock::time_point logTimer;
                 std::condition_variable cv;
+                std::condition_variable videoCV;
                 std::thread thread;
+                std::vector<std::thread> workers;
                 std::atomic<bool> running;
+
+                // Workers with an index greater than or equal to the active
+                // count do not take requests.
+                std::atomic<size_t> activeWorkers;
+
+                // Measurements for adjusting the number of threads.
+                std::atomic<size_t> frameCount;
+                std::atomic<uint64_t> frameMicroseconds;
+                std::atomic<bool> idle;
+                std::chrono::steady_clock::time_point throughputTimer;
+                double throughput = 0.0;
+                double frameTime = 0.0;
+                int threadCountDirection = 1;
             };
             Thread thread;
         };
@@ -9,8 +9,13 @@
 #include <tlCore/LogSystem.h>
 #include <tlCore/StringFormat.h>
 
+#include <algorithm>
+#include <condition_variable>
 #include <cstring>
+#include <list>
+#include <mutex>
 #include <sstream>
+#include <thread>
 
 namespace tl
 {
@@ -25,6 +30,28 @@ namespace tl
             std::string extension;
 
             float defaultSpeed = sequenceDefaultSpeed;
+            size_t threadCount = sequenceWriteThreadCount;
+            size_t queueSize = sequenceWriteQueueSize;
+
+            struct Request
+            {
+                std::string fileName;
+                otime::RationalTime time = time::invalidTime;
+                std::shared_ptr<image::Image> image;
+                Options options;
+            };
+
+            struct Mutex
+            {
+                std::list<Request> requests;
+                size_t active = 0;
+                std::string error;
+                bool stopped = false;
+                std::mutex mutex;
+            };
+            Mutex mutex;
+            std::condition_variable cv;
+            std::vector<std::thread> threads;
         };
 
         void ISequenceWrite::_init(
@@ -37,12 +64,33 @@ namespace tl
 
             TLRENDER_P();
 
-            const auto i = options.find("SequenceIO/DefaultSpeed");
+            auto i = options.find("SequenceIO/DefaultSpeed");
             if (i != options.end())
             {
                 std::stringstream ss(i->second);
                 ss >> p.defaultSpeed;
             }
+            i = options.find("SequenceIO/WriteThreadCount");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.threadCount;
+            }
+            i = options.find("SequenceIO/WriteQueueSize");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.queueSize;
+            }
+
+            for (size_t j = 0; j < p.threadCount; ++j)
+            {
+                p.threads.push_back(std::thread(
+                    [this]
+                    {
+                        _thread();
+                    }));
+            }
         }
 
         ISequenceWrite::ISequenceWrite() :
@@ -57,11 +105,137 @@ namespace tl
             const std::shared_ptr<image::Image>& image,
             const Options& options)
         {
-            _writeVideo(
-                _path.get(static_cast<int>(time.value())),
-                time,
-                image,
-                merge(options, _options));
+            TLRENDER_P();
+            if (p.threads.empty())
+            {
+                _writeVideo(
+                    _path.get(static_cast<int>(time.value())),
+                    time,
+                    image,
+                    merge(options, _options));
+                return;
+            }
+
+            Private::Request request;
+            request.fileName = _path.get(static_cast<int>(time.value()));
+            request.time = time;
+            request.image = image;
+            request.options = merge(options, _options);
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            p.cv.wait(
+                lock,
+                [this]
+                {
+                    TLRENDER_P();
+                    return
+                        p.mutex.requests.size() + p.mutex.active < std::max(p.queueSize, p.threads.size()) ||
+                        !p.mutex.error.empty();
+                });
+            if (!p.mutex.error.empty())
+            {
+                throw std::runtime_error(p.mutex.error);
+            }
+            p.mutex.requests.push_back(std::move(request));
+            lock.unlock();
+            p.cv.notify_all();
+        }
+
+        void ISequenceWrite::flush()
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            p.cv.wait(
+                lock,
+                [this]
+                {
+                    TLRENDER_P();
+                    return p.mutex.requests.empty() && 0 == p.mutex.active;
+                });
+            if (!p.mutex.error.empty())
+            {
+                throw std::runtime_error(p.mutex.error);
+            }
+        }
+
+        void ISequenceWrite::_finish()
+        {
+            TLRENDER_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.mutex.stopped = true;
+            }
+            p.cv.notify_all();
+            for (auto& thread : p.threads)
+            {
+                if (thread.joinable())
+                {
+                    thread.join();
+                }
+            }
+            p.threads.clear();
+        }
+
+        void ISequenceWrite::_thread()
+        {
+            TLRENDER_P();
+            while (true)
+            {
+                Private::Request request;
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    p.cv.wait(
+                        lock,
+                        [this]
+                        {
+                            TLRENDER_P();
+                            return !p.mutex.requests.empty() || p.mutex.stopped;
+                        });
+                    if (p.mutex.requests.empty())
+                    {
+                        break;
+                    }
+                    request = std::move(p.mutex.requests.front());
+                    p.mutex.requests.pop_front();
+                    ++p.mutex.active;
+                }
+
+                std::string error;
+                try
+                {
+                    _writeVideo(
+                        request.fileName,
+                        request.time,
+                        request.image,
+                        request.options);
+                }
+                catch (const std::exception& e)
+                {
+                    error = e.what();
+                    if (auto logSystem = _logSystem.lock())
+                    {
+                        const std::string id = string::Format("tl::io::ISequenceWrite ({0}: {1})").
+                            arg(__FILE__).
+                            arg(__LINE__);
+                        logSystem->print(id, string::Format("{0}: {1}").
+                            arg(request.fileName).
+                            arg(error),
+                            log::Type::Error);
+                    }
+                }
+                request.image.reset();
+
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    --p.mutex.active;
+                    if (!error.empty() && p.mutex.error.empty())
+                    {
+                        // Drop the pending frames after the first error.
+                        p.mutex.error = error;
+                        p.mutex.requests.clear();
+                    }
+                }
+                p.cv.notify_all();
+            }
         }
     }
 }
@@ -61,7 +61,8 @@ namespace tl
             std::future<io::Info> getInfo() override;
             std::future<io::VideoData> readVideo(
                 const otime::RationalTime&,
-                const io::Options&) override;
+                const io::Options&,
+                const std::shared_ptr<io::ReadRequest>& = nullptr) override;
             void cancelRequests() override;
 
         private:
@@ -45,7 +45,8 @@ namespace tl
                 int64_t id,
                 const file::Path& path,
                 const otime::RationalTime& time,
-                const io::Options&);
+                const io::Options&,
+                const std::shared_ptr<io::ReadRequest>& = nullptr);
 
             //! Cancel requests.
             void cancelRequests(int64_t id);
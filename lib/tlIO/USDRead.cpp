@@ -57,10 +57,11 @@ namespace tl
         
         std::future<io::VideoData> Read::readVideo(
             const otime::RationalTime& time,
-            const io::Options& options)
+            const io::Options& options,
+            const std::shared_ptr<io::ReadRequest>& readRequest)
         {
             TLRENDER_P();
-            return p.render->render(p.id, _path, time, io::merge(options, _options));
+            return p.render->render(p.id, _path, time, io::merge(options, _options), readRequest);
         }
         
         void Read::cancelRequests()
@@ -56,6 +56,7 @@ namespace tl
                 file::Path path;
                 otime::RationalTime time = time::invalidTime;
                 io::Options options;
+                std::shared_ptr<io::ReadRequest> readRequest;
                 std::promise<io::VideoData> promise;
             };
             
@@ -87,7 +88,7 @@ namespace tl
             struct Thread
             {
                 memory::LRUCache<std::string, StageCacheItem> stageCache;
-                memory::LRUCache<std::string, std::shared_ptr<DiskCacheItem> > diskCache;
+                memory::LRUCache<io::CacheKey, std::shared_ptr<DiskCacheItem> > diskCache;
                 std::string tempDir;
                 std::chrono::steady_clock::time_point logTimer;
                 std::condition_variable cv;
@@ -213,7 +214,8 @@ namespace tl
             int64_t id,
             const file::Path& path,
             const otime::RationalTime& time,
-            const io::Options& options)
+            const io::Options& options,
+            const std::shared_ptr<io::ReadRequest>& readRequest)
         {
             TLRENDER_P();
             auto request = std::make_shared<Private::Request>();
@@ -221,6 +223,7 @@ namespace tl
             request->path = path;
             request->time = time;
             request->options = options;
+            request->readRequest = readRequest;
             auto future = request->promise.get_future();
             bool valid = false;
             {
@@ -238,6 +241,7 @@ namespace tl
             else
             {
                 request->promise.set_value(io::VideoData());
+                io::finished(request->readRequest);
             }
             return future;
         }
@@ -282,7 +286,11 @@ namespace tl
             }
             for (auto& request : requests)
             {
-                request->promise.set_value(io::VideoData());
+                io::VideoData videoData;
+                videoData.time = request->time;
+                videoData.canceled = true;
+                request->promise.set_value(videoData);
+                io::finished(request->readRequest);
             }
         }
                         
@@ -439,6 +447,7 @@ namespace tl
                 // Check requests.
                 std::shared_ptr<Private::InfoRequest> infoRequest;
                 std::shared_ptr<Private::Request> request;
+                std::vector<std::shared_ptr<Private::Request> > canceledRequests;
                 {
                     std::unique_lock<std::mutex> lock(p.mutex.mutex);
                     if (p.thread.cv.wait_for(
@@ -456,6 +465,13 @@ namespace tl
                             infoRequest = p.mutex.infoRequests.front();
                             p.mutex.infoRequests.pop_front();
                         }
+                        // Skip the requests that have been canceled.
+                        while (!p.mutex.requests.empty() &&
+                            io::isCanceled(p.mutex.requests.front()->readRequest))
+                        {
+                            canceledRequests.push_back(p.mutex.requests.front());
+                            p.mutex.requests.pop_front();
+                        }
                         if (!p.mutex.requests.empty())
                         {
                             request = p.mutex.requests.front();
@@ -463,6 +479,14 @@ namespace tl
                         }
                     }
                 }
+                for (auto& canceledRequest : canceledRequests)
+                {
+                    io::VideoData videoData;
+                    videoData.time = canceledRequest->time;
+                    videoData.canceled = true;
+                    canceledRequest->promise.set_value(videoData);
+                    io::finished(canceledRequest->readRequest);
+                }
 
                 // Set options.
                 io::Options ioOptions;
@@ -563,7 +587,7 @@ namespace tl
                 io::VideoData videoData;
                 if (request && p.cache)
                 {
-                    const std::string cacheKey = io::getCacheKey(
+                    const io::CacheKey cacheKey = io::getCacheKey(
                         request->path,
                         request->time,
                         ioOptions,
@@ -571,6 +595,7 @@ namespace tl
                     if (p.cache->getVideo(cacheKey, videoData))
                     {
                         request->promise.set_value(videoData);
+                        io::finished(request->readRequest);
                         request.reset();
                     }
                 }
@@ -579,7 +604,7 @@ namespace tl
                 if (request)
                 {
                     std::shared_ptr<Private::DiskCacheItem> diskCacheItem;
-                    const std::string cacheKey = io::getCacheKey(
+                    const io::CacheKey cacheKey = io::getCacheKey(
                         request->path,
                         request->time,
                         ioOptions,
@@ -616,6 +641,7 @@ namespace tl
                         videoData.time = request->time;
                         videoData.image = image;
                         request->promise.set_value(videoData);
+                        io::finished(request->readRequest);
 
                         if (p.cache)
                         {
@@ -630,7 +656,7 @@ namespace tl
                 if (request)
                 {
                     std::shared_ptr<image::Image> image;
-                    const std::string cacheKey = io::getCacheKey(
+                    const io::CacheKey cacheKey = io::getCacheKey(
                         request->path,
                         request->time,
                         ioOptions,
@@ -842,6 +868,7 @@ namespace tl
                     videoData.time = request->time;
                     videoData.image = image;
                     request->promise.set_value(videoData);
+                    io::finished(request->readRequest);
 
                     if (p.cache)
                     {
@@ -898,7 +925,11 @@ namespace tl
             }
             for (auto& request : requests)
             {
-                request->promise.set_value(io::VideoData());
+                io::VideoData videoData;
+                videoData.time = request->time;
+                videoData.canceled = true;
+                request->promise.set_value(videoData);
+                io::finished(request->readRequest);
             }
         }
     }
@@ -4,6 +4,13 @@
 
 #include <tlPlay/App.h>
 
+#include <tlUI/ThumbnailSystem.h>
+
+#include <tlIO/DiskCache.h>
+#include <tlIO/PersistentCache.h>
+#include <tlIO/System.h>
+
+#include <tlCore/File.h>
 #include <tlCore/StringFormat.h>
 
 namespace tl
@@ -107,6 +114,21 @@ namespace tl
                     "LUT operation order.",
                     string::Format("{0}").arg(options.lutOptions.order),
                     string::join(timeline::getLUTOrderLabels(), ", ")),
+                app::CmdLineValueOption<size_t>::create(
+                    options.diskCache,
+                    { "-diskCache" },
+                    "Disk cache size in gigabytes. Frames evicted from the memory cache are written to the disk cache. A size of zero disables the disk cache.",
+                    string::Format("{0}").arg(options.diskCache)),
+                app::CmdLineValueOption<std::string>::create(
+                    options.diskCachePath,
+                    { "-diskCachePath" },
+                    "Disk cache directory. Thumbnails, file information, and audio waveform peaks are also stored in this directory so they can be reused.",
+                    file::getTemp()),
+                app::CmdLineValueOption<size_t>::create(
+                    options.thumbnailCache,
+                    { "-thumbnailCache" },
+                    "Persistent thumbnail cache size in gigabytes. The cache is stored in the disk cache directory. A size of zero disables the persistent thumbnail cache.",
+                    string::Format("{0}").arg(options.thumbnailCache)),
 #if defined(TLRENDER_USD)
                 app::CmdLineValueOption<int>::create(
                     options.usdRenderWidth,
@@ -161,5 +183,48 @@ namespace tl
                     string::Format("{0}").arg(settingsFileName)),
             };
         }
+
+        void diskCacheInit(
+            const Options& options,
+            const std::shared_ptr<system::Context>& context)
+        {
+            if (options.diskCache > 0)
+            {
+                try
+                {
+                    auto diskCache = io::DiskCache::create(
+                        !options.diskCachePath.empty() ? options.diskCachePath : file::getTemp(),
+                        options.diskCache * memory::gigabyte);
+                    context->getSystem<io::System>()->getCache()->setDiskCache(diskCache);
+                    context->log(
+                        std::string(),
+                        string::Format("Disk cache: {0}").arg(diskCache->getPath()));
+                }
+                catch (const std::exception& e)
+                {
+                    context->log(std::string(), e.what(), log::Type::Error);
+                }
+            }
+            if (!options.diskCachePath.empty() && options.thumbnailCache > 0)
+            {
+                if (auto thumbnailSystem = context->getSystem<ui::ThumbnailSystem>())
+                {
+                    try
+                    {
+                        auto persistentCache = io::PersistentCache::create(
+                            file::Path(options.diskCachePath, "tlRenderThumbnails").get(),
+                            options.thumbnailCache * memory::gigabyte);
+                        thumbnailSystem->getCache()->setPersistentCache(persistentCache);
+                        context->log(
+                            std::string(),
+                            string::Format("Thumbnail cache: {0}").arg(persistentCache->getPath()));
+                    }
+                    catch (const std::exception& e)
+                    {
+                        context->log(std::string(), e.what(), log::Type::Error);
+                    }
+                }
+            }
+        }
     }
 }
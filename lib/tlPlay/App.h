@@ -33,6 +33,9 @@ namespace tl
             otime::TimeRange inOutRange = time::invalidTimeRange;
             timeline::OCIOOptions ocioOptions;
             timeline::LUTOptions lutOptions;
+            size_t diskCache = 0;
+            std::string diskCachePath;
+            size_t thumbnailCache = 1;
 
 #if defined(TLRENDER_USD)
             int usdRenderWidth = 1920;
@@ -57,5 +60,11 @@ namespace tl
             Options&,
             const std::string& logFileName,
             const std::string& settingsFileName);
+
+        //! Initialize the I/O disk cache and the persistent thumbnail cache
+        //! from the application options.
+        void diskCacheInit(
+            const Options&,
+            const std::shared_ptr<system::Context>&);
     }
 }
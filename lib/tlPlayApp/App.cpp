@@ -121,6 +121,7 @@ namespace tl
 
             _fileLogInit(logFileName);
             _settingsInit(settingsFileName);
+            play::diskCacheInit(p.options, _context);
             _modelsInit();
             _devicesInit();
             _observersInit();
@@ -384,6 +385,7 @@ namespace tl
 #if defined(TLRENDER_FFMPEG)
             p.settings->setDefaultValue("FFmpeg/YUVToRGBConversion", false);
             p.settings->setDefaultValue("FFmpeg/ThreadCount", 0);
+            p.settings->setDefaultValue("FFmpeg/VideoDecoderCount", 1);
 #endif // TLRENDER_FFMPEG
 
 #if defined(TLRENDER_USD)
@@ -743,6 +745,8 @@ namespace tl
                 arg(p.settings->getValue<bool>("FFmpeg/YUVToRGBConversion"));
             out["FFmpeg/ThreadCount"] = string::Format("{0}").
                 arg(p.settings->getValue<int>("FFmpeg/ThreadCount"));
+            out["FFmpeg/VideoDecoderCount"] = string::Format("{0}").
+                arg(p.settings->getValue<int>("FFmpeg/VideoDecoderCount"));
 #endif // TLRENDER_FFMPEG
 
 #if defined(TLRENDER_USD)
@@ -200,7 +200,7 @@ namespace tl
             p.maxDigitsEdit = ui::IntEdit::create(context);
 
             p.threadsEdit = ui::IntEdit::create(context);
-            p.threadsEdit->setRange(math::IntRange(1, 64));
+            p.threadsEdit->setRange(math::IntRange(0, 64));
 
             p.layout = ui::GridLayout::create(context, shared_from_this());
             p.layout->setMarginRole(ui::SizeRole::MarginSmall);
@@ -334,6 +334,7 @@ namespace tl
 
             std::shared_ptr<ui::CheckBox> yuvToRGBCheckBox;
             std::shared_ptr<ui::IntEdit> threadsEdit;
+            std::shared_ptr<ui::IntEdit> videoDecodersEdit;
             std::shared_ptr<ui::VerticalLayout> layout;
 
             std::shared_ptr<observer::ValueObserver<std::string> > settingsObserver;
@@ -354,6 +355,9 @@ namespace tl
             p.threadsEdit = ui::IntEdit::create(context);
             p.threadsEdit->setRange(math::IntRange(0, 64));
 
+            p.videoDecodersEdit = ui::IntEdit::create(context);
+            p.videoDecodersEdit->setRange(math::IntRange(1, 16));
+
             p.layout = ui::VerticalLayout::create(context, shared_from_this());
             p.layout->setMarginRole(ui::SizeRole::MarginSmall);
             p.layout->setSpacingRole(ui::SizeRole::SpacingSmall);
@@ -368,6 +372,10 @@ namespace tl
             gridLayout->setGridPos(label, 1, 0);
             p.threadsEdit->setParent(gridLayout);
             gridLayout->setGridPos(p.threadsEdit, 1, 1);
+            label = ui::Label::create("Video decoders:", context, gridLayout);
+            gridLayout->setGridPos(label, 2, 0);
+            p.videoDecodersEdit->setParent(gridLayout);
+            gridLayout->setGridPos(p.videoDecodersEdit, 2, 1);
 
             _settingsUpdate(std::string());
 
@@ -389,6 +397,12 @@ namespace tl
                 {
                     _p->settings->setValue("FFmpeg/ThreadCount", value);
                 });
+
+            p.videoDecodersEdit->setCallback(
+                [this](int value)
+                {
+                    _p->settings->setValue("FFmpeg/VideoDecoderCount", value);
+                });
         }
 
         FFmpegSettingsWidget::FFmpegSettingsWidget() :
@@ -433,6 +447,11 @@ namespace tl
                 p.threadsEdit->setValue(
                     p.settings->getValue<size_t>("FFmpeg/ThreadCount"));
             }
+            if ("FFmpeg/VideoDecoderCount" == name || name.empty())
+            {
+                p.videoDecodersEdit->setValue(
+                    p.settings->getValue<size_t>("FFmpeg/VideoDecoderCount"));
+            }
         }
 
 #endif // TLRENDER_FFMPEG
@@ -162,7 +162,7 @@ namespace tl
             p.maxDigitsSpinBox->setRange(0, 255);
 
             p.threadCountSpinBox = new QSpinBox;
-            p.threadCountSpinBox->setRange(1, 64);
+            p.threadCountSpinBox->setRange(0, 64);
 
             auto layout = new QFormLayout;
             layout->addRow(tr("Audio:"), p.audioComboBox);
@@ -273,6 +273,7 @@ namespace tl
 
             QCheckBox* yuvToRGBConversionCheckBox = nullptr;
             QSpinBox* threadCountSpinBox = nullptr;
+            QSpinBox* videoDecoderCountSpinBox = nullptr;
 
             std::shared_ptr<observer::ValueObserver<std::string> > settingsObserver;
         };
@@ -290,12 +291,16 @@ namespace tl
             p.threadCountSpinBox = new QSpinBox;
             p.threadCountSpinBox->setRange(0, 64);
 
+            p.videoDecoderCountSpinBox = new QSpinBox;
+            p.videoDecoderCountSpinBox->setRange(1, 16);
+
             auto layout = new QFormLayout;
             auto label = new QLabel(tr("Changes are applied to new files."));
             label->setWordWrap(true);
             layout->addRow(label);
             layout->addRow(tr("YUV to RGB conversion:"), p.yuvToRGBConversionCheckBox);
             layout->addRow(tr("I/O threads:"), p.threadCountSpinBox);
+            layout->addRow(tr("Video decoders:"), p.videoDecoderCountSpinBox);
             setLayout(layout);
 
             _settingsUpdate(std::string());
@@ -322,6 +327,14 @@ namespace tl
                 {
                     _p->settings->setValue("FFmpeg/ThreadCount", value);
                 });
+
+            connect(
+                p.videoDecoderCountSpinBox,
+                QOverload<int>::of(&QSpinBox::valueChanged),
+                [this](int value)
+                {
+                    _p->settings->setValue("FFmpeg/VideoDecoderCount", value);
+                });
         }
 
         FFmpegSettingsWidget::~FFmpegSettingsWidget()
@@ -342,6 +355,12 @@ namespace tl
                 p.threadCountSpinBox->setValue(
                     p.settings->getValue<int>("FFmpeg/ThreadCount"));
             }
+            if ("FFmpeg/VideoDecoderCount" == name || name.empty())
+            {
+                QSignalBlocker signalBlocker(p.videoDecoderCountSpinBox);
+                p.videoDecoderCountSpinBox->setValue(
+                    p.settings->getValue<int>("FFmpeg/VideoDecoderCount"));
+            }
         }
 #endif // TLRENDER_FFMPEG
 
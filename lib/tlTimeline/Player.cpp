@@ -71,6 +71,8 @@ namespace tl
                     arg(playerOptions.cache.readAhead));
                 lines.push_back(string::Format("    Cache read behind: {0}").
                     arg(playerOptions.cache.readBehind));
+                lines.push_back(string::Format("    Cache video size: {0}MB").
+                    arg(playerOptions.cache.videoByteCount / memory::megabyte));
                 lines.push_back(string::Format("    Timer mode: {0}").
                     arg(playerOptions.timerMode));
                 lines.push_back(string::Format("    Audio buffer frame count: {0}").
@@ -126,7 +128,14 @@ namespace tl
             p.mutex.audioOffset = p.audioOffset->get();
             p.mutex.cacheOptions = p.cacheOptions->get();
             p.mutex.cacheInfo = p.cacheInfo->get();
+            p.mutex.prefetchPolicies.push_back(ScrubPrefetchPolicy::create());
+            p.mutex.prefetchPolicies.push_back(StructurePrefetchPolicy::create());
+            p.mutex.prefetchPoliciesChanged = true;
             p.audioMutex.speed = p.speed->get();
+            p.readyQueue = std::make_shared<Private::ReadyQueue>();
+            p.audioThread.output = false;
+            p.audioThread.flush = false;
+            p.audioThread.underrunCount = 0;
 #if defined(TLRENDER_AUDIO)
             try
             {
@@ -164,6 +173,9 @@ namespace tl
                                 p.audioThread.info.dataType != audio::DataType::None &&
                                 p.audioThread.info.sampleRate > 0)
                             {
+                                p.audioThread.ringBuffer = audio::AudioRingBuffer::create(
+                                    p.audioThread.info,
+                                    p.playerOptions.audioBufferFrameCount * 4);
                                 try
                                 {
                                     RtAudio::StreamParameters rtParameters;
@@ -182,6 +194,20 @@ namespace tl
                                         nullptr,
                                         p.rtAudioErrorCallback);
                                     p.thread.rtAudio->startStream();
+
+                                    // Start the audio thread.
+                                    p.audioThread.thread = std::thread(
+                                        [this]
+                                        {
+                                            TLRENDER_P();
+                                            while (p.running)
+                                            {
+                                                const auto t0 = std::chrono::steady_clock::now();
+                                                p.audioUpdate();
+                                                const auto t1 = std::chrono::steady_clock::now();
+                                                time::sleep(p.playerOptions.sleepTimeout, t0, t1);
+                                            }
+                                        });
                                 }
                                 catch (const std::exception& e)
                                 {
@@ -204,6 +230,8 @@ namespace tl
                         std::vector<std::shared_ptr<Timeline> > compare;
                         bool clearRequests = false;
                         bool clearCache = false;
+                        std::vector<std::shared_ptr<IPrefetchPolicy> > prefetchPolicies;
+                        bool prefetchPoliciesChanged = false;
                         {
                             std::unique_lock<std::mutex> lock(p.mutex.mutex);
                             p.thread.playback = p.mutex.playback;
@@ -221,6 +249,12 @@ namespace tl
                             p.mutex.clearCache = false;
                             p.thread.cacheDirection = p.mutex.cacheDirection;
                             p.thread.cacheOptions = p.mutex.cacheOptions;
+                            prefetchPoliciesChanged = p.mutex.prefetchPoliciesChanged;
+                            p.mutex.prefetchPoliciesChanged = false;
+                            if (prefetchPoliciesChanged)
+                            {
+                                prefetchPolicies = p.mutex.prefetchPolicies;
+                            }
                         }
 
                         // Clear requests.
@@ -236,6 +270,17 @@ namespace tl
                             p.clearCache();
                         }
 
+                        // Update the prefetch policies.
+                        if (prefetchPoliciesChanged)
+                        {
+                            p.thread.prefetchPolicies = prefetchPolicies;
+                            p.thread.prefetchChanged = true;
+                            for (const auto& policy : p.thread.prefetchPolicies)
+                            {
+                                policy->setTimeline(p.timeline);
+                            }
+                        }
+
                         // Update the cache.
                         p.cacheUpdate();
 
@@ -333,6 +378,10 @@ namespace tl
             {
                 p.thread.thread.join();
             }
+            if (p.audioThread.thread.joinable())
+            {
+                p.audioThread.thread.join();
+            }
 #if defined(TLRENDER_AUDIO)
             if (p.thread.rtAudio && p.thread.rtAudio->isStreamOpen())
             {
@@ -891,6 +940,11 @@ namespace tl
             return _p->currentAudioData;
         }
 
+        size_t Player::getAudioUnderrunCount() const
+        {
+            return _p->audioThread.underrunCount;
+        }
+
         const PlayerCacheOptions& Player::getCacheOptions() const
         {
             return _p->cacheOptions->get();
@@ -924,6 +978,28 @@ namespace tl
             p.mutex.clearCache = true;
         }
 
+        std::vector<std::shared_ptr<IPrefetchPolicy> > Player::getPrefetchPolicies() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            return p.mutex.prefetchPolicies;
+        }
+
+        void Player::setPrefetchPolicies(const std::vector<std::shared_ptr<IPrefetchPolicy> >& value)
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            p.mutex.prefetchPolicies = value;
+            p.mutex.prefetchPoliciesChanged = true;
+        }
+
+        PlayerPrefetchStats Player::getPrefetchStats() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            return p.mutex.prefetchStats;
+        }
+
         void Player::tick()
         {
             TLRENDER_P();
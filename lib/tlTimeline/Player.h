@@ -6,6 +6,7 @@
 
 #include <tlTimeline/CompareOptions.h>
 #include <tlTimeline/PlayerOptions.h>
+#include <tlTimeline/PlayerPrefetch.h>
 #include <tlTimeline/Timeline.h>
 
 #include <tlCore/ListObserver.h>
@@ -26,6 +27,12 @@ namespace tl
             //! Cached audio frames.
             std::vector<otime::TimeRange> audioFrames;
 
+            //! Cached video size in bytes.
+            size_t videoByteCount = 0;
+
+            //! Cached audio size in bytes.
+            size_t audioByteCount = 0;
+
             bool operator == (const PlayerCacheInfo&) const;
             bool operator != (const PlayerCacheInfo&) const;
         };
@@ -142,7 +149,10 @@ namespace tl
             //! Observe the playback speed.
             std::shared_ptr<observer::IValue<double> > observeSpeed() const;
 
-            //! Set the playback speed.
+            //! Set the playback speed. Audio is time stretched to keep the
+            //! pitch when the speed is between audio::timeStretchSpeedMin
+            //! and audio::timeStretchSpeedMax times the default speed, and
+            //! muted otherwise.
             void setSpeed(double);
 
             //! Get the playback mode.
@@ -322,6 +332,9 @@ namespace tl
             //! Observe the current audio data.
             std::shared_ptr<observer::IList<AudioData> > observeCurrentAudio() const;
 
+            //! Get the number of times the audio output ran out of data.
+            size_t getAudioUnderrunCount() const;
+
             ///@}
 
             //! \name Cache
@@ -344,6 +357,21 @@ namespace tl
 
             ///@}
 
+            //! \name Prefetch
+            ///@{
+
+            //! Get the prefetch policies.
+            std::vector<std::shared_ptr<IPrefetchPolicy> > getPrefetchPolicies() const;
+
+            //! Set the prefetch policies. By default the scrub and structure
+            //! prefetch policies are used.
+            void setPrefetchPolicies(const std::vector<std::shared_ptr<IPrefetchPolicy> >&);
+
+            //! Get the prefetch statistics.
+            PlayerPrefetchStats getPrefetchStats() const;
+
+            ///@}
+
             //! Tick the timeline player.
             void tick();
 
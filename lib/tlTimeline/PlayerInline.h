@@ -11,7 +11,9 @@ namespace tl
             return
                 videoPercentage == other.videoPercentage &&
                 videoFrames == other.videoFrames &&
-                audioFrames == other.audioFrames;
+                audioFrames == other.audioFrames &&
+                videoByteCount == other.videoByteCount &&
+                audioByteCount == other.audioByteCount;
         }
 
         inline bool PlayerCacheInfo::operator != (const PlayerCacheInfo& other) const
@@ -31,6 +31,17 @@ namespace tl
             //! Cache read behind.
             otime::RationalTime readBehind = otime::RationalTime(0.5, 1.0);
 
+            //! Maximum video cache size in bytes. When this is non-zero the
+            //! read ahead and read behind are adjusted to the number of
+            //! frames that fit, keeping their ratio. The frame size is
+            //! measured from the cached video, including compare timelines.
+            size_t videoByteCount = 0;
+
+            //! Maximum number of frames to prefetch while playback is
+            //! stopped. Zero disables prefetching. The prefetched frames
+            //! are counted in the video cache size.
+            size_t prefetchCount = 8;
+
             bool operator == (const PlayerCacheOptions&) const;
             bool operator != (const PlayerCacheOptions&) const;
         };
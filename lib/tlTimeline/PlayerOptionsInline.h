@@ -10,7 +10,9 @@ namespace tl
         {
             return
                 readAhead == other.readAhead &&
-                readBehind == other.readBehind;
+                readBehind == other.readBehind &&
+                videoByteCount == other.videoByteCount &&
+                prefetchCount == other.prefetchCount;
         }
 
         inline bool PlayerCacheOptions::operator != (const PlayerCacheOptions& other) const
@@ -0,0 +1,246 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlTimeline/PlayerPrefetch.h>
+
+#include <tlTimeline/Timeline.h>
+
+#include <opentimelineio/clip.h>
+#include <opentimelineio/marker.h>
+#include <opentimelineio/stack.h>
+#include <opentimelineio/track.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace tl
+{
+    namespace timeline
+    {
+        IPrefetchPolicy::IPrefetchPolicy()
+        {}
+
+        IPrefetchPolicy::~IPrefetchPolicy()
+        {}
+
+        void IPrefetchPolicy::setTimeline(const std::shared_ptr<Timeline>&)
+        {}
+
+        void IPrefetchPolicy::timeUpdate(
+            const otime::RationalTime&,
+            const std::chrono::steady_clock::time_point&)
+        {}
+
+        struct ScrubPrefetchPolicy::Private
+        {
+            double lookAhead = .5;
+            double velocity = 0.0;
+            otime::RationalTime time = time::invalidTime;
+            std::chrono::steady_clock::time_point timePoint;
+        };
+
+        ScrubPrefetchPolicy::ScrubPrefetchPolicy() :
+            _p(new Private)
+        {}
+
+        ScrubPrefetchPolicy::~ScrubPrefetchPolicy()
+        {}
+
+        std::shared_ptr<ScrubPrefetchPolicy> ScrubPrefetchPolicy::create()
+        {
+            return std::shared_ptr<ScrubPrefetchPolicy>(new ScrubPrefetchPolicy);
+        }
+
+        double ScrubPrefetchPolicy::getVelocity() const
+        {
+            return _p->velocity;
+        }
+
+        double ScrubPrefetchPolicy::getLookAhead() const
+        {
+            return _p->lookAhead;
+        }
+
+        void ScrubPrefetchPolicy::setLookAhead(double value)
+        {
+            _p->lookAhead = value;
+        }
+
+        void ScrubPrefetchPolicy::timeUpdate(
+            const otime::RationalTime& time,
+            const std::chrono::steady_clock::time_point& timePoint)
+        {
+            TLRENDER_P();
+            if (time::isValid(p.time))
+            {
+                const std::chrono::duration<double> diff = timePoint - p.timePoint;
+                if (diff.count() > 0.0 && diff.count() < .25)
+                {
+                    // Smooth the velocity since the time changes are
+                    // irregular.
+                    const double velocity = (time - p.time).to_seconds() / diff.count();
+                    p.velocity = p.velocity * .5 + velocity * .5;
+                }
+                else
+                {
+                    // A long pause starts a new scrub.
+                    p.velocity = 0.0;
+                }
+            }
+            p.time = time;
+            p.timePoint = timePoint;
+        }
+
+        std::vector<otime::RationalTime> ScrubPrefetchPolicy::getPrefetch(
+            const otime::RationalTime& currentTime,
+            const otime::TimeRange& inOutRange,
+            size_t count)
+        {
+            TLRENDER_P();
+            std::vector<otime::RationalTime> out;
+            const double rate = currentTime.rate();
+            if (count > 0 && std::fabs(p.velocity) * p.lookAhead >= 1.0 / rate)
+            {
+                for (size_t i = 1; i <= count; ++i)
+                {
+                    const double offset = p.velocity * p.lookAhead * i / static_cast<double>(count);
+                    otime::RationalTime t = (currentTime + otime::RationalTime(offset, 1.0)).
+                        rescaled_to(rate).
+                        round();
+                    t = std::max(t, inOutRange.start_time());
+                    t = std::min(t, inOutRange.end_time_inclusive());
+                    if (t != currentTime &&
+                        std::find(out.begin(), out.end(), t) == out.end())
+                    {
+                        out.push_back(t);
+                    }
+                }
+            }
+            return out;
+        }
+
+        struct StructurePrefetchPolicy::Private
+        {
+            std::vector<otime::RationalTime> targets;
+        };
+
+        StructurePrefetchPolicy::StructurePrefetchPolicy() :
+            _p(new Private)
+        {}
+
+        StructurePrefetchPolicy::~StructurePrefetchPolicy()
+        {}
+
+        std::shared_ptr<StructurePrefetchPolicy> StructurePrefetchPolicy::create()
+        {
+            return std::shared_ptr<StructurePrefetchPolicy>(new StructurePrefetchPolicy);
+        }
+
+        const std::vector<otime::RationalTime>& StructurePrefetchPolicy::getTargets() const
+        {
+            return _p->targets;
+        }
+
+        namespace
+        {
+            void addMarkers(
+                const otio::Item* item,
+                const otime::RationalTime& start,
+                std::vector<otime::RationalTime>& out)
+            {
+                // The markers are in the item's time, so convert them to
+                // the parent time.
+                const otime::RationalTime itemStart = item->trimmed_range().start_time();
+                for (const auto& marker : item->markers())
+                {
+                    out.push_back(start + (marker->marked_range().start_time() - itemStart));
+                }
+            }
+        }
+
+        void StructurePrefetchPolicy::setTimeline(const std::shared_ptr<Timeline>& timeline)
+        {
+            TLRENDER_P();
+            p.targets.clear();
+            if (!timeline)
+                return;
+            const otime::TimeRange& timeRange = timeline->getTimeRange();
+            const auto& otioTimeline = timeline->getTimeline();
+            std::vector<otime::RationalTime> targets;
+            targets.push_back(timeRange.start_time());
+            targets.push_back(timeRange.end_time_inclusive());
+            if (otioTimeline.value && otioTimeline.value->tracks())
+            {
+                addMarkers(otioTimeline.value->tracks(), timeRange.start_time(), targets);
+                for (const auto& i : otioTimeline.value->tracks()->children())
+                {
+                    if (auto otioTrack = dynamic_cast<const otio::Track*>(i.value))
+                    {
+                        addMarkers(otioTrack, timeRange.start_time(), targets);
+                        for (const auto& j : otioTrack->children())
+                        {
+                            if (auto otioClip = dynamic_cast<const otio::Clip*>(j.value))
+                            {
+                                const auto rangeOpt = otioClip->trimmed_range_in_parent();
+                                if (rangeOpt.has_value())
+                                {
+                                    const otime::RationalTime start =
+                                        timeRange.start_time() + rangeOpt.value().start_time();
+                                    targets.push_back(start);
+                                    addMarkers(otioClip, start, targets);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+            for (auto& t : targets)
+            {
+                t = t.rescaled_to(timeRange.duration().rate()).floor();
+            }
+            std::sort(targets.begin(), targets.end());
+            targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+            p.targets = targets;
+        }
+
+        std::vector<otime::RationalTime> StructurePrefetchPolicy::getPrefetch(
+            const otime::RationalTime& currentTime,
+            const otime::TimeRange& inOutRange,
+            size_t count)
+        {
+            TLRENDER_P();
+
+            // Get the targets closest to the current time.
+            std::vector<otime::RationalTime> targets;
+            for (const auto& t : p.targets)
+            {
+                if (inOutRange.contains(t))
+                {
+                    targets.push_back(t);
+                }
+            }
+            targets.push_back(inOutRange.start_time());
+            targets.push_back(inOutRange.end_time_inclusive());
+            std::sort(
+                targets.begin(),
+                targets.end(),
+                [currentTime](const otime::RationalTime& a, const otime::RationalTime& b)
+                {
+                    return std::fabs((a - currentTime).to_seconds()) <
+                        std::fabs((b - currentTime).to_seconds());
+                });
+            std::vector<otime::RationalTime> out;
+            for (size_t i = 0; i < targets.size() && out.size() < count; ++i)
+            {
+                const otime::RationalTime t = targets[i].rescaled_to(currentTime.rate());
+                if (t != currentTime &&
+                    std::find(out.begin(), out.end(), t) == out.end())
+                {
+                    out.push_back(t);
+                }
+            }
+            return out;
+        }
+    }
+}
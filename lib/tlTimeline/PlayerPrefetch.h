@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlCore/Time.h>
+#include <tlCore/Util.h>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace tl
+{
+    namespace timeline
+    {
+        class Timeline;
+
+        //! Timeline player prefetch statistics. The statistics are counted
+        //! each time the current time changes.
+        struct PlayerPrefetchStats
+        {
+            //! Current frames found in the cache.
+            size_t hitCount = 0;
+
+            //! Current frames found in the prefetch cache or in prefetch
+            //! requests.
+            size_t prefetchHitCount = 0;
+
+            //! Current frames that were not cached.
+            size_t missCount = 0;
+
+            //! Prefetch requests.
+            size_t requestCount = 0;
+
+            //! Get the percentage of current frames that were cached or
+            //! prefetched.
+            float getHitPercentage() const;
+
+            bool operator == (const PlayerPrefetchStats&) const;
+            bool operator != (const PlayerPrefetchStats&) const;
+        };
+
+        //! Base class for prefetch policies.
+        //!
+        //! Prefetch policies predict the times that will be needed outside
+        //! of the cache read ahead and read behind, for example when the
+        //! timeline is scrubbed or the user jumps between clips. The player
+        //! reads the predicted frames with a low priority while playback is
+        //! stopped. The functions are called from the player thread.
+        class IPrefetchPolicy : public std::enable_shared_from_this<IPrefetchPolicy>
+        {
+            TLRENDER_NON_COPYABLE(IPrefetchPolicy);
+
+        protected:
+            IPrefetchPolicy();
+
+        public:
+            virtual ~IPrefetchPolicy() = 0;
+
+            //! Set the timeline. This is also called when the timeline is
+            //! changed.
+            virtual void setTimeline(const std::shared_ptr<Timeline>&);
+
+            //! Called when the current time changes while playback is
+            //! stopped.
+            virtual void timeUpdate(
+                const otime::RationalTime&,
+                const std::chrono::steady_clock::time_point&);
+
+            //! Get the times to prefetch in priority order.
+            virtual std::vector<otime::RationalTime> getPrefetch(
+                const otime::RationalTime& currentTime,
+                const otime::TimeRange& inOutRange,
+                size_t count) = 0;
+        };
+
+        //! Prefetch policy that follows the scrub velocity.
+        //!
+        //! The velocity is measured from the time changes, and the frames
+        //! are predicted where the scrub will be over the look ahead time.
+        class ScrubPrefetchPolicy : public IPrefetchPolicy
+        {
+        protected:
+            ScrubPrefetchPolicy();
+
+        public:
+            virtual ~ScrubPrefetchPolicy();
+
+            //! Create a new prefetch policy.
+            static std::shared_ptr<ScrubPrefetchPolicy> create();
+
+            //! Get the scrub velocity (timeline seconds per second).
+            double getVelocity() const;
+
+            //! Get the look ahead time in seconds.
+            double getLookAhead() const;
+
+            //! Set the look ahead time in seconds.
+            void setLookAhead(double);
+
+            void timeUpdate(
+                const otime::RationalTime&,
+                const std::chrono::steady_clock::time_point&) override;
+            std::vector<otime::RationalTime> getPrefetch(
+                const otime::RationalTime& currentTime,
+                const otime::TimeRange& inOutRange,
+                size_t count) override;
+
+        private:
+            TLRENDER_PRIVATE();
+        };
+
+        //! Prefetch policy that follows the timeline structure.
+        //!
+        //! The frames are predicted at the likely jump targets closest to
+        //! the current time: the clip start times, the markers, the in/out
+        //! points, and the start and end of the timeline.
+        class StructurePrefetchPolicy : public IPrefetchPolicy
+        {
+        protected:
+            StructurePrefetchPolicy();
+
+        public:
+            virtual ~StructurePrefetchPolicy();
+
+            //! Create a new prefetch policy.
+            static std::shared_ptr<StructurePrefetchPolicy> create();
+
+            //! Get the jump targets from the timeline, in ascending order.
+            const std::vector<otime::RationalTime>& getTargets() const;
+
+            void setTimeline(const std::shared_ptr<Timeline>&) override;
+            std::vector<otime::RationalTime> getPrefetch(
+                const otime::RationalTime& currentTime,
+                const otime::TimeRange& inOutRange,
+                size_t count) override;
+
+        private:
+            TLRENDER_PRIVATE();
+        };
+    }
+}
+
+#include <tlTimeline/PlayerPrefetchInline.h>
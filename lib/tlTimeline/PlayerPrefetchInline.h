@@ -0,0 +1,31 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+namespace tl
+{
+    namespace timeline
+    {
+        inline float PlayerPrefetchStats::getHitPercentage() const
+        {
+            const size_t count = hitCount + prefetchHitCount + missCount;
+            return count > 0 ?
+                ((hitCount + prefetchHitCount) / static_cast<float>(count) * 100.F) :
+                0.F;
+        }
+
+        inline bool PlayerPrefetchStats::operator == (const PlayerPrefetchStats& other) const
+        {
+            return
+                hitCount == other.hitCount &&
+                prefetchHitCount == other.prefetchHitCount &&
+                missCount == other.missCount &&
+                requestCount == other.requestCount;
+        }
+
+        inline bool PlayerPrefetchStats::operator != (const PlayerPrefetchStats& other) const
+        {
+            return !(*this == other);
+        }
+    }
+}
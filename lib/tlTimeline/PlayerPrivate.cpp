@@ -8,10 +8,60 @@
 
 #include <tlCore/StringFormat.h>
 
+#include <algorithm>
+
 namespace tl
 {
     namespace timeline
     {
+        namespace
+        {
+            size_t getByteCount(const std::vector<VideoData>& value)
+            {
+                size_t out = 0;
+                for (const auto& videoData : value)
+                {
+                    for (const auto& layer : videoData.layers)
+                    {
+                        if (layer.image)
+                        {
+                            out += layer.image->getDataByteCount();
+                        }
+                        if (layer.imageB)
+                        {
+                            out += layer.imageB->getDataByteCount();
+                        }
+                    }
+                }
+                return out;
+            }
+
+            size_t getByteCount(const AudioData& value)
+            {
+                size_t out = 0;
+                for (const auto& layer : value.layers)
+                {
+                    if (layer.audio)
+                    {
+                        out += layer.audio->getByteCount();
+                    }
+                }
+                return out;
+            }
+
+            bool isCanceled(const std::vector<VideoData>& value)
+            {
+                for (const auto& videoData : value)
+                {
+                    if (videoData.canceled)
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            }
+        }
+
         otime::RationalTime Player::Private::loopPlayback(const otime::RationalTime& time)
         {
             otime::RationalTime out = time;
@@ -121,11 +171,40 @@ namespace tl
             }
             thread.videoDataRequests.clear();
             thread.audioDataRequests.clear();
+            thread.cacheRangesChanged = true;
         }
 
         void Player::Private::clearCache()
         {
             thread.videoDataCache.clear();
+            thread.videoDataCacheByteCount = 0;
+            thread.videoCacheFrames.clear();
+            thread.audioDataCacheByteCount = 0;
+            thread.audioCacheSeconds.clear();
+            thread.cacheRangesChanged = true;
+
+            // Cancel the prefetch requests and update the policies, since
+            // the timeline or the options may have changed.
+            std::vector<std::vector<uint64_t> > ids(1 + thread.compare.size());
+            for (const auto& i : thread.prefetchRequests)
+            {
+                for (size_t j = 0; j < i.second.size() && j < ids.size(); ++j)
+                {
+                    ids[j].push_back(i.second[j].id);
+                }
+            }
+            timeline->cancelRequests(ids[0]);
+            for (size_t i = 0; i < thread.compare.size(); ++i)
+            {
+                thread.compare[i]->cancelRequests(ids[i + 1]);
+            }
+            thread.prefetchRequests.clear();
+            thread.prefetchCache.clear();
+            thread.prefetchChanged = true;
+            for (const auto& policy : thread.prefetchPolicies)
+            {
+                policy->setTimeline(timeline);
+            }
             {
                 std::unique_lock<std::mutex> lock(mutex.mutex);
                 mutex.cacheInfo = PlayerCacheInfo();
@@ -136,6 +215,58 @@ namespace tl
             }
         }
 
+        size_t Player::Private::getVideoFrameByteCount() const
+        {
+            size_t out = 0;
+            if (!thread.videoDataCache.empty())
+            {
+                // Use the average size of the cached frames.
+                out = thread.videoDataCacheByteCount / thread.videoDataCache.size();
+            }
+            else
+            {
+                // Estimate the size from the I/O information until frames
+                // have been cached.
+                if (thread.videoLayer >= 0 &&
+                    thread.videoLayer < static_cast<int>(ioInfo.video.size()))
+                {
+                    out += image::getDataByteCount(ioInfo.video[thread.videoLayer]);
+                }
+                for (size_t i = 0; i < thread.compare.size(); ++i)
+                {
+                    const io::Info& compareInfo = thread.compare[i]->getIOInfo();
+                    const int videoLayer = i < thread.compareVideoLayers.size() ?
+                        thread.compareVideoLayers[i] :
+                        thread.videoLayer;
+                    if (videoLayer >= 0 &&
+                        videoLayer < static_cast<int>(compareInfo.video.size()))
+                    {
+                        out += image::getDataByteCount(compareInfo.video[videoLayer]);
+                    }
+                }
+            }
+            return out;
+        }
+
+        size_t Player::Private::getPrefetchFrameCount() const
+        {
+            // The prefetch cache keeps twice the number of prefetched
+            // frames, so the frames are not evicted before they are used.
+            // It is limited to half of the video cache budget.
+            size_t out = thread.prefetchPolicies.empty() ?
+                0 :
+                (thread.cacheOptions.prefetchCount * 2);
+            if (thread.cacheOptions.videoByteCount > 0)
+            {
+                const size_t frameByteCount = getVideoFrameByteCount();
+                if (frameByteCount > 0)
+                {
+                    out = std::min(out, thread.cacheOptions.videoByteCount / frameByteCount / 2);
+                }
+            }
+            return out;
+        }
+
         void Player::Private::cacheUpdate()
         {
             // Get the video ranges to be cached.
@@ -152,18 +283,54 @@ namespace tl
             const otime::RationalTime readBehindRescaled = readBehindDivided.
                 rescaled_to(timeRange.duration().rate()).
                 floor();
+            otime::RationalTime videoReadAhead = readAheadRescaled;
+            otime::RationalTime videoReadBehind = readBehindRescaled;
+            if (thread.cacheOptions.videoByteCount > 0)
+            {
+                // Adjust the video read ahead and read behind to the number
+                // of frames that fit in the cache. The frame size includes
+                // the compare timelines, so the times are not divided. The
+                // audio is small, so it still uses the read ahead and read
+                // behind times.
+                // The frames kept by the prefetch cache are taken out of
+                // the budget.
+                const size_t frameByteCount = getVideoFrameByteCount();
+                if (frameByteCount > 0)
+                {
+                    const size_t budgetFrameCount = thread.cacheOptions.videoByteCount / frameByteCount;
+                    const size_t prefetchFrameCount = getPrefetchFrameCount();
+                    const size_t frameCount = budgetFrameCount > prefetchFrameCount ?
+                        std::max(budgetFrameCount - prefetchFrameCount, static_cast<size_t>(1)) :
+                        1;
+                    const double readAheadSeconds = std::max(
+                        thread.cacheOptions.readAhead.to_seconds(), 0.0);
+                    const double readBehindSeconds = std::max(
+                        thread.cacheOptions.readBehind.to_seconds(), 0.0);
+                    const double sum = readAheadSeconds + readBehindSeconds;
+                    const size_t readAheadFrames = sum > 0.0 ?
+                        static_cast<size_t>((frameCount - 1) * (readAheadSeconds / sum)) :
+                        (frameCount - 1);
+                    const size_t readBehindFrames = frameCount - 1 - readAheadFrames;
+                    videoReadAhead = otime::RationalTime(
+                        readAheadFrames,
+                        timeRange.duration().rate());
+                    videoReadBehind = otime::RationalTime(
+                        readBehindFrames,
+                        timeRange.duration().rate());
+                }
+            }
             otime::TimeRange videoRange = time::invalidTimeRange;
             switch (thread.cacheDirection)
             {
             case CacheDirection::Forward:
                 videoRange = otime::TimeRange::range_from_start_end_time_inclusive(
-                    thread.currentTime - readBehindRescaled,
-                    thread.currentTime + readAheadRescaled);
+                    thread.currentTime - videoReadBehind,
+                    thread.currentTime + videoReadAhead);
                 break;
             case CacheDirection::Reverse:
                 videoRange = otime::TimeRange::range_from_start_end_time_inclusive(
-                    thread.currentTime - readAheadRescaled,
-                    thread.currentTime + readBehindRescaled);
+                    thread.currentTime - videoReadAhead,
+                    thread.currentTime + videoReadBehind);
                 break;
             default: break;
             }
@@ -225,62 +392,209 @@ namespace tl
                 inOutAudioRange,
                 thread.cacheDirection);
 
-            // Remove old video from the cache.
-            auto videoCacheIt = thread.videoDataCache.begin();
-            while (videoCacheIt != thread.videoDataCache.end())
+            // The cache is only updated when the ranges change, instead of
+            // scanning the cache and requests every tick.
+            const bool videoRangesChanged =
+                thread.cacheRangesChanged ||
+                videoRanges != thread.videoRanges;
+            const bool audioRangesChanged =
+                thread.cacheRangesChanged ||
+                audioRanges != thread.audioRanges;
+            thread.cacheRangesChanged = false;
+            thread.videoRanges = videoRanges;
+            thread.audioRanges = audioRanges;
+            thread.videoCacheFrameCount = thread.cacheOptions.videoByteCount > 0 ?
+                0.0 :
+                (readAheadDivided.rescaled_to(timeRange.duration().rate()).value() +
+                    readBehindDivided.rescaled_to(timeRange.duration().rate()).value());
+
+            // Use the prefetched frames before requesting new ones.
+            prefetchHitUpdate();
+            if (videoRangesChanged)
             {
-                const otime::RationalTime t = videoCacheIt->first;
-                const auto j = std::find_if(
-                    videoRanges.begin(),
-                    videoRanges.end(),
-                    [t](const otime::TimeRange& value)
-                    {
-                        return value.contains(t);
-                    });
-                if (j == videoRanges.end())
+                playbackHintUpdate();
+                videoCacheUpdate();
+            }
+            if (audioRangesChanged)
+            {
+                audioCacheUpdate();
+            }
+
+            // Move finished requests into the cache.
+            readyUpdate();
+
+            // Request frames from the prefetch policies.
+            prefetchUpdate();
+
+            // Update the cache information.
+            const auto now = std::chrono::steady_clock::now();
+            const std::chrono::duration<float> diff = now - thread.cacheTimer;
+            if (thread.cacheInfoChanged && diff.count() > .5F)
+            {
+                thread.cacheTimer = now;
+                thread.cacheInfoChanged = false;
+                cacheInfoUpdate();
+            }
+        }
+
+        void Player::Private::playbackHintUpdate()
+        {
+            // Set the playback hint so the frames closest to the current
+            // time are read first.
+            const otime::TimeRange& timeRange = timeline->getTimeRange();
+            io::PlaybackHint playbackHint;
+            playbackHint.time = thread.currentTime;
+            switch (thread.playback)
+            {
+            case Playback::Forward: playbackHint.direction = 1; break;
+            case Playback::Reverse: playbackHint.direction = -1; break;
+            default: break;
+            }
+            playbackHint.ranges = thread.videoRanges;
+
+            // Include the prefetch requests so they are not canceled.
+            for (const auto& i : thread.prefetchRequests)
+            {
+                playbackHint.ranges.push_back(otime::TimeRange(
+                    i.first,
+                    otime::RationalTime(1.0, i.first.rate())));
+            }
+            timeline->setPlaybackHint(playbackHint);
+            for (size_t i = 0; i < thread.compare.size(); ++i)
+            {
+                io::PlaybackHint comparePlaybackHint;
+                comparePlaybackHint.time = timeline::getCompareTime(
+                    playbackHint.time,
+                    timeRange,
+                    thread.compare[i]->getTimeRange(),
+                    thread.compareTime);
+                comparePlaybackHint.direction = playbackHint.direction;
+                for (const auto& range : playbackHint.ranges)
                 {
-                    videoCacheIt = thread.videoDataCache.erase(videoCacheIt);
+                    comparePlaybackHint.ranges.push_back(
+                        otime::TimeRange::range_from_start_end_time_inclusive(
+                            timeline::getCompareTime(
+                                range.start_time(),
+                                timeRange,
+                                thread.compare[i]->getTimeRange(),
+                                thread.compareTime),
+                            timeline::getCompareTime(
+                                range.end_time_inclusive(),
+                                timeRange,
+                                thread.compare[i]->getTimeRange(),
+                                thread.compareTime)));
                 }
-                else
+                thread.compare[i]->setPlaybackHint(comparePlaybackHint);
+            }
+        }
+
+        int64_t Player::Private::getVideoCacheFrame(const otime::RationalTime& time) const
+        {
+            const otime::TimeRange& timeRange = timeline->getTimeRange();
+            return static_cast<int64_t>(std::floor(
+                (time - timeRange.start_time()).rescaled_to(timeRange.duration().rate()).value()));
+        }
+
+        bool Player::Private::isVideoCached(const otime::RationalTime& time) const
+        {
+            for (const auto& range : thread.videoRanges)
+            {
+                if (range.contains(time))
                 {
-                    ++videoCacheIt;
+                    return true;
                 }
             }
+            return false;
+        }
 
-            // Remove old audio from the cache.
+        bool Player::Private::isAudioCached(int64_t seconds) const
+        {
+            const otime::TimeRange& timeRange = timeline->getTimeRange();
+            const otime::TimeRange cacheRange(
+                otime::RationalTime(
+                    timeRange.start_time().rescaled_to(1.0).value() + seconds,
+                    1.0),
+                otime::RationalTime(1.0, 1.0));
+            for (const auto& range : thread.audioRanges)
             {
-                std::unique_lock<std::mutex> lock(audioMutex.mutex);
-                auto audioCacheIt = audioMutex.audioDataCache.begin();
-                while (audioCacheIt != audioMutex.audioDataCache.end())
+                if (cacheRange.intersects(range))
                 {
-                    const otime::TimeRange cacheRange(
-                        otime::RationalTime(
-                            timeRange.start_time().rescaled_to(1.0).value() +
-                            audioCacheIt->first,
-                            1.0),
-                        otime::RationalTime(1.0, 1.0));
-                    const auto j = std::find_if(
-                        audioRanges.begin(),
-                        audioRanges.end(),
-                        [cacheRange](const otime::TimeRange& value)
-                        {
-                            return cacheRange.intersects(value);
-                        });
-                    if (j == audioRanges.end())
-                    {
-                        audioCacheIt = audioMutex.audioDataCache.erase(audioCacheIt);
-                    }
-                    else
-                    {
-                        ++audioCacheIt;
-                    }
+                    return true;
                 }
             }
+            return false;
+        }
+
+        void Player::Private::videoCacheUpdate()
+        {
+            // Remove old video from the cache. The cache and the sorted
+            // ranges are walked together so only the removed frames are
+            // visited.
+            std::vector<otime::TimeRange> sortedRanges = thread.videoRanges;
+            std::sort(
+                sortedRanges.begin(),
+                sortedRanges.end(),
+                [](const otime::TimeRange& a, const otime::TimeRange& b)
+                {
+                    return a.start_time() < b.start_time();
+                });
+            auto removeVideo = [this](
+                std::map<otime::RationalTime, std::vector<VideoData> >::iterator i)
+            {
+                thread.videoDataCacheByteCount -= getByteCount(i->second);
+                thread.videoCacheFrames.remove(getVideoCacheFrame(i->first));
+                thread.cacheInfoChanged = true;
+                return thread.videoDataCache.erase(i);
+            };
+            auto videoCacheIt = thread.videoDataCache.begin();
+            for (const auto& range : sortedRanges)
+            {
+                while (videoCacheIt != thread.videoDataCache.end() &&
+                    videoCacheIt->first < range.start_time())
+                {
+                    videoCacheIt = removeVideo(videoCacheIt);
+                }
+                const auto j = thread.videoDataCache.lower_bound(range.end_time_exclusive());
+                if (j == thread.videoDataCache.end() ||
+                    (videoCacheIt != thread.videoDataCache.end() && j->first > videoCacheIt->first))
+                {
+                    videoCacheIt = j;
+                }
+            }
+            while (videoCacheIt != thread.videoDataCache.end())
+            {
+                videoCacheIt = removeVideo(videoCacheIt);
+            }
 
             // Get uncached video.
             if (!ioInfo.video.empty())
             {
-                for (const auto& range : videoRanges)
+                auto requestVideo = [this](const otime::RationalTime& time)
+                {
+                    if (thread.videoDataCache.find(time) == thread.videoDataCache.end() &&
+                        thread.videoDataRequests.find(time) == thread.videoDataRequests.end())
+                    {
+                        // Use prefetched frames if they are available.
+                        std::vector<VideoData> videoData;
+                        const auto i = thread.prefetchRequests.find(time);
+                        if (i != thread.prefetchRequests.end())
+                        {
+                            thread.videoDataRequests[time] = std::move(i->second);
+                            thread.prefetchRequests.erase(i);
+                        }
+                        else if (thread.prefetchCache.peek(time, videoData))
+                        {
+                            thread.prefetchCache.remove(time);
+                            addVideoCache(time, videoData);
+                        }
+                        else
+                        {
+                            //std::cout << this << " video request: " << time << std::endl;
+                            thread.videoDataRequests[time] = getVideo(time);
+                        }
+                    }
+                };
+                for (const auto& range : thread.videoRanges)
                 {
                     switch (thread.cacheDirection)
                     {
@@ -291,33 +605,7 @@ namespace tl
                         const otime::RationalTime inc = otime::RationalTime(1.0, range.duration().rate());
                         for (otime::RationalTime time = start; time <= end; time += inc)
                         {
-                            const auto i = thread.videoDataCache.find(time);
-                            if (i == thread.videoDataCache.end())
-                            {
-                                const auto j = thread.videoDataRequests.find(time);
-                                if (j == thread.videoDataRequests.end())
-                                {
-                                    //std::cout << this << " video request: " << time << std::endl;
-                                    auto& request = thread.videoDataRequests[time];
-                                    request.clear();
-                                    io::Options ioOptions2 = thread.ioOptions;
-                                    ioOptions2["Layer"] = string::Format("{0}").arg(thread.videoLayer);
-                                    request.push_back(timeline->getVideo(time, ioOptions2));
-                                    for (size_t i = 0; i < thread.compare.size(); ++i)
-                                    {
-                                        const otime::RationalTime time2 = timeline::getCompareTime(
-                                            time,
-                                            timeRange,
-                                            thread.compare[i]->getTimeRange(),
-                                            thread.compareTime);
-                                        ioOptions2["Layer"] = string::Format("{0}").
-                                            arg(i < thread.compareVideoLayers.size() ?
-                                                thread.compareVideoLayers[i] :
-                                                thread.videoLayer);
-                                        request.push_back(thread.compare[i]->getVideo(time2, ioOptions2));
-                                    }
-                                }
-                            }
+                            requestVideo(time);
                         }
                         break;
                     }
@@ -328,33 +616,7 @@ namespace tl
                         const auto inc = otime::RationalTime(1.0, range.duration().rate());
                         for (auto time = start; time >= end; time -= inc)
                         {
-                            const auto i = thread.videoDataCache.find(time);
-                            if (i == thread.videoDataCache.end())
-                            {
-                                const auto j = thread.videoDataRequests.find(time);
-                                if (j == thread.videoDataRequests.end())
-                                {
-                                    //std::cout << this << " video request: " << time << std::endl;
-                                    auto& request = thread.videoDataRequests[time];
-                                    request.clear();
-                                    io::Options ioOptions2 = thread.ioOptions;
-                                    ioOptions2["Layer"] = string::Format("{0}").arg(thread.videoLayer);
-                                    request.push_back(timeline->getVideo(time, ioOptions2));
-                                    for (size_t i = 0; i < thread.compare.size(); ++i)
-                                    {
-                                        const otime::RationalTime time2 = timeline::getCompareTime(
-                                            time,
-                                            timeRange,
-                                            thread.compare[i]->getTimeRange(),
-                                            thread.compareTime);
-                                        ioOptions2["Layer"] = string::Format("{0}").
-                                            arg(i < thread.compareVideoLayers.size() ?
-                                                thread.compareVideoLayers[i] :
-                                                thread.videoLayer);
-                                        request.push_back(thread.compare[i]->getVideo(time2, ioOptions2));
-                                    }
-                                }
-                            }
+                            requestVideo(time);
                         }
                         break;
                     }
@@ -362,12 +624,66 @@ namespace tl
                     }
                 }
             }
+        }
+
+        std::vector<VideoRequest> Player::Private::getVideo(const otime::RationalTime& time)
+        {
+            std::vector<VideoRequest> out;
+            const otime::TimeRange& timeRange = timeline->getTimeRange();
+            auto readyQueue = this->readyQueue;
+            const auto callback = [readyQueue, time]
+            {
+                std::unique_lock<std::mutex> lock(readyQueue->mutex);
+                readyQueue->video.push_back(time);
+            };
+            io::Options ioOptions2 = thread.ioOptions;
+            ioOptions2["Layer"] = string::Format("{0}").arg(thread.videoLayer);
+            out.push_back(timeline->getVideo(time, ioOptions2, callback));
+            for (size_t i = 0; i < thread.compare.size(); ++i)
+            {
+                const otime::RationalTime time2 = timeline::getCompareTime(
+                    time,
+                    timeRange,
+                    thread.compare[i]->getTimeRange(),
+                    thread.compareTime);
+                ioOptions2["Layer"] = string::Format("{0}").
+                    arg(i < thread.compareVideoLayers.size() ?
+                        thread.compareVideoLayers[i] :
+                        thread.videoLayer);
+                out.push_back(thread.compare[i]->getVideo(time2, ioOptions2, callback));
+            }
+            return out;
+        }
+
+        void Player::Private::audioCacheUpdate()
+        {
+            const otime::TimeRange& timeRange = timeline->getTimeRange();
+
+            // Remove old audio from the cache.
+            {
+                std::unique_lock<std::mutex> lock(audioMutex.mutex);
+                auto audioCacheIt = audioMutex.audioDataCache.begin();
+                while (audioCacheIt != audioMutex.audioDataCache.end())
+                {
+                    if (!isAudioCached(audioCacheIt->first))
+                    {
+                        thread.audioDataCacheByteCount -= getByteCount(audioCacheIt->second);
+                        thread.audioCacheSeconds.remove(audioCacheIt->first);
+                        thread.cacheInfoChanged = true;
+                        audioCacheIt = audioMutex.audioDataCache.erase(audioCacheIt);
+                    }
+                    else
+                    {
+                        ++audioCacheIt;
+                    }
+                }
+            }
 
             // Get uncached audio.
             if (ioInfo.audio.isValid())
             {
                 std::set<int64_t> seconds;
-                for (const auto& range : audioRanges)
+                for (const auto& range : thread.audioRanges)
                 {
                     const int64_t start = range.start_time().rescaled_to(1.0).value() -
                         timeRange.start_time().rescaled_to(1.0).value();
@@ -378,53 +694,82 @@ namespace tl
                     }
                 }
                 std::map<int64_t, double> requests;
+                for (int64_t s : seconds)
                 {
-                    std::unique_lock<std::mutex> lock(audioMutex.mutex);
-                    for (int64_t s : seconds)
+                    if (!thread.audioCacheSeconds.contains(s))
                     {
-                        const auto i = audioMutex.audioDataCache.find(s);
-                        if (i == audioMutex.audioDataCache.end())
+                        const auto j = thread.audioDataRequests.find(s);
+                        if (j == thread.audioDataRequests.end())
                         {
-                            const auto j = thread.audioDataRequests.find(s);
-                            if (j == thread.audioDataRequests.end())
-                            {
-                                requests[s] = timeRange.start_time().rescaled_to(1.0).value() + s;
-                            }
+                            requests[s] = timeRange.start_time().rescaled_to(1.0).value() + s;
                         }
                     }
                 }
+                auto requestAudio = [this](int64_t seconds, double time)
+                {
+                    auto readyQueue = this->readyQueue;
+                    thread.audioDataRequests[seconds] = timeline->getAudio(
+                        time,
+                        thread.ioOptions,
+                        [readyQueue, seconds]
+                        {
+                            std::unique_lock<std::mutex> lock(readyQueue->mutex);
+                            readyQueue->audio.push_back(seconds);
+                        });
+                };
                 switch (thread.cacheDirection)
                 {
                 case CacheDirection::Forward:
                     for (auto i = requests.begin(); i != requests.end(); ++i)
                     {
-                        thread.audioDataRequests[i->first] = timeline->getAudio(i->second, thread.ioOptions);
+                        requestAudio(i->first, i->second);
                     }
                     break;
                 case CacheDirection::Reverse:
                     for (auto i = requests.rbegin(); i != requests.rend(); ++i)
                     {
-                        thread.audioDataRequests[i->first] = timeline->getAudio(i->second, thread.ioOptions);
+                        requestAudio(i->first, i->second);
                     }
                     break;
                 default: break;
                 }
-                /*if (!requests.empty())
-                {
-                    std::cout << "audio range: " << audioRange << std::endl;
-                    std::cout << "audio request:";
-                    for (auto i : requests)
-                    {
-                        std::cout << " " << i;
-                    }
-                    std::cout << std::endl;
-                }*/
             }
+        }
 
-            // Check for finished video.
-            auto videoDataRequestsIt = thread.videoDataRequests.begin();
-            while (videoDataRequestsIt != thread.videoDataRequests.end())
+        void Player::Private::addVideoCache(
+            const otime::RationalTime& time,
+            const std::vector<VideoData>& videoData)
+        {
+            auto& videoDataCache = thread.videoDataCache[time];
+            thread.videoDataCacheByteCount -= getByteCount(videoDataCache);
+            videoDataCache = videoData;
+            thread.videoDataCacheByteCount += getByteCount(videoDataCache);
+            thread.videoCacheFrames.insert(getVideoCacheFrame(time));
+            thread.cacheInfoChanged = true;
+        }
+
+        void Player::Private::readyUpdate()
+        {
+            std::vector<otime::RationalTime> readyVideo;
+            std::vector<int64_t> readyAudio;
             {
+                std::unique_lock<std::mutex> lock(readyQueue->mutex);
+                std::swap(readyVideo, readyQueue->video);
+                std::swap(readyAudio, readyQueue->audio);
+            }
+
+            // Check for finished video. A frame is finished when the
+            // requests for all of the timelines are ready. The request is
+            // removed either way, so a canceled frame is requested again if
+            // it is still needed.
+            auto getReady = [](
+                std::map<otime::RationalTime, std::vector<VideoRequest> >& requests,
+                const otime::RationalTime& time,
+                std::vector<VideoData>& out)
+            {
+                const auto videoDataRequestsIt = requests.find(time);
+                if (videoDataRequestsIt == requests.end())
+                    return false;
                 bool ready = true;
                 for (auto videoDataRequestIt = videoDataRequestsIt->second.begin();
                     videoDataRequestIt != videoDataRequestsIt->second.end();
@@ -435,86 +780,229 @@ namespace tl
                 }
                 if (ready)
                 {
-                    const otime::RationalTime time = videoDataRequestsIt->first;
-                    auto& videoDataCache = thread.videoDataCache[time];
-                    videoDataCache.clear();
                     for (auto videoDataRequestIt = videoDataRequestsIt->second.begin();
                         videoDataRequestIt != videoDataRequestsIt->second.end();
                         ++videoDataRequestIt)
                     {
                         auto videoData = videoDataRequestIt->future.get();
                         videoData.time = time;
-                        videoDataCache.push_back(videoData);
+                        out.push_back(videoData);
                     }
-                    videoDataRequestsIt = thread.videoDataRequests.erase(videoDataRequestsIt);
+                    requests.erase(videoDataRequestsIt);
                 }
-                else
+                return ready;
+            };
+            for (const auto& time : readyVideo)
+            {
+                std::vector<VideoData> videoDataList;
+                if (getReady(thread.videoDataRequests, time, videoDataList))
+                {
+                    // Frames that have moved out of the cache ranges while
+                    // they were being read are discarded, along with frames
+                    // whose reads were canceled.
+                    if (isVideoCached(time) && !isCanceled(videoDataList))
+                    {
+                        addVideoCache(time, videoDataList);
+                    }
+                }
+                else if (getReady(thread.prefetchRequests, time, videoDataList))
                 {
-                    ++videoDataRequestsIt;
+                    if (!isCanceled(videoDataList))
+                    {
+                        thread.prefetchCache.add(time, videoDataList, getByteCount(videoDataList));
+                        thread.cacheInfoChanged = true;
+                        thread.prefetchChanged = true;
+                    }
                 }
             }
 
             // Check for finished audio.
-            auto audioDataRequestsIt = thread.audioDataRequests.begin();
-            while (audioDataRequestsIt != thread.audioDataRequests.end())
+            for (int64_t seconds : readyAudio)
             {
-                if (audioDataRequestsIt->second.future.valid() &&
+                const auto audioDataRequestsIt = thread.audioDataRequests.find(seconds);
+                if (audioDataRequestsIt != thread.audioDataRequests.end() &&
+                    audioDataRequestsIt->second.future.valid() &&
                     audioDataRequestsIt->second.future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
                 {
                     auto audioData = audioDataRequestsIt->second.future.get();
-                    audioData.seconds = audioDataRequestsIt->first;
+                    audioData.seconds = seconds;
+                    thread.audioDataRequests.erase(audioDataRequestsIt);
+                    const size_t byteCount = getByteCount(audioData);
                     {
                         std::unique_lock<std::mutex> lock(audioMutex.mutex);
-                        audioMutex.audioDataCache[audioDataRequestsIt->first] = audioData;
+                        auto& audioDataCache = audioMutex.audioDataCache[seconds];
+                        thread.audioDataCacheByteCount -= getByteCount(audioDataCache);
+                        audioDataCache = audioData;
                     }
-                    audioDataRequestsIt = thread.audioDataRequests.erase(audioDataRequestsIt);
-                }
-                else
-                {
-                    ++audioDataRequestsIt;
+                    thread.audioDataCacheByteCount += byteCount;
+                    thread.audioCacheSeconds.insert(seconds);
+                    thread.cacheInfoChanged = true;
                 }
             }
+        }
 
-            // Update cached frames.
+        void Player::Private::prefetchHitUpdate()
+        {
+            // The prefetch cache is limited in bytes, so it uses no more
+            // than the memory taken out of the video cache budget.
+            thread.prefetchCache.setMax(std::max(
+                getPrefetchFrameCount() * getVideoFrameByteCount(),
+                static_cast<size_t>(1)));
+            if (thread.playback != Playback::Stop ||
+                thread.currentTime == thread.prefetchTime ||
+                !time::isValid(thread.currentTime) ||
+                ioInfo.video.empty())
+                return;
+            thread.prefetchTime = thread.currentTime;
             const auto now = std::chrono::steady_clock::now();
-            const std::chrono::duration<float> diff = now - thread.cacheTimer;
-            if (diff.count() > .5F)
+            for (const auto& policy : thread.prefetchPolicies)
             {
-                thread.cacheTimer = now;
-                std::vector<otime::RationalTime> cachedVideoFrames;
-                for (const auto& i : thread.videoDataCache)
-                {
-                    cachedVideoFrames.push_back(i.first);
-                }
-                const float cachedVideoPercentage = cachedVideoFrames.size() /
-                    static_cast<float>(readAheadDivided.rescaled_to(timeRange.duration().rate()).value() +
-                        readBehindDivided.rescaled_to(timeRange.duration().rate()).value()) *
-                    100.F;
-                std::vector<otime::RationalTime> cachedAudioFrames;
+                policy->timeUpdate(thread.currentTime, now);
+            }
+            thread.prefetchChanged = true;
+
+            // Count whether the current frame was cached, and move
+            // prefetched frames into the cache.
+            const otime::RationalTime& time = thread.currentTime;
+            std::vector<VideoData> videoData;
+            if (thread.videoDataCache.find(time) != thread.videoDataCache.end())
+            {
+                ++thread.prefetchStats.hitCount;
+            }
+            else if (thread.prefetchCache.peek(time, videoData))
+            {
+                ++thread.prefetchStats.prefetchHitCount;
+                thread.prefetchCache.remove(time);
+                addVideoCache(time, videoData);
+            }
+            else
+            {
+                const auto i = thread.prefetchRequests.find(time);
+                if (i != thread.prefetchRequests.end())
                 {
-                    std::unique_lock<std::mutex> lock(audioMutex.mutex);
-                    for (const auto& i : audioMutex.audioDataCache)
+                    ++thread.prefetchStats.prefetchHitCount;
+                    if (thread.videoDataRequests.find(time) == thread.videoDataRequests.end())
                     {
-                        cachedAudioFrames.push_back(otime::RationalTime(
-                            timeRange.start_time().rescaled_to(1.0).value() + i.first,
-                            1.0));
+                        thread.videoDataRequests[time] = std::move(i->second);
                     }
+                    thread.prefetchRequests.erase(i);
                 }
-                auto cachedVideoRanges = toRanges(cachedVideoFrames);
-                auto cachedAudioRanges = toRanges(cachedAudioFrames);
-                for (auto& i : cachedAudioRanges)
+                else
                 {
-                    i = otime::TimeRange(
-                        i.start_time().rescaled_to(timeRange.duration().rate()).floor(),
-                        i.duration().rescaled_to(timeRange.duration().rate()).ceil());
+                    ++thread.prefetchStats.missCount;
                 }
-                float cachedAudioPercentage = 0.F;
+            }
+            std::unique_lock<std::mutex> lock(mutex.mutex);
+            mutex.prefetchStats = thread.prefetchStats;
+        }
+
+        void Player::Private::prefetchUpdate()
+        {
+            // Prefetch requests have a low priority; they are only made
+            // while playback is stopped and the cache requests are done.
+            if (thread.playback != Playback::Stop ||
+                0 == thread.cacheOptions.prefetchCount ||
+                thread.prefetchPolicies.empty() ||
+                !thread.videoDataRequests.empty() ||
+                !thread.prefetchChanged ||
+                ioInfo.video.empty() ||
+                !time::isValid(thread.currentTime))
+                return;
+            thread.prefetchChanged = false;
+
+            // Merge the times from the policies in turn so that each policy
+            // gets a share of the requests.
+            const size_t count = thread.cacheOptions.prefetchCount;
+            std::vector<std::vector<otime::RationalTime> > policyTimes;
+            for (const auto& policy : thread.prefetchPolicies)
+            {
+                policyTimes.push_back(policy->getPrefetch(
+                    thread.currentTime,
+                    thread.inOutRange,
+                    count));
+            }
+            std::vector<otime::RationalTime> times;
+            for (size_t i = 0; times.size() < count; ++i)
+            {
+                bool done = true;
+                for (const auto& j : policyTimes)
                 {
-                    std::unique_lock<std::mutex> lock(mutex.mutex);
-                    mutex.cacheInfo.videoPercentage = cachedVideoPercentage;
-                    mutex.cacheInfo.videoFrames = cachedVideoRanges;
-                    mutex.cacheInfo.audioFrames = cachedAudioRanges;
+                    if (i < j.size())
+                    {
+                        done = false;
+                        const otime::RationalTime& time = j[i];
+                        if (!isVideoCached(time) &&
+                            std::find(times.begin(), times.end(), time) == times.end() &&
+                            thread.videoDataCache.find(time) == thread.videoDataCache.end() &&
+                            thread.videoDataRequests.find(time) == thread.videoDataRequests.end() &&
+                            thread.prefetchRequests.find(time) == thread.prefetchRequests.end() &&
+                            !thread.prefetchCache.contains(time))
+                        {
+                            times.push_back(time);
+                        }
+                    }
                 }
+                if (done)
+                    break;
+            }
+
+            // Request the frames.
+            size_t requestCount = 0;
+            for (const auto& time : times)
+            {
+                if (thread.prefetchRequests.size() >= count)
+                    break;
+                thread.prefetchRequests[time] = getVideo(time);
+                ++requestCount;
+            }
+            if (requestCount > 0)
+            {
+                playbackHintUpdate();
+                thread.prefetchStats.requestCount += requestCount;
+                std::unique_lock<std::mutex> lock(mutex.mutex);
+                mutex.prefetchStats = thread.prefetchStats;
+            }
+        }
+
+        void Player::Private::cacheInfoUpdate()
+        {
+            // Convert the cached frames to time ranges. The frames are kept
+            // in range sets, so this does not need to walk the cache.
+            const otime::TimeRange& timeRange = timeline->getTimeRange();
+            const double rate = timeRange.duration().rate();
+            std::vector<otime::TimeRange> cachedVideoRanges;
+            for (const auto& range : thread.videoCacheFrames.getRanges())
+            {
+                cachedVideoRanges.push_back(otime::TimeRange(
+                    timeRange.start_time() + otime::RationalTime(range.getMin(), rate),
+                    otime::RationalTime(range.getMax() - range.getMin() + 1, rate)));
+            }
+            std::vector<otime::TimeRange> cachedAudioRanges;
+            const double startSeconds = timeRange.start_time().rescaled_to(1.0).value();
+            for (const auto& range : thread.audioCacheSeconds.getRanges())
+            {
+                cachedAudioRanges.push_back(otime::TimeRange(
+                    otime::RationalTime(startSeconds + range.getMin(), 1.0).rescaled_to(rate).floor(),
+                    otime::RationalTime(range.getMax() - range.getMin() + 1, 1.0).rescaled_to(rate).ceil()));
+            }
+            // The prefetched frames are included in the video byte count.
+            const size_t videoByteCount =
+                thread.videoDataCacheByteCount +
+                thread.prefetchCache.getSize();
+            const float cachedVideoPercentage = thread.cacheOptions.videoByteCount > 0 ?
+                (videoByteCount /
+                    static_cast<float>(thread.cacheOptions.videoByteCount) *
+                    100.F) :
+                (thread.videoDataCache.size() /
+                    static_cast<float>(thread.videoCacheFrameCount) *
+                    100.F);
+            {
+                std::unique_lock<std::mutex> lock(mutex.mutex);
+                mutex.cacheInfo.videoPercentage = cachedVideoPercentage;
+                mutex.cacheInfo.videoFrames = cachedVideoRanges;
+                mutex.cacheInfo.audioFrames = cachedAudioRanges;
+                mutex.cacheInfo.videoByteCount = videoByteCount;
+                mutex.cacheInfo.audioByteCount = thread.audioDataCacheByteCount;
             }
         }
 
@@ -552,26 +1040,17 @@ namespace tl
 #endif // TLRENDER_AUDIO
         }
 
-#if defined(TLRENDER_AUDIO)
-        int Player::Private::rtAudioCallback(
-            void* outputBuffer,
-            void* inputBuffer,
-            unsigned int nFrames,
-            double streamTime,
-            RtAudioStreamStatus status,
-            void* userData)
+        void Player::Private::audioUpdate()
         {
-            auto p = reinterpret_cast<Player::Private*>(userData);
-            
             // Get mutex protected values.
             Playback playback = Playback::Stop;
             otime::RationalTime playbackStartTime = time::invalidTime;
             double audioOffset = 0.0;
             {
-                std::unique_lock<std::mutex> lock(p->mutex.mutex);
-                playback = p->mutex.playback;
-                playbackStartTime = p->mutex.playbackStartTime;
-                audioOffset = p->mutex.audioOffset;
+                std::unique_lock<std::mutex> lock(mutex.mutex);
+                playback = mutex.playback;
+                playbackStartTime = mutex.playbackStartTime;
+                audioOffset = mutex.audioOffset;
             }
             double speed = 0.0;
             float volume = 1.F;
@@ -579,102 +1058,142 @@ namespace tl
             std::chrono::steady_clock::time_point muteTimeout;
             bool reset = false;
             {
-                std::unique_lock<std::mutex> lock(p->audioMutex.mutex);
-                speed = p->audioMutex.speed;
-                volume = p->audioMutex.volume;
-                mute = p->audioMutex.mute;
-                muteTimeout = p->audioMutex.muteTimeout;
-                reset = p->audioMutex.reset;
-                p->audioMutex.reset = false;
+                std::unique_lock<std::mutex> lock(audioMutex.mutex);
+                speed = audioMutex.speed;
+                volume = audioMutex.volume;
+                mute = audioMutex.mute;
+                muteTimeout = audioMutex.muteTimeout;
+                reset = audioMutex.reset;
+                audioMutex.reset = false;
             }
-            //std::cout << "playback: " << playback << std::endl;
-            //std::cout << "playbackStartTime: " << playbackStartTime << std::endl;
-            //std::cout << "reset: " << reset << std::endl;
 
-            // Zero output audio data.
-            std::memset(outputBuffer, 0, nFrames * p->audioThread.info.getByteCount());
-
-            switch (playback)
-            {
-            case Playback::Forward:
+            // Flush the audio resampler and buffers when the playback is
+            // reset. The ring buffer is flushed by the RtAudio callback
+            // since it is the consumer.
+            if (reset)
             {
-                // Flush the audio resampler and buffer when the RtAudio
-                // playback is reset.
-                if (reset)
+                if (audioThread.resample)
                 {
-                    if (p->audioThread.resample)
-                    {
-                        p->audioThread.resample->flush();
-                    }
-                    p->audioThread.buffer.clear();
-                    p->audioThread.rtAudioCurrentFrame = 0;
+                    audioThread.resample->flush();
+                }
+                if (audioThread.timeStretch)
+                {
+                    audioThread.timeStretch->flush();
                 }
+                audioThread.buffer.clear();
+                audioThread.inputFrame = 0;
+                audioThread.flush = true;
+            }
+
+            // Audio is time stretched when the playback speed is different
+            // from the timeline speed, within the supported range.
+            const double timeStretchSpeed = speed / timeline->getTimeRange().duration().rate();
+            const bool timeStretchValid =
+                timeStretchSpeed >= audio::timeStretchSpeedMin &&
+                timeStretchSpeed <= audio::timeStretchSpeedMax;
+
+            // Set whether the RtAudio callback should output audio.
+            const auto now = std::chrono::steady_clock::now();
+            audioThread.output =
+                playback != Playback::Stop &&
+                timeStretchValid &&
+                !mute &&
+                now >= muteTimeout;
+
+            // Wait for the RtAudio callback to flush the ring buffer.
+            if (audioThread.flush)
+                return;
 
+            if (playback != Playback::Stop && timeStretchValid)
+            {
                 // Create the audio resampler.
-                if (!p->audioThread.resample ||
-                    (p->audioThread.resample && p->audioThread.resample->getInputInfo() != p->ioInfo.audio))
+                if (!audioThread.resample ||
+                    (audioThread.resample && audioThread.resample->getInputInfo() != ioInfo.audio))
                 {
-                    p->audioThread.resample = audio::AudioResample::create(
-                        p->ioInfo.audio,
-                        p->audioThread.info);
+                    audioThread.resample = audio::AudioResample::create(
+                        ioInfo.audio,
+                        audioThread.info);
                 }
 
+                // Create the audio time stretch.
+                if (!audioThread.timeStretch)
+                {
+                    audioThread.timeStretch = audio::AudioTimeStretch::create(audioThread.info);
+                }
+                audioThread.timeStretch->setSpeed(timeStretchSpeed);
+
                 // Fill the audio buffer.
-                if (p->ioInfo.audio.sampleRate > 0 &&
+                const size_t writeAvailable = audioThread.ringBuffer->getWriteAvailable();
+                const int64_t sampleRate = ioInfo.audio.sampleRate;
+                if (sampleRate > 0 &&
                     playbackStartTime != time::invalidTime)
                 {
                     const int64_t playbackStartFrame =
-                        playbackStartTime.rescaled_to(p->ioInfo.audio.sampleRate).value() -
-                        p->timeline->getTimeRange().start_time().rescaled_to(p->ioInfo.audio.sampleRate).value() -
-                        otime::RationalTime(audioOffset, 1.0).rescaled_to(p->ioInfo.audio.sampleRate).value();;
-                    int64_t frame = playbackStartFrame +
-                        otime::RationalTime(
-                            p->audioThread.rtAudioCurrentFrame + audio::getSampleCount(p->audioThread.buffer),
-                            p->audioThread.info.sampleRate).rescaled_to(p->ioInfo.audio.sampleRate).value();
-                    int64_t seconds = p->ioInfo.audio.sampleRate > 0 ? (frame / p->ioInfo.audio.sampleRate) : 0;
-                    int64_t offset = frame - seconds * p->ioInfo.audio.sampleRate;
-                    while (audio::getSampleCount(p->audioThread.buffer) < nFrames &&
-                        p->running)
+                        playbackStartTime.rescaled_to(sampleRate).value() -
+                        timeline->getTimeRange().start_time().rescaled_to(sampleRate).value() -
+                        otime::RationalTime(audioOffset, 1.0).rescaled_to(sampleRate).value();
+                    while (audio::getSampleCount(audioThread.buffer) < writeAvailable &&
+                        running)
                     {
-                        //std::cout << "frame: " << frame << std::endl;
-                        //std::cout << "seconds: " << seconds << std::endl;
-                        //std::cout << "offset: " << offset << std::endl;
+                        // Find the one second block of audio data and the
+                        // range of samples to read. In reverse the samples
+                        // are read backwards from the playback start.
+                        int64_t seconds = 0;
+                        int64_t offset = 0;
+                        size_t size = 0;
+                        if (Playback::Forward == playback)
+                        {
+                            const int64_t frame = playbackStartFrame + audioThread.inputFrame;
+                            seconds = frame >= 0 ? (frame / sampleRate) : ((frame + 1) / sampleRate - 1);
+                            offset = frame - seconds * sampleRate;
+                            size = std::min(
+                                playerOptions.audioBufferFrameCount,
+                                static_cast<size_t>(sampleRate - offset));
+                        }
+                        else
+                        {
+                            const int64_t frame = playbackStartFrame - audioThread.inputFrame - 1;
+                            seconds = frame >= 0 ? (frame / sampleRate) : ((frame + 1) / sampleRate - 1);
+                            const int64_t end = frame - seconds * sampleRate + 1;
+                            size = std::min(
+                                playerOptions.audioBufferFrameCount,
+                                static_cast<size_t>(end));
+                            offset = end - size;
+                        }
+                        audioThread.inputFrame += size;
+
                         AudioData audioData;
                         {
-                            std::unique_lock<std::mutex> lock(p->audioMutex.mutex);
-                            const auto j = p->audioMutex.audioDataCache.find(seconds);
-                            if (j != p->audioMutex.audioDataCache.end())
+                            std::unique_lock<std::mutex> lock(audioMutex.mutex);
+                            const auto j = audioMutex.audioDataCache.find(seconds);
+                            if (j != audioMutex.audioDataCache.end())
                             {
                                 audioData = j->second;
                             }
                         }
-                        if (!p->audioThread.silence)
+                        if (!audioThread.silence)
                         {
-                            p->audioThread.silence = audio::Audio::create(p->ioInfo.audio, p->ioInfo.audio.sampleRate);
-                            p->audioThread.silence->zero();
+                            audioThread.silence = audio::Audio::create(ioInfo.audio, ioInfo.audio.sampleRate);
+                            audioThread.silence->zero();
                         }
                         std::vector<const uint8_t*> audioDataP;
                         for (const auto& layer : audioData.layers)
                         {
-                            if (layer.audio && layer.audio->getInfo() == p->ioInfo.audio)
+                            if (layer.audio && layer.audio->getInfo() == ioInfo.audio)
                             {
                                 audioDataP.push_back(
                                     layer.audio->getData() +
-                                    (offset * p->ioInfo.audio.getByteCount()));
+                                    (offset * ioInfo.audio.getByteCount()));
                             }
                         }
                         if (audioDataP.empty())
                         {
                             audioDataP.push_back(
-                                p->audioThread.silence->getData() +
-                                (offset * p->ioInfo.audio.getByteCount()));
+                                audioThread.silence->getData() +
+                                (offset * ioInfo.audio.getByteCount()));
                         }
 
-                        const size_t size = std::min(
-                            p->playerOptions.audioBufferFrameCount,
-                            static_cast<size_t>(p->ioInfo.audio.sampleRate - offset));
-                        //std::cout << "size: " << size << std::endl;
-                        auto tmp = audio::Audio::create(p->ioInfo.audio, size);
+                        auto tmp = audio::Audio::create(ioInfo.audio, size);
                         tmp->zero();
                         audio::mix(
                             audioDataP.data(),
@@ -682,49 +1201,83 @@ namespace tl
                             tmp->getData(),
                             volume,
                             size,
-                            p->ioInfo.audio.channelCount,
-                            p->ioInfo.audio.dataType);
-
-                        if (p->audioThread.resample)
+                            ioInfo.audio.channelCount,
+                            ioInfo.audio.dataType);
+                        if (Playback::Reverse == playback)
                         {
-                            p->audioThread.buffer.push_back(p->audioThread.resample->process(tmp));
+                            audio::reverse(tmp);
                         }
 
-                        offset += size;
-                        if (offset >= p->ioInfo.audio.sampleRate)
+                        auto resampled = audioThread.resample->process(tmp);
+                        if (!resampled)
+                            break;
+                        auto stretched = audioThread.timeStretch->process(resampled);
+                        if (stretched->getSampleCount() > 0)
                         {
-                            offset -= p->ioInfo.audio.sampleRate;
-                            seconds += 1;
+                            audioThread.buffer.push_back(stretched);
                         }
-
-                        //std::cout << std::endl;
                     }
                 }
 
-                // Send audio data to RtAudio.
-                const auto now = std::chrono::steady_clock::now();
-                if (speed == p->timeline->getTimeRange().duration().rate() &&
-                    !mute &&
-                    now >= muteTimeout &&
-                    nFrames <= getSampleCount(p->audioThread.buffer))
+                // Write the audio buffer to the ring buffer.
+                const size_t size = std::min(
+                    audio::getSampleCount(audioThread.buffer),
+                    writeAvailable);
+                if (size > 0)
                 {
+                    audioThread.moveBuffer.resize(size * audioThread.info.getByteCount());
                     audio::move(
-                        p->audioThread.buffer,
-                        reinterpret_cast<uint8_t*>(outputBuffer),
-                        nFrames);
+                        audioThread.buffer,
+                        audioThread.moveBuffer.data(),
+                        size);
+                    audioThread.ringBuffer->write(audioThread.moveBuffer.data(), size);
                 }
+            }
+        }
+
+#if defined(TLRENDER_AUDIO)
+        int Player::Private::rtAudioCallback(
+            void* outputBuffer,
+            void* inputBuffer,
+            unsigned int nFrames,
+            double streamTime,
+            RtAudioStreamStatus status,
+            void* userData)
+        {
+            // This function is called from the real-time audio thread, so it
+            // should not lock or allocate memory.
+            auto p = reinterpret_cast<Player::Private*>(userData);
+            const size_t byteCount = p->audioThread.info.getByteCount();
+            uint8_t* outputBufferP = reinterpret_cast<uint8_t*>(outputBuffer);
 
-                // Update the audio frame.
-                p->audioThread.rtAudioCurrentFrame += nFrames;
+            // Flush the ring buffer when the playback is reset.
+            if (p->audioThread.flush)
+            {
+                p->audioThread.ringBuffer->clear();
+                p->audioThread.flush = false;
+            }
 
-                break;
+            // Copy audio data from the ring buffer. The audio data is still
+            // consumed when it is not output to keep it in sync. Samples
+            // that are missing because of an underrun are skipped when they
+            // arrive, so the audio stays in sync with the stream time.
+            size_t size = 0;
+            if (p->audioThread.output)
+            {
+                size = p->audioThread.ringBuffer->readSync(outputBufferP, nFrames);
+                if (size < nFrames)
+                {
+                    ++(p->audioThread.underrunCount);
+                }
             }
-            case Playback::Reverse:
-                // Update the audio frame.
-                p->audioThread.rtAudioCurrentFrame += nFrames;
-                break;
-            default: break;
+            else
+            {
+                p->audioThread.ringBuffer->readSync(nullptr, nFrames);
             }
+            std::memset(
+                outputBufferP + size * byteCount,
+                0,
+                (nFrames - size) * byteCount);
 
             return 0;
         }
@@ -817,12 +1370,12 @@ namespace tl
                 "    Current time: {1}\n"
                 "    In/out range: {2}\n"
                 "    I/O options: {3}\n"
-                "    Cache: {4} read ahead, {5} read behind\n"
-                "    Video: {6} requests, {7} cached\n"
-                "    Audio: {8} requests, {9} cached\n"
-                "    {10}\n"
-                "    {11}\n"
-                "    {12}\n"
+                "    Cache: {4} read ahead, {5} read behind, {6}MB video\n"
+                "    Video: {7} requests, {8} cached, {9}MB\n"
+                "    Audio: {10} requests, {11} cached, {12}MB, {13} underruns\n"
+                "    {14}\n"
+                "    {15}\n"
+                "    {16}\n"
                 "    (T=current time, V=cached video, A=cached audio)").
                 arg(timeline->getPath().get()).
                 arg(currentTime).
@@ -830,10 +1383,14 @@ namespace tl
                 arg(string::join(ioOptionStrings, ", ")).
                 arg(cacheOptions->get().readAhead).
                 arg(cacheOptions->get().readBehind).
+                arg(cacheOptions->get().videoByteCount / memory::megabyte).
                 arg(thread.videoDataRequests.size()).
                 arg(thread.videoDataCache.size()).
+                arg(cacheInfo.videoByteCount / memory::megabyte).
                 arg(thread.audioDataRequests.size()).
                 arg(audioDataCacheSize).
+                arg(cacheInfo.audioByteCount / memory::megabyte).
+                arg(audioThread.underrunCount.load()).
                 arg(currentTimeDisplay).
                 arg(cachedVideoFramesDisplay).
                 arg(cachedAudioFramesDisplay));
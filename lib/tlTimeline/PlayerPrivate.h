@@ -9,7 +9,10 @@
 #include <tlTimeline/Util.h>
 
 #include <tlCore/AudioResample.h>
+#include <tlCore/AudioRingBuffer.h>
+#include <tlCore/AudioTimeStretch.h>
 #include <tlCore/LRUCache.h>
+#include <tlCore/RangeSet.h>
 
 #if defined(TLRENDER_AUDIO)
 #include <rtaudio/RtAudio.h>
@@ -29,12 +32,27 @@ namespace tl
 
             void clearRequests();
             void clearCache();
+            size_t getVideoFrameByteCount() const;
+            size_t getPrefetchFrameCount() const;
             void cacheUpdate();
+            void playbackHintUpdate();
+            int64_t getVideoCacheFrame(const otime::RationalTime&) const;
+            bool isVideoCached(const otime::RationalTime&) const;
+            bool isAudioCached(int64_t seconds) const;
+            void videoCacheUpdate();
+            void audioCacheUpdate();
+            void addVideoCache(const otime::RationalTime&, const std::vector<VideoData>&);
+            void readyUpdate();
+            void cacheInfoUpdate();
+            std::vector<VideoRequest> getVideo(const otime::RationalTime&);
+            void prefetchHitUpdate();
+            void prefetchUpdate();
 
             static size_t getAudioChannelCount(
                 const audio::Info& input,
                 const audio::Info& output);
             void resetAudioTime();
+            void audioUpdate();
 #if defined(TLRENDER_AUDIO)
             static int rtAudioCallback(
                 void* outputBuffer,
@@ -95,6 +113,9 @@ namespace tl
                 CacheDirection cacheDirection = CacheDirection::Forward;
                 PlayerCacheOptions cacheOptions;
                 PlayerCacheInfo cacheInfo;
+                std::vector<std::shared_ptr<IPrefetchPolicy> > prefetchPolicies;
+                bool prefetchPoliciesChanged = false;
+                PlayerPrefetchStats prefetchStats;
                 std::mutex mutex;
             };
             Mutex mutex;
@@ -111,6 +132,16 @@ namespace tl
             };
             AudioMutex audioMutex;
 
+            // Finished requests are added to the ready queue by the
+            // timeline callbacks.
+            struct ReadyQueue
+            {
+                std::vector<otime::RationalTime> video;
+                std::vector<int64_t> audio;
+                std::mutex mutex;
+            };
+            std::shared_ptr<ReadyQueue> readyQueue;
+
             struct Thread
             {
                 Playback playback = Playback::Stop;
@@ -127,6 +158,30 @@ namespace tl
 
                 std::map<otime::RationalTime, std::vector<VideoRequest> > videoDataRequests;
                 std::map<otime::RationalTime, std::vector<VideoData> > videoDataCache;
+                size_t videoDataCacheByteCount = 0;
+                size_t audioDataCacheByteCount = 0;
+
+                // The ranges of the cache and whether they have changed.
+                std::vector<otime::TimeRange> videoRanges;
+                std::vector<otime::TimeRange> audioRanges;
+                bool cacheRangesChanged = true;
+                double videoCacheFrameCount = 0.0;
+
+                // The cached video frames relative to the start of the
+                // timeline, and the cached audio seconds.
+                math::Int64RangeSet videoCacheFrames;
+                math::Int64RangeSet audioCacheSeconds;
+                bool cacheInfoChanged = false;
+
+                // Prefetched frames are kept separately from the cache
+                // ranges.
+                std::vector<std::shared_ptr<IPrefetchPolicy> > prefetchPolicies;
+                std::map<otime::RationalTime, std::vector<VideoRequest> > prefetchRequests;
+                memory::LRUCache<otime::RationalTime, std::vector<VideoData> > prefetchCache;
+                otime::RationalTime prefetchTime = time::invalidTime;
+                bool prefetchChanged = false;
+                PlayerPrefetchStats prefetchStats;
+
 #if defined(TLRENDER_AUDIO)
                 std::unique_ptr<RtAudio> rtAudio;
 #endif // TLRENDER_AUDIO
@@ -141,9 +196,22 @@ namespace tl
             {
                 audio::Info info;
                 std::shared_ptr<audio::AudioResample> resample;
+                std::shared_ptr<audio::AudioTimeStretch> timeStretch;
                 std::list<std::shared_ptr<audio::Audio> > buffer;
+                std::vector<uint8_t> moveBuffer;
                 std::shared_ptr<audio::Audio> silence;
-                size_t rtAudioCurrentFrame = 0;
+
+                // The number of input samples read since the playback
+                // was reset.
+                int64_t inputFrame = 0;
+
+                // The audio thread prepares audio data in the ring buffer,
+                // and the RtAudio callback only copies from it.
+                std::shared_ptr<audio::AudioRingBuffer> ringBuffer;
+                std::atomic<bool> output;
+                std::atomic<bool> flush;
+                std::atomic<size_t> underrunCount;
+                std::thread thread;
             };
             AudioThread audioThread;
         };
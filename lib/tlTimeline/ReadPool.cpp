@@ -0,0 +1,253 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlTimeline/ReadPool.h>
+
+#include <list>
+#include <mutex>
+#include <vector>
+
+namespace tl
+{
+    namespace timeline
+    {
+        struct ReadPool::Private
+        {
+            ReadPoolOptions options;
+
+            // The readers are kept with the most recently used at the
+            // front.
+            struct Item
+            {
+                std::string key;
+                std::shared_ptr<io::IRead> read;
+                std::chrono::steady_clock::time_point time;
+            };
+            std::list<Item> items;
+
+            ReadPoolStats stats;
+            mutable std::mutex mutex;
+
+            std::list<Item>::const_iterator find(const std::string&) const;
+            void getCounts(size_t& fileCount, size_t& byteCount) const;
+            void evict(std::vector<std::shared_ptr<io::IRead> >&);
+        };
+
+        std::list<ReadPool::Private::Item>::const_iterator ReadPool::Private::find(const std::string& key) const
+        {
+            auto i = items.begin();
+            for (; i != items.end(); ++i)
+            {
+                if (key == i->key)
+                    break;
+            }
+            return i;
+        }
+
+        void ReadPool::Private::getCounts(size_t& fileCount, size_t& byteCount) const
+        {
+            // The file and memory counts can change while the readers are
+            // open, so they are measured each time.
+            fileCount = 0;
+            byteCount = 0;
+            for (const auto& item : items)
+            {
+                if (item.read)
+                {
+                    fileCount += item.read->getOpenFileCount();
+                    byteCount += item.read->getByteCount();
+                }
+            }
+        }
+
+        void ReadPool::Private::evict(std::vector<std::shared_ptr<io::IRead> >& out)
+        {
+            size_t fileCount = 0;
+            size_t byteCount = 0;
+            getCounts(fileCount, byteCount);
+
+            // The most recently used reader and the readers that are in use
+            // are never evicted.
+            auto i = items.end();
+            while (i != items.begin() &&
+                --i != items.begin() &&
+                (items.size() > options.readerCount ||
+                    fileCount > options.fileCount ||
+                    byteCount > options.byteCount))
+            {
+                if (i->read.use_count() > 1)
+                    continue;
+                if (i->read)
+                {
+                    fileCount -= i->read->getOpenFileCount();
+                    byteCount -= i->read->getByteCount();
+                }
+                out.push_back(i->read);
+                i = items.erase(i);
+                ++stats.evictCount;
+            }
+        }
+
+        void ReadPool::_init(const ReadPoolOptions& options)
+        {
+            _p->options = options;
+        }
+
+        ReadPool::ReadPool() :
+            _p(new Private)
+        {}
+
+        ReadPool::~ReadPool()
+        {}
+
+        std::shared_ptr<ReadPool> ReadPool::create(const ReadPoolOptions& options)
+        {
+            auto out = std::shared_ptr<ReadPool>(new ReadPool);
+            out->_init(options);
+            return out;
+        }
+
+        ReadPoolOptions ReadPool::getOptions() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.options;
+        }
+
+        void ReadPool::setOptions(const ReadPoolOptions& value)
+        {
+            TLRENDER_P();
+            std::vector<std::shared_ptr<io::IRead> > evicted;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.options = value;
+                p.evict(evicted);
+            }
+        }
+
+        std::shared_ptr<io::IRead> ReadPool::get(
+            const std::string& key,
+            const std::function<std::shared_ptr<io::IRead>(void)>& open)
+        {
+            TLRENDER_P();
+            const auto now = std::chrono::steady_clock::now();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                const auto i = p.find(key);
+                if (i != p.items.end())
+                {
+                    p.items.splice(p.items.begin(), p.items, i);
+                    p.items.front().time = now;
+                    ++p.stats.hitCount;
+                    return p.items.front().read;
+                }
+            }
+
+            // Open the reader without holding the lock.
+            std::shared_ptr<io::IRead> out = open ? open() : nullptr;
+            std::vector<std::shared_ptr<io::IRead> > evicted;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                const auto i = p.find(key);
+                if (i != p.items.end())
+                {
+                    // The reader was opened by another thread.
+                    evicted.push_back(out);
+                    p.items.splice(p.items.begin(), p.items, i);
+                    p.items.front().time = now;
+                    out = p.items.front().read;
+                }
+                else
+                {
+                    p.items.push_front(Private::Item{ key, out, now });
+                    ++p.stats.openCount;
+                    p.evict(evicted);
+                }
+            }
+            return out;
+        }
+
+        std::shared_ptr<io::IRead> ReadPool::peek(const std::string& key) const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            const auto i = p.find(key);
+            return i != p.items.end() ? i->read : nullptr;
+        }
+
+        bool ReadPool::contains(const std::string& key) const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.find(key) != p.items.end();
+        }
+
+        size_t ReadPool::getFreeCount() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            size_t fileCount = 0;
+            size_t byteCount = 0;
+            p.getCounts(fileCount, byteCount);
+            return
+                fileCount < p.options.fileCount &&
+                byteCount < p.options.byteCount &&
+                p.items.size() < p.options.readerCount ?
+                (p.options.readerCount - p.items.size()) :
+                0;
+        }
+
+        void ReadPool::evictIdle(const std::chrono::steady_clock::time_point& now)
+        {
+            TLRENDER_P();
+            std::vector<std::shared_ptr<io::IRead> > evicted;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                auto i = p.items.begin();
+                while (i != p.items.end())
+                {
+                    if (now - i->time > p.options.idleTimeout &&
+                        i->read.use_count() <= 1)
+                    {
+                        evicted.push_back(i->read);
+                        i = p.items.erase(i);
+                        ++p.stats.evictCount;
+                    }
+                    else
+                    {
+                        ++i;
+                    }
+                }
+            }
+        }
+
+        ReadPoolStats ReadPool::getStats() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            ReadPoolStats out = p.stats;
+            out.readerCount = p.items.size();
+            for (const auto& item : p.items)
+            {
+                if (item.read)
+                {
+                    out.fileCount += item.read->getOpenFileCount();
+                    out.byteCount += item.read->getByteCount();
+                }
+            }
+            return out;
+        }
+
+        void ReadPool::clear()
+        {
+            TLRENDER_P();
+            std::list<Private::Item> items;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                items = std::move(p.items);
+                p.items.clear();
+            }
+        }
+    }
+}
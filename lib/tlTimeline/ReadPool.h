@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlIO/Plugin.h>
+
+#include <chrono>
+#include <functional>
+
+namespace tl
+{
+    namespace timeline
+    {
+        //! Reader pool options.
+        struct ReadPoolOptions
+        {
+            //! Maximum number of readers.
+            size_t readerCount = 10;
+
+            //! Maximum number of files kept open by the readers.
+            size_t fileCount = 64;
+
+            //! Maximum memory used by the readers in bytes.
+            size_t byteCount = memory::gigabyte;
+
+            //! Readers that have not been used for this time are evicted.
+            std::chrono::milliseconds idleTimeout = std::chrono::seconds(30);
+
+            bool operator == (const ReadPoolOptions&) const;
+            bool operator != (const ReadPoolOptions&) const;
+        };
+
+        //! Reader pool statistics.
+        struct ReadPoolStats
+        {
+            size_t openCount   = 0; //!< Readers opened
+            size_t hitCount    = 0; //!< Readers found in the pool
+            size_t evictCount  = 0; //!< Readers evicted
+            size_t readerCount = 0; //!< Readers in the pool
+            size_t fileCount   = 0; //!< Files kept open by the readers
+            size_t byteCount   = 0; //!< Memory used by the readers
+
+            bool operator == (const ReadPoolStats&) const;
+            bool operator != (const ReadPoolStats&) const;
+        };
+
+        //! Reader pool.
+        //!
+        //! Readers are kept open so they can be reused, and the least
+        //! recently used readers are evicted to keep the number of readers,
+        //! the open files, and the memory within the maximums. The file
+        //! and memory counts are the estimates given by the readers.
+        //! Readers that are referenced outside of the pool are in use and
+        //! are not evicted. Readers are destroyed outside of the pool lock,
+        //! since destroying a reader finishes its pending requests.
+        class ReadPool
+        {
+            TLRENDER_NON_COPYABLE(ReadPool);
+
+        protected:
+            void _init(const ReadPoolOptions&);
+
+            ReadPool();
+
+        public:
+            ~ReadPool();
+
+            //! Create a new reader pool.
+            static std::shared_ptr<ReadPool> create(const ReadPoolOptions& = ReadPoolOptions());
+
+            //! Get the options.
+            ReadPoolOptions getOptions() const;
+
+            //! Set the options.
+            void setOptions(const ReadPoolOptions&);
+
+            //! Get a reader, or open a new reader with the given function
+            //! if it is not in the pool. Readers that fail to open are also
+            //! kept in the pool so they are not opened again.
+            std::shared_ptr<io::IRead> get(
+                const std::string& key,
+                const std::function<std::shared_ptr<io::IRead>(void)>& open);
+
+            //! Get a reader without opening it or updating its use.
+            std::shared_ptr<io::IRead> peek(const std::string& key) const;
+
+            //! Get whether the pool contains a reader.
+            bool contains(const std::string& key) const;
+
+            //! Get the number of readers that can be opened without
+            //! evicting other readers.
+            size_t getFreeCount() const;
+
+            //! Evict the readers that have been idle longer than the
+            //! timeout.
+            void evictIdle(const std::chrono::steady_clock::time_point&);
+
+            //! Get the statistics.
+            ReadPoolStats getStats() const;
+
+            //! Remove all of the readers.
+            void clear();
+
+        private:
+            TLRENDER_PRIVATE();
+        };
+    }
+}
+
+#include <tlTimeline/ReadPoolInline.h>
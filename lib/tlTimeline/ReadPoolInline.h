@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+namespace tl
+{
+    namespace timeline
+    {
+        inline bool ReadPoolOptions::operator == (const ReadPoolOptions& other) const
+        {
+            return
+                readerCount == other.readerCount &&
+                fileCount == other.fileCount &&
+                byteCount == other.byteCount &&
+                idleTimeout == other.idleTimeout;
+        }
+
+        inline bool ReadPoolOptions::operator != (const ReadPoolOptions& other) const
+        {
+            return !(*this == other);
+        }
+
+        inline bool ReadPoolStats::operator == (const ReadPoolStats& other) const
+        {
+            return
+                openCount == other.openCount &&
+                hitCount == other.hitCount &&
+                evictCount == other.evictCount &&
+                readerCount == other.readerCount &&
+                fileCount == other.fileCount &&
+                byteCount == other.byteCount;
+        }
+
+        inline bool ReadPoolStats::operator != (const ReadPoolStats& other) const
+        {
+            return !(*this == other);
+        }
+    }
+}
@@ -13,15 +13,12 @@
 #include <tlCore/String.h>
 #include <tlCore/StringFormat.h>
 
+#include <algorithm>
+
 namespace tl
 {
     namespace timeline
     {
-        namespace
-        {
-            const size_t readCacheMax = 10;
-        }
-
         TLRENDER_ENUM_IMPL(
             FileSequenceAudio,
             "None",
@@ -38,6 +35,8 @@ namespace tl
                 videoRequestCount == other.videoRequestCount &&
                 audioRequestCount == other.audioRequestCount &&
                 requestTimeout == other.requestTimeout &&
+                readPoolOptions == other.readPoolOptions &&
+                readAheadCount == other.readAheadCount &&
                 ioOptions == other.ioOptions &&
                 pathOptions == other.pathOptions;
         }
@@ -70,6 +69,13 @@ namespace tl
                     arg(options.audioRequestCount));
                 lines.push_back(string::Format("    Request timeout: {0}ms").
                     arg(options.requestTimeout.count()));
+                lines.push_back(string::Format("    Reader pool: {0} readers, {1} files, {2}MB, {3}ms idle timeout").
+                    arg(options.readPoolOptions.readerCount).
+                    arg(options.readPoolOptions.fileCount).
+                    arg(options.readPoolOptions.byteCount / memory::megabyte).
+                    arg(options.readPoolOptions.idleTimeout.count()));
+                lines.push_back(string::Format("    Read ahead count: {0}").
+                    arg(options.readAheadCount));
                 for (const auto& i : options.ioOptions)
                 {
                     lines.push_back(string::Format("    AV I/O {0}: {1}").
@@ -107,7 +113,7 @@ namespace tl
                 {}
             }
             p.options = options;
-            p.readCache.setMax(readCacheMax);
+            p.readPool = ReadPool::create(options.readPoolOptions);
 
             // Get information about the timeline.
             p.timeRange = timeline::getTimeRange(p.otioTimeline.value);
@@ -198,6 +204,10 @@ namespace tl
             {
                 p.thread.thread.join();
             }
+
+            // Destroy the readers while the request callbacks are still
+            // valid.
+            p.readPool->clear();
         }
 
         const std::weak_ptr<system::Context>& Timeline::getContext() const
@@ -251,9 +261,15 @@ namespace tl
             return _p->ioInfo;
         }
 
+        ReadPoolStats Timeline::getReadPoolStats() const
+        {
+            return _p->readPool->getStats();
+        }
+
         VideoRequest Timeline::getVideo(
             const otime::RationalTime& time,
-            const io::Options& options)
+            const io::Options& options,
+            const std::function<void(void)>& callback)
         {
             TLRENDER_P();
             (p.requestId)++;
@@ -261,6 +277,7 @@ namespace tl
             request->id = p.requestId;
             request->time = time;
             request->options = options;
+            request->callback = callback;
             VideoRequest out;
             out.id = p.requestId;
             out.future = request->promise.get_future();
@@ -280,13 +297,18 @@ namespace tl
             else
             {
                 request->promise.set_value(VideoData());
+                if (request->callback)
+                {
+                    request->callback();
+                }
             }
             return out;
         }
 
         AudioRequest Timeline::getAudio(
             double seconds,
-            const io::Options& options)
+            const io::Options& options,
+            const std::function<void(void)>& callback)
         {
             TLRENDER_P();
             (p.requestId)++;
@@ -294,6 +316,7 @@ namespace tl
             request->id = p.requestId;
             request->seconds = seconds;
             request->options = options;
+            request->callback = callback;
             AudioRequest out;
             out.id = p.requestId;
             out.future = request->promise.get_future();
@@ -313,6 +336,10 @@ namespace tl
             else
             {
                 request->promise.set_value(AudioData());
+                if (request->callback)
+                {
+                    request->callback();
+                }
             }
             return out;
         }
@@ -320,37 +347,67 @@ namespace tl
         void Timeline::cancelRequests(const std::vector<uint64_t>& ids)
         {
             TLRENDER_P();
-            std::unique_lock<std::mutex> lock(p.mutex.mutex);
             {
-                auto i = p.mutex.videoRequests.begin();
-                while (i != p.mutex.videoRequests.end())
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                std::vector<uint64_t> pending;
                 {
-                    const auto j = std::find(ids.begin(), ids.end(), (*i)->id);
-                    if (j != ids.end())
+                    auto i = p.mutex.videoRequests.begin();
+                    while (i != p.mutex.videoRequests.end())
                     {
-                        i = p.mutex.videoRequests.erase(i);
-                    }
-                    else
-                    {
-                        ++i;
+                        const auto j = std::find(ids.begin(), ids.end(), (*i)->id);
+                        if (j != ids.end())
+                        {
+                            pending.push_back((*i)->id);
+                            i = p.mutex.videoRequests.erase(i);
+                        }
+                        else
+                        {
+                            ++i;
+                        }
                     }
                 }
-            }
-            {
-                auto i = p.mutex.audioRequests.begin();
-                while (i != p.mutex.audioRequests.end())
                 {
-                    const auto j = std::find(ids.begin(), ids.end(), (*i)->id);
-                    if (j != ids.end())
+                    auto i = p.mutex.audioRequests.begin();
+                    while (i != p.mutex.audioRequests.end())
                     {
-                        i = p.mutex.audioRequests.erase(i);
+                        const auto j = std::find(ids.begin(), ids.end(), (*i)->id);
+                        if (j != ids.end())
+                        {
+                            pending.push_back((*i)->id);
+                            i = p.mutex.audioRequests.erase(i);
+                        }
+                        else
+                        {
+                            ++i;
+                        }
                     }
-                    else
+                }
+
+                // The other requests may be in progress, so their reads
+                // are canceled by the thread.
+                std::sort(pending.begin(), pending.end());
+                for (const auto id : ids)
+                {
+                    if (!std::binary_search(pending.begin(), pending.end(), id))
                     {
-                        ++i;
+                        p.mutex.canceled.push_back(id);
                     }
                 }
             }
+            p.thread.cv.notify_one();
+        }
+
+        void Timeline::setPlaybackHint(const io::PlaybackHint& value)
+        {
+            TLRENDER_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                if (value == p.mutex.playbackHint)
+                    return;
+                p.mutex.playbackHint = value;
+                p.mutex.playbackHintChanged = true;
+            }
+            p.thread.cv.notify_one();
         }
 
         void Timeline::tick()
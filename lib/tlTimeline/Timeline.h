@@ -5,6 +5,7 @@
 #pragma once
 
 #include <tlTimeline/Audio.h>
+#include <tlTimeline/ReadPool.h>
 #include <tlTimeline/Video.h>
 
 #include <tlCore/Context.h>
@@ -13,6 +14,7 @@
 
 #include <opentimelineio/timeline.h>
 
+#include <functional>
 #include <future>
 
 namespace tl
@@ -45,6 +47,13 @@ namespace tl
             size_t audioRequestCount = 16;
             std::chrono::milliseconds requestTimeout = std::chrono::milliseconds(5);
 
+            //! Reader pool options.
+            ReadPoolOptions readPoolOptions;
+
+            //! Number of upcoming clips on each track that have their
+            //! readers opened ahead of the playback time.
+            size_t readAheadCount = 2;
+
             io::Options ioOptions;
 
             file::PathOptions pathOptions;
@@ -167,24 +176,37 @@ namespace tl
             //! the first clip in the timeline.
             const io::Info& getIOInfo() const;
 
+            //! Get the reader pool statistics.
+            ReadPoolStats getReadPoolStats() const;
+
             ///@}
 
             //! \name Video and Audio Data
             ///@{
 
-            //! Get video data.
+            //! Get video data. The optional callback is called when the
+            //! request is finished, usually from the timeline thread.
             VideoRequest getVideo(
                 const otime::RationalTime&,
-                const io::Options& = io::Options());
+                const io::Options& = io::Options(),
+                const std::function<void(void)>& callback = nullptr);
 
-            //! Get audio data.
+            //! Get audio data. The optional callback is called when the
+            //! request is finished, usually from the timeline thread.
             AudioRequest getAudio(
                 double seconds,
-                const io::Options& = io::Options());
+                const io::Options& = io::Options(),
+                const std::function<void(void)>& callback = nullptr);
 
-            //! Cancel requests.
+            //! Cancel requests. Requests that are in progress have their
+            //! reads canceled, and are finished with the data that has been
+            //! read.
             void cancelRequests(const std::vector<uint64_t>&);
 
+            //! Set the playback hint used to prioritize requests. The hint
+            //! is passed on to the readers in their media time.
+            void setPlaybackHint(const io::PlaybackHint&);
+
             ///@}
 
             //! Tick the timeline.
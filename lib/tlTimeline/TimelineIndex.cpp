@@ -0,0 +1,160 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlTimeline/TimelineIndex.h>
+
+#include <algorithm>
+
+namespace tl
+{
+    namespace timeline
+    {
+        TrackIndex::TrackIndex()
+        {}
+
+        TrackIndex::TrackIndex(const otio::Track* track) :
+            _track(track)
+        {
+            if (!track)
+                return;
+
+            // Get the ranges of all of the children at once, since getting
+            // the range of each child separately traverses the track.
+            otio::ErrorStatus errorStatus;
+            const auto ranges = track->range_of_all_children(&errorStatus);
+            if (otio::is_error(errorStatus))
+                return;
+            const auto& sourceRange = track->source_range();
+
+            const auto& children = track->children();
+            for (size_t i = 0; i < children.size(); ++i)
+            {
+                auto otioItem = dynamic_cast<const otio::Item*>(children[i].value);
+                if (!otioItem)
+                    continue;
+                const auto j = ranges.find(children[i].value);
+                if (j == ranges.end())
+                    continue;
+
+                // Trim the range by the track source range, the same as
+                // otio::Item::trimmed_range_in_parent().
+                otime::TimeRange range = j->second;
+                if (sourceRange.has_value())
+                {
+                    const otime::TimeRange& trim = sourceRange.value();
+                    if (trim.start_time() >= range.end_time_exclusive() ||
+                        trim.end_time_exclusive() <= range.start_time())
+                        continue;
+                    range = otime::TimeRange::range_from_start_end_time(
+                        std::max(range.start_time(), trim.start_time()),
+                        std::min(range.end_time_exclusive(), trim.end_time_exclusive()));
+                }
+
+                TrackIndexItem item;
+                item.item = otioItem;
+                item.clip = dynamic_cast<const otio::Clip*>(otioItem);
+                item.range = range;
+                if (i > 0)
+                {
+                    item.inTransition = dynamic_cast<const otio::Transition*>(children[i - 1].value);
+                    if (item.inTransition && i > 1)
+                    {
+                        item.inClip = dynamic_cast<const otio::Clip*>(children[i - 2].value);
+                    }
+                }
+                if (i + 1 < children.size())
+                {
+                    item.outTransition = dynamic_cast<const otio::Transition*>(children[i + 1].value);
+                    if (item.outTransition && i + 2 < children.size())
+                    {
+                        item.outClip = dynamic_cast<const otio::Clip*>(children[i + 2].value);
+                    }
+                }
+                _items.push_back(item);
+            }
+        }
+
+        const otio::Track* TrackIndex::getTrack() const
+        {
+            return _track;
+        }
+
+        const std::vector<TrackIndexItem>& TrackIndex::getItems() const
+        {
+            return _items;
+        }
+
+        const TrackIndexItem* TrackIndex::getItem(const otime::RationalTime& value) const
+        {
+            // Find the last item that starts at or before the time.
+            auto i = std::upper_bound(
+                _items.begin(),
+                _items.end(),
+                value,
+                [](const otime::RationalTime& value, const TrackIndexItem& item)
+                {
+                    return value < item.range.start_time();
+                });
+            while (i != _items.begin())
+            {
+                --i;
+                if (i->range.contains(value))
+                    return &*i;
+                if (i->range.duration().value() > 0.0)
+                    break;
+            }
+            return nullptr;
+        }
+
+        std::vector<const TrackIndexItem*> TrackIndex::getItems(const otime::TimeRange& value) const
+        {
+            std::vector<const TrackIndexItem*> out;
+
+            // Find the first item that ends at or after the start of the
+            // range.
+            const otime::RationalTime start = value.start_time();
+            const otime::RationalTime end = value.end_time_exclusive();
+            auto i = std::lower_bound(
+                _items.begin(),
+                _items.end(),
+                start,
+                [](const TrackIndexItem& item, const otime::RationalTime& value)
+                {
+                    return item.range.end_time_exclusive() < value;
+                });
+            for (; i != _items.end() && i->range.start_time() <= end; ++i)
+            {
+                out.push_back(&*i);
+            }
+            return out;
+        }
+
+        TimelineIndex::TimelineIndex()
+        {}
+
+        TimelineIndex::TimelineIndex(const otio::Timeline* timeline)
+        {
+            if (!timeline)
+                return;
+            for (const auto& otioTrack : timeline->video_tracks())
+            {
+                _videoTracks.push_back(TrackIndex(otioTrack.value));
+            }
+            for (const auto& otioTrack : timeline->audio_tracks())
+            {
+                _audioTracks.push_back(TrackIndex(otioTrack.value));
+            }
+        }
+
+        const std::vector<TrackIndex>& TimelineIndex::getVideoTracks() const
+        {
+            return _videoTracks;
+        }
+
+        const std::vector<TrackIndex>& TimelineIndex::getAudioTracks() const
+        {
+            return _audioTracks;
+        }
+    }
+}
@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlCore/Time.h>
+
+#include <opentimelineio/clip.h>
+#include <opentimelineio/timeline.h>
+#include <opentimelineio/transition.h>
+
+namespace tl
+{
+    namespace timeline
+    {
+        //! Track index item.
+        struct TrackIndexItem
+        {
+            //! The item.
+            const otio::Item* item = nullptr;
+
+            //! The clip, or null if the item is not a clip.
+            const otio::Clip* clip = nullptr;
+
+            //! The trimmed range of the item in the track.
+            otime::TimeRange range;
+
+            //! The transition before the item, and the clip before the
+            //! transition.
+            const otio::Transition* inTransition = nullptr;
+            const otio::Clip* inClip = nullptr;
+
+            //! The transition after the item, and the clip after the
+            //! transition.
+            const otio::Transition* outTransition = nullptr;
+            const otio::Clip* outClip = nullptr;
+        };
+
+        //! Track index.
+        //!
+        //! The items of a track are stored in time order with their
+        //! trimmed ranges and neighboring transitions, so the items at a
+        //! given time can be found with a binary search instead of
+        //! traversing the track.
+        class TrackIndex
+        {
+        public:
+            TrackIndex();
+            explicit TrackIndex(const otio::Track*);
+
+            //! Get the track.
+            const otio::Track* getTrack() const;
+
+            //! Get the items.
+            const std::vector<TrackIndexItem>& getItems() const;
+
+            //! Get the item that contains the given time, or null if there
+            //! is no item.
+            const TrackIndexItem* getItem(const otime::RationalTime&) const;
+
+            //! Get the items that may intersect the given time range. The
+            //! items that touch the start or end of the range are included,
+            //! so the caller can apply its own intersection test.
+            std::vector<const TrackIndexItem*> getItems(const otime::TimeRange&) const;
+
+        private:
+            const otio::Track* _track = nullptr;
+            std::vector<TrackIndexItem> _items;
+        };
+
+        //! Timeline index.
+        class TimelineIndex
+        {
+        public:
+            TimelineIndex();
+            explicit TimelineIndex(const otio::Timeline*);
+
+            //! Get the video track indexes.
+            const std::vector<TrackIndex>& getVideoTracks() const;
+
+            //! Get the audio track indexes.
+            const std::vector<TrackIndex>& getAudioTracks() const;
+
+        private:
+            std::vector<TrackIndex> _videoTracks;
+            std::vector<TrackIndex> _audioTracks;
+        };
+    }
+}
@@ -13,15 +13,13 @@
 
 #include <opentimelineio/transition.h>
 
+#include <algorithm>
+#include <map>
+
 namespace tl
 {
     namespace timeline
     {
-        namespace
-        {
-            const std::chrono::milliseconds timeout(5);
-        }
-
         bool Timeline::Private::getVideoInfo(const otio::Composable* composable)
         {
             if (auto clip = dynamic_cast<const otio::Clip*>(composable))
@@ -89,16 +87,17 @@ namespace tl
 
         void Timeline::Private::tick()
         {
-            const auto t0 = std::chrono::steady_clock::now();
-
             requests();
 
+            // Close the readers that are no longer used.
+            const auto now = std::chrono::steady_clock::now();
+            readPool->evictIdle(now);
+
             // Logging.
-            auto t1 = std::chrono::steady_clock::now();
-            const std::chrono::duration<float> diff = t1 - thread.logTimer;
+            const std::chrono::duration<float> diff = now - thread.logTimer;
             if (diff.count() > 10.F)
             {
-                thread.logTimer = t1;
+                thread.logTimer = now;
                 if (auto context = this->context.lock())
                 {
                     size_t videoRequestsSize = 0;
@@ -108,6 +107,7 @@ namespace tl
                         videoRequestsSize = mutex.videoRequests.size();
                         audioRequestsSize = mutex.audioRequests.size();
                     }
+                    const ReadPoolStats readPoolStats = readPool->getStats();
                     auto logSystem = context->getLogSystem();
                     logSystem->print(
                         string::Format("tl::timeline::Timeline {0}").arg(this),
@@ -115,20 +115,24 @@ namespace tl
                         "\n"
                         "    Path: {0}\n"
                         "    Video requests: {1}, {2} in-progress, {3} max\n"
-                        "    Audio requests: {4}, {5} in-progress, {6} max").
+                        "    Audio requests: {4}, {5} in-progress, {6} max\n"
+                        "    Readers: {7}, {8} files, {9}MB\n"
+                        "    Reader opens: {10}, {11} hits, {12} evicted").
                         arg(path.get()).
                         arg(videoRequestsSize).
                         arg(thread.videoRequestsInProgress.size()).
                         arg(options.videoRequestCount).
                         arg(audioRequestsSize).
                         arg(thread.audioRequestsInProgress.size()).
-                        arg(options.audioRequestCount));
+                        arg(options.audioRequestCount).
+                        arg(readPoolStats.readerCount).
+                        arg(readPoolStats.fileCount).
+                        arg(readPoolStats.byteCount / memory::megabyte).
+                        arg(readPoolStats.openCount).
+                        arg(readPoolStats.hitCount).
+                        arg(readPoolStats.evictCount));
                 }
-                t1 = std::chrono::steady_clock::now();
             }
-
-            // Sleep for a bit.
-            time::sleep(timeout, t0, t1);
         }
 
         void Timeline::Private::requests()
@@ -136,31 +140,95 @@ namespace tl
             // Gather requests.
             std::list<std::shared_ptr<VideoRequest> > newVideoRequests;
             std::list<std::shared_ptr<AudioRequest> > newAudioRequests;
+            bool otioTimelineChanged = false;
+            bool playbackHintChanged = false;
+            std::list<std::shared_ptr<VideoRequest> > canceledVideoRequests;
+            std::vector<uint64_t> videoReady;
+            std::vector<uint64_t> audioReady;
+            std::vector<uint64_t> canceled;
             {
+                // Wait for new requests, or for reads to finish. Requests
+                // are only taken while there is room for them in progress.
                 std::unique_lock<std::mutex> lock(mutex.mutex);
-                thread.cv.wait_for(
+                const bool timeout = !thread.cv.wait_for(
                     lock,
                     options.requestTimeout,
                     [this]
                     {
                         return
                             mutex.otioTimeline.value ||
-                            !mutex.videoRequests.empty() ||
-                            !thread.videoRequestsInProgress.empty() ||
-                            !mutex.audioRequests.empty() ||
-                            !thread.audioRequestsInProgress.empty();
+                            mutex.playbackHintChanged ||
+                            (!mutex.videoRequests.empty() &&
+                                thread.videoRequestsInProgress.size() < options.videoRequestCount) ||
+                            (!mutex.audioRequests.empty() &&
+                                thread.audioRequestsInProgress.size() < options.audioRequestCount) ||
+                            !mutex.videoReady.empty() ||
+                            !mutex.audioReady.empty() ||
+                            !mutex.canceled.empty();
                     });
+                videoReady = std::move(mutex.videoReady);
+                mutex.videoReady.clear();
+                audioReady = std::move(mutex.audioReady);
+                mutex.audioReady.clear();
+                canceled = std::move(mutex.canceled);
+                mutex.canceled.clear();
+                if (timeout)
+                {
+                    // Check all of the requests in progress in case a
+                    // reader does not call the request callback.
+                    for (const auto& i : thread.videoRequestsInProgress)
+                    {
+                        videoReady.push_back(i.first);
+                    }
+                    for (const auto& i : thread.audioRequestsInProgress)
+                    {
+                        audioReady.push_back(i.first);
+                    }
+                }
                 if (mutex.otioTimeline.value)
                 {
                     thread.otioTimeline = mutex.otioTimeline;
                     mutex.otioTimeline = nullptr;
                     mutex.otioTimelineChanged = true;
+                    otioTimelineChanged = true;
+                }
+                if (mutex.playbackHintChanged)
+                {
+                    thread.playbackHint = mutex.playbackHint;
+                    mutex.playbackHintChanged = false;
+                    playbackHintChanged = true;
+
+                    // Cancel the pending requests that are no longer needed.
+                    auto i = mutex.videoRequests.begin();
+                    while (i != mutex.videoRequests.end())
+                    {
+                        if (!io::contains(thread.playbackHint, (*i)->time))
+                        {
+                            canceledVideoRequests.push_back(*i);
+                            i = mutex.videoRequests.erase(i);
+                        }
+                        else
+                        {
+                            ++i;
+                        }
+                    }
                 }
                 while (!mutex.videoRequests.empty() &&
                     (thread.videoRequestsInProgress.size() + newVideoRequests.size()) < options.videoRequestCount)
                 {
-                    newVideoRequests.push_back(mutex.videoRequests.front());
-                    mutex.videoRequests.pop_front();
+                    // Take the request with the highest priority.
+                    const io::PlaybackHint& hint = thread.playbackHint;
+                    const auto i = std::min_element(
+                        mutex.videoRequests.begin(),
+                        mutex.videoRequests.end(),
+                        [&hint](
+                            const std::shared_ptr<VideoRequest>& a,
+                            const std::shared_ptr<VideoRequest>& b)
+                        {
+                            return io::getPriority(hint, a->time) < io::getPriority(hint, b->time);
+                        });
+                    newVideoRequests.push_back(*i);
+                    mutex.videoRequests.erase(i);
                 }
                 while (!mutex.audioRequests.empty() &&
                     (thread.audioRequestsInProgress.size() + newAudioRequests.size()) < options.audioRequestCount)
@@ -170,65 +238,120 @@ namespace tl
                 }
             }
 
+            // Index the timeline when it changes.
+            if (otioTimelineChanged)
+            {
+                thread.index = TimelineIndex(thread.otioTimeline.value);
+                thread.clipData.clear();
+            }
+
+            // Finish the canceled requests.
+            for (auto& request : canceledVideoRequests)
+            {
+                VideoData data;
+                data.time = request->time;
+                data.canceled = true;
+                request->promise.set_value(data);
+                if (request->callback)
+                {
+                    request->callback();
+                }
+            }
+
+            // Cancel the reads for the in-progress requests that are no
+            // longer needed. The readers skip the canceled reads, and the
+            // requests are finished when the reads are ready.
+            for (const auto id : canceled)
+            {
+                const auto i = thread.videoRequestsInProgress.find(id);
+                if (i != thread.videoRequestsInProgress.end())
+                {
+                    i->second->readRequest->canceled = true;
+                }
+                const auto j = thread.audioRequestsInProgress.find(id);
+                if (j != thread.audioRequestsInProgress.end())
+                {
+                    j->second->readRequest->canceled = true;
+                }
+            }
+            if (playbackHintChanged)
+            {
+                for (const auto& i : thread.videoRequestsInProgress)
+                {
+                    if (!io::contains(thread.playbackHint, i.second->time))
+                    {
+                        i.second->readRequest->canceled = true;
+                    }
+                }
+            }
+
+            // Open the readers for the upcoming clips, and pass the
+            // playback hint to the readers.
+            if (playbackHintChanged)
+            {
+                readAhead();
+                playbackHintUpdate();
+            }
+
             // Traverse the timeline for new video requests.
             for (auto& request : newVideoRequests)
             {
+                request->readRequest = std::make_shared<io::ReadRequest>();
+                const uint64_t id = request->id;
+                request->readRequest->callback = [this, id]
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(mutex.mutex);
+                        mutex.videoReady.push_back(id);
+                    }
+                    thread.cv.notify_one();
+                };
                 try
                 {
-                    for (const auto& otioTrack : thread.otioTimeline->video_tracks())
+                    const auto requestTime = request->time - timeRange.start_time();
+                    for (const auto& track : thread.index.getVideoTracks())
                     {
-                        for (const auto& otioChild : otioTrack->children())
+                        const TrackIndexItem* item = track.getItem(requestTime);
+                        if (!item)
+                            continue;
+                        const otime::TimeRange& range = item->range;
+                        VideoLayerData videoData;
+                        if (item->clip)
+                        {
+                            videoData.image = readVideo(item->clip, requestTime, request->options, request->readRequest, request->reads);
+                        }
+                        if (auto otioTransition = item->outTransition)
+                        {
+                            if (requestTime > range.end_time_inclusive() - otioTransition->in_offset())
+                            {
+                                videoData.transition = toTransition(otioTransition->transition_type());
+                                videoData.transitionValue = transitionValue(
+                                    requestTime.value(),
+                                    range.end_time_inclusive().value() - otioTransition->in_offset().value(),
+                                    range.end_time_inclusive().value() + otioTransition->out_offset().value() + 1.0);
+                                if (item->outClip)
+                                {
+                                    videoData.imageB = readVideo(item->outClip, requestTime, request->options, request->readRequest, request->reads);
+                                }
+                            }
+                        }
+                        if (auto otioTransition = item->inTransition)
                         {
-                            if (auto otioItem = dynamic_cast<otio::Item*>(otioChild.value))
+                            if (requestTime < range.start_time() + otioTransition->out_offset())
                             {
-                                const auto requestTime = request->time - timeRange.start_time();
-                                otio::ErrorStatus errorStatus;
-                                const auto range = otioItem->trimmed_range_in_parent(&errorStatus);
-                                if (range.has_value() && range.value().contains(requestTime))
+                                std::swap(videoData.image, videoData.imageB);
+                                videoData.transition = toTransition(otioTransition->transition_type());
+                                videoData.transitionValue = transitionValue(
+                                    requestTime.value(),
+                                    range.start_time().value() - otioTransition->in_offset().value() - 1.0,
+                                    range.start_time().value() + otioTransition->out_offset().value());
+                                if (item->inClip)
                                 {
-                                    VideoLayerData videoData;
-                                    if (auto otioClip = dynamic_cast<const otio::Clip*>(otioItem))
-                                    {
-                                        videoData.image = readVideo(otioClip, requestTime, request->options);
-                                    }
-                                    const auto neighbors = otioTrack->neighbors_of(otioItem, &errorStatus);
-                                    if (auto otioTransition = dynamic_cast<otio::Transition*>(neighbors.second.value))
-                                    {
-                                        if (requestTime > range.value().end_time_inclusive() - otioTransition->in_offset())
-                                        {
-                                            videoData.transition = toTransition(otioTransition->transition_type());
-                                            videoData.transitionValue = transitionValue(
-                                                requestTime.value(),
-                                                range.value().end_time_inclusive().value() - otioTransition->in_offset().value(),
-                                                range.value().end_time_inclusive().value() + otioTransition->out_offset().value() + 1.0);
-                                            const auto transitionNeighbors = otioTrack->neighbors_of(otioTransition, &errorStatus);
-                                            if (const auto otioClipB = dynamic_cast<otio::Clip*>(transitionNeighbors.second.value))
-                                            {
-                                                videoData.imageB = readVideo(otioClipB, requestTime, request->options);
-                                            }
-                                        }
-                                    }
-                                    if (auto otioTransition = dynamic_cast<otio::Transition*>(neighbors.first.value))
-                                    {
-                                        if (requestTime < range.value().start_time() + otioTransition->out_offset())
-                                        {
-                                            std::swap(videoData.image, videoData.imageB);
-                                            videoData.transition = toTransition(otioTransition->transition_type());
-                                            videoData.transitionValue = transitionValue(
-                                                requestTime.value(),
-                                                range.value().start_time().value() - otioTransition->in_offset().value() - 1.0,
-                                                range.value().start_time().value() + otioTransition->out_offset().value());
-                                            const auto transitionNeighbors = otioTrack->neighbors_of(otioTransition, &errorStatus);
-                                            if (const auto otioClipB = dynamic_cast<otio::Clip*>(transitionNeighbors.first.value))
-                                            {
-                                                videoData.image = readVideo(otioClipB, requestTime, request->options);
-                                            }
-                                        }
-                                    }
-                                    request->layerData.push_back(std::move(videoData));
+                                    videoData.image = readVideo(item->inClip, requestTime, request->options, request->readRequest, request->reads);
                                 }
                             }
                         }
+                        request->layerData.push_back(std::move(videoData));
                     }
                 }
                 catch (const std::exception&)
@@ -236,51 +359,58 @@ namespace tl
                     //! \todo How should this be handled?
                 }
 
-                thread.videoRequestsInProgress.push_back(request);
+                // Requests without reads are finished immediately.
+                thread.videoRequestsInProgress[request->id] = request;
+                videoReady.push_back(request->id);
             }
 
             // Traverse the timeline for new audio requests.
             for (auto& request : newAudioRequests)
             {
+                request->readRequest = std::make_shared<io::ReadRequest>();
+                const uint64_t id = request->id;
+                request->readRequest->callback = [this, id]
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(mutex.mutex);
+                        mutex.audioReady.push_back(id);
+                    }
+                    thread.cv.notify_one();
+                };
                 try
                 {
-                    for (const auto& otioTrack : thread.otioTimeline->audio_tracks())
+                    const double start = request->seconds -
+                        timeRange.start_time().rescaled_to(1.0).value();
+                    const otime::TimeRange requestTimeRange = otime::TimeRange(
+                        otime::RationalTime(start, 1.0),
+                        otime::RationalTime(1.0, 1.0));
+                    for (const auto& track : thread.index.getAudioTracks())
                     {
-                        for (const auto& otioChild : otioTrack->children())
+                        for (const auto item : track.getItems(requestTimeRange))
                         {
-                            if (auto otioClip = dynamic_cast<otio::Clip*>(otioChild.value))
+                            if (!item->clip)
+                                continue;
+                            const otime::TimeRange clipTimeRange(
+                                item->range.start_time().rescaled_to(1.0),
+                                item->range.duration().rescaled_to(1.0));
+                            if (requestTimeRange.intersects(clipTimeRange))
                             {
-                                const auto rangeOptional = otioClip->trimmed_range_in_parent();
-                                if (rangeOptional.has_value())
-                                {
-                                    const otime::TimeRange clipTimeRange(
-                                        rangeOptional.value().start_time().rescaled_to(1.0),
-                                        rangeOptional.value().duration().rescaled_to(1.0));
-                                    const double start = request->seconds -
-                                        timeRange.start_time().rescaled_to(1.0).value();
-                                    const otime::TimeRange requestTimeRange = otime::TimeRange(
-                                        otime::RationalTime(start, 1.0),
-                                        otime::RationalTime(1.0, 1.0));
-                                    if (requestTimeRange.intersects(clipTimeRange))
-                                    {
-                                        AudioLayerData audioData;
-                                        audioData.seconds = request->seconds;
-                                        //! \bug Why is otime::TimeRange::clamped() not giving us the
-                                        //! result we expect?
-                                        //audioData.timeRange = requestTimeRange.clamped(clipTimeRange);
-                                        const double start = std::max(
-                                            clipTimeRange.start_time().value(),
-                                            requestTimeRange.start_time().value());
-                                        const double end = std::min(
-                                            clipTimeRange.start_time().value() + clipTimeRange.duration().value(),
-                                            requestTimeRange.start_time().value() + requestTimeRange.duration().value());
-                                        audioData.timeRange = otime::TimeRange(
-                                            otime::RationalTime(start, 1.0),
-                                            otime::RationalTime(end - start, 1.0));
-                                        audioData.audio = readAudio(otioClip, audioData.timeRange, request->options);
-                                        request->layerData.push_back(std::move(audioData));
-                                    }
-                                }
+                                AudioLayerData audioData;
+                                audioData.seconds = request->seconds;
+                                //! \bug Why is otime::TimeRange::clamped() not giving us the
+                                //! result we expect?
+                                //audioData.timeRange = requestTimeRange.clamped(clipTimeRange);
+                                const double start = std::max(
+                                    clipTimeRange.start_time().value(),
+                                    requestTimeRange.start_time().value());
+                                const double end = std::min(
+                                    clipTimeRange.start_time().value() + clipTimeRange.duration().value(),
+                                    requestTimeRange.start_time().value() + requestTimeRange.duration().value());
+                                audioData.timeRange = otime::TimeRange(
+                                    otime::RationalTime(start, 1.0),
+                                    otime::RationalTime(end - start, 1.0));
+                                audioData.audio = readAudio(item->clip, audioData.timeRange, request->options, request->readRequest, request->reads);
+                                request->layerData.push_back(std::move(audioData));
                             }
                         }
                     }
@@ -290,103 +420,130 @@ namespace tl
                     //! \todo How should this be handled?
                 }
 
-                thread.audioRequestsInProgress.push_back(request);
+                thread.audioRequestsInProgress[request->id] = request;
+                audioReady.push_back(request->id);
             }
 
-            // Check for finished video requests.
-            auto videoRequestIt = thread.videoRequestsInProgress.begin();
-            while (videoRequestIt != thread.videoRequestsInProgress.end())
+            // Finish the requests in the ready queue.
+            for (const auto id : videoReady)
             {
-                bool valid = true;
-                for (auto& i : (*videoRequestIt)->layerData)
+                const auto i = thread.videoRequestsInProgress.find(id);
+                if (i != thread.videoRequestsInProgress.end() && isReady(i->second))
                 {
-                    if (i.image.valid())
-                    {
-                        valid &= i.image.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
-                    }
-                    if (i.imageB.valid())
-                    {
-                        valid &= i.imageB.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
-                    }
+                    finishRequest(i->second);
+                    thread.videoRequestsInProgress.erase(i);
                 }
-                if (valid)
+            }
+            for (const auto id : audioReady)
+            {
+                const auto i = thread.audioRequestsInProgress.find(id);
+                if (i != thread.audioRequestsInProgress.end() && isReady(i->second))
                 {
-                    VideoData data;
-                    if (!ioInfo.video.empty())
-                    {
-                        data.size = ioInfo.video.front().size;
-                    }
-                    data.time = (*videoRequestIt)->time;
-                    try
-                    {
-                        for (auto& j : (*videoRequestIt)->layerData)
-                        {
-                            VideoLayer layer;
-                            if (j.image.valid())
-                            {
-                                layer.image = j.image.get().image;
-                            }
-                            if (j.imageB.valid())
-                            {
-                                layer.imageB = j.imageB.get().image;
-                            }
-                            layer.transition = j.transition;
-                            layer.transitionValue = j.transitionValue;
-                            data.layers.push_back(layer);
-                        }
-                    }
-                    catch (const std::exception&)
-                    {
-                        //! \todo How should this be handled?
-                    }
-                    (*videoRequestIt)->promise.set_value(data);
-                    videoRequestIt = thread.videoRequestsInProgress.erase(videoRequestIt);
-                    continue;
+                    finishRequest(i->second);
+                    thread.audioRequestsInProgress.erase(i);
+                }
+            }
+        }
+
+        bool Timeline::Private::isReady(const std::shared_ptr<VideoRequest>& request) const
+        {
+            bool out = true;
+            for (const auto& i : request->layerData)
+            {
+                if (i.image.valid())
+                {
+                    out &= i.image.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+                }
+                if (i.imageB.valid())
+                {
+                    out &= i.imageB.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+                }
+            }
+            return out;
+        }
+
+        bool Timeline::Private::isReady(const std::shared_ptr<AudioRequest>& request) const
+        {
+            bool out = true;
+            for (const auto& i : request->layerData)
+            {
+                if (i.audio.valid())
+                {
+                    out &= i.audio.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
                 }
-                ++videoRequestIt;
             }
+            return out;
+        }
 
-            // Check for finished audio requests.
-            auto audioRequestIt = thread.audioRequestsInProgress.begin();
-            while (audioRequestIt != thread.audioRequestsInProgress.end())
+        void Timeline::Private::finishRequest(const std::shared_ptr<VideoRequest>& request)
+        {
+            VideoData data;
+            if (!ioInfo.video.empty())
             {
-                bool valid = true;
-                for (auto& i : (*audioRequestIt)->layerData)
+                data.size = ioInfo.video.front().size;
+            }
+            data.time = request->time;
+            try
+            {
+                for (auto& j : request->layerData)
                 {
-                    if (i.audio.valid())
+                    VideoLayer layer;
+                    if (j.image.valid())
+                    {
+                        const auto videoData = j.image.get();
+                        layer.image = videoData.image;
+                        data.canceled |= videoData.canceled;
+                    }
+                    if (j.imageB.valid())
                     {
-                        valid &= i.audio.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+                        const auto videoData = j.imageB.get();
+                        layer.imageB = videoData.image;
+                        data.canceled |= videoData.canceled;
                     }
+                    layer.transition = j.transition;
+                    layer.transitionValue = j.transitionValue;
+                    data.layers.push_back(layer);
                 }
-                if (valid)
+            }
+            catch (const std::exception&)
+            {
+                //! \todo How should this be handled?
+            }
+            request->promise.set_value(data);
+            if (request->callback)
+            {
+                request->callback();
+            }
+        }
+
+        void Timeline::Private::finishRequest(const std::shared_ptr<AudioRequest>& request)
+        {
+            AudioData data;
+            data.seconds = request->seconds;
+            try
+            {
+                for (auto& j : request->layerData)
                 {
-                    AudioData data;
-                    data.seconds = (*audioRequestIt)->seconds;
-                    try
+                    AudioLayer layer;
+                    if (j.audio.valid())
                     {
-                        for (auto& j : (*audioRequestIt)->layerData)
+                        const auto audioData = j.audio.get();
+                        if (audioData.audio)
                         {
-                            AudioLayer layer;
-                            if (j.audio.valid())
-                            {
-                                const auto audioData = j.audio.get();
-                                if (audioData.audio)
-                                {
-                                    layer.audio = padAudioToOneSecond(audioData.audio, j.seconds, j.timeRange);
-                                }
-                            }
-                            data.layers.push_back(layer);
+                            layer.audio = padAudioToOneSecond(audioData.audio, j.seconds, j.timeRange);
                         }
                     }
-                    catch (const std::exception&)
-                    {
-                        //! \todo How should this be handled?
-                    }
-                    (*audioRequestIt)->promise.set_value(data);
-                    audioRequestIt = thread.audioRequestsInProgress.erase(audioRequestIt);
-                    continue;
+                    data.layers.push_back(layer);
                 }
-                ++audioRequestIt;
+            }
+            catch (const std::exception&)
+            {
+                //! \todo How should this be handled?
+            }
+            request->promise.set_value(data);
+            if (request->callback)
+            {
+                request->callback();
             }
         }
 
@@ -401,15 +558,15 @@ namespace tl
                     videoRequests = std::move(mutex.videoRequests);
                     audioRequests = std::move(mutex.audioRequests);
                 }
-                videoRequests.insert(
-                    videoRequests.begin(),
-                    thread.videoRequestsInProgress.begin(),
-                    thread.videoRequestsInProgress.end());
+                for (const auto& i : thread.videoRequestsInProgress)
+                {
+                    videoRequests.push_back(i.second);
+                }
                 thread.videoRequestsInProgress.clear();
-                audioRequests.insert(
-                    audioRequests.begin(),
-                    thread.audioRequestsInProgress.begin(),
-                    thread.audioRequestsInProgress.end());
+                for (const auto& i : thread.audioRequestsInProgress)
+                {
+                    audioRequests.push_back(i.second);
+                }
                 thread.audioRequestsInProgress.clear();
                 for (auto& request : videoRequests)
                 {
@@ -431,6 +588,10 @@ namespace tl
                         data.layers.push_back(layer);
                     }
                     request->promise.set_value(data);
+                    if (request->callback)
+                    {
+                        request->callback();
+                    }
                 }
                 for (auto& request : audioRequests)
                 {
@@ -446,6 +607,10 @@ namespace tl
                         data.layers.push_back(layer);
                     }
                     request->promise.set_value(data);
+                    if (request->callback)
+                    {
+                        request->callback();
+                    }
                 }
             }
         }
@@ -461,40 +626,262 @@ namespace tl
             }
         }
 
+        Timeline::Private::ClipData& Timeline::Private::getClipData(const otio::Clip* clip)
+        {
+            auto i = thread.clipData.find(clip);
+            if (i == thread.clipData.end())
+            {
+                ClipData data;
+                data.key = getKey(timeline::getPath(
+                    clip->media_reference(),
+                    this->path.getDirectory(),
+                    options.pathOptions));
+                i = thread.clipData.insert(std::make_pair(clip, std::move(data))).first;
+            }
+            return i->second;
+        }
+
+        void Timeline::Private::playbackHintUpdate()
+        {
+            // Find the clips that intersect the hint, and convert the hint
+            // to the media time of each clip. Clips that share a reader are
+            // combined.
+            std::map<std::shared_ptr<io::IRead>, io::PlaybackHint> hints;
+            const io::PlaybackHint& hint = thread.playbackHint;
+            const otime::RationalTime t = time::isValid(hint.time) ?
+                (hint.time - timeRange.start_time()) :
+                time::invalidTime;
+            std::vector<otime::TimeRange> ranges;
+            for (const auto& i : hint.ranges)
+            {
+                ranges.push_back(otime::TimeRange(
+                    i.start_time() - timeRange.start_time(),
+                    i.duration()));
+            }
+            for (const auto& track : thread.index.getVideoTracks())
+            {
+                std::vector<const TrackIndexItem*> items;
+                if (time::isValid(t))
+                {
+                    if (const TrackIndexItem* item = track.getItem(t))
+                    {
+                        items.push_back(item);
+                    }
+                }
+                for (const auto& r : ranges)
+                {
+                    for (const TrackIndexItem* item : track.getItems(r))
+                    {
+                        items.push_back(item);
+                    }
+                }
+                std::sort(items.begin(), items.end());
+                items.erase(std::unique(items.begin(), items.end()), items.end());
+                for (const TrackIndexItem* item : items)
+                {
+                    auto otioClip = item->clip;
+                    if (!otioClip)
+                        continue;
+                    ClipData& clipData = getClipData(otioClip);
+                    const auto read = readPool->peek(clipData.key);
+                    if (!read)
+                        continue;
+
+                    // Skip the readers that are still opening, instead of
+                    // waiting for their information.
+                    if (clipData.read.lock() != read)
+                    {
+                        clipData.read = read;
+                        clipData.info = read->getInfo();
+                        clipData.rate = 0.0;
+                    }
+                    if (clipData.info.valid() &&
+                        clipData.info.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                    {
+                        clipData.rate = clipData.info.get().videoTime.duration().rate();
+                    }
+                    if (clipData.rate <= 0.0)
+                        continue;
+                    const double rate = clipData.rate;
+
+                    const otime::TimeRange& range = item->range;
+                    auto& readHint = hints[read];
+                    readHint.direction = hint.direction;
+                    if (time::isValid(t))
+                    {
+                        if (!time::isValid(readHint.time) || range.contains(t))
+                        {
+                            const otime::RationalTime clamped = std::min(
+                                std::max(t, range.start_time()),
+                                range.end_time_inclusive());
+                            readHint.time = timeline::toVideoMediaTime(
+                                clamped,
+                                range,
+                                otioClip->trimmed_range(),
+                                rate);
+                        }
+                    }
+                    for (const auto& r : ranges)
+                    {
+                        if (r.intersects(range))
+                        {
+                            const otime::RationalTime start = std::max(
+                                r.start_time(),
+                                range.start_time());
+                            const otime::RationalTime end = std::min(
+                                r.end_time_inclusive(),
+                                range.end_time_inclusive());
+                            readHint.ranges.push_back(otime::TimeRange::range_from_start_end_time_inclusive(
+                                timeline::toVideoMediaTime(start, range, otioClip->trimmed_range(), rate),
+                                timeline::toVideoMediaTime(end, range, otioClip->trimmed_range(), rate)));
+                        }
+                    }
+                    if (!hint.ranges.empty() && readHint.ranges.empty())
+                    {
+                        // Keep an empty range so that the requests
+                        // outside of the hint are canceled.
+                        readHint.ranges.push_back(otime::TimeRange());
+                    }
+                }
+            }
+
+            // The readers that were given the previous hint, but no longer
+            // intersect it, are given an empty range so that their requests
+            // are canceled.
+            if (!hint.ranges.empty())
+            {
+                for (const auto& i : thread.hintReads)
+                {
+                    if (auto read = i.lock())
+                    {
+                        if (hints.find(read) == hints.end())
+                        {
+                            io::PlaybackHint readHint;
+                            readHint.direction = hint.direction;
+                            readHint.ranges.push_back(otime::TimeRange());
+                            hints[read] = readHint;
+                        }
+                    }
+                }
+            }
+            thread.hintReads.clear();
+            for (const auto& i : hints)
+            {
+                i.first->setPlaybackHint(i.second);
+                thread.hintReads.push_back(i.first);
+            }
+        }
+
+        void Timeline::Private::readAhead()
+        {
+            // Find the clips on each track that are next in the playback
+            // direction, and open their readers so they are ready when
+            // playback reaches them. Only the free capacity of the reader
+            // pool is used, so the readers for the current requests are not
+            // evicted.
+            const io::PlaybackHint& hint = thread.playbackHint;
+            if (!time::isValid(hint.time) || 0 == options.readAheadCount)
+                return;
+            size_t freeCount = readPool->getFreeCount();
+            if (0 == freeCount)
+                return;
+            const otime::RationalTime t = hint.time - timeRange.start_time();
+            std::vector<const TrackIndex*> tracks;
+            for (const auto& track : thread.index.getVideoTracks())
+            {
+                tracks.push_back(&track);
+            }
+            for (const auto& track : thread.index.getAudioTracks())
+            {
+                tracks.push_back(&track);
+            }
+            std::vector<const otio::Clip*> clips;
+            for (const auto track : tracks)
+            {
+                // The items are in time order, so the next items are found
+                // with a binary search.
+                const auto& items = track->getItems();
+                const auto next = std::partition_point(
+                    items.begin(),
+                    items.end(),
+                    [&t](const TrackIndexItem& item)
+                    {
+                        return item.range.start_time() <= t;
+                    });
+                size_t count = 0;
+                if (hint.direction >= 0)
+                {
+                    for (auto i = next; i != items.end() && count < options.readAheadCount; ++i)
+                    {
+                        if (i->clip)
+                        {
+                            clips.push_back(i->clip);
+                            ++count;
+                        }
+                    }
+                }
+                else
+                {
+                    for (auto i = std::make_reverse_iterator(next); i != items.rend() && count < options.readAheadCount; ++i)
+                    {
+                        if (i->clip && i->range.end_time_inclusive() < t)
+                        {
+                            clips.push_back(i->clip);
+                            ++count;
+                        }
+                    }
+                }
+            }
+            for (size_t i = 0; i < clips.size() && freeCount > 0; ++i)
+            {
+                if (!readPool->contains(getClipData(clips[i]).key))
+                {
+                    getRead(clips[i], options.ioOptions);
+                    --freeCount;
+                }
+            }
+        }
+
         std::shared_ptr<io::IRead> Timeline::Private::getRead(
             const otio::Clip* clip,
             const io::Options& ioOptions)
         {
-            std::shared_ptr<io::IRead> out;
             const auto path = timeline::getPath(
                 clip->media_reference(),
                 this->path.getDirectory(),
                 options.pathOptions);
-            const std::string key = getKey(path);
-            if (!readCache.get(key, out))
-            {
-                if (auto context = this->context.lock())
+            return readPool->get(
+                getKey(path),
+                [this, clip, path, ioOptions]
                 {
-                    const auto memoryRead = getMemoryRead(clip->media_reference());
-                    io::Options options = ioOptions;
-                    options["SequenceIO/DefaultSpeed"] = string::Format("{0}").arg(timeRange.duration().rate());
-                    const auto ioSystem = context->getSystem<io::System>();
-                    out = ioSystem->read(path, memoryRead, options);
-                    readCache.add(key, out);
-                }
-            }
-            return out;
+                    std::shared_ptr<io::IRead> out;
+                    if (auto context = this->context.lock())
+                    {
+                        const auto memoryRead = getMemoryRead(clip->media_reference());
+                        io::Options options = ioOptions;
+                        options["SequenceIO/DefaultSpeed"] = string::Format("{0}").arg(timeRange.duration().rate());
+                        const auto ioSystem = context->getSystem<io::System>();
+                        out = ioSystem->read(path, memoryRead, options);
+                    }
+                    return out;
+                });
         }
 
         std::future<io::VideoData> Timeline::Private::readVideo(
             const otio::Clip* clip,
             const otime::RationalTime& time,
-            const io::Options& options)
+            const io::Options& options,
+            const std::shared_ptr<io::ReadRequest>& readRequest,
+            std::vector<std::shared_ptr<io::IRead> >& reads)
         {
             std::future<io::VideoData> out;
             io::Options optionsMerged = io::merge(options, this->options.ioOptions);
             optionsMerged["USD/cameraName"] = clip->name();
             auto read = getRead(clip, optionsMerged);
+            if (read)
+            {
+                reads.push_back(read);
+            }
             const auto timeRangeOpt = clip->trimmed_range_in_parent();
             if (read && timeRangeOpt.has_value())
             {
@@ -504,7 +891,7 @@ namespace tl
                     timeRangeOpt.value(),
                     clip->trimmed_range(),
                     ioInfo.videoTime.duration().rate());
-                out = read->readVideo(mediaTime, optionsMerged);
+                out = read->readVideo(mediaTime, optionsMerged, readRequest);
             }
             return out;
         }
@@ -512,11 +899,17 @@ namespace tl
         std::future<io::AudioData> Timeline::Private::readAudio(
             const otio::Clip* clip,
             const otime::TimeRange& timeRange,
-            const io::Options& options)
+            const io::Options& options,
+            const std::shared_ptr<io::ReadRequest>& readRequest,
+            std::vector<std::shared_ptr<io::IRead> >& reads)
         {
             std::future<io::AudioData> out;
             io::Options optionsMerged = io::merge(options, this->options.ioOptions);
             auto read = getRead(clip, optionsMerged);
+            if (read)
+            {
+                reads.push_back(read);
+            }
             const auto timeRangeOpt = clip->trimmed_range_in_parent();
             if (read && timeRangeOpt.has_value())
             {
@@ -526,7 +919,7 @@ namespace tl
                     timeRangeOpt.value(),
                     clip->trimmed_range(),
                     ioInfo.audio.sampleRate);
-                out = read->readAudio(mediaRange, optionsMerged);
+                out = read->readAudio(mediaRange, optionsMerged, readRequest);
             }
             return out;
         }
@@ -5,15 +5,15 @@
 #pragma once
 
 #include <tlTimeline/Timeline.h>
+#include <tlTimeline/TimelineIndex.h>
 
 #include <tlIO/Plugin.h>
 
-#include <tlCore/LRUCache.h>
-
 #include <opentimelineio/clip.h>
 
 #include <atomic>
 #include <list>
+#include <map>
 #include <mutex>
 #include <thread>
 
@@ -32,17 +32,27 @@ namespace tl
             void requests();
             void finishRequests();
 
+            void playbackHintUpdate();
+            void readAhead();
+
+            struct ClipData;
+            ClipData& getClipData(const otio::Clip*);
+
             std::shared_ptr<io::IRead> getRead(
                 const otio::Clip*,
                 const io::Options&);
             std::future<io::VideoData> readVideo(
                 const otio::Clip*,
                 const otime::RationalTime&,
-                const io::Options&);
+                const io::Options&,
+                const std::shared_ptr<io::ReadRequest>&,
+                std::vector<std::shared_ptr<io::IRead> >&);
             std::future<io::AudioData> readAudio(
                 const otio::Clip*,
                 const otime::TimeRange&,
-                const io::Options&);
+                const io::Options&,
+                const std::shared_ptr<io::ReadRequest>&,
+                std::vector<std::shared_ptr<io::IRead> >&);
 
             std::shared_ptr<audio::Audio> padAudioToOneSecond(
                 const std::shared_ptr<audio::Audio>&,
@@ -55,7 +65,7 @@ namespace tl
             file::Path path;
             file::Path audioPath;
             Options options;
-            memory::LRUCache<std::string, std::shared_ptr<io::IRead> > readCache;
+            std::shared_ptr<ReadPool> readPool;
             otime::TimeRange timeRange = time::invalidTimeRange;
             io::Info ioInfo;
             uint64_t requestId = 0;
@@ -79,8 +89,17 @@ namespace tl
                 otime::RationalTime time = time::invalidTime;
                 io::Options options;
                 std::promise<VideoData> promise;
+                std::function<void(void)> callback;
 
+                // The read request is shared by the layers, and is used to
+                // cancel the reads and to add the request to the ready
+                // queue when a read is finished.
+                std::shared_ptr<io::ReadRequest> readRequest;
                 std::vector<VideoLayerData> layerData;
+
+                // The readers are held while the reads are in progress so
+                // they are not evicted from the reader pool.
+                std::vector<std::shared_ptr<io::IRead> > reads;
             };
 
             struct AudioLayerData
@@ -101,25 +120,57 @@ namespace tl
                 double seconds = -1.0;
                 io::Options options;
                 std::promise<AudioData> promise;
+                std::function<void(void)> callback;
 
+                std::shared_ptr<io::ReadRequest> readRequest;
                 std::vector<AudioLayerData> layerData;
+                std::vector<std::shared_ptr<io::IRead> > reads;
             };
 
+            bool isReady(const std::shared_ptr<VideoRequest>&) const;
+            bool isReady(const std::shared_ptr<AudioRequest>&) const;
+            void finishRequest(const std::shared_ptr<VideoRequest>&);
+            void finishRequest(const std::shared_ptr<AudioRequest>&);
+
             struct Mutex
             {
                 otio::SerializableObject::Retainer<otio::Timeline> otioTimeline;
                 bool otioTimelineChanged = false;
                 std::list<std::shared_ptr<VideoRequest> > videoRequests;
                 std::list<std::shared_ptr<AudioRequest> > audioRequests;
+                io::PlaybackHint playbackHint;
+                bool playbackHintChanged = false;
+
+                // Requests that have reads finished, and in-progress
+                // requests that have been canceled.
+                std::vector<uint64_t> videoReady;
+                std::vector<uint64_t> audioReady;
+                std::vector<uint64_t> canceled;
+
                 bool stopped = false;
                 std::mutex mutex;
             };
             Mutex mutex;
+            // The reader key and video rate of a clip, cached so they are
+            // not looked up for every playback hint. The rate is known
+            // once the information of the reader is ready.
+            struct ClipData
+            {
+                std::string key;
+                std::weak_ptr<io::IRead> read;
+                std::future<io::Info> info;
+                double rate = 0.0;
+            };
+
             struct Thread
             {
                 otio::SerializableObject::Retainer<otio::Timeline> otioTimeline;
-                std::list<std::shared_ptr<VideoRequest> > videoRequestsInProgress;
-                std::list<std::shared_ptr<AudioRequest> > audioRequestsInProgress;
+                TimelineIndex index;
+                std::map<const otio::Clip*, ClipData> clipData;
+                std::vector<std::weak_ptr<io::IRead> > hintReads;
+                std::map<uint64_t, std::shared_ptr<VideoRequest> > videoRequestsInProgress;
+                std::map<uint64_t, std::shared_ptr<AudioRequest> > audioRequestsInProgress;
+                io::PlaybackHint playbackHint;
                 std::condition_variable cv;
                 std::thread thread;
                 std::atomic<bool> running;
@@ -37,6 +37,10 @@ namespace tl
             otime::RationalTime time = time::invalidTime;
             std::vector<VideoLayer> layers;
 
+            //! Whether any of the reads were canceled. Canceled video data
+            //! is incomplete and should not be cached.
+            bool canceled = false;
+
             bool operator == (const VideoData&) const;
             bool operator != (const VideoData&) const;
         };
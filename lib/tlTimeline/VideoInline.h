@@ -27,7 +27,8 @@ namespace tl
             return
                 size == other.size &&
                 time.strictly_equal(other.time) &&
-                layers == other.layers;
+                layers == other.layers &&
+                canceled == other.canceled;
         }
 
         inline bool VideoData::operator != (const VideoData& other) const
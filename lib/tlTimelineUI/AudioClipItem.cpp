@@ -163,7 +163,7 @@ namespace tl
                     i->second.future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
                 {
                     const auto mesh = i->second.future.get();
-                    const std::string cacheKey = io::getCacheKey(
+                    const io::CacheKey cacheKey = io::getCacheKey(
                         p.path,
                         i->second.timeRange,
                         _data->options.ioOptions,
@@ -284,7 +284,7 @@ namespace tl
                             _trimmedRange,
                             p.ioInfo->audio.sampleRate);
 
-                        const std::string cacheKey = io::getCacheKey(
+                        const io::CacheKey cacheKey = io::getCacheKey(
                             p.path,
                             mediaRange,
                             _data->options.ioOptions,
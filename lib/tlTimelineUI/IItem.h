@@ -9,6 +9,8 @@
 #include <tlTimeline/TimeUnits.h>
 #include <tlTimeline/Timeline.h>
 
+#include <tlIO/Cache.h>
+
 #include <opentimelineio/item.h>
 
 namespace tl
@@ -25,8 +27,8 @@ namespace tl
             timeline::Options options;
             std::shared_ptr<timeline::ITimeUnitsModel> timeUnitsModel;
             std::map<std::string, std::shared_ptr<io::Info> > info;
-            std::map<std::string, std::shared_ptr<image::Image> > thumbnails;
-            std::map<std::string, std::shared_ptr<geom::TriangleMesh2> > waveforms;
+            std::map<io::CacheKey, std::shared_ptr<image::Image> > thumbnails;
+            std::map<io::CacheKey, std::shared_ptr<geom::TriangleMesh2> > waveforms;
         };
 
         //! In/out points display options.
@@ -167,7 +167,7 @@ namespace tl
                     const auto image = i->second.future.get();
                     io::Options ioOptions = _data->options.ioOptions;
                     ioOptions["USD/cameraName"] = p.clipName;
-                    const std::string cacheKey = io::getCacheKey(
+                    const io::CacheKey cacheKey = io::getCacheKey(
                         p.path,
                         i->first,
                         ioOptions,
@@ -295,7 +295,7 @@ namespace tl
 
                         io::Options ioOptions = _data->options.ioOptions;
                         ioOptions["USD/cameraName"] = p.clipName;
-                        const std::string cacheKey = io::getCacheKey(
+                        const io::CacheKey cacheKey = io::getCacheKey(
                             p.path,
                             mediaTime,
                             ioOptions,
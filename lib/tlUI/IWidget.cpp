@@ -26,10 +26,15 @@ namespace tl
                 ChildEvent event;
                 event.child = shared_from_this();
                 parent->childAddedEvent(event);
+
+                // Mark the parents so that the new widget is visited.
+                _updates |= Update::Size;
+                _updates |= Update::Draw;
             }
         }
 
-        IWidget::IWidget()
+        IWidget::IWidget() :
+            _updates(this, Update::Size | Update::Draw)
         {}
 
         IWidget::~IWidget()
@@ -76,6 +81,8 @@ namespace tl
                 value->childAddedEvent(event);
                 value->_updates |= Update::Size;
                 value->_updates |= Update::Draw;
+                _updates |= Update::Size;
+                _updates |= Update::Draw;
             }
         }
 
@@ -186,6 +193,11 @@ namespace tl
             _childrenClipRect = _geometry;
             _updates |= Update::Size;
             _updates |= Update::Draw;
+            if (auto parent = _parent.lock())
+            {
+                // Draw the parent to cover the previous geometry.
+                parent->_updates |= Update::Draw;
+            }
         }
 
         void IWidget::setVisible(bool value)
@@ -398,6 +410,18 @@ namespace tl
             _mousePressModifiers = modifiers;
         }
 
+        void IWidget::_parentUpdates(int value)
+        {
+            // Stop at the first parent that is already marked, the parents
+            // above it are also marked.
+            auto parent = _parent.lock();
+            while (parent && (parent->_childUpdates & value) != value)
+            {
+                parent->_childUpdates |= value;
+                parent = parent->_parent.lock();
+            }
+        }
+
         void IWidget::_releaseMouse()
         {
             if (_mouse.inside || _mouse.press)
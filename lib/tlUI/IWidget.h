@@ -19,6 +19,7 @@ namespace tl
         class IWidget : public std::enable_shared_from_this<IWidget>
         {
             TLRENDER_NON_COPYABLE(IWidget);
+            friend class IWindow;
 
         protected:
             void _init(
@@ -43,6 +44,9 @@ namespace tl
             //! Get whether updates are needed.
             int getUpdates() const;
 
+            //! Get whether updates are needed by any of the child widgets.
+            int getChildUpdates() const;
+
             //! Hierarchy
             ///@{
 
@@ -267,11 +271,29 @@ namespace tl
             void _setMousePress(bool, int button = -1, int modifiers = -1);
             virtual void _releaseMouse();
 
+            //! Widget updates. Setting an update also marks the parent
+            //! widgets, so the window only needs to visit the widgets that
+            //! have changed.
+            class Updates
+            {
+            public:
+                Updates(IWidget*, int);
+
+                operator int() const;
+
+                Updates& operator |= (int);
+                Updates& operator &= (int);
+
+            private:
+                IWidget* _widget = nullptr;
+                int _value = 0;
+            };
+
             std::weak_ptr<system::Context> _context;
             std::string _objectName;
             ColorRole _backgroundRole = ColorRole::None;
             float _displayScale = 1.F;
-            int _updates = 0;
+            Updates _updates;
             std::weak_ptr<IWidget> _parent;
             std::list<std::shared_ptr<IWidget> > _children;
             math::Size2i _sizeHint;
@@ -299,6 +321,9 @@ namespace tl
             std::string _toolTip;
 
         private:
+            void _parentUpdates(int);
+
+            int _childUpdates = 0;
             bool _mouseHoverEnabled = false;
             bool _mousePressEnabled = false;
             int _mousePressButton = -1;
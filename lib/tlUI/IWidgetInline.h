@@ -16,6 +16,11 @@ namespace tl
             return _updates;
         }
 
+        inline int IWidget::getChildUpdates() const
+        {
+            return _childUpdates;
+        }
+
         inline const std::weak_ptr<IWidget>& IWidget::getParent() const
         {
             return _parent;
@@ -122,5 +127,28 @@ namespace tl
         {
             return _toolTip;
         }
+
+        inline IWidget::Updates::Updates(IWidget* widget, int value) :
+            _widget(widget),
+            _value(value)
+        {}
+
+        inline IWidget::Updates::operator int() const
+        {
+            return _value;
+        }
+
+        inline IWidget::Updates& IWidget::Updates::operator |= (int value)
+        {
+            _value |= value;
+            _widget->_parentUpdates(value);
+            return *this;
+        }
+
+        inline IWidget::Updates& IWidget::Updates::operator &= (int value)
+        {
+            _value &= value;
+            return *this;
+        }
     }
 }
@@ -477,6 +477,57 @@ namespace tl
             }
         }
 
+        void IWindow::_sizeHintEventRecursive(
+            const std::shared_ptr<IWidget>& widget,
+            const SizeHintEvent& event,
+            bool all)
+        {
+            // Only the widgets that need a size update and their parents
+            // are visited, unless all of the widgets are requested (for
+            // example when the display scale changes).
+            widget->_childUpdates &= ~static_cast<int>(Update::Size);
+            for (const auto& child : widget->_children)
+            {
+                if (all || ((child->_updates | child->_childUpdates) & Update::Size))
+                {
+                    _sizeHintEventRecursive(child, event, all);
+                }
+            }
+            widget->sizeHintEvent(event);
+        }
+
+        void IWindow::_getDrawRects(
+            const std::shared_ptr<IWidget>& widget,
+            const math::Box2i& drawRect,
+            bool visible,
+            std::vector<math::Box2i>& out)
+        {
+            // The widgets that need a draw update are collected with the
+            // same clipping used for drawing. Widgets that are not visible
+            // are still visited to clear the child updates.
+            widget->_childUpdates &= ~static_cast<int>(Update::Draw);
+            const math::Box2i& g = widget->_geometry;
+            visible &= !widget->_clipped && g.w() > 0 && g.h() > 0;
+            if (visible && (widget->_updates & Update::Draw))
+            {
+                out.push_back(drawRect);
+            }
+            const math::Box2i childrenClipRect =
+                widget->_childrenClipRect.intersect(drawRect);
+            for (const auto& child : widget->_children)
+            {
+                if ((child->_updates | child->_childUpdates) & Update::Draw)
+                {
+                    const math::Box2i& childGeometry = child->_geometry;
+                    _getDrawRects(
+                        child,
+                        childGeometry.intersect(childrenClipRect),
+                        visible && childGeometry.intersects(childrenClipRect),
+                        out);
+                }
+            }
+        }
+
         void IWindow::_drop(const std::vector<std::string>&)
         {}
 
@@ -52,6 +52,17 @@ namespace tl
                 const math::Box2i&,
                 bool clipped);
 
+            void _sizeHintEventRecursive(
+                const std::shared_ptr<IWidget>&,
+                const SizeHintEvent&,
+                bool all);
+
+            void _getDrawRects(
+                const std::shared_ptr<IWidget>&,
+                const math::Box2i&,
+                bool visible,
+                std::vector<math::Box2i>&);
+
             virtual void _drop(const std::vector<std::string>&);
 
         private:
@@ -15,9 +15,12 @@
 #include <tlGL/OffscreenBuffer.h>
 
 #include <tlCore/AudioResample.h>
+#include <tlCore/ImageResize.h>
 #include <tlCore/LRUCache.h>
 #include <tlCore/StringFormat.h>
 
+#include <algorithm>
+#include <cmath>
 #include <sstream>
 
 namespace tl
@@ -27,19 +30,26 @@ namespace tl
         namespace
         {
             const size_t ioCacheMax = 16;
+            const size_t thumbnailThreadCount = 4;
+            const size_t peaksMax = 256 * memory::megabyte;
+            const double peaksChunkSize = 10.0;
         }
 
         struct ThumbnailCache::Private
         {
             size_t max = 1000;
-            memory::LRUCache<std::string, io::Info> info;
-            memory::LRUCache<std::string, std::shared_ptr<image::Image> > thumbnails;
-            memory::LRUCache<std::string, std::shared_ptr<geom::TriangleMesh2> > waveforms;
+            memory::LRUCache<io::CacheKey, io::Info> info;
+            memory::LRUCache<io::CacheKey, std::shared_ptr<image::Image> > thumbnails;
+            memory::LRUCache<io::CacheKey, std::shared_ptr<geom::TriangleMesh2> > waveforms;
+            memory::LRUCache<io::CacheKey, std::shared_ptr<audio::AudioPeaks> > peaks;
+            std::shared_ptr<io::PersistentCache> persistentCache;
             std::mutex mutex;
         };
 
         void ThumbnailCache::_init(const std::shared_ptr<system::Context>& context)
         {
+            TLRENDER_P();
+            p.peaks.setMax(peaksMax);
             _maxUpdate();
         }
 
@@ -88,59 +98,51 @@ namespace tl
                 static_cast<float>(p.info.getMax() + p.thumbnails.getMax() + p.waveforms.getMax()) * 100.F;
         }
 
-        std::string ThumbnailCache::getInfoKey(
+        io::CacheKey ThumbnailCache::getInfoKey(
             const file::Path& path,
             const io::Options& options)
         {
-            std::vector<std::string> s;
-            s.push_back(path.get());
-            for (const auto& i : options)
-            {
-                s.push_back(string::Format("{0}:{1}").arg(i.first).arg(i.second));
-            }
-            return string::join(s, ';');
+            return io::CacheKey(
+                io::getCacheHash(path),
+                time::invalidTime,
+                io::getCacheHash(options));
         }
 
-        void ThumbnailCache::addInfo(const std::string& key, const io::Info& info)
+        void ThumbnailCache::addInfo(const io::CacheKey& key, const io::Info& info)
         {
             TLRENDER_P();
             std::unique_lock<std::mutex> lock(p.mutex);
             p.info.add(key, info);
         }
 
-        bool ThumbnailCache::containsInfo(const std::string& key)
+        bool ThumbnailCache::containsInfo(const io::CacheKey& key)
         {
             TLRENDER_P();
             std::unique_lock<std::mutex> lock(p.mutex);
             return p.info.contains(key);
         }
 
-        bool ThumbnailCache::getInfo(const std::string& key, io::Info& info) const
+        bool ThumbnailCache::getInfo(const io::CacheKey& key, io::Info& info) const
         {
             TLRENDER_P();
             std::unique_lock<std::mutex> lock(p.mutex);
             return p.info.get(key, info);
         }
 
-        std::string ThumbnailCache::getThumbnailKey(
+        io::CacheKey ThumbnailCache::getThumbnailKey(
             int height,
             const file::Path& path,
             const otime::RationalTime& time,
             const io::Options& options)
         {
-            std::vector<std::string> s;
-            s.push_back(string::Format("{0}").arg(height));
-            s.push_back(path.get());
-            s.push_back(string::Format("{0}").arg(time));
-            for (const auto& i : options)
-            {
-                s.push_back(string::Format("{0}:{1}").arg(i.first).arg(i.second));
-            }
-            return string::join(s, ';');
+            return io::CacheKey(
+                io::getCacheHash(path),
+                time,
+                io::combineCacheHash(io::getCacheHash(options), height));
         }
 
         void ThumbnailCache::addThumbnail(
-            const std::string& key,
+            const io::CacheKey& key,
             const std::shared_ptr<image::Image>& thumbnail)
         {
             TLRENDER_P();
@@ -148,7 +150,7 @@ namespace tl
             p.thumbnails.add(key, thumbnail);
         }
 
-        bool ThumbnailCache::containsThumbnail(const std::string& key)
+        bool ThumbnailCache::containsThumbnail(const io::CacheKey& key)
         {
             TLRENDER_P();
             std::unique_lock<std::mutex> lock(p.mutex);
@@ -156,7 +158,7 @@ namespace tl
         }
 
         bool ThumbnailCache::getThumbnail(
-            const std::string& key,
+            const io::CacheKey& key,
             std::shared_ptr<image::Image>& thumbnail) const
         {
             TLRENDER_P();
@@ -164,25 +166,22 @@ namespace tl
             return p.thumbnails.get(key, thumbnail);
         }
 
-        std::string ThumbnailCache::getWaveformKey(
+        io::CacheKey ThumbnailCache::getWaveformKey(
             const math::Size2i& size,
             const file::Path& path,
             const otime::TimeRange& timeRange,
             const io::Options& options)
         {
-            std::vector<std::string> s;
-            s.push_back(string::Format("{0}").arg(size));
-            s.push_back(path.get());
-            s.push_back(string::Format("{0}").arg(timeRange));
-            for (const auto& i : options)
-            {
-                s.push_back(string::Format("{0}:{1}").arg(i.first).arg(i.second));
-            }
-            return string::join(s, ';');
+            return io::CacheKey(
+                io::getCacheHash(path),
+                timeRange,
+                io::combineCacheHash(
+                    io::combineCacheHash(io::getCacheHash(options), size.w),
+                    size.h));
         }
 
         void ThumbnailCache::addWaveform(
-            const std::string& key,
+            const io::CacheKey& key,
             const std::shared_ptr<geom::TriangleMesh2>& waveform)
         {
             TLRENDER_P();
@@ -190,7 +189,7 @@ namespace tl
             p.waveforms.add(key, waveform);
         }
 
-        bool ThumbnailCache::containsWaveform(const std::string& key)
+        bool ThumbnailCache::containsWaveform(const io::CacheKey& key)
         {
             TLRENDER_P();
             std::unique_lock<std::mutex> lock(p.mutex);
@@ -198,7 +197,7 @@ namespace tl
         }
 
         bool ThumbnailCache::getWaveform(
-            const std::string& key,
+            const io::CacheKey& key,
             std::shared_ptr<geom::TriangleMesh2>& waveform) const
         {
             TLRENDER_P();
@@ -206,6 +205,57 @@ namespace tl
             return p.waveforms.get(key, waveform);
         }
 
+        io::CacheKey ThumbnailCache::getPeaksKey(
+            const file::Path& path,
+            const io::Options& options)
+        {
+            return io::PersistentCache::getFileKey(
+                io::CacheKey(
+                    io::getCacheHash(path),
+                    time::invalidTime,
+                    io::getCacheHash(options)),
+                path);
+        }
+
+        void ThumbnailCache::addPeaks(
+            const io::CacheKey& key,
+            const std::shared_ptr<audio::AudioPeaks>& peaks)
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.peaks.add(key, peaks, peaks ? peaks->getByteCount() : 1);
+        }
+
+        bool ThumbnailCache::containsPeaks(const io::CacheKey& key)
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.peaks.contains(key);
+        }
+
+        bool ThumbnailCache::getPeaks(
+            const io::CacheKey& key,
+            std::shared_ptr<audio::AudioPeaks>& peaks) const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.peaks.get(key, peaks);
+        }
+
+        std::shared_ptr<io::PersistentCache> ThumbnailCache::getPersistentCache() const
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.persistentCache;
+        }
+
+        void ThumbnailCache::setPersistentCache(const std::shared_ptr<io::PersistentCache>& value)
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.persistentCache = value;
+        }
+
         void ThumbnailCache::_maxUpdate()
         {
             TLRENDER_P();
@@ -240,6 +290,11 @@ namespace tl
                 otime::RationalTime time = time::invalidTime;
                 io::Options options;
                 std::promise<std::shared_ptr<image::Image> > promise;
+
+                // The decoded image and thumbnail size, when the request
+                // is passed to the OpenGL thread.
+                std::shared_ptr<image::Image> image;
+                math::Size2i size;
             };
 
             struct WaveformRequest
@@ -264,6 +319,7 @@ namespace tl
             struct ThumbnailMutex
             {
                 std::list<std::shared_ptr<ThumbnailRequest> > requests;
+                std::list<std::shared_ptr<ThumbnailRequest> > glRequests;
                 bool stopped = false;
                 std::mutex mutex;
             };
@@ -272,6 +328,7 @@ namespace tl
             struct WaveformMutex
             {
                 std::list<std::shared_ptr<WaveformRequest> > requests;
+                std::vector<uint64_t> canceled;
                 bool stopped = false;
                 std::mutex mutex;
             };
@@ -286,19 +343,46 @@ namespace tl
             InfoThread infoThread;
 
             struct ThumbnailThread
+            {
+                memory::LRUCache<std::string, std::shared_ptr<io::IRead> > ioCache;
+                std::mutex ioCacheMutex;
+                std::condition_variable cv;
+                std::vector<std::thread> threads;
+                std::atomic<bool> running;
+            };
+            ThumbnailThread thumbnailThread;
+
+            struct GLThread
             {
                 std::shared_ptr<timeline_gl::Render> render;
                 std::shared_ptr<gl::OffscreenBuffer> buffer;
-                memory::LRUCache<std::string, std::shared_ptr<io::IRead> > ioCache;
                 std::condition_variable cv;
                 std::thread thread;
                 std::atomic<bool> running;
             };
-            ThumbnailThread thumbnailThread;
+            GLThread glThread;
+
+            // Audio peaks for a file that are being built in chunks. The
+            // peaks are abandoned when all of the requests that started
+            // them are canceled.
+            struct WaveformPeaks
+            {
+                io::CacheKey key;
+                std::shared_ptr<io::IRead> read;
+                io::Info info;
+                io::Options options;
+                bool persistent = false;
+                std::shared_ptr<audio::AudioPeaks> peaks;
+                std::shared_ptr<audio::AudioResample> resample;
+                otime::RationalTime time = time::invalidTime;
+                otime::RationalTime endTime = time::invalidTime;
+                std::vector<uint64_t> ids;
+            };
 
             struct WaveformThread
             {
                 memory::LRUCache<std::string, std::shared_ptr<io::IRead> > ioCache;
+                std::list<std::shared_ptr<WaveformPeaks> > peaks;
                 std::condition_variable cv;
                 std::thread thread;
                 std::atomic<bool> running;
@@ -320,11 +404,20 @@ namespace tl
             p.window = window;
             if (!p.window)
             {
-                p.window = gl::GLFWWindow::create(
-                    "tl::ui::ThumbnailGenerator",
-                    math::Size2i(1, 1),
-                    context,
-                    static_cast<int>(gl::GLFWWindowOptions::None));
+                // Without a window the thumbnails are only generated on
+                // the CPU, so the generator can also run headless.
+                try
+                {
+                    p.window = gl::GLFWWindow::create(
+                        "tl::ui::ThumbnailGenerator",
+                        math::Size2i(1, 1),
+                        context,
+                        static_cast<int>(gl::GLFWWindowOptions::None));
+                }
+                catch (const std::exception& e)
+                {
+                    context->log("tl::ui::ThumbnailGenerator", e.what(), log::Type::Warning);
+                }
             }
 
             p.infoThread.running = true;
@@ -345,26 +438,46 @@ namespace tl
 
             p.thumbnailThread.ioCache.setMax(ioCacheMax);
             p.thumbnailThread.running = true;
-            p.thumbnailThread.thread = std::thread(
+            for (size_t i = 0; i < thumbnailThreadCount; ++i)
+            {
+                p.thumbnailThread.threads.push_back(std::thread(
+                    [this]
+                    {
+                        TLRENDER_P();
+                        while (p.thumbnailThread.running)
+                        {
+                            _thumbnailRun();
+                        }
+                    }));
+            }
+
+            p.glThread.running = true;
+            p.glThread.thread = std::thread(
                 [this]
                 {
                     TLRENDER_P();
-                    p.window->makeCurrent();
-                    if (auto context = p.context.lock())
+                    if (p.window)
                     {
-                        p.thumbnailThread.render = timeline_gl::Render::create(context);
+                        p.window->makeCurrent();
+                        if (auto context = p.context.lock())
+                        {
+                            p.glThread.render = timeline_gl::Render::create(context);
+                        }
                     }
-                    while (p.thumbnailThread.running)
+                    while (p.glThread.running)
                     {
-                        _thumbnailRun();
+                        _glRun();
                     }
                     {
                         std::unique_lock<std::mutex> lock(p.thumbnailMutex.mutex);
                         p.thumbnailMutex.stopped = true;
                     }
-                    p.thumbnailThread.buffer.reset();
-                    p.thumbnailThread.render.reset();
-                    p.window->doneCurrent();
+                    p.glThread.buffer.reset();
+                    p.glThread.render.reset();
+                    if (p.window)
+                    {
+                        p.window->doneCurrent();
+                    }
                     _thumbnailCancel();
                 });
 
@@ -378,6 +491,7 @@ namespace tl
                     {
                         _waveformRun();
                     }
+                    p.waveformThread.peaks.clear();
                     {
                         std::unique_lock<std::mutex> lock(p.waveformMutex.mutex);
                         p.waveformMutex.stopped = true;
@@ -398,10 +512,20 @@ namespace tl
             {
                 p.infoThread.thread.join();
             }
+            // The OpenGL thread is stopped after the CPU threads, since
+            // they pass requests to it.
             p.thumbnailThread.running = false;
-            if (p.thumbnailThread.thread.joinable())
+            for (auto& thread : p.thumbnailThread.threads)
+            {
+                if (thread.joinable())
+                {
+                    thread.join();
+                }
+            }
+            p.glThread.running = false;
+            if (p.glThread.thread.joinable())
             {
-                p.thumbnailThread.thread.join();
+                p.glThread.thread.join();
             }
             p.waveformThread.running = false;
             if (p.waveformThread.thread.joinable())
@@ -596,6 +720,19 @@ namespace tl
                         ++i;
                     }
                 }
+                i = p.thumbnailMutex.glRequests.begin();
+                while (i != p.thumbnailMutex.glRequests.end())
+                {
+                    const auto j = std::find(ids.begin(), ids.end(), (*i)->id);
+                    if (j != ids.end())
+                    {
+                        i = p.thumbnailMutex.glRequests.erase(i);
+                    }
+                    else
+                    {
+                        ++i;
+                    }
+                }
             }
             {
                 std::unique_lock<std::mutex> lock(p.waveformMutex.mutex);
@@ -612,6 +749,10 @@ namespace tl
                         ++i;
                     }
                 }
+                p.waveformMutex.canceled.insert(
+                    p.waveformMutex.canceled.end(),
+                    ids.begin(),
+                    ids.end());
             }
         }
 
@@ -636,10 +777,25 @@ namespace tl
             if (request)
             {
                 io::Info info;
-                const std::string key = ThumbnailCache::getInfoKey(
+                const io::CacheKey key = ThumbnailCache::getInfoKey(
                     request->path,
                     request->options);
-                if (!p.cache->getInfo(key, info))
+                // Only files on disk are stored in the persistent cache. The
+                // persistent key reads the file information, so it is only
+                // computed when the memory cache misses.
+                std::shared_ptr<io::PersistentCache> persistentCache;
+                io::CacheKey persistentKey;
+                bool found = p.cache->getInfo(key, info);
+                if (!found && request->memoryRead.empty())
+                {
+                    persistentCache = p.cache->getPersistentCache();
+                    if (persistentCache)
+                    {
+                        persistentKey = io::PersistentCache::getFileKey(key, request->path);
+                        found = persistentCache->getInfo(persistentKey, info);
+                    }
+                }
+                if (!found)
                 {
                     if (auto context = p.context.lock())
                     {
@@ -655,6 +811,10 @@ namespace tl
                             if (read)
                             {
                                 info = read->getInfo().get();
+                                if (persistentCache)
+                                {
+                                    persistentCache->addInfo(persistentKey, info);
+                                }
                             }
                         }
                         catch (const std::exception&)
@@ -688,30 +848,57 @@ namespace tl
             if (request)
             {
                 std::shared_ptr<image::Image> image;
-                const std::string key = ThumbnailCache::getThumbnailKey(
+                bool gl = false;
+                const io::CacheKey key = ThumbnailCache::getThumbnailKey(
                     request->height,
                     request->path,
                     request->time,
                     request->options);
-                if (!p.cache->getThumbnail(key, image))
+                std::shared_ptr<io::PersistentCache> persistentCache;
+                io::CacheKey persistentKey;
+                bool found = p.cache->getThumbnail(key, image);
+                if (!found && request->memoryRead.empty())
+                {
+                    persistentCache = p.cache->getPersistentCache();
+                    if (persistentCache)
+                    {
+                        persistentKey = io::PersistentCache::getFileKey(key, request->path);
+                        found = persistentCache->getImage(persistentKey, image);
+                    }
+                }
+                if (!found)
                 {
                     if (auto context = p.context.lock())
                     {
-                        auto ioSystem = context->getSystem<io::System>();
                         try
                         {
                             const std::string& fileName = request->path.get();
                             //std::cout << "thumbnail request: " << fileName << " " <<
                             //    request->time << std::endl;
+
+                            // The readers are opened with the thumbnail
+                            // height so they can decode at a reduced
+                            // resolution.
+                            io::Options options = request->options;
+                            options["ReducedHeight"] = string::Format("{0}").arg(request->height);
+                            const std::string ioCacheKey = string::Format("{0}@{1}").
+                                arg(fileName).
+                                arg(request->height);
                             std::shared_ptr<io::IRead> read;
-                            if (!p.thumbnailThread.ioCache.get(fileName, read))
+                            bool cached = false;
+                            {
+                                std::unique_lock<std::mutex> lock(p.thumbnailThread.ioCacheMutex);
+                                cached = p.thumbnailThread.ioCache.get(ioCacheKey, read);
+                            }
+                            if (!cached)
                             {
                                 auto ioSystem = context->getSystem<io::System>();
                                 read = ioSystem->read(
                                     request->path,
                                     request->memoryRead,
-                                    request->options);
-                                p.thumbnailThread.ioCache.add(fileName, read);
+                                    options);
+                                std::unique_lock<std::mutex> lock(p.thumbnailThread.ioCacheMutex);
+                                p.thumbnailThread.ioCache.add(ioCacheKey, read);
                             }
                             if (read)
                             {
@@ -722,25 +909,135 @@ namespace tl
                                     size.w = request->height * info.video[0].size.getAspect();
                                     size.h = request->height;
                                 }
-                                gl::OffscreenBufferOptions options;
-                                options.colorType = image::PixelType::RGBA_U8;
-                                if (gl::doCreate(p.thumbnailThread.buffer, size, options))
-                                {
-                                    p.thumbnailThread.buffer = gl::OffscreenBuffer::create(size, options);
-                                }
                                 const otime::RationalTime time =
                                     request->time != time::invalidTime ?
                                     request->time :
                                     info.videoTime.start_time();
-                                const auto videoData = read->readVideo(time, request->options).get();
-                                if (p.thumbnailThread.render && p.thumbnailThread.buffer && videoData.image)
+                                const auto videoData = read->readVideo(time, options).get();
+                                if (videoData.image && size.isValid())
+                                {
+                                    if (image::isResizeSupported(videoData.image->getInfo()))
+                                    {
+                                        // The Lanczos filter is used when the
+                                        // image is close to the thumbnail size,
+                                        // and the box filter is used for large
+                                        // reductions where it is much cheaper.
+                                        const image::ResizeFilter filter =
+                                            videoData.image->getHeight() < size.h * 4 ?
+                                            image::ResizeFilter::Lanczos3 :
+                                            image::ResizeFilter::Box;
+                                        image = image::resize(
+                                            videoData.image,
+                                            image::Size(size.w, size.h),
+                                            filter);
+                                        if (persistentCache)
+                                        {
+                                            persistentCache->addImage(persistentKey, image);
+                                        }
+                                    }
+                                    else
+                                    {
+                                        request->image = videoData.image;
+                                        request->size = size;
+                                        gl = true;
+                                    }
+                                }
+                            }
+                            else if (
+                                string::compare(
+                                    ".otio",
+                                    request->path.getExtension(),
+                                    string::Compare::CaseInsensitive) ||
+                                string::compare(
+                                    ".otioz",
+                                    request->path.getExtension(),
+                                    string::Compare::CaseInsensitive))
+                            {
+                                gl = true;
+                            }
+                        }
+                        catch (const std::exception&)
+                        {
+                        }
+                    }
+                }
+                if (gl)
+                {
+                    bool valid = false;
+                    {
+                        std::unique_lock<std::mutex> lock(p.thumbnailMutex.mutex);
+                        if (!p.thumbnailMutex.stopped)
+                        {
+                            valid = true;
+                            p.thumbnailMutex.glRequests.push_back(request);
+                        }
+                    }
+                    if (valid)
+                    {
+                        p.glThread.cv.notify_one();
+                    }
+                    else
+                    {
+                        request->promise.set_value(nullptr);
+                    }
+                }
+                else
+                {
+                    request->promise.set_value(image);
+                    p.cache->addThumbnail(key, image);
+                }
+            }
+        }
+
+        void ThumbnailGenerator::_glRun()
+        {
+            TLRENDER_P();
+            std::shared_ptr<Private::ThumbnailRequest> request;
+            {
+                std::unique_lock<std::mutex> lock(p.thumbnailMutex.mutex);
+                if (p.glThread.cv.wait_for(
+                    lock,
+                    std::chrono::milliseconds(5),
+                    [this]
+                    {
+                        return !_p->thumbnailMutex.glRequests.empty();
+                    }))
+                {
+                    request = p.thumbnailMutex.glRequests.front();
+                    p.thumbnailMutex.glRequests.pop_front();
+                }
+            }
+            if (request)
+            {
+                std::shared_ptr<image::Image> image;
+                const io::CacheKey key = ThumbnailCache::getThumbnailKey(
+                    request->height,
+                    request->path,
+                    request->time,
+                    request->options);
+                if (p.glThread.render)
+                {
+                    if (auto context = p.context.lock())
+                    {
+                        try
+                        {
+                            if (request->image)
+                            {
+                                const math::Size2i& size = request->size;
+                                gl::OffscreenBufferOptions options;
+                                options.colorType = image::PixelType::RGBA_U8;
+                                if (gl::doCreate(p.glThread.buffer, size, options))
                                 {
-                                    gl::OffscreenBufferBinding binding(p.thumbnailThread.buffer);
-                                    p.thumbnailThread.render->begin(size);
-                                    p.thumbnailThread.render->drawImage(
-                                        videoData.image,
+                                    p.glThread.buffer = gl::OffscreenBuffer::create(size, options);
+                                }
+                                if (p.glThread.buffer)
+                                {
+                                    gl::OffscreenBufferBinding binding(p.glThread.buffer);
+                                    p.glThread.render->begin(size);
+                                    p.glThread.render->drawImage(
+                                        request->image,
                                         { math::Box2i(0, 0, size.w, size.h) });
-                                    p.thumbnailThread.render->end();
+                                    p.glThread.render->end();
                                     image = image::Image::create(
                                         size.w,
                                         size.h,
@@ -756,15 +1053,7 @@ namespace tl
                                         image->getData());
                                 }
                             }
-                            else if (
-                                string::compare(
-                                    ".otio",
-                                    request->path.getExtension(),
-                                    string::Compare::CaseInsensitive) ||
-                                string::compare(
-                                    ".otioz",
-                                    request->path.getExtension(),
-                                    string::Compare::CaseInsensitive))
+                            else
                             {
                                 timeline::Options timelineOptions;
                                 timelineOptions.ioOptions = request->options;
@@ -785,18 +1074,18 @@ namespace tl
                                 {
                                     gl::OffscreenBufferOptions options;
                                     options.colorType = image::PixelType::RGBA_U8;
-                                    if (gl::doCreate(p.thumbnailThread.buffer, size, options))
+                                    if (gl::doCreate(p.glThread.buffer, size, options))
                                     {
-                                        p.thumbnailThread.buffer = gl::OffscreenBuffer::create(size, options);
+                                        p.glThread.buffer = gl::OffscreenBuffer::create(size, options);
                                     }
-                                    if (p.thumbnailThread.render && p.thumbnailThread.buffer)
+                                    if (p.glThread.buffer)
                                     {
-                                        gl::OffscreenBufferBinding binding(p.thumbnailThread.buffer);
-                                        p.thumbnailThread.render->begin(size);
-                                        p.thumbnailThread.render->drawVideo(
+                                        gl::OffscreenBufferBinding binding(p.glThread.buffer);
+                                        p.glThread.render->begin(size);
+                                        p.glThread.render->drawVideo(
                                             { videoData },
                                             { math::Box2i(0, 0, size.w, size.h) });
-                                        p.thumbnailThread.render->end();
+                                        p.glThread.render->end();
                                         image = image::Image::create(
                                             size.w,
                                             size.h,
@@ -819,6 +1108,15 @@ namespace tl
                         }
                     }
                 }
+                if (image && request->memoryRead.empty())
+                {
+                    if (auto persistentCache = p.cache->getPersistentCache())
+                    {
+                        persistentCache->addImage(
+                            io::PersistentCache::getFileKey(key, request->path),
+                            image);
+                    }
+                }
                 request->promise.set_value(image);
                 p.cache->addThumbnail(key, image);
             }
@@ -827,68 +1125,96 @@ namespace tl
         namespace
         {
             std::shared_ptr<geom::TriangleMesh2> audioMesh(
-                const std::shared_ptr<audio::Audio>& audio,
+                const std::vector<audio::Peak>& peaks,
                 const math::Size2i& size)
             {
                 auto out = std::shared_ptr<geom::TriangleMesh2>(new geom::TriangleMesh2);
-                const auto& info = audio->getInfo();
-                const size_t sampleCount = audio->getSampleCount();
-                if (sampleCount > 0)
+                const int h2 = size.h / 2;
+                for (size_t x = 0; x < peaks.size(); ++x)
                 {
-                    switch (info.dataType)
+                    const math::Box2i box(
+                        math::Vector2i(
+                            x,
+                            h2 - h2 * peaks[x].max),
+                        math::Vector2i(
+                            x + 1,
+                            h2 - h2 * peaks[x].min));
+                    if (box.isValid())
                     {
-                    case audio::DataType::F32:
+                        const size_t j = 1 + out->v.size();
+                        out->v.push_back(math::Vector2f(box.x(), box.y()));
+                        out->v.push_back(math::Vector2f(box.x() + box.w(), box.y()));
+                        out->v.push_back(math::Vector2f(box.x() + box.w(), box.y() + box.h()));
+                        out->v.push_back(math::Vector2f(box.x(), box.y() + box.h()));
+                        out->triangles.push_back(geom::Triangle2({ j + 0, j + 1, j + 2 }));
+                        out->triangles.push_back(geom::Triangle2({ j + 2, j + 3, j + 0 }));
+                    }
+                }
+                return out;
+            }
+
+            // Compute the peaks of a fixed number of columns from mono
+            // float samples that are added in order.
+            class ColumnPeaks
+            {
+            public:
+                ColumnPeaks(size_t columnCount, int64_t sampleCount) :
+                    _peaks(columnCount),
+                    _sums(columnCount, 0.0),
+                    _counts(columnCount, 0),
+                    _sampleCount(std::max(sampleCount, static_cast<int64_t>(1)))
+                {}
+
+                void add(const std::shared_ptr<audio::Audio>& audio)
+                {
+                    if (!audio || audio->getDataType() != audio::DataType::F32 || _peaks.empty())
+                        return;
+                    const audio::F32_T* data = reinterpret_cast<const audio::F32_T*>(audio->getData());
+                    const size_t channelCount = audio->getChannelCount();
+                    const size_t sampleCount = audio->getSampleCount();
+                    const size_t columnCount = _peaks.size();
+                    for (size_t i = 0; i < sampleCount; ++i, ++_sample)
                     {
-                        const audio::F32_T* data = reinterpret_cast<const audio::F32_T*>(
-                            audio->getData());
-                        for (int x = 0; x < size.w; ++x)
+                        const size_t column = std::min(
+                            static_cast<size_t>(_sample * static_cast<int64_t>(columnCount) / _sampleCount),
+                            columnCount - 1);
+                        const audio::F32_T v = data[i * channelCount];
+                        audio::Peak& peak = _peaks[column];
+                        if (0 == _counts[column])
                         {
-                            const int x0 = std::min(
-                                static_cast<size_t>((x + 0) / static_cast<double>(size.w - 1) * (sampleCount - 1)),
-                                sampleCount - 1);
-                            const int x1 = std::min(
-                                static_cast<size_t>((x + 1) / static_cast<double>(size.w - 1) * (sampleCount - 1)),
-                                sampleCount - 1);
-                            //std::cout << x << ": " << x0 << " " << x1 << std::endl;
-                            audio::F32_T min = 0.F;
-                            audio::F32_T max = 0.F;
-                            if (x0 <= x1)
-                            {
-                                min = audio::F32Range.getMax();
-                                max = audio::F32Range.getMin();
-                                for (int i = x0; i <= x1 && i < sampleCount; ++i)
-                                {
-                                    const audio::F32_T v = *(data + i * info.channelCount);
-                                    min = std::min(min, v);
-                                    max = std::max(max, v);
-                                }
-                            }
-                            const int h2 = size.h / 2;
-                            const math::Box2i box(
-                                math::Vector2i(
-                                    x,
-                                    h2 - h2 * max),
-                                math::Vector2i(
-                                    x + 1,
-                                    h2 - h2 * min));
-                            if (box.isValid())
-                            {
-                                const size_t j = 1 + out->v.size();
-                                out->v.push_back(math::Vector2f(box.x(), box.y()));
-                                out->v.push_back(math::Vector2f(box.x() + box.w(), box.y()));
-                                out->v.push_back(math::Vector2f(box.x() + box.w(), box.y() + box.h()));
-                                out->v.push_back(math::Vector2f(box.x(), box.y() + box.h()));
-                                out->triangles.push_back(geom::Triangle2({ j + 0, j + 1, j + 2 }));
-                                out->triangles.push_back(geom::Triangle2({ j + 2, j + 3, j + 0 }));
-                            }
+                            peak.min = v;
+                            peak.max = v;
                         }
-                        break;
+                        else
+                        {
+                            peak.min = std::min(peak.min, v);
+                            peak.max = std::max(peak.max, v);
+                        }
+                        _sums[column] += v * v;
+                        ++_counts[column];
                     }
-                    default: break;
+                }
+
+                std::vector<audio::Peak> getPeaks() const
+                {
+                    std::vector<audio::Peak> out = _peaks;
+                    for (size_t i = 0; i < out.size(); ++i)
+                    {
+                        if (_counts[i] > 0)
+                        {
+                            out[i].rms = std::sqrt(_sums[i] / _counts[i]);
+                        }
                     }
+                    return out;
                 }
-                return out;
-            }
+
+            private:
+                std::vector<audio::Peak> _peaks;
+                std::vector<double> _sums;
+                std::vector<size_t> _counts;
+                int64_t _sampleCount = 1;
+                int64_t _sample = 0;
+            };
 
             std::shared_ptr<image::Image> audioImage(
                 const std::shared_ptr<audio::Audio>& audio,
@@ -948,11 +1274,13 @@ namespace tl
         {
             TLRENDER_P();
             std::shared_ptr<Private::WaveformRequest> request;
+            std::vector<uint64_t> canceled;
             {
+                // Don't wait while there are peaks to build.
                 std::unique_lock<std::mutex> lock(p.waveformMutex.mutex);
                 if (p.waveformThread.cv.wait_for(
                     lock,
-                    std::chrono::milliseconds(5),
+                    std::chrono::milliseconds(p.waveformThread.peaks.empty() ? 5 : 0),
                     [this]
                     {
                         return !_p->waveformMutex.requests.empty();
@@ -961,11 +1289,41 @@ namespace tl
                     request = p.waveformMutex.requests.front();
                     p.waveformMutex.requests.pop_front();
                 }
+                canceled = std::move(p.waveformMutex.canceled);
+                p.waveformMutex.canceled.clear();
             }
+
+            // Abandon the peaks that are no longer requested.
+            if (!canceled.empty())
+            {
+                auto i = p.waveformThread.peaks.begin();
+                while (i != p.waveformThread.peaks.end())
+                {
+                    auto& ids = (*i)->ids;
+                    ids.erase(
+                        std::remove_if(
+                            ids.begin(),
+                            ids.end(),
+                            [&canceled](uint64_t id)
+                            {
+                                return std::find(canceled.begin(), canceled.end(), id) != canceled.end();
+                            }),
+                        ids.end());
+                    if (ids.empty())
+                    {
+                        i = p.waveformThread.peaks.erase(i);
+                    }
+                    else
+                    {
+                        ++i;
+                    }
+                }
+            }
+
             if (request)
             {
                 std::shared_ptr<geom::TriangleMesh2> mesh;
-                const std::string key = ThumbnailCache::getWaveformKey(
+                const io::CacheKey key = ThumbnailCache::getWaveformKey(
                     request->size,
                     request->path,
                     request->timeRange,
@@ -996,14 +1354,88 @@ namespace tl
                                     otime::TimeRange(
                                         otime::RationalTime(0.0, 1.0),
                                         otime::RationalTime(1.0, 1.0));
-                                const auto audioData = read->readAudio(timeRange, request->options).get();
-                                if (audioData.audio)
+                                const size_t sampleRate = info.audio.sampleRate;
+                                const int64_t sampleCount = timeRange.duration().rescaled_to(sampleRate).round().value();
+                                const size_t columnCount = std::max(request->size.w, 0);
+
+                                // Use the audio peaks for the file unless the
+                                // waveform is zoomed in past the first level.
+                                std::shared_ptr<audio::AudioPeaks> peaks;
+                                if (columnCount > 0 &&
+                                    sampleCount / columnCount >= audio::AudioPeaks::defaultBlockSize)
                                 {
-                                    auto resample = audio::AudioResample::create(
-                                        audioData.audio->getInfo(),
-                                        audio::Info(1, audio::DataType::F32, audioData.audio->getSampleRate()));
-                                    const auto resampledAudio = resample->process(audioData.audio);
-                                    mesh = audioMesh(resampledAudio, request->size);
+                                    const io::CacheKey peaksKey = ThumbnailCache::getPeaksKey(
+                                        request->path,
+                                        request->options);
+                                    if (!p.cache->getPeaks(peaksKey, peaks))
+                                    {
+                                        // Peaks can only be stored for files
+                                        // on disk.
+                                        std::shared_ptr<io::PersistentCache> persistentCache;
+                                        if (request->memoryRead.empty())
+                                        {
+                                            persistentCache = p.cache->getPersistentCache();
+                                        }
+                                        if (persistentCache && persistentCache->getPeaks(peaksKey, peaks))
+                                        {
+                                            p.cache->addPeaks(peaksKey, peaks);
+                                        }
+                                        else
+                                        {
+                                            // Start building the peaks in the
+                                            // background, the waveform is
+                                            // read directly until they are
+                                            // finished.
+                                            _waveformPeaksAdd(
+                                                request->id,
+                                                peaksKey,
+                                                read,
+                                                info,
+                                                request->options,
+                                                persistentCache.get() != nullptr);
+                                        }
+                                    }
+                                }
+                                if (peaks)
+                                {
+                                    const int64_t start =
+                                        (timeRange.start_time() - info.audioTime.start_time()).
+                                        rescaled_to(sampleRate).round().value();
+                                    mesh = audioMesh(
+                                        peaks->getPeaks(start, sampleCount, columnCount),
+                                        request->size);
+                                }
+                                else
+                                {
+                                    // Read the range in chunks and compute
+                                    // the peaks of each column directly.
+                                    ColumnPeaks columnPeaks(columnCount, sampleCount);
+                                    std::shared_ptr<audio::AudioResample> resample;
+                                    const otime::RationalTime endTime =
+                                        timeRange.end_time_exclusive().rescaled_to(sampleRate).round();
+                                    const otime::RationalTime chunkSize(peaksChunkSize * sampleRate, sampleRate);
+                                    otime::RationalTime time = timeRange.start_time().rescaled_to(sampleRate).round();
+                                    bool valid = false;
+                                    while (time < endTime)
+                                    {
+                                        const otime::TimeRange chunkRange(time, std::min(chunkSize, endTime - time));
+                                        const auto audioData = read->readAudio(chunkRange, request->options).get();
+                                        if (!audioData.audio)
+                                            break;
+                                        if (!resample)
+                                        {
+                                            resample = audio::AudioResample::create(
+                                                audioData.audio->getInfo(),
+                                                audio::Info(1, audio::DataType::F32, audioData.audio->getSampleRate()));
+                                        }
+                                        columnPeaks.add(resample->process(audioData.audio));
+                                        valid = true;
+                                        time += chunkRange.duration();
+                                    }
+                                    if (valid)
+                                    {
+                                        mesh = audioMesh(columnPeaks.getPeaks(), request->size);
+                                    }
                                 }
                             }
                         }
@@ -1015,6 +1447,103 @@ namespace tl
                 request->promise.set_value(mesh);
                 p.cache->addWaveform(key, mesh);
             }
+
+            _waveformPeaksRun();
+        }
+
+        void ThumbnailGenerator::_waveformPeaksAdd(
+            uint64_t id,
+            const io::CacheKey& key,
+            const std::shared_ptr<io::IRead>& read,
+            const io::Info& info,
+            const io::Options& options,
+            bool persistent)
+        {
+            TLRENDER_P();
+            const auto i = std::find_if(
+                p.waveformThread.peaks.begin(),
+                p.waveformThread.peaks.end(),
+                [&key](const std::shared_ptr<Private::WaveformPeaks>& value)
+                {
+                    return key == value->key;
+                });
+            if (i != p.waveformThread.peaks.end())
+            {
+                (*i)->ids.push_back(id);
+            }
+            else
+            {
+                const size_t sampleRate = info.audio.sampleRate;
+                auto peaks = std::make_shared<Private::WaveformPeaks>();
+                peaks->key = key;
+                peaks->read = read;
+                peaks->info = info;
+                peaks->options = options;
+                peaks->persistent = persistent;
+                peaks->peaks = audio::AudioPeaks::create(sampleRate);
+                peaks->time = info.audioTime.start_time().rescaled_to(sampleRate).round();
+                peaks->endTime = info.audioTime.end_time_exclusive().rescaled_to(sampleRate).round();
+                peaks->ids.push_back(id);
+                p.waveformThread.peaks.push_back(peaks);
+            }
+        }
+
+        void ThumbnailGenerator::_waveformPeaksRun()
+        {
+            TLRENDER_P();
+            if (p.waveformThread.peaks.empty())
+                return;
+
+            // Read the next chunk of audio and mix it down to one channel.
+            auto peaks = p.waveformThread.peaks.front();
+            bool finished = false;
+            try
+            {
+                const size_t sampleRate = peaks->info.audio.sampleRate;
+                const otime::RationalTime chunkSize(peaksChunkSize * sampleRate, sampleRate);
+                const otime::TimeRange timeRange(
+                    peaks->time,
+                    std::min(chunkSize, peaks->endTime - peaks->time));
+                const auto audioData = peaks->read->readAudio(timeRange, peaks->options).get();
+                if (audioData.audio)
+                {
+                    if (!peaks->resample)
+                    {
+                        peaks->resample = audio::AudioResample::create(
+                            audioData.audio->getInfo(),
+                            audio::Info(1, audio::DataType::F32, sampleRate));
+                    }
+                    peaks->peaks->add(peaks->resample->process(audioData.audio));
+                    peaks->time += timeRange.duration();
+                    if (peaks->time >= peaks->endTime)
+                    {
+                        if (peaks->persistent)
+                        {
+                            if (auto persistentCache = p.cache->getPersistentCache())
+                            {
+                                persistentCache->addPeaks(peaks->key, peaks->peaks);
+                            }
+                        }
+                        p.cache->addPeaks(peaks->key, peaks->peaks);
+                        finished = true;
+                    }
+                }
+                else
+                {
+                    finished = true;
+                }
+            }
+            catch (const std::exception&)
+            {
+                finished = true;
+            }
+            p.waveformThread.peaks.pop_front();
+            if (!finished)
+            {
+                // Move to the back so that the peaks for multiple files are
+                // built in turn.
+                p.waveformThread.peaks.push_back(peaks);
+            }
         }
 
         void ThumbnailGenerator::_infoCancel()
@@ -1038,6 +1567,7 @@ namespace tl
             {
                 std::unique_lock<std::mutex> lock(p.thumbnailMutex.mutex);
                 requests = std::move(p.thumbnailMutex.requests);
+                requests.splice(requests.end(), p.thumbnailMutex.glRequests);
             }
             for (auto& request : requests)
             {
@@ -4,8 +4,10 @@
 
 #pragma once
 
-#include <tlIO/IO.h>
+#include <tlIO/Cache.h>
+#include <tlIO/PersistentCache.h>
 
+#include <tlCore/AudioPeaks.h>
 #include <tlCore/Context.h>
 #include <tlCore/FileIO.h>
 #include <tlCore/ISystem.h>
@@ -22,6 +24,11 @@ namespace tl
         class GLFWWindow;
     }
 
+    namespace io
+    {
+        class IRead;
+    }
+
     namespace ui
     {
         //! Information request.
@@ -77,21 +84,21 @@ namespace tl
             float getPercentage() const;
             
             //! Get an I/O information cache key.
-            static std::string getInfoKey(
+            static io::CacheKey getInfoKey(
                 const file::Path&,
                 const io::Options&);
 
             //! Add I/O information to the cache.
-            void addInfo(const std::string& key, const io::Info&);
+            void addInfo(const io::CacheKey& key, const io::Info&);
 
             //! Get whether the cache contains I/O information.
-            bool containsInfo(const std::string& key);
+            bool containsInfo(const io::CacheKey& key);
 
             //! Get I/O information from the cache.
-            bool getInfo(const std::string& key, io::Info&) const;
+            bool getInfo(const io::CacheKey& key, io::Info&) const;
             
             //! Get a thumbnail cache key.
-            static std::string getThumbnailKey(
+            static io::CacheKey getThumbnailKey(
                 int height,
                 const file::Path&,
                 const otime::RationalTime&,
@@ -99,19 +106,19 @@ namespace tl
 
             //! Add a thumbnail to the cache.
             void addThumbnail(
-                const std::string& key,
+                const io::CacheKey& key,
                 const std::shared_ptr<image::Image>&);
 
             //! Get whether the cache contains a thumbnail.
-            bool containsThumbnail(const std::string& key);
+            bool containsThumbnail(const io::CacheKey& key);
 
             //! Get a thumbnail from the cache.
             bool getThumbnail(
-                const std::string& key,
+                const io::CacheKey& key,
                 std::shared_ptr<image::Image>&) const;
 
             //! Get a waveform cache key.
-            static std::string getWaveformKey(
+            static io::CacheKey getWaveformKey(
                 const math::Size2i&,
                 const file::Path&,
                 const otime::TimeRange&,
@@ -119,17 +126,45 @@ namespace tl
 
             //! Add a waveform to the cache.
             void addWaveform(
-                const std::string& key,
+                const io::CacheKey& key,
                 const std::shared_ptr<geom::TriangleMesh2>&);
 
             //! Get whether the cache contains a waveform.
-            bool containsWaveform(const std::string& key);
+            bool containsWaveform(const io::CacheKey& key);
 
             //! Get a waveform from the cache.
             bool getWaveform(
-                const std::string& key,
+                const io::CacheKey& key,
                 std::shared_ptr<geom::TriangleMesh2>&) const;
 
+            //! Get an audio peaks cache key. The key includes the file size
+            //! and modification time so that the peaks are not used after
+            //! the file changes.
+            static io::CacheKey getPeaksKey(
+                const file::Path&,
+                const io::Options&);
+
+            //! Add audio peaks to the cache.
+            void addPeaks(
+                const io::CacheKey& key,
+                const std::shared_ptr<audio::AudioPeaks>&);
+
+            //! Get whether the cache contains audio peaks.
+            bool containsPeaks(const io::CacheKey& key);
+
+            //! Get audio peaks from the cache.
+            bool getPeaks(
+                const io::CacheKey& key,
+                std::shared_ptr<audio::AudioPeaks>&) const;
+
+            //! Get the persistent cache.
+            std::shared_ptr<io::PersistentCache> getPersistentCache() const;
+
+            //! Set the persistent cache. Information, thumbnails, and audio
+            //! peaks for files on disk are also stored in the persistent
+            //! cache so they can be reused by later sessions.
+            void setPersistentCache(const std::shared_ptr<io::PersistentCache>&);
+
         private:
             void _maxUpdate();
 
@@ -137,6 +172,12 @@ namespace tl
         };
 
         //! Thumbnail generator.
+        //!
+        //! Video thumbnails are decoded at a reduced resolution when the
+        //! format supports it, and resized on the CPU by a pool of threads.
+        //! Images that cannot be resized on the CPU, and timelines, are
+        //! rendered with OpenGL. If a window is not given and one cannot be
+        //! created, those thumbnails are not generated.
         class ThumbnailGenerator : public std::enable_shared_from_this<ThumbnailGenerator>
         {
         protected:
@@ -203,7 +244,16 @@ namespace tl
         private:
             void _infoRun();
             void _thumbnailRun();
+            void _glRun();
             void _waveformRun();
+            void _waveformPeaksAdd(
+                uint64_t id,
+                const io::CacheKey&,
+                const std::shared_ptr<io::IRead>&,
+                const io::Info&,
+                const io::Options&,
+                bool persistent);
+            void _waveformPeaksRun();
             void _infoCancel();
             void _thumbnailCancel();
             void _waveformCancel();
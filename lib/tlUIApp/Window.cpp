@@ -16,6 +16,7 @@
 #endif // TLRENDER_API_GLES_2
 
 #include <tlCore/StringFormat.h>
+#include <tlCore/ValueObserver.h>
 
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
@@ -147,6 +148,45 @@ namespace tl
                 return out;
             }
 
+            const size_t drawRectsMax = 8;
+
+            // Merge the overlapping draw rectangles. If there are too many
+            // rectangles they are replaced with their bounding box.
+            std::vector<math::Box2i> mergeDrawRects(const std::vector<math::Box2i>& rects)
+            {
+                std::vector<math::Box2i> out;
+                for (math::Box2i rect : rects)
+                {
+                    if (rect.w() <= 0 || rect.h() <= 0)
+                        continue;
+                    auto i = out.begin();
+                    while (i != out.end())
+                    {
+                        if (i->intersects(rect))
+                        {
+                            rect.expand(*i);
+                            out.erase(i);
+                            i = out.begin();
+                        }
+                        else
+                        {
+                            ++i;
+                        }
+                    }
+                    out.push_back(rect);
+                }
+                if (out.size() > drawRectsMax)
+                {
+                    math::Box2i rect = out.front();
+                    for (const auto& i : out)
+                    {
+                        rect.expand(i);
+                    }
+                    out = { rect };
+                }
+                return out;
+            }
+
 #if defined(_WINDOWS)
             //! \bug https://social.msdn.microsoft.com/Forums/vstudio/en-US/8f40dcd8-c67f-4eba-9134-a19b9178e481/vs-2015-rc-linker-stdcodecvt-error?forum=vcgeneral
             typedef unsigned int tl_char_t;
@@ -167,7 +207,10 @@ namespace tl
             std::shared_ptr<gl::GLFWWindow> glfwWindow;
             math::Size2i frameBufferSize;
             float displayScale = 1.F;
+            bool sizeHintAll = true;
             bool refresh = false;
+            std::shared_ptr<ui::Style> style;
+            std::shared_ptr<observer::ValueObserver<bool> > styleChangedObserver;
             int modifiers = 0;
             std::shared_ptr<timeline_gl::TextureCache> textureCache;
             std::shared_ptr<timeline_gl::Render> render;
@@ -210,6 +253,7 @@ namespace tl
                 [this](const math::Vector2f& value)
                 {
                     _p->displayScale = value.x;
+                    _p->sizeHintAll = true;
                     _updates |= ui::Update::Size;
                     _updates |= ui::Update::Draw;
                 });
@@ -438,14 +482,33 @@ namespace tl
             IWindow::tickEvent(parentsVisible, parentsEnabled, event);
             TLRENDER_P();
 
-            if (_hasSizeUpdate(shared_from_this()))
+            // Style changes can affect the size and appearance of all of
+            // the widgets.
+            if (event.style != p.style)
+            {
+                p.style = event.style;
+                p.styleChangedObserver = p.style ?
+                    observer::ValueObserver<bool>::create(
+                        p.style->observeChanged(),
+                        [this](bool)
+                        {
+                            _p->sizeHintAll = true;
+                            _p->refresh = true;
+                        }) :
+                    nullptr;
+            }
+
+            // The widgets mark their parents when they need updates, so
+            // only the branches of the tree that changed are visited.
+            if (p.sizeHintAll || ((_updates | getChildUpdates()) & ui::Update::Size))
             {
                 ui::SizeHintEvent sizeHintEvent(
                     event.style,
                     event.iconLibrary,
                     event.fontSystem,
                     p.displayScale);
-                _sizeHintEventRecursive(shared_from_this(), sizeHintEvent);
+                _sizeHintEventRecursive(shared_from_this(), sizeHintEvent, p.sizeHintAll);
+                p.sizeHintAll = false;
 
                 setGeometry(math::Box2i(p.frameBufferSize));
 
@@ -455,7 +518,28 @@ namespace tl
                     !isVisible(false));
             }
 
-            if (p.refresh || _hasDrawUpdate(shared_from_this()))
+            gl::OffscreenBufferOptions offscreenBufferOptions;
+            offscreenBufferOptions.colorType = p.colorBuffer->get();
+            const bool offscreenBufferCreate = gl::doCreate(
+                p.offscreenBuffer,
+                p.frameBufferSize,
+                offscreenBufferOptions);
+            std::vector<math::Box2i> drawRects;
+            if ((_updates | getChildUpdates()) & ui::Update::Draw)
+            {
+                _getDrawRects(
+                    shared_from_this(),
+                    _geometry,
+                    isVisible(false),
+                    drawRects);
+                drawRects = mergeDrawRects(drawRects);
+            }
+            if (p.refresh || offscreenBufferCreate)
+            {
+                drawRects = { math::Box2i(p.frameBufferSize) };
+            }
+
+            if (!drawRects.empty())
             {
                 p.refresh = false;
 
@@ -468,12 +552,7 @@ namespace tl
                         p.textureCache);
                 }
 
-                gl::OffscreenBufferOptions offscreenBufferOptions;
-                offscreenBufferOptions.colorType = p.colorBuffer->get();
-                if (gl::doCreate(
-                    p.offscreenBuffer,
-                    p.frameBufferSize,
-                    offscreenBufferOptions))
+                if (offscreenBufferCreate)
                 {
                     p.offscreenBuffer = gl::OffscreenBuffer::create(
                         p.frameBufferSize,
@@ -482,8 +561,12 @@ namespace tl
                 if (p.offscreenBuffer)
                 {
                     {
+                        // The offscreen buffer is kept between frames, so
+                        // only the regions that changed are cleared and
+                        // drawn.
                         gl::OffscreenBufferBinding binding(p.offscreenBuffer);
                         timeline::RenderOptions renderOptions;
+                        renderOptions.clear = false;
                         renderOptions.colorBuffer = p.colorBuffer->get();
                         p.render->begin(p.frameBufferSize, renderOptions);
                         ui::DrawEvent drawEvent(
@@ -492,10 +575,15 @@ namespace tl
                             p.render,
                             event.fontSystem);
                         p.render->setClipRectEnabled(true);
-                        _drawEventRecursive(
-                            shared_from_this(),
-                            math::Box2i(p.frameBufferSize),
-                            drawEvent);
+                        for (const auto& drawRect : drawRects)
+                        {
+                            p.render->setClipRect(drawRect);
+                            p.render->clearViewport(renderOptions.clearColor);
+                            _drawEventRecursive(
+                                shared_from_this(),
+                                drawRect,
+                                drawEvent);
+                        }
                         p.render->setClipRectEnabled(false);
                         p.render->end();
                     }
@@ -638,63 +726,6 @@ namespace tl
             }
         }
 
-        bool Window::_hasSizeUpdate(const std::shared_ptr<IWidget>& widget) const
-        {
-            bool out = widget->getUpdates() & ui::Update::Size;
-            if (out)
-            {
-                //std::cout << "Size update: " << widget->getObjectName() << std::endl;
-            }
-            else
-            {
-                for (const auto& child : widget->getChildren())
-                {
-                    out |= _hasSizeUpdate(child);
-                    if (out)
-                    {
-                        break;
-                    }
-                }
-            }
-            return out;
-        }
-
-        void Window::_sizeHintEventRecursive(
-            const std::shared_ptr<IWidget>& widget,
-            const ui::SizeHintEvent& event)
-        {
-            for (const auto& child : widget->getChildren())
-            {
-                _sizeHintEventRecursive(child, event);
-            }
-            widget->sizeHintEvent(event);
-        }
-
-        bool Window::_hasDrawUpdate(const std::shared_ptr<IWidget>& widget) const
-        {
-            bool out = false;
-            if (!widget->isClipped())
-            {
-                out = widget->getUpdates() & ui::Update::Draw;
-                if (out)
-                {
-                    //std::cout << "Draw update: " << widget->getObjectName() << std::endl;
-                }
-                else
-                {
-                    for (const auto& child : widget->getChildren())
-                    {
-                        out |= _hasDrawUpdate(child);
-                        if (out)
-                        {
-                            break;
-                        }
-                    }
-                }
-            }
-            return out;
-        }
-
         void Window::_drawEventRecursive(
             const std::shared_ptr<IWidget>& widget,
             const math::Box2i& drawRect,
@@ -97,12 +97,6 @@ namespace tl
             void _doneCurrent();
 
         private:
-            bool _hasSizeUpdate(const std::shared_ptr<IWidget>&) const;
-            void _sizeHintEventRecursive(
-                const std::shared_ptr<IWidget>&,
-                const ui::SizeHintEvent&);
-
-            bool _hasDrawUpdate(const std::shared_ptr<IWidget>&) const;
             void _drawEventRecursive(
                 const std::shared_ptr<IWidget>&,
                 const math::Box2i&,
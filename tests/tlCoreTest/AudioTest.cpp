@@ -5,10 +5,19 @@
 #include <tlCoreTest/AudioTest.h>
 
 #include <tlCore/Assert.h>
+#include <tlCore/AudioPeaks.h>
 #include <tlCore/AudioResample.h>
+#include <tlCore/AudioRingBuffer.h>
 #include <tlCore/AudioSystem.h>
+#include <tlCore/AudioTimeStretch.h>
+#include <tlCore/FileIO.h>
+#include <tlCore/Math.h>
 
+#include <chrono>
+#include <cmath>
 #include <cstring>
+#include <random>
+#include <thread>
 
 using namespace tl::audio;
 
@@ -29,12 +38,18 @@ namespace tl
         {
             _enums();
             _types();
+            _simd();
+            _simdBenchmark();
             _audio();
             _audioSystem();
             _mix();
             _convert();
             _interleave();
             _move();
+            _reverse();
+            _ringBuffer();
+            _peaks();
+            _timeStretch();
             _resample();
         }
 
@@ -42,6 +57,7 @@ namespace tl
         {
             _enum<DataType>("DataType", getDataTypeEnums);
             _enum<DeviceFormat>("DeviceFormat", getDeviceFormatEnums);
+            _enum<SIMD>("SIMD", getSIMDEnums);
         }
 
         void AudioTest::_types()
@@ -66,6 +82,180 @@ namespace tl
             }
         }
 
+        namespace
+        {
+            std::shared_ptr<Audio> createRandom(const Info& info, size_t sampleCount, unsigned seed)
+            {
+                auto out = Audio::create(info, sampleCount);
+                std::minstd_rand random(seed);
+                std::uniform_real_distribution<double> dist(-1.1, 1.1);
+                const size_t size = sampleCount * info.channelCount;
+                for (size_t i = 0; i < size; ++i)
+                {
+                    // Include the extremes of the range.
+                    double v = dist(random);
+                    if (0 == i % 97)
+                    {
+                        v = i % 2 ? -1.0 : 1.0;
+                    }
+                    switch (info.dataType)
+                    {
+                    case DataType::S16:
+                        reinterpret_cast<S16_T*>(out->getData())[i] =
+                            v >= 1.0 ? S16Range.getMax() :
+                            v <= -1.0 ? S16Range.getMin() :
+                            static_cast<S16_T>(v * S16Range.getMax());
+                        break;
+                    case DataType::F32:
+                        reinterpret_cast<F32_T*>(out->getData())[i] = v;
+                        break;
+                    case DataType::F64:
+                        reinterpret_cast<F64_T*>(out->getData())[i] = v;
+                        break;
+                    default: break;
+                    }
+                }
+                return out;
+            }
+
+            std::shared_ptr<Audio> mixAudio(
+                const std::vector<std::shared_ptr<Audio> >& in,
+                float volume)
+            {
+                const Info& info = in[0]->getInfo();
+                const size_t sampleCount = in[0]->getSampleCount();
+                auto out = Audio::create(info, sampleCount);
+                std::vector<const uint8_t*> inP;
+                for (const auto& i : in)
+                {
+                    inP.push_back(i->getData());
+                }
+                mix(
+                    inP.data(),
+                    inP.size(),
+                    out->getData(),
+                    volume,
+                    sampleCount,
+                    info.channelCount,
+                    info.dataType);
+                return out;
+            }
+
+            bool isEqual(const std::shared_ptr<Audio>& a, const std::shared_ptr<Audio>& b)
+            {
+                return
+                    a->getInfo() == b->getInfo() &&
+                    a->getSampleCount() == b->getSampleCount() &&
+                    (0 == a->getByteCount() ||
+                        0 == std::memcmp(a->getData(), b->getData(), a->getByteCount()));
+            }
+        }
+
+        void AudioTest::_simd()
+        {
+            const SIMD simdDefault = getSIMD();
+            {
+                std::stringstream ss;
+                ss << "Default SIMD: " << simdDefault;
+                _print(ss.str());
+            }
+            TLRENDER_ASSERT(isSIMDSupported(SIMD::None));
+            TLRENDER_ASSERT(isSIMDSupported(simdDefault));
+            for (auto simd : getSIMDEnums())
+            {
+                if (!isSIMDSupported(simd))
+                    continue;
+
+                // Compare the results with the scalar code. Odd sample
+                // counts are used to test the remainders.
+                for (auto dataType : { DataType::S16, DataType::F32, DataType::F64 })
+                {
+                    for (size_t sampleCount : { 0, 1, 7, 1001 })
+                    {
+                        const Info info(2, dataType, 48000);
+                        std::vector<std::shared_ptr<Audio> > in;
+                        for (size_t i = 0; i < 4; ++i)
+                        {
+                            in.push_back(createRandom(info, sampleCount, i));
+                        }
+                        for (float volume : { 0.F, .5F, 1.F, 1.7F })
+                        {
+                            for (size_t inCount : { 1, 2, 4 })
+                            {
+                                const std::vector<std::shared_ptr<Audio> > inList(
+                                    in.begin(),
+                                    in.begin() + inCount);
+                                setSIMD(SIMD::None);
+                                const auto a = mixAudio(inList, volume);
+                                setSIMD(simd);
+                                const auto b = mixAudio(inList, volume);
+                                TLRENDER_ASSERT(isEqual(a, b));
+                            }
+                        }
+                        for (auto convertType : { DataType::S16, DataType::F32, DataType::F64 })
+                        {
+                            setSIMD(SIMD::None);
+                            const auto a = convert(in[0], convertType);
+                            setSIMD(simd);
+                            const auto b = convert(in[0], convertType);
+                            TLRENDER_ASSERT(isEqual(a, b));
+                        }
+                        {
+                            setSIMD(SIMD::None);
+                            const auto a = planarInterleave(in[0]);
+                            setSIMD(simd);
+                            const auto b = planarInterleave(in[0]);
+                            TLRENDER_ASSERT(isEqual(a, b));
+                        }
+                    }
+                }
+                TLRENDER_ASSERT(simd == getSIMD());
+            }
+            setSIMD(simdDefault);
+            TLRENDER_ASSERT(simdDefault == getSIMD());
+        }
+
+        void AudioTest::_simdBenchmark()
+        {
+            const SIMD simdDefault = getSIMD();
+            const size_t sampleCount = 48000;
+            const size_t count = 10;
+            for (auto dataType : { DataType::S16, DataType::F32 })
+            {
+                const Info info(6, dataType, 48000);
+                std::vector<std::shared_ptr<Audio> > in;
+                for (size_t i = 0; i < 8; ++i)
+                {
+                    in.push_back(createRandom(info, sampleCount, i));
+                }
+                for (auto simd : getSIMDEnums())
+                {
+                    if (!isSIMDSupported(simd))
+                        continue;
+                    setSIMD(simd);
+                    const auto t0 = std::chrono::steady_clock::now();
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        mixAudio(in, .5F);
+                    }
+                    const auto t1 = std::chrono::steady_clock::now();
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        convert(in[0], DataType::S16 == dataType ? DataType::F32 : DataType::S16);
+                    }
+                    const auto t2 = std::chrono::steady_clock::now();
+                    const std::chrono::duration<double> mixTime = t1 - t0;
+                    const std::chrono::duration<double> convertTime = t2 - t1;
+                    std::stringstream ss;
+                    ss << dataType << " " << simd << ": mix " << in.size() << " tracks: " <<
+                        mixTime.count() / count * 1000.0 << "ms, convert: " <<
+                        convertTime.count() / count * 1000.0 << "ms";
+                    _print(ss.str());
+                }
+            }
+            setSIMD(simdDefault);
+        }
+
         void AudioTest::_audio()
         {
             {
@@ -469,6 +659,313 @@ namespace tl
             }
         }
 
+        void AudioTest::_reverse()
+        {
+            for (size_t sampleCount : { 0, 1, 2, 5 })
+            {
+                const Info info(2, DataType::S16, 10);
+                auto audio = Audio::create(info, sampleCount);
+                S16_T* data = reinterpret_cast<S16_T*>(audio->getData());
+                for (size_t i = 0; i < sampleCount; ++i)
+                {
+                    data[i * 2] = i;
+                    data[i * 2 + 1] = -static_cast<S16_T>(i);
+                }
+                reverse(audio);
+                for (size_t i = 0; i < sampleCount; ++i)
+                {
+                    TLRENDER_ASSERT(sampleCount - 1 - i == data[i * 2]);
+                    TLRENDER_ASSERT(-static_cast<S16_T>(sampleCount - 1 - i) == data[i * 2 + 1]);
+                }
+            }
+        }
+
+        void AudioTest::_ringBuffer()
+        {
+            {
+                const Info info(2, DataType::S16, 10);
+                auto ringBuffer = AudioRingBuffer::create(info, 8);
+                TLRENDER_ASSERT(ringBuffer->getInfo() == info);
+                TLRENDER_ASSERT(8 == ringBuffer->getSampleCount());
+                TLRENDER_ASSERT(0 == ringBuffer->getReadAvailable());
+                TLRENDER_ASSERT(8 == ringBuffer->getWriteAvailable());
+
+                std::vector<audio::S16_T> in(10 * 2);
+                for (size_t i = 0; i < 10; ++i)
+                {
+                    in[i * 2] = i;
+                    in[i * 2 + 1] = i;
+                }
+                std::vector<audio::S16_T> out(10 * 2, 0);
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    // Write and read across the end of the buffer.
+                    TLRENDER_ASSERT(6 == ringBuffer->write(
+                        reinterpret_cast<const uint8_t*>(in.data()), 6));
+                    TLRENDER_ASSERT(6 == ringBuffer->getReadAvailable());
+                    TLRENDER_ASSERT(2 == ringBuffer->getWriteAvailable());
+                    TLRENDER_ASSERT(6 == ringBuffer->read(
+                        reinterpret_cast<uint8_t*>(out.data()), 10));
+                    for (size_t j = 0; j < 6; ++j)
+                    {
+                        TLRENDER_ASSERT(j == out[j * 2]);
+                        TLRENDER_ASSERT(j == out[j * 2 + 1]);
+                    }
+                }
+                TLRENDER_ASSERT(8 == ringBuffer->write(
+                    reinterpret_cast<const uint8_t*>(in.data()), 10));
+                TLRENDER_ASSERT(0 == ringBuffer->getWriteAvailable());
+                TLRENDER_ASSERT(0 == ringBuffer->write(
+                    reinterpret_cast<const uint8_t*>(in.data()), 10));
+                TLRENDER_ASSERT(3 == ringBuffer->skip(3));
+                TLRENDER_ASSERT(2 == ringBuffer->read(
+                    reinterpret_cast<uint8_t*>(out.data()), 2));
+                TLRENDER_ASSERT(3 == out[0]);
+                TLRENDER_ASSERT(4 == out[2]);
+                ringBuffer->clear();
+                TLRENDER_ASSERT(0 == ringBuffer->getReadAvailable());
+                TLRENDER_ASSERT(8 == ringBuffer->getWriteAvailable());
+
+                // Force an underrun, and check that the missing samples are
+                // skipped when they are written.
+                TLRENDER_ASSERT(0 == ringBuffer->readSync(
+                    reinterpret_cast<uint8_t*>(out.data()), 4));
+                TLRENDER_ASSERT(4 == ringBuffer->getUnderrun());
+                TLRENDER_ASSERT(2 == ringBuffer->write(
+                    reinterpret_cast<const uint8_t*>(in.data()), 2));
+                TLRENDER_ASSERT(0 == ringBuffer->readSync(nullptr, 1));
+                TLRENDER_ASSERT(3 == ringBuffer->getUnderrun());
+                TLRENDER_ASSERT(6 == ringBuffer->write(
+                    reinterpret_cast<const uint8_t*>(in.data() + 2 * 2), 6));
+                TLRENDER_ASSERT(2 == ringBuffer->readSync(
+                    reinterpret_cast<uint8_t*>(out.data()), 2));
+                TLRENDER_ASSERT(0 == ringBuffer->getUnderrun());
+                TLRENDER_ASSERT(5 == out[0]);
+                TLRENDER_ASSERT(6 == out[2]);
+                TLRENDER_ASSERT(1 == ringBuffer->getReadAvailable());
+                TLRENDER_ASSERT(1 == ringBuffer->readSync(
+                    reinterpret_cast<uint8_t*>(out.data()), 2));
+                TLRENDER_ASSERT(7 == out[0]);
+                TLRENDER_ASSERT(1 == ringBuffer->getUnderrun());
+                ringBuffer->clear();
+                TLRENDER_ASSERT(0 == ringBuffer->getUnderrun());
+            }
+            {
+                const Info info(1, DataType::S32, 48000);
+                auto ringBuffer = AudioRingBuffer::create(info, 1000);
+                const audio::S32_T count = 100000;
+                std::thread thread(
+                    [ringBuffer, count]
+                    {
+                        audio::S32_T value = 0;
+                        while (value < count)
+                        {
+                            std::vector<audio::S32_T> data(64);
+                            for (size_t i = 0; i < data.size(); ++i)
+                            {
+                                data[i] = value + i;
+                            }
+                            value += ringBuffer->write(
+                                reinterpret_cast<const uint8_t*>(data.data()),
+                                std::min(data.size(), static_cast<size_t>(count - value)));
+                        }
+                    });
+                audio::S32_T value = 0;
+                bool valid = true;
+                while (value < count)
+                {
+                    std::vector<audio::S32_T> data(100);
+                    const size_t size = ringBuffer->read(
+                        reinterpret_cast<uint8_t*>(data.data()),
+                        data.size());
+                    for (size_t i = 0; i < size; ++i, ++value)
+                    {
+                        valid &= value == data[i];
+                    }
+                }
+                thread.join();
+                TLRENDER_ASSERT(valid);
+            }
+        }
+
+        void AudioTest::_peaks()
+        {
+            {
+                auto peaks = AudioPeaks::create(48000, 4);
+                TLRENDER_ASSERT(48000 == peaks->getSampleRate());
+                TLRENDER_ASSERT(4 == peaks->getBlockSize());
+                TLRENDER_ASSERT(0 == peaks->getSampleCount());
+                TLRENDER_ASSERT(1 == peaks->getLevelCount());
+                TLRENDER_ASSERT(peaks->getLevel(0).empty());
+                const auto out = peaks->getPeaks(0, 10, 2);
+                TLRENDER_ASSERT(2 == out.size());
+                TLRENDER_ASSERT(Peak() == out[0]);
+            }
+            {
+                const Info info(1, DataType::F32, 48000);
+                auto audio = Audio::create(info, 10);
+                F32_T* data = reinterpret_cast<F32_T*>(audio->getData());
+                for (size_t i = 0; i < 10; ++i)
+                {
+                    data[i] = (i % 2 ? -.1F : .1F) * i;
+                }
+
+                // Add the samples in one call, and in two calls that split
+                // a block.
+                auto peaks = AudioPeaks::create(48000, 4);
+                peaks->add(audio);
+                auto peaks2 = AudioPeaks::create(48000, 4);
+                auto audio2 = Audio::create(info, 3);
+                std::memcpy(audio2->getData(), data, 3 * sizeof(F32_T));
+                peaks2->add(audio2);
+                audio2 = Audio::create(info, 7);
+                std::memcpy(audio2->getData(), data + 3, 7 * sizeof(F32_T));
+                peaks2->add(audio2);
+
+                for (const auto& p : { peaks, peaks2 })
+                {
+                    TLRENDER_ASSERT(10 == p->getSampleCount());
+                    TLRENDER_ASSERT(3 == p->getLevelCount());
+                    TLRENDER_ASSERT(3 == p->getLevel(0).size());
+                    TLRENDER_ASSERT(2 == p->getLevel(1).size());
+                    TLRENDER_ASSERT(1 == p->getLevel(2).size());
+                    TLRENDER_ASSERT(6 * sizeof(Peak) == p->getByteCount());
+                    const Peak& peak = p->getLevel(0)[0];
+                    TLRENDER_ASSERT(math::fuzzyCompare(-.3F, peak.min));
+                    TLRENDER_ASSERT(math::fuzzyCompare(.2F, peak.max));
+                    TLRENDER_ASSERT(math::fuzzyCompare(std::sqrt(.035F), peak.rms));
+                    const Peak& peak2 = p->getLevel(0)[2];
+                    TLRENDER_ASSERT(math::fuzzyCompare(-.9F, peak2.min));
+                    TLRENDER_ASSERT(math::fuzzyCompare(.8F, peak2.max));
+                    TLRENDER_ASSERT(math::fuzzyCompare(std::sqrt(1.45F / 2.F), peak2.rms));
+                    const Peak& peak3 = p->getLevel(2)[0];
+                    TLRENDER_ASSERT(math::fuzzyCompare(-.9F, peak3.min));
+                    TLRENDER_ASSERT(math::fuzzyCompare(.8F, peak3.max));
+                    TLRENDER_ASSERT(math::fuzzyCompare(std::sqrt(2.85F / 10.F), peak3.rms));
+                }
+                for (size_t i = 0; i < 3; ++i)
+                {
+                    TLRENDER_ASSERT(peaks->getLevel(i) == peaks2->getLevel(i));
+                }
+
+                auto out = peaks->getPeaks(0, 10, 1);
+                TLRENDER_ASSERT(1 == out.size());
+                TLRENDER_ASSERT(peaks->getLevel(2)[0] == out[0]);
+                out = peaks->getPeaks(0, 8, 1);
+                TLRENDER_ASSERT(peaks->getLevel(1)[0] == out[0]);
+                out = peaks->getPeaks(0, 10, 10);
+                TLRENDER_ASSERT(10 == out.size());
+                TLRENDER_ASSERT(peaks->getLevel(0)[0] == out[0]);
+                TLRENDER_ASSERT(peaks->getLevel(0)[2] == out[9]);
+                out = peaks->getPeaks(-10, 10, 2);
+                TLRENDER_ASSERT(Peak() == out[0]);
+                TLRENDER_ASSERT(Peak() == out[1]);
+                out = peaks->getPeaks(8, 10, 2);
+                TLRENDER_ASSERT(peaks->getLevel(0)[2] == out[0]);
+                TLRENDER_ASSERT(Peak() == out[1]);
+
+                auto io = file::FileIO::createTemp();
+                peaks->write(io);
+                io->setPos(0);
+                auto peaks3 = AudioPeaks::read(io);
+                TLRENDER_ASSERT(peaks3->getSampleRate() == peaks->getSampleRate());
+                TLRENDER_ASSERT(peaks3->getBlockSize() == peaks->getBlockSize());
+                TLRENDER_ASSERT(peaks3->getSampleCount() == peaks->getSampleCount());
+                TLRENDER_ASSERT(peaks3->getLevelCount() == peaks->getLevelCount());
+                for (size_t i = 0; i < peaks->getLevelCount(); ++i)
+                {
+                    TLRENDER_ASSERT(peaks3->getLevel(i) == peaks->getLevel(i));
+                }
+
+                // Adding samples after reading continues the last block.
+                audio2 = Audio::create(info, 1);
+                reinterpret_cast<F32_T*>(audio2->getData())[0] = 1.F;
+                peaks->add(audio2);
+                peaks3->add(audio2);
+                TLRENDER_ASSERT(peaks3->getLevel(0) == peaks->getLevel(0));
+                TLRENDER_ASSERT(math::fuzzyCompare(1.F, peaks3->getLevel(2)[0].max));
+            }
+            {
+                auto io = file::FileIO::createTemp();
+                io->writeU32(0);
+                io->setPos(0);
+                try
+                {
+                    AudioPeaks::read(io);
+                    TLRENDER_ASSERT(false);
+                }
+                catch (const std::exception&)
+                {}
+            }
+        }
+
+        void AudioTest::_timeStretch()
+        {
+            const Info info(2, DataType::F32, 48000);
+            auto timeStretch = AudioTimeStretch::create(info);
+            TLRENDER_ASSERT(info == timeStretch->getInfo());
+            TLRENDER_ASSERT(1.0 == timeStretch->getSpeed());
+            timeStretch->setSpeed(100.0);
+            TLRENDER_ASSERT(timeStretchSpeedMax == timeStretch->getSpeed());
+            timeStretch->setSpeed(0.0);
+            TLRENDER_ASSERT(timeStretchSpeedMin == timeStretch->getSpeed());
+
+            // Create a sine wave.
+            const size_t sampleCount = 48000;
+            const float frequency = 440.F;
+            auto in = Audio::create(info, sampleCount);
+            F32_T* inP = reinterpret_cast<F32_T*>(in->getData());
+            for (size_t i = 0; i < sampleCount; ++i)
+            {
+                const float v = std::sin(math::pi2 * frequency * i / info.sampleRate) * .5F;
+                inP[i * 2] = v;
+                inP[i * 2 + 1] = v;
+            }
+
+            for (double speed : { .25, .5, 1.0, 2.0, 4.0 })
+            {
+                // Process the audio in small chunks.
+                timeStretch->setSpeed(speed);
+                std::list<std::shared_ptr<Audio> > list;
+                for (size_t i = 0; i < sampleCount; i += 1000)
+                {
+                    auto chunk = Audio::create(info, 1000);
+                    std::memcpy(
+                        chunk->getData(),
+                        in->getData() + i * info.getByteCount(),
+                        chunk->getByteCount());
+                    list.push_back(timeStretch->process(chunk));
+                }
+
+                // Check the length.
+                const size_t outSampleCount = getSampleCount(list);
+                {
+                    std::stringstream ss;
+                    ss << "Time stretch " << speed << ": " << outSampleCount << " samples";
+                    _print(ss.str());
+                }
+                const double expected = sampleCount / speed;
+                TLRENDER_ASSERT(std::fabs(outSampleCount - expected) < info.sampleRate * .1 / speed);
+
+                // Check the pitch by counting zero crossings.
+                auto out = Audio::create(info, outSampleCount);
+                move(list, out->getData(), outSampleCount);
+                const F32_T* outP = reinterpret_cast<const F32_T*>(out->getData());
+                size_t zeroCrossings = 0;
+                for (size_t i = 1; i < outSampleCount; ++i)
+                {
+                    if ((outP[(i - 1) * 2] < 0.F) != (outP[i * 2] < 0.F))
+                    {
+                        ++zeroCrossings;
+                    }
+                }
+                const double outFrequency = zeroCrossings / 2.0 /
+                    (outSampleCount / static_cast<double>(info.sampleRate));
+                TLRENDER_ASSERT(std::fabs(outFrequency - frequency) < frequency * .05);
+            }
+            timeStretch->flush();
+        }
+
         void AudioTest::_resample()
         {
             for (auto dataType :
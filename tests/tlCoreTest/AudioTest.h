@@ -23,12 +23,18 @@ namespace tl
         private:
             void _enums();
             void _types();
+            void _simd();
+            void _simdBenchmark();
             void _audio();
             void _audioSystem();
             void _mix();
             void _convert();
             void _interleave();
             void _move();
+            void _reverse();
+            void _ringBuffer();
+            void _peaks();
+            void _timeStretch();
             void _resample();
         };
     }
@@ -0,0 +1,165 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlCoreTest/BufferPoolTest.h>
+
+#include <tlCore/Assert.h>
+#include <tlCore/BufferPool.h>
+#include <tlCore/Image.h>
+
+#include <cstring>
+#include <thread>
+
+using namespace tl::memory;
+
+namespace tl
+{
+    namespace core_tests
+    {
+        BufferPoolTest::BufferPoolTest(const std::shared_ptr<system::Context>& context) :
+            ITest("core_tests::BufferPoolTest", context)
+        {}
+
+        std::shared_ptr<BufferPoolTest> BufferPoolTest::create(const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<BufferPoolTest>(new BufferPoolTest(context));
+        }
+
+        void BufferPoolTest::run()
+        {
+            _sizeClass();
+            _pool();
+            _threads();
+            _image();
+        }
+
+        void BufferPoolTest::_sizeClass()
+        {
+            TLRENDER_ASSERT(0 == BufferPool::getSizeClass(0));
+            TLRENDER_ASSERT(100 == BufferPool::getSizeClass(100));
+            const size_t minSize = BufferPool::minSize;
+            TLRENDER_ASSERT(minSize == BufferPool::getSizeClass(minSize));
+            TLRENDER_ASSERT(minSize + minSize / 8 == BufferPool::getSizeClass(minSize + 1));
+            TLRENDER_ASSERT(megabyte == BufferPool::getSizeClass(megabyte));
+            TLRENDER_ASSERT(megabyte + megabyte / 8 == BufferPool::getSizeClass(megabyte + 1));
+            for (size_t size = minSize; size < gigabyte; size = size * 3 / 2 + 1)
+            {
+                // The size class is at most 1/8th larger than the size.
+                const size_t sizeClass = BufferPool::getSizeClass(size);
+                TLRENDER_ASSERT(sizeClass >= size);
+                TLRENDER_ASSERT(sizeClass - size <= size / 8);
+            }
+        }
+
+        void BufferPoolTest::_pool()
+        {
+            auto pool = BufferPool::create(10 * megabyte);
+            TLRENDER_ASSERT(10 * megabyte == pool->getMaxFreeByteCount());
+            TLRENDER_ASSERT(BufferPoolStats() == pool->getStats());
+            {
+                // Small buffers are not pooled.
+                auto buffer = pool->getBuffer(100);
+                TLRENDER_ASSERT(buffer->getData());
+                TLRENDER_ASSERT(100 == buffer->getSize());
+                std::memset(buffer->getData(), 0, buffer->getSize());
+            }
+            TLRENDER_ASSERT(BufferPoolStats() == pool->getStats());
+
+            uint8_t* data = nullptr;
+            const size_t capacity = BufferPool::getSizeClass(3 * megabyte);
+            {
+                auto buffer = pool->getBuffer(3 * megabyte);
+                data = buffer->getData();
+                TLRENDER_ASSERT(data);
+                TLRENDER_ASSERT(3 * megabyte == buffer->getSize());
+                TLRENDER_ASSERT(capacity == buffer->getCapacity());
+                std::memset(buffer->getData(), 0, buffer->getCapacity());
+                const BufferPoolStats stats = pool->getStats();
+                TLRENDER_ASSERT(1 == stats.allocCount);
+                TLRENDER_ASSERT(capacity == stats.usedByteCount);
+                TLRENDER_ASSERT(0 == stats.freeByteCount);
+            }
+            {
+                const BufferPoolStats stats = pool->getStats();
+                TLRENDER_ASSERT(0 == stats.usedByteCount);
+                TLRENDER_ASSERT(capacity == stats.freeByteCount);
+                TLRENDER_ASSERT(capacity == stats.peakByteCount);
+            }
+            {
+                // Buffers in the same size class are reused.
+                auto buffer = pool->getBuffer(3 * megabyte - 1);
+                TLRENDER_ASSERT(data == buffer->getData());
+                const BufferPoolStats stats = pool->getStats();
+                TLRENDER_ASSERT(1 == stats.allocCount);
+                TLRENDER_ASSERT(1 == stats.reuseCount);
+            }
+            {
+                // Free buffers above the maximum are released.
+                std::vector<std::shared_ptr<Buffer> > buffers;
+                for (size_t i = 0; i < 5; ++i)
+                {
+                    buffers.push_back(pool->getBuffer(3 * megabyte));
+                }
+                buffers.clear();
+                const BufferPoolStats stats = pool->getStats();
+                TLRENDER_ASSERT(5 == stats.allocCount);
+                TLRENDER_ASSERT(2 == stats.reuseCount);
+                TLRENDER_ASSERT(2 == stats.releaseCount);
+                TLRENDER_ASSERT(3 * capacity == stats.freeByteCount);
+                TLRENDER_ASSERT(5 * capacity == stats.peakByteCount);
+            }
+            pool->setMaxFreeByteCount(capacity);
+            TLRENDER_ASSERT(capacity == pool->getStats().freeByteCount);
+            pool->clear();
+            {
+                const BufferPoolStats stats = pool->getStats();
+                TLRENDER_ASSERT(5 == stats.releaseCount);
+                TLRENDER_ASSERT(0 == stats.freeByteCount);
+            }
+        }
+
+        void BufferPoolTest::_threads()
+        {
+            auto pool = BufferPool::create(100 * megabyte);
+            std::vector<std::thread> threads;
+            for (size_t i = 0; i < 4; ++i)
+            {
+                threads.push_back(std::thread(
+                    [pool, i]
+                    {
+                        for (size_t j = 0; j < 100; ++j)
+                        {
+                            auto buffer = pool->getBuffer((i + 1) * megabyte);
+                            std::memset(buffer->getData(), j, buffer->getSize());
+                        }
+                    }));
+            }
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+            const BufferPoolStats stats = pool->getStats();
+            TLRENDER_ASSERT(400 == stats.allocCount + stats.reuseCount);
+            TLRENDER_ASSERT(0 == stats.usedByteCount);
+            TLRENDER_ASSERT(stats.allocCount <= 4);
+        }
+
+        void BufferPoolTest::_image()
+        {
+            // Images reuse the memory of previous images.
+            const image::Info info(1920, 1080, image::PixelType::RGBA_U8);
+            auto pool = BufferPool::getGlobal();
+            TLRENDER_ASSERT(BufferPool::defaultMaxFreeByteCount == pool->getMaxFreeByteCount());
+            image::Image::create(info);
+            const BufferPoolStats stats = pool->getStats();
+            for (size_t i = 0; i < 10; ++i)
+            {
+                auto image = image::Image::create(info);
+                image->zero();
+            }
+            TLRENDER_ASSERT(pool->getStats().allocCount == stats.allocCount);
+            TLRENDER_ASSERT(pool->getStats().reuseCount == stats.reuseCount + 10);
+        }
+    }
+}
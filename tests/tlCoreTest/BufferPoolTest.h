@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTestLib/ITest.h>
+
+namespace tl
+{
+    namespace core_tests
+    {
+        class BufferPoolTest : public tests::ITest
+        {
+        protected:
+            BufferPoolTest(const std::shared_ptr<system::Context>&);
+
+        public:
+            static std::shared_ptr<BufferPoolTest> create(const std::shared_ptr<system::Context>&);
+
+            void run() override;
+
+        private:
+            void _sizeClass();
+            void _pool();
+            void _threads();
+            void _image();
+        };
+    }
+}
@@ -38,7 +38,9 @@ namespace tl
                 FileIO::create(fileName, Mode::Write);
             }
             TLRENDER_ASSERT(exists(fileName));
+            TLRENDER_ASSERT(touch(fileName));
             TLRENDER_ASSERT(rm(fileName));
+            TLRENDER_ASSERT(!touch(fileName));
         }
 
         void FileTest::_dir()
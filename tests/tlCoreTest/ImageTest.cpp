@@ -6,8 +6,11 @@
 
 #include <tlCore/Assert.h>
 #include <tlCore/Image.h>
+#include <tlCore/ImageResize.h>
 #include <tlCore/StringFormat.h>
 
+#include <cstring>
+
 using namespace tl::image;
 
 namespace tl
@@ -30,6 +33,7 @@ namespace tl
             _util();
             _info();
             _image();
+            _resize();
             _serialize();
         }
 
@@ -76,6 +80,7 @@ namespace tl
             _enum<PixelType>("PixelType", getPixelTypeEnums);
             _enum<VideoLevels>("VideoLevels", getVideoLevelsEnums);
             _enum<YUVCoefficients>("YUVCoefficients", getYUVCoefficientsEnums);
+            _enum<ResizeFilter>("ResizeFilter", getResizeFilterEnums);
             for (auto i : getYUVCoefficientsEnums())
             {
                 _print(string::Format("%0: %1").arg(getLabel(i)).arg(getYUVCoefficients(i)));
@@ -211,6 +216,124 @@ namespace tl
                 TLRENDER_ASSERT(image->getHeight() == 2);
                 TLRENDER_ASSERT(image->getPixelType() == PixelType::L_U8);
             }
+            {
+                const Info info(2, 2, PixelType::YUV_420P_U8);
+                auto data = std::shared_ptr<uint8_t>(
+                    new uint8_t[getDataByteCount(info)],
+                    std::default_delete<uint8_t[]>());
+                std::weak_ptr<uint8_t> weak = data;
+                {
+                    auto image = Image::create(info, data.get(), data);
+                    data.reset();
+                    TLRENDER_ASSERT(image->getInfo() == info);
+                    TLRENDER_ASSERT(image->getDataByteCount() == getDataByteCount(info));
+                    TLRENDER_ASSERT(image->getData() == weak.lock().get());
+                    image->zero();
+                    TLRENDER_ASSERT(0 == image->getData()[0]);
+                    TLRENDER_ASSERT(!weak.expired());
+                }
+                TLRENDER_ASSERT(weak.expired());
+            }
+        }
+
+        void ImageTest::_resize()
+        {
+            {
+                TLRENDER_ASSERT(!isResizeSupported(Info()));
+                TLRENDER_ASSERT(isResizeSupported(Info(2, 2, PixelType::RGBA_U8)));
+                TLRENDER_ASSERT(isResizeSupported(Info(2, 2, PixelType::YUV_420P_U8)));
+                TLRENDER_ASSERT(!isResizeSupported(Info(1, 1, PixelType::YUV_420P_U8)));
+                TLRENDER_ASSERT(!isResizeSupported(Info(2, 2, PixelType::ARGB_4444_Premult)));
+            }
+            for (auto filter : getResizeFilterEnums())
+            {
+                auto image = Image::create(4, 4, PixelType::L_U8);
+                memset(image->getData(), 128, image->getDataByteCount());
+                auto out = resize(image, Size(2, 2), filter);
+                TLRENDER_ASSERT(Size(2, 2) == out->getSize());
+                TLRENDER_ASSERT(PixelType::RGBA_U8 == out->getPixelType());
+                for (size_t i = 0; i < 2 * 2; ++i)
+                {
+                    TLRENDER_ASSERT(128 == out->getData()[i * 4]);
+                    TLRENDER_ASSERT(128 == out->getData()[i * 4 + 1]);
+                    TLRENDER_ASSERT(128 == out->getData()[i * 4 + 2]);
+                    TLRENDER_ASSERT(255 == out->getData()[i * 4 + 3]);
+                }
+            }
+            {
+                auto image = Image::create(4, 1, PixelType::L_U8);
+                const std::vector<uint8_t> data = { 0, 255, 0, 255 };
+                memcpy(image->getData(), data.data(), data.size());
+                auto out = resize(image, Size(2, 1), ResizeFilter::Box);
+                TLRENDER_ASSERT(128 == out->getData()[0]);
+                TLRENDER_ASSERT(128 == out->getData()[4]);
+            }
+            {
+                Info info(1, 2, PixelType::RGB_U8);
+                info.layout.mirror.y = true;
+                auto image = Image::create(info);
+                const std::vector<uint8_t> data = { 255, 0, 0, 0, 0, 255 };
+                memcpy(image->getData(), data.data(), data.size());
+                auto out = resize(image, Size(1, 2), ResizeFilter::Box);
+                const std::vector<uint8_t> result = { 0, 0, 255, 255, 255, 0, 0, 255 };
+                TLRENDER_ASSERT(0 == memcmp(out->getData(), result.data(), result.size()));
+            }
+            {
+                Info info(2, 1, PixelType::LA_U16);
+                info.layout.mirror.x = true;
+                auto image = Image::create(info);
+                const std::vector<uint16_t> data = { 0, 65535, 65535, 0 };
+                memcpy(image->getData(), data.data(), data.size() * sizeof(uint16_t));
+                auto out = resize(image, Size(2, 1), ResizeFilter::Lanczos3);
+                const std::vector<uint8_t> result = { 255, 255, 255, 0, 0, 0, 0, 255 };
+                TLRENDER_ASSERT(0 == memcmp(out->getData(), result.data(), result.size()));
+            }
+            {
+                auto image = Image::create(2, 2, PixelType::RGBA_F32);
+                float* data = reinterpret_cast<float*>(image->getData());
+                for (size_t i = 0; i < 2 * 2 * 4; ++i)
+                {
+                    data[i] = i % 4 == 3 ? 1.F : 2.F;
+                }
+                auto out = resize(image, Size(1, 1), ResizeFilter::Box);
+                const std::vector<uint8_t> result = { 255, 255, 255, 255 };
+                TLRENDER_ASSERT(0 == memcmp(out->getData(), result.data(), result.size()));
+            }
+            {
+                Info info(2, 2, PixelType::L_U8);
+                info.videoLevels = VideoLevels::LegalRange;
+                auto image = Image::create(info);
+                const std::vector<uint8_t> data = { 16, 16, 235, 235 };
+                memcpy(image->getData(), data.data(), data.size());
+                auto out = resize(image, Size(2, 2), ResizeFilter::Box);
+                TLRENDER_ASSERT(0 == out->getData()[0]);
+                TLRENDER_ASSERT(0 == out->getData()[1]);
+                TLRENDER_ASSERT(255 == out->getData()[8]);
+                TLRENDER_ASSERT(255 == out->getData()[10]);
+            }
+            for (auto pixelType : {
+                PixelType::YUV_420P_U8,
+                PixelType::YUV_422P_U8,
+                PixelType::YUV_444P_U8 })
+            {
+                auto image = Image::create(4, 4, pixelType);
+                memset(image->getData(), 128, image->getDataByteCount());
+                auto out = resize(image, Size(2, 2), ResizeFilter::Lanczos3);
+                for (size_t i = 0; i < 2 * 2; ++i)
+                {
+                    TLRENDER_ASSERT(std::abs(out->getData()[i * 4] - 128) <= 1);
+                    TLRENDER_ASSERT(std::abs(out->getData()[i * 4 + 1] - 128) <= 1);
+                    TLRENDER_ASSERT(std::abs(out->getData()[i * 4 + 2] - 128) <= 1);
+                    TLRENDER_ASSERT(255 == out->getData()[i * 4 + 3]);
+                }
+            }
+            try
+            {
+                resize(Image::create(2, 2, PixelType::ARGB_4444_Premult), Size(1, 1));
+                TLRENDER_ASSERT(false);
+            }
+            catch (const std::exception&)
+            {}
         }
 
         void ImageTest::_serialize()
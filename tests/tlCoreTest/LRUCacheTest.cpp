@@ -7,6 +7,9 @@
 #include <tlCore/Assert.h>
 #include <tlCore/LRUCache.h>
 #include <tlCore/Memory.h>
+#include <tlCore/StringFormat.h>
+
+#include <chrono>
 
 using namespace tl::memory;
 
@@ -66,6 +69,11 @@ namespace tl
                 const auto l = c.getKeys();
                 TLRENDER_ASSERT(std::vector<int>({ 1, 3, 4 }) == c.getKeys());
                 TLRENDER_ASSERT(std::vector<int>({ 2, 4, 5 }) == c.getValues());
+                int k = 0;
+                TLRENDER_ASSERT(c.getOldest(k));
+                TLRENDER_ASSERT(3 == k);
+                c.clear();
+                TLRENDER_ASSERT(!c.getOldest(k));
             }
             {
                 LRUCache<int, int> c;
@@ -87,6 +95,66 @@ namespace tl
                 TLRENDER_ASSERT(std::vector<int>({ 1, 3, 4 }) == c.getKeys());
                 TLRENDER_ASSERT(std::vector<int>({ 2, 4, 5 }) == c.getValues());
             }
+            {
+                LRUCache<std::pair<std::string, int>, int> c;
+                c.setMax(2);
+                c.add(std::make_pair("a", 0), 0);
+                c.add(std::make_pair("b", 1), 1);
+                c.add(std::make_pair("a", 0), 2);
+                TLRENDER_ASSERT(2 == c.getSize());
+                c.add(std::make_pair("c", 2), 3);
+                TLRENDER_ASSERT(c.contains(std::make_pair("a", 0)));
+                TLRENDER_ASSERT(!c.contains(std::make_pair("b", 1)));
+                TLRENDER_ASSERT(c.contains(std::make_pair("c", 2)));
+                int v = 0;
+                TLRENDER_ASSERT(c.get(std::make_pair("a", 0), v));
+                TLRENDER_ASSERT(2 == v);
+                c.remove(std::make_pair("a", 0));
+                TLRENDER_ASSERT(1 == c.getSize());
+                TLRENDER_ASSERT(1 == c.getCount());
+                c.clear();
+                TLRENDER_ASSERT(0 == c.getSize());
+                TLRENDER_ASSERT(0 == c.getCount());
+            }
+            _benchmark();
+        }
+
+        void LRUCacheTest::_benchmark()
+        {
+            const size_t count = 100000;
+            const size_t budget = 1000;
+            LRUCache<int64_t, int64_t> c;
+            c.setMax(budget * memory::megabyte);
+
+            const auto t0 = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < count; ++i)
+            {
+                c.add(i, i, memory::megabyte);
+            }
+            TLRENDER_ASSERT(budget == c.getCount());
+            TLRENDER_ASSERT(budget * memory::megabyte == c.getSize());
+
+            const auto t1 = std::chrono::steady_clock::now();
+            int64_t v = 0;
+            size_t hits = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (c.get(count - 1 - (i % (budget * 2)), v))
+                {
+                    ++hits;
+                }
+            }
+            TLRENDER_ASSERT(count / 2 == hits);
+
+            const auto t2 = std::chrono::steady_clock::now();
+            const std::chrono::duration<double> addTime = t1 - t0;
+            const std::chrono::duration<double> getTime = t2 - t1;
+            _print(string::Format("Add with eviction: {0} items, {1} ns/item").
+                arg(count).
+                arg(addTime.count() / count * 1000000000.0));
+            _print(string::Format("Get: {0} items, {1} ns/item").
+                arg(count).
+                arg(getTime.count() / count * 1000000000.0));
         }
     }
 }
@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlCoreTest/RangeSetTest.h>
+
+#include <tlCore/Assert.h>
+#include <tlCore/RangeSet.h>
+
+#include <random>
+#include <set>
+
+using namespace tl::math;
+
+namespace tl
+{
+    namespace core_tests
+    {
+        RangeSetTest::RangeSetTest(const std::shared_ptr<system::Context>& context) :
+            ITest("core_tests::RangeSetTest", context)
+        {}
+
+        std::shared_ptr<RangeSetTest> RangeSetTest::create(const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<RangeSetTest>(new RangeSetTest(context));
+        }
+
+        void RangeSetTest::run()
+        {
+            {
+                Int64RangeSet s;
+                TLRENDER_ASSERT(s.isEmpty());
+                TLRENDER_ASSERT(0 == s.getRangeCount());
+                TLRENDER_ASSERT(!s.contains(0));
+            }
+            {
+                Int64RangeSet s;
+                s.insert(1);
+                s.insert(3);
+                TLRENDER_ASSERT(2 == s.getRangeCount());
+                s.insert(2);
+                TLRENDER_ASSERT(1 == s.getRangeCount());
+                TLRENDER_ASSERT(Range<int64_t>(1, 3) == s.getRanges()[0]);
+                TLRENDER_ASSERT(s.contains(1));
+                TLRENDER_ASSERT(s.contains(3));
+                TLRENDER_ASSERT(!s.contains(0));
+                TLRENDER_ASSERT(!s.contains(4));
+                s.remove(2);
+                TLRENDER_ASSERT(2 == s.getRangeCount());
+                TLRENDER_ASSERT(Range<int64_t>(1, 1) == s.getRanges()[0]);
+                TLRENDER_ASSERT(Range<int64_t>(3, 3) == s.getRanges()[1]);
+                s.clear();
+                TLRENDER_ASSERT(s.isEmpty());
+            }
+            {
+                Int64RangeSet s;
+                s.insert(Range<int64_t>(0, 9));
+                s.insert(Range<int64_t>(20, 29));
+                s.insert(Range<int64_t>(-10, -1));
+                TLRENDER_ASSERT(2 == s.getRangeCount());
+                s.insert(Range<int64_t>(5, 25));
+                TLRENDER_ASSERT(1 == s.getRangeCount());
+                TLRENDER_ASSERT(Range<int64_t>(-10, 29) == s.getRanges()[0]);
+                s.remove(Range<int64_t>(0, 9));
+                TLRENDER_ASSERT(2 == s.getRangeCount());
+                TLRENDER_ASSERT(Range<int64_t>(-10, -1) == s.getRanges()[0]);
+                TLRENDER_ASSERT(Range<int64_t>(10, 29) == s.getRanges()[1]);
+                s.remove(Range<int64_t>(-20, 40));
+                TLRENDER_ASSERT(s.isEmpty());
+            }
+            {
+                Int64RangeSet s;
+                Int64RangeSet s2;
+                TLRENDER_ASSERT(s == s2);
+                s.insert(1);
+                TLRENDER_ASSERT(s != s2);
+            }
+            {
+                // Compare random insertions and removals with a set.
+                Int64RangeSet s;
+                std::set<int64_t> values;
+                std::minstd_rand random(1);
+                for (size_t i = 0; i < 10000; ++i)
+                {
+                    const int64_t min = static_cast<int64_t>(random() % 200) - 100;
+                    const int64_t max = min + static_cast<int64_t>(random() % 10);
+                    if (random() % 2)
+                    {
+                        s.insert(Range<int64_t>(min, max));
+                        for (int64_t j = min; j <= max; ++j)
+                        {
+                            values.insert(j);
+                        }
+                    }
+                    else
+                    {
+                        s.remove(Range<int64_t>(min, max));
+                        for (int64_t j = min; j <= max; ++j)
+                        {
+                            values.erase(j);
+                        }
+                    }
+                }
+                for (int64_t i = -110; i < 110; ++i)
+                {
+                    TLRENDER_ASSERT(s.contains(i) == (values.find(i) != values.end()));
+                }
+                int64_t prevMax = 0;
+                bool first = true;
+                for (const auto& range : s.getRanges())
+                {
+                    TLRENDER_ASSERT(range.getMin() <= range.getMax());
+                    TLRENDER_ASSERT(first || range.getMin() > prevMax + 1);
+                    prevMax = range.getMax();
+                    first = false;
+                }
+            }
+        }
+    }
+}
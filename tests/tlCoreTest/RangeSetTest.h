@@ -0,0 +1,24 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTestLib/ITest.h>
+
+namespace tl
+{
+    namespace core_tests
+    {
+        class RangeSetTest : public tests::ITest
+        {
+        protected:
+            RangeSetTest(const std::shared_ptr<system::Context>&);
+
+        public:
+            static std::shared_ptr<RangeSetTest> create(const std::shared_ptr<system::Context>&);
+
+            void run() override;
+        };
+    }
+}
@@ -4,12 +4,17 @@
 
 #include <tlIOTest/IOTest.h>
 
+#include <tlIO/Cache.h>
+#include <tlIO/DiskCache.h>
+#include <tlIO/PersistentCache.h>
 #include <tlIO/System.h>
 
 #include <tlCore/Assert.h>
+#include <tlCore/File.h>
 #include <tlCore/String.h>
 #include <tlCore/StringFormat.h>
 
+#include <cstring>
 #include <sstream>
 
 using namespace tl::io;
@@ -30,7 +35,11 @@ namespace tl
         void IOTest::run()
         {
             _videoData();
+            _playbackHint();
+            _readRequest();
             _ioSystem();
+            _cache();
+            _persistentCache();
         }
 
         void IOTest::_videoData()
@@ -39,6 +48,7 @@ namespace tl
                 const VideoData v;
                 TLRENDER_ASSERT(!time::isValid(v.time));
                 TLRENDER_ASSERT(!v.image);
+                TLRENDER_ASSERT(!v.canceled);
             }
             {
                 const auto time = otime::RationalTime(1.0, 24.0);
@@ -56,6 +66,9 @@ namespace tl
                 const VideoData a(time, layer, image);
                 VideoData b(time, layer, image);
                 TLRENDER_ASSERT(a == b);
+                b.canceled = true;
+                TLRENDER_ASSERT(a != b);
+                b.canceled = false;
                 b.time = otime::RationalTime(2.0, 24.0);
                 TLRENDER_ASSERT(a != b);
                 TLRENDER_ASSERT(a < b);
@@ -91,6 +104,67 @@ namespace tl
             };
         }
 
+        void IOTest::_playbackHint()
+        {
+            {
+                const PlaybackHint hint;
+                TLRENDER_ASSERT(hint == PlaybackHint());
+                TLRENDER_ASSERT(0.0 == getPriority(hint, otime::RationalTime(0.0, 24.0)));
+                TLRENDER_ASSERT(0.0 == getPriority(hint, otime::RationalTime(10.0, 24.0)));
+                TLRENDER_ASSERT(contains(hint, otime::RationalTime(10.0, 24.0)));
+            }
+            {
+                PlaybackHint hint;
+                hint.time = otime::RationalTime(10.0, 24.0);
+                hint.direction = 1;
+                hint.ranges.push_back(otime::TimeRange(
+                    otime::RationalTime(0.0, 24.0),
+                    otime::RationalTime(20.0, 24.0)));
+                TLRENDER_ASSERT(hint != PlaybackHint());
+                const double p10 = getPriority(hint, otime::RationalTime(10.0, 24.0));
+                const double p11 = getPriority(hint, otime::RationalTime(11.0, 24.0));
+                const double p19 = getPriority(hint, otime::RationalTime(19.0, 24.0));
+                const double p9 = getPriority(hint, otime::RationalTime(9.0, 24.0));
+                TLRENDER_ASSERT(p10 < p11);
+                TLRENDER_ASSERT(p11 < p19);
+                TLRENDER_ASSERT(p19 < p9);
+                TLRENDER_ASSERT(contains(hint, otime::RationalTime(19.0, 24.0)));
+                TLRENDER_ASSERT(!contains(hint, otime::RationalTime(20.0, 24.0)));
+
+                hint.direction = -1;
+                TLRENDER_ASSERT(
+                    getPriority(hint, otime::RationalTime(9.0, 24.0)) <
+                    getPriority(hint, otime::RationalTime(11.0, 24.0)));
+
+                hint.direction = 0;
+                TLRENDER_ASSERT(
+                    getPriority(hint, otime::RationalTime(9.0, 24.0)) ==
+                    getPriority(hint, otime::RationalTime(11.0, 24.0)));
+            }
+        }
+
+        void IOTest::_readRequest()
+        {
+            {
+                const std::shared_ptr<ReadRequest> request;
+                TLRENDER_ASSERT(!isCanceled(request));
+                finished(request);
+            }
+            {
+                auto request = std::make_shared<ReadRequest>();
+                TLRENDER_ASSERT(!isCanceled(request));
+                request->canceled = true;
+                TLRENDER_ASSERT(isCanceled(request));
+                int count = 0;
+                request->callback = [&count]
+                {
+                    ++count;
+                };
+                finished(request);
+                TLRENDER_ASSERT(1 == count);
+            }
+        }
+
         void IOTest::_ioSystem()
         {
             auto system = _context->getSystem<System>();
@@ -134,5 +208,336 @@ namespace tl
             TLRENDER_ASSERT(!system->read(file::Path()));
             TLRENDER_ASSERT(!system->write(file::Path(), Info()));
         }
+
+        void IOTest::_cache()
+        {
+            {
+                const file::Path path("test.0.exr");
+                const Options options = { { "Layer", "0" } };
+                const CacheKey key = getCacheKey(
+                    path,
+                    otime::RationalTime(0.0, 24.0),
+                    options,
+                    Options());
+                TLRENDER_ASSERT(key == getCacheKey(
+                    path,
+                    otime::RationalTime(0.0, 24.0),
+                    options,
+                    Options()));
+                TLRENDER_ASSERT(std::hash<CacheKey>()(key) == std::hash<CacheKey>()(getCacheKey(
+                    path,
+                    otime::RationalTime(0.0, 24.0),
+                    options,
+                    Options())));
+                TLRENDER_ASSERT(key != getCacheKey(
+                    path,
+                    otime::RationalTime(1.0, 24.0),
+                    options,
+                    Options()));
+                TLRENDER_ASSERT(key != getCacheKey(
+                    file::Path("test.1.exr"),
+                    otime::RationalTime(0.0, 24.0),
+                    options,
+                    Options()));
+                TLRENDER_ASSERT(key != getCacheKey(
+                    path,
+                    otime::RationalTime(0.0, 24.0),
+                    Options(),
+                    options));
+                TLRENDER_ASSERT(getCacheHash(Options({ { "ab", "c" } })) !=
+                    getCacheHash(Options({ { "a", "bc" } })));
+                TLRENDER_ASSERT(key != getCacheKey(
+                    path,
+                    otime::TimeRange(
+                        otime::RationalTime(0.0, 24.0),
+                        otime::RationalTime(1.0, 24.0)),
+                    options,
+                    Options()));
+            }
+            {
+                auto cache = Cache::create(4);
+                TLRENDER_ASSERT(4 == cache->getShardCount());
+                cache->setMax(memory::megabyte);
+                TLRENDER_ASSERT(memory::megabyte == cache->getMax());
+                TLRENDER_ASSERT(0 == cache->getSize());
+
+                VideoData videoData;
+                for (int i = 0; i < 16; ++i)
+                {
+                    const CacheKey key(0, otime::RationalTime(i, 24.0), 0);
+                    TLRENDER_ASSERT(!cache->containsVideo(key));
+                    TLRENDER_ASSERT(!cache->getVideo(key, videoData));
+                    videoData.time = otime::RationalTime(i, 24.0);
+                    cache->addVideo(key, videoData);
+                    TLRENDER_ASSERT(cache->containsVideo(key));
+                    TLRENDER_ASSERT(cache->getVideo(key, videoData));
+                    TLRENDER_ASSERT(otime::RationalTime(i, 24.0) == videoData.time);
+                }
+                TLRENDER_ASSERT(16 == cache->getSize());
+
+                AudioData audioData;
+                const CacheKey audioKey(
+                    0,
+                    otime::TimeRange(
+                        otime::RationalTime(0.0, 48000.0),
+                        otime::RationalTime(48000.0, 48000.0)),
+                    0);
+                TLRENDER_ASSERT(!cache->getAudio(audioKey, audioData));
+                cache->addAudio(audioKey, audioData);
+                TLRENDER_ASSERT(cache->containsAudio(audioKey));
+                TLRENDER_ASSERT(cache->getAudio(audioKey, audioData));
+
+                CacheShardStats total;
+                for (const auto& stats : cache->getShardStats())
+                {
+                    total.videoHits += stats.videoHits;
+                    total.videoMisses += stats.videoMisses;
+                    total.audioHits += stats.audioHits;
+                    total.audioMisses += stats.audioMisses;
+                }
+                TLRENDER_ASSERT(16 == total.videoHits);
+                TLRENDER_ASSERT(16 == total.videoMisses);
+                TLRENDER_ASSERT(1 == total.audioHits);
+                TLRENDER_ASSERT(1 == total.audioMisses);
+                cache->resetShardStats();
+                for (const auto& stats : cache->getShardStats())
+                {
+                    TLRENDER_ASSERT(CacheShardStats() == stats);
+                }
+
+                cache->clear();
+                TLRENDER_ASSERT(0 == cache->getSize());
+            }
+            {
+                // Cache frames that are larger than a single shard's share
+                // of the budget.
+                const image::Info info(256, 256, image::PixelType::RGBA_U8);
+                const size_t byteCount = image::getDataByteCount(info);
+                auto cache = Cache::create(16);
+                cache->setMax(memory::megabyte);
+                TLRENDER_ASSERT(byteCount > cache->getMax() / cache->getShardCount());
+                for (int i = 0; i < 4; ++i)
+                {
+                    const CacheKey key(0, otime::RationalTime(i, 24.0), 0);
+                    VideoData videoData;
+                    videoData.time = otime::RationalTime(i, 24.0);
+                    videoData.image = image::Image::create(info);
+                    cache->addVideo(key, videoData);
+                    TLRENDER_ASSERT(cache->containsVideo(key));
+                    TLRENDER_ASSERT(cache->getVideo(key, videoData));
+                    TLRENDER_ASSERT(videoData.image);
+                }
+
+                // Only the oldest frame is evicted to stay within the budget.
+                TLRENDER_ASSERT(!cache->containsVideo(
+                    CacheKey(0, otime::RationalTime(0.0, 24.0), 0)));
+                for (int i = 1; i < 4; ++i)
+                {
+                    TLRENDER_ASSERT(cache->containsVideo(
+                        CacheKey(0, otime::RationalTime(i, 24.0), 0)));
+                }
+                TLRENDER_ASSERT(byteCount * 3 == cache->getSize());
+                TLRENDER_ASSERT(cache->getPercentage() <= 100.F);
+
+                // A frame larger than the whole budget is kept until the
+                // next frame is added.
+                cache->setMax(byteCount / 2);
+                TLRENDER_ASSERT(0 == cache->getSize());
+                VideoData videoData;
+                videoData.image = image::Image::create(info);
+                cache->addVideo(CacheKey(0, otime::RationalTime(0.0, 24.0), 0), videoData);
+                TLRENDER_ASSERT(cache->containsVideo(
+                    CacheKey(0, otime::RationalTime(0.0, 24.0), 0)));
+                cache->addVideo(CacheKey(0, otime::RationalTime(1.0, 24.0), 0), videoData);
+                TLRENDER_ASSERT(!cache->containsVideo(
+                    CacheKey(0, otime::RationalTime(0.0, 24.0), 0)));
+                TLRENDER_ASSERT(cache->containsVideo(
+                    CacheKey(0, otime::RationalTime(1.0, 24.0), 0)));
+            }
+            {
+                const image::Info info(16, 16, image::PixelType::RGBA_U8);
+                const size_t byteCount = image::getDataByteCount(info);
+                auto diskCache = DiskCache::create(file::getTemp(), byteCount * 4);
+                TLRENDER_ASSERT(file::exists(diskCache->getPath()));
+                TLRENDER_ASSERT(byteCount * 4 == diskCache->getMax());
+                auto cache = Cache::create(1);
+                cache->setMax(byteCount * 2 / .9F + 1);
+                cache->setDiskCache(diskCache);
+                TLRENDER_ASSERT(diskCache == cache->getDiskCache());
+
+                // Fill the memory cache so that frames are evicted to disk.
+                for (int i = 0; i < 4; ++i)
+                {
+                    VideoData videoData;
+                    videoData.time = otime::RationalTime(i, 24.0);
+                    videoData.image = image::Image::create(info);
+                    videoData.image->getData()[0] = i;
+                    videoData.image->setTags({ { "Frame", string::Format("{0}").arg(i) } });
+                    cache->addVideo(CacheKey(0, videoData.time, 0), videoData);
+                }
+
+                // The frames are written to disk by a separate thread.
+                for (int i = 0; i < 4; ++i)
+                {
+                    const CacheKey key(0, otime::RationalTime(i, 24.0), 0);
+                    TLRENDER_ASSERT(cache->containsVideo(key));
+                }
+                diskCache->flush();
+                TLRENDER_ASSERT(byteCount * 2 == diskCache->getSize());
+                for (int i = 0; i < 4; ++i)
+                {
+                    const CacheKey key(0, otime::RationalTime(i, 24.0), 0);
+                    TLRENDER_ASSERT(cache->containsVideo(key));
+                }
+
+                // Read the frames back from the disk cache.
+                for (int i = 0; i < 2; ++i)
+                {
+                    VideoData videoData;
+                    TLRENDER_ASSERT(cache->getVideo(
+                        CacheKey(0, otime::RationalTime(i, 24.0), 0),
+                        videoData));
+                    TLRENDER_ASSERT(otime::RationalTime(i, 24.0) == videoData.time);
+                    TLRENDER_ASSERT(videoData.image);
+                    TLRENDER_ASSERT(info == videoData.image->getInfo());
+                    TLRENDER_ASSERT(i == videoData.image->getData()[0]);
+                    TLRENDER_ASSERT(std::to_string(i) == videoData.image->getTags().at("Frame"));
+                }
+                size_t diskHits = 0;
+                for (const auto& stats : cache->getShardStats())
+                {
+                    diskHits += stats.diskHits;
+                }
+                TLRENDER_ASSERT(2 == diskHits);
+
+                cache->clear();
+                TLRENDER_ASSERT(0 == diskCache->getSize());
+                const std::string path = diskCache->getPath();
+                cache.reset();
+                diskCache.reset();
+                TLRENDER_ASSERT(!file::exists(path));
+            }
+        }
+
+        void IOTest::_persistentCache()
+        {
+            const std::string tempDir = file::createTempDir();
+            const std::string path = file::Path(tempDir, "cache").get();
+            auto cache = PersistentCache::create(path, memory::megabyte);
+            TLRENDER_ASSERT(file::exists(path));
+            TLRENDER_ASSERT(path == cache->getPath());
+            TLRENDER_ASSERT(memory::megabyte == cache->getMax());
+            TLRENDER_ASSERT(0 == cache->getSize());
+            {
+                Info info;
+                info.video.push_back(image::Info(16, 9, image::PixelType::RGB_U8));
+                info.video.back().name = "Video";
+                info.videoTime = otime::TimeRange(
+                    otime::RationalTime(0.0, 24.0),
+                    otime::RationalTime(24.0, 24.0));
+                info.audio = audio::Info(2, audio::DataType::F32, 48000);
+                info.audioTime = otime::TimeRange(
+                    otime::RationalTime(0.0, 48000.0),
+                    otime::RationalTime(48000.0, 48000.0));
+                info.tags["Tag"] = "Value";
+                const CacheKey key(1, time::invalidTime, 2);
+                cache->addInfo(key, info);
+                TLRENDER_ASSERT(cache->getSize() > 0);
+                Info info2;
+                TLRENDER_ASSERT(cache->getInfo(key, info2));
+                TLRENDER_ASSERT(info == info2);
+                TLRENDER_ASSERT(!cache->getInfo(CacheKey(1, time::invalidTime, 3), info2));
+            }
+            {
+                // Opaque images are stored without the alpha channel.
+                const image::Info info(16, 16, image::PixelType::RGBA_U8);
+                auto image = image::Image::create(info);
+                uint8_t* p = image->getData();
+                for (size_t i = 0; i < 16 * 16; ++i, p += 4)
+                {
+                    p[0] = i;
+                    p[1] = i + 1;
+                    p[2] = i + 2;
+                    p[3] = 255;
+                }
+                image->setTags({ { "Tag", "Value" } });
+                const CacheKey key(1, otime::RationalTime(0.0, 24.0), 2);
+                const size_t size = cache->getSize();
+                cache->addImage(key, image);
+                TLRENDER_ASSERT(cache->getSize() - size < image->getDataByteCount());
+                std::shared_ptr<image::Image> image2;
+                TLRENDER_ASSERT(cache->getImage(key, image2));
+                TLRENDER_ASSERT(image2);
+                TLRENDER_ASSERT(info == image2->getInfo());
+                TLRENDER_ASSERT(image->getTags() == image2->getTags());
+                TLRENDER_ASSERT(0 == memcmp(
+                    image->getData(),
+                    image2->getData(),
+                    image->getDataByteCount()));
+
+                image->getData()[3] = 0;
+                cache->addImage(key, image);
+                TLRENDER_ASSERT(cache->getImage(key, image2));
+                TLRENDER_ASSERT(0 == memcmp(
+                    image->getData(),
+                    image2->getData(),
+                    image->getDataByteCount()));
+
+                TLRENDER_ASSERT(!cache->getImage(
+                    CacheKey(1, otime::RationalTime(1.0, 24.0), 2),
+                    image2));
+            }
+            {
+                auto peaks = audio::AudioPeaks::create(48000);
+                auto audio = audio::Audio::create(
+                    audio::Info(1, audio::DataType::F32, 48000),
+                    48000);
+                audio->zero();
+                peaks->add(audio);
+                const CacheKey key(1, time::invalidTime, 2);
+                cache->addPeaks(key, peaks);
+                std::shared_ptr<audio::AudioPeaks> peaks2;
+                TLRENDER_ASSERT(cache->getPeaks(key, peaks2));
+                TLRENDER_ASSERT(peaks2);
+                TLRENDER_ASSERT(peaks->getSampleCount() == peaks2->getSampleCount());
+                TLRENDER_ASSERT(peaks->getLevelCount() == peaks2->getLevelCount());
+            }
+            {
+                // A second cache using the same directory sees the items.
+                auto cache2 = PersistentCache::create(path, memory::megabyte);
+                TLRENDER_ASSERT(cache->getSize() == cache2->getSize());
+                Info info;
+                TLRENDER_ASSERT(cache2->getInfo(CacheKey(1, time::invalidTime, 2), info));
+            }
+            {
+                // The cache is trimmed when it is larger than the maximum.
+                const image::Info info(64, 64, image::PixelType::RGBA_U8);
+                const size_t byteCount = image::getDataByteCount(info);
+                cache->setMax(byteCount * 4);
+                for (int i = 0; i < 8; ++i)
+                {
+                    auto image = image::Image::create(info);
+                    image->zero();
+                    cache->addImage(CacheKey(i, otime::RationalTime(0.0, 24.0), 3), image);
+                    TLRENDER_ASSERT(cache->getSize() <= cache->getMax());
+                }
+                size_t hits = 0;
+                for (int i = 0; i < 8; ++i)
+                {
+                    std::shared_ptr<image::Image> image;
+                    if (cache->getImage(CacheKey(i, otime::RationalTime(0.0, 24.0), 3), image))
+                    {
+                        ++hits;
+                    }
+                }
+                TLRENDER_ASSERT(hits > 0 && hits < 8);
+            }
+            cache->clear();
+            TLRENDER_ASSERT(0 == cache->getSize());
+            cache.reset();
+            file::rmdir(path);
+            file::rmdir(tempDir);
+            TLRENDER_ASSERT(!file::exists(tempDir));
+        }
     }
 }
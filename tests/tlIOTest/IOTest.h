@@ -22,7 +22,11 @@ namespace tl
 
         private:
             void _videoData();
+            void _playbackHint();
+            void _readRequest();
             void _ioSystem();
+            void _cache();
+            void _persistentCache();
         };
     }
 }
@@ -10,6 +10,13 @@
 #include <tlCore/Assert.h>
 #include <tlCore/FileIO.h>
 
+#include <ImfChannelList.h>
+#include <ImfFrameBuffer.h>
+#include <ImfHeader.h>
+#include <ImfMultiPartOutputFile.h>
+#include <ImfOutputPart.h>
+#include <ImfPartType.h>
+
 #include <sstream>
 
 using namespace tl::io;
@@ -31,6 +38,8 @@ namespace tl
         {
             _enums();
             _io();
+            _dataWindow();
+            _multiPart();
         }
 
         void OpenEXRTest::_enums()
@@ -243,7 +252,8 @@ namespace tl
                 { "OpenEXR/Compression", "DWAA" },
                 { "OpenEXR/Compression", "DWAB" },
                 { "OpenEXR/DWACompressionLevel", "45" },
-                { "OpenEXR/DWACompressionLevel", "100" }
+                { "OpenEXR/DWACompressionLevel", "100" },
+                { "OpenEXR/ThreadCount", "4" }
             };
 
             for (const auto& fileName : fileNames)
@@ -290,5 +300,212 @@ namespace tl
                 }
             }
         }
+
+        namespace
+        {
+            // Test pixel value, the values are exact in 32-bit float.
+            float pixel(int x, int y, int c, int part)
+            {
+                return x + y * 1024.F + c * .25F + part * 2048.F * 1024.F;
+            }
+
+            struct Part
+            {
+                std::string name;
+                math::Box2i dataWindow;
+            };
+
+            // Write a file with RGB float channels, one part for each
+            // data window.
+            void writeParts(
+                const std::string& fileName,
+                const math::Box2i& displayWindow,
+                const std::vector<Part>& parts)
+            {
+                std::vector<Imf::Header> headers;
+                for (const auto& part : parts)
+                {
+                    Imf::Header header(
+                        Imath::Box2i(
+                            Imath::V2i(displayWindow.min.x, displayWindow.min.y),
+                            Imath::V2i(displayWindow.max.x, displayWindow.max.y)),
+                        Imath::Box2i(
+                            Imath::V2i(part.dataWindow.min.x, part.dataWindow.min.y),
+                            Imath::V2i(part.dataWindow.max.x, part.dataWindow.max.y)));
+                    header.setName(part.name);
+                    header.setType(Imf::SCANLINEIMAGE);
+                    header.channels().insert("R", Imf::Channel(Imf::FLOAT));
+                    header.channels().insert("G", Imf::Channel(Imf::FLOAT));
+                    header.channels().insert("B", Imf::Channel(Imf::FLOAT));
+                    headers.push_back(header);
+                }
+                Imf::MultiPartOutputFile file(
+                    fileName.c_str(),
+                    headers.data(),
+                    static_cast<int>(headers.size()));
+                for (size_t i = 0; i < parts.size(); ++i)
+                {
+                    const math::Box2i& dataWindow = parts[i].dataWindow;
+                    const int w = dataWindow.w();
+                    const int h = dataWindow.h();
+                    std::vector<float> buf(w * h * 3);
+                    for (int y = 0; y < h; ++y)
+                    {
+                        for (int x = 0; x < w; ++x)
+                        {
+                            for (int c = 0; c < 3; ++c)
+                            {
+                                buf[(y * w + x) * 3 + c] = pixel(
+                                    dataWindow.min.x + x,
+                                    dataWindow.min.y + y,
+                                    c,
+                                    i);
+                            }
+                        }
+                    }
+                    char* base =
+                        reinterpret_cast<char*>(buf.data()) -
+                        (dataWindow.min.x + dataWindow.min.y * static_cast<ptrdiff_t>(w)) * 3 * sizeof(float);
+                    Imf::FrameBuffer frameBuffer;
+                    const char* names[] = { "R", "G", "B" };
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        frameBuffer.insert(
+                            names[c],
+                            Imf::Slice(
+                                Imf::FLOAT,
+                                base + c * sizeof(float),
+                                3 * sizeof(float),
+                                w * 3 * sizeof(float)));
+                    }
+                    Imf::OutputPart part(file, static_cast<int>(i));
+                    part.setFrameBuffer(frameBuffer);
+                    part.writePixels(h);
+                }
+            }
+
+            // Read a layer and compare it with the written pixels. The
+            // pixels outside of the data window should be zero.
+            void readCompare(
+                const std::shared_ptr<io::IPlugin>& plugin,
+                const std::string& fileName,
+                const math::Box2i& displayWindow,
+                const math::Box2i& dataWindow,
+                int layer,
+                int part)
+            {
+                Options options;
+                options["Layer"] = std::to_string(layer);
+                auto read = plugin->read(file::Path(fileName), options);
+                const auto videoData = read->readVideo(
+                    otime::RationalTime(0.0, 24.0),
+                    options).get();
+                TLRENDER_ASSERT(videoData.image);
+                TLRENDER_ASSERT(videoData.image->getPixelType() == image::PixelType::RGB_F32);
+                TLRENDER_ASSERT(videoData.image->getWidth() == displayWindow.w());
+                TLRENDER_ASSERT(videoData.image->getHeight() == displayWindow.h());
+                const float* data = reinterpret_cast<const float*>(videoData.image->getData());
+                for (int y = displayWindow.min.y; y <= displayWindow.max.y; ++y)
+                {
+                    for (int x = displayWindow.min.x; x <= displayWindow.max.x; ++x)
+                    {
+                        const bool inside = dataWindow.contains(math::Vector2i(x, y));
+                        for (int c = 0; c < 3; ++c)
+                        {
+                            TLRENDER_ASSERT(*data++ == (inside ? pixel(x, y, c, part) : 0.F));
+                        }
+                    }
+                }
+            }
+        }
+
+        void OpenEXRTest::_dataWindow()
+        {
+            auto system = _context->getSystem<System>();
+            auto plugin = system->getPlugin<exr::Plugin>();
+            struct Data
+            {
+                math::Box2i displayWindow;
+                math::Box2i dataWindow;
+            };
+            const std::vector<Data> data =
+            {
+                // Data window inside the display window.
+                { math::Box2i(0, 0, 32, 24), math::Box2i(4, 3, 17, 15) },
+                // Display window with an offset.
+                { math::Box2i(-8, 10, 32, 24), math::Box2i(-4, 12, 8, 8) },
+                // Data window larger than the display window, with more
+                // scanlines than a single chunk.
+                { math::Box2i(0, 0, 16, 600), math::Box2i(-8, -10, 32, 620) },
+                // Data window that partially overlaps the display window.
+                { math::Box2i(0, 0, 32, 32), math::Box2i(16, -4, 32, 24) },
+                // Data window outside of the display window.
+                { math::Box2i(0, 0, 16, 16), math::Box2i(32, 32, 8, 8) }
+            };
+            for (size_t i = 0; i < data.size(); ++i)
+            {
+                std::stringstream ss;
+                ss << "OpenEXRTest_DataWindow_" << i << ".0.exr";
+                const std::string fileName = ss.str();
+                _print(fileName);
+                try
+                {
+                    writeParts(
+                        fileName,
+                        data[i].displayWindow,
+                        { { "rgb", data[i].dataWindow } });
+                    readCompare(
+                        plugin,
+                        fileName,
+                        data[i].displayWindow,
+                        data[i].dataWindow,
+                        0,
+                        0);
+                    system->getCache()->clear();
+                }
+                catch (const std::exception& e)
+                {
+                    _printError(e.what());
+                }
+            }
+        }
+
+        void OpenEXRTest::_multiPart()
+        {
+            auto system = _context->getSystem<System>();
+            auto plugin = system->getPlugin<exr::Plugin>();
+            const math::Box2i displayWindow(0, 0, 24, 16);
+            const std::vector<Part> parts =
+            {
+                { "diffuse", math::Box2i(0, 0, 24, 16) },
+                { "specular", math::Box2i(2, 4, 12, 8) }
+            };
+            const std::string fileName = "OpenEXRTest_MultiPart.0.exr";
+            _print(fileName);
+            try
+            {
+                writeParts(fileName, displayWindow, parts);
+                {
+                    auto read = plugin->read(file::Path(fileName));
+                    const auto info = read->getInfo().get();
+                    TLRENDER_ASSERT(2 == info.video.size());
+                }
+                for (size_t i = 0; i < parts.size(); ++i)
+                {
+                    readCompare(
+                        plugin,
+                        fileName,
+                        displayWindow,
+                        parts[i].dataWindow,
+                        i,
+                        i);
+                    system->getCache()->clear();
+                }
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+        }
     }
 }
@@ -8,7 +8,10 @@
 #include <tlIO/System.h>
 
 #include <tlCore/Assert.h>
+#include <tlCore/File.h>
 
+#include <chrono>
+#include <list>
 #include <sstream>
 
 using namespace tl::io;
@@ -30,6 +33,9 @@ namespace tl
         {
             _enums();
             _io();
+            _writeThreads();
+            _readThreads();
+            _playbackHint();
         }
 
         void PPMTest::_enums()
@@ -184,5 +190,165 @@ namespace tl
                 }
             }
         }
+
+        void PPMTest::_writeThreads()
+        {
+            auto system = _context->getSystem<System>();
+            auto plugin = system->getPlugin<ppm::Plugin>();
+            const auto imageInfo = plugin->getWriteInfo(
+                image::Info(16, 16, image::PixelType::RGB_U8));
+            auto image = image::Image::create(imageInfo);
+            image->zero();
+            Info info;
+            info.video.push_back(imageInfo);
+            info.videoTime = otime::TimeRange(
+                otime::RationalTime(0.0, 24.0),
+                otime::RationalTime(16.0, 24.0));
+            Options options;
+            options["SequenceIO/WriteThreadCount"] = "4";
+            options["SequenceIO/WriteQueueSize"] = "2";
+            {
+                const file::Path path("PPMTest_WriteThreads.0.ppm");
+                auto write = plugin->write(path, info, options);
+                for (int i = 0; i < 16; ++i)
+                {
+                    write->writeVideo(otime::RationalTime(i, 24.0), image);
+                }
+                write->flush();
+                for (int i = 0; i < 16; ++i)
+                {
+                    TLRENDER_ASSERT(file::exists(path.get(i)));
+                }
+            }
+            {
+                const file::Path path("PPMTest_WriteThreads/Error.0.ppm");
+                auto write = plugin->write(path, info, options);
+                try
+                {
+                    for (int i = 0; i < 16; ++i)
+                    {
+                        write->writeVideo(otime::RationalTime(i, 24.0), image);
+                    }
+                    write->flush();
+                    TLRENDER_ASSERT(false);
+                }
+                catch (const std::exception&)
+                {}
+            }
+        }
+
+        void PPMTest::_readThreads()
+        {
+            auto system = _context->getSystem<System>();
+            auto plugin = system->getPlugin<ppm::Plugin>();
+            const auto imageInfo = plugin->getWriteInfo(
+                image::Info(128, 128, image::PixelType::RGB_U8));
+            auto image = image::Image::create(imageInfo);
+            image->zero();
+            Info info;
+            info.video.push_back(imageInfo);
+            info.videoTime = otime::TimeRange(
+                otime::RationalTime(0.0, 24.0),
+                otime::RationalTime(16.0, 24.0));
+            const file::Path path("PPMTest_ReadThreads.0.ppm");
+            {
+                auto write = plugin->write(path, info);
+                for (int i = 0; i < 16; ++i)
+                {
+                    write->writeVideo(otime::RationalTime(i, 24.0), image);
+                }
+            }
+
+            // Keep the readers busy for longer than the adjustment
+            // interval, and check that the number of threads stays
+            // within the limits.
+            Options options;
+            options["SequenceIO/ThreadCount"] = "0";
+            auto read = std::dynamic_pointer_cast<ISequenceRead>(plugin->read(path, options));
+            TLRENDER_ASSERT(read);
+            TLRENDER_ASSERT(sequenceThreadCount == read->getThreadCount());
+            std::list<std::future<VideoData> > futures;
+            int frame = 0;
+            const auto start = std::chrono::steady_clock::now();
+            while (std::chrono::steady_clock::now() - start < sequenceThreadCountInterval * 3)
+            {
+                while (futures.size() < 256)
+                {
+                    futures.push_back(read->readVideo(otime::RationalTime(frame, 24.0)));
+                    frame = (frame + 1) % 16;
+                }
+                const auto videoData = futures.front().get();
+                futures.pop_front();
+                TLRENDER_ASSERT(videoData.image);
+                TLRENDER_ASSERT(videoData.image->getSize() == image->getSize());
+                const size_t threadCount = read->getThreadCount();
+                TLRENDER_ASSERT(threadCount >= sequenceThreadCountMin);
+                TLRENDER_ASSERT(threadCount <= sequenceThreadCountMax);
+                system->getCache()->clear();
+            }
+            for (auto& future : futures)
+            {
+                TLRENDER_ASSERT(future.get().image);
+            }
+        }
+
+        void PPMTest::_playbackHint()
+        {
+            auto system = _context->getSystem<System>();
+            auto plugin = system->getPlugin<ppm::Plugin>();
+            const auto imageInfo = plugin->getWriteInfo(
+                image::Info(256, 256, image::PixelType::RGB_U8));
+            auto image = image::Image::create(imageInfo);
+            image->zero();
+            Info info;
+            info.video.push_back(imageInfo);
+            info.videoTime = otime::TimeRange(
+                otime::RationalTime(0.0, 24.0),
+                otime::RationalTime(16.0, 24.0));
+            const file::Path path("PPMTest_PlaybackHint.0.ppm");
+            {
+                auto write = plugin->write(path, info);
+                for (int i = 0; i < 16; ++i)
+                {
+                    write->writeVideo(otime::RationalTime(i, 24.0), image);
+                }
+            }
+
+            // Queue more requests than the single thread can read, then
+            // change the playback hint so that only the first frame is
+            // needed. The pending requests for the other frames should be
+            // canceled.
+            Options options;
+            options["SequenceIO/ThreadCount"] = "1";
+            auto read = plugin->read(path, options);
+            std::vector<std::future<VideoData> > futures;
+            for (int i = 0; i < 256; ++i)
+            {
+                futures.push_back(read->readVideo(otime::RationalTime(i % 16, 24.0)));
+            }
+            PlaybackHint hint;
+            hint.time = otime::RationalTime(0.0, 24.0);
+            hint.ranges.push_back(otime::TimeRange(
+                otime::RationalTime(0.0, 24.0),
+                otime::RationalTime(1.0, 24.0)));
+            read->setPlaybackHint(hint);
+            size_t canceled = 0;
+            for (auto& future : futures)
+            {
+                const auto videoData = future.get();
+                if (videoData.canceled)
+                {
+                    TLRENDER_ASSERT(!videoData.image);
+                    TLRENDER_ASSERT(videoData.time.value() != 0.0);
+                    ++canceled;
+                }
+                else
+                {
+                    TLRENDER_ASSERT(videoData.image);
+                }
+            }
+            TLRENDER_ASSERT(canceled > 0);
+            system->getCache()->clear();
+        }
     }
 }
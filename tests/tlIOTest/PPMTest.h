@@ -23,6 +23,9 @@ namespace tl
         private:
             void _enums();
             void _io();
+            void _writeThreads();
+            void _readThreads();
+            void _playbackHint();
         };
     }
 }
@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlTimelineTest/PlayerPrefetchTest.h>
+
+#include <tlTimeline/PlayerPrefetch.h>
+
+#include <tlCore/Assert.h>
+
+using namespace tl::timeline;
+
+namespace tl
+{
+    namespace timeline_tests
+    {
+        PlayerPrefetchTest::PlayerPrefetchTest(const std::shared_ptr<system::Context>& context) :
+            ITest("timeline_tests::PlayerPrefetchTest", context)
+        {}
+
+        std::shared_ptr<PlayerPrefetchTest> PlayerPrefetchTest::create(const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<PlayerPrefetchTest>(new PlayerPrefetchTest(context));
+        }
+
+        void PlayerPrefetchTest::run()
+        {
+            _stats();
+            _scrub();
+            _structure();
+        }
+
+        void PlayerPrefetchTest::_stats()
+        {
+            PlayerPrefetchStats v;
+            TLRENDER_ASSERT(0.F == v.getHitPercentage());
+            v.hitCount = 1;
+            v.prefetchHitCount = 2;
+            v.missCount = 1;
+            TLRENDER_ASSERT(75.F == v.getHitPercentage());
+            TLRENDER_ASSERT(v == v);
+            TLRENDER_ASSERT(v != PlayerPrefetchStats());
+        }
+
+        void PlayerPrefetchTest::_scrub()
+        {
+            const otime::TimeRange range(
+                otime::RationalTime(0.0, 24.0),
+                otime::RationalTime(240.0, 24.0));
+            auto policy = ScrubPrefetchPolicy::create();
+            policy->setLookAhead(1.0);
+            TLRENDER_ASSERT(1.0 == policy->getLookAhead());
+            TLRENDER_ASSERT(0.0 == policy->getVelocity());
+            TLRENDER_ASSERT(policy->getPrefetch(range.start_time(), range, 4).empty());
+
+            // Scrub forward.
+            auto t = std::chrono::steady_clock::now();
+            policy->timeUpdate(otime::RationalTime(0.0, 24.0), t);
+            t += std::chrono::milliseconds(100);
+            policy->timeUpdate(otime::RationalTime(24.0, 24.0), t);
+            TLRENDER_ASSERT(policy->getVelocity() > 0.0);
+            auto times = policy->getPrefetch(otime::RationalTime(24.0, 24.0), range, 4);
+            TLRENDER_ASSERT(4 == times.size());
+            for (const auto& i : times)
+            {
+                TLRENDER_ASSERT(i > otime::RationalTime(24.0, 24.0));
+                TLRENDER_ASSERT(range.contains(i));
+            }
+
+            // Scrub backward; the predictions are clamped to the range.
+            for (int i = 0; i < 4; ++i)
+            {
+                t += std::chrono::milliseconds(100);
+                policy->timeUpdate(otime::RationalTime(0.0, 24.0), t);
+            }
+            TLRENDER_ASSERT(policy->getVelocity() < 0.0);
+            times = policy->getPrefetch(otime::RationalTime(1.0, 24.0), range, 4);
+            TLRENDER_ASSERT(1 == times.size());
+            TLRENDER_ASSERT(range.start_time() == times[0]);
+
+            // A pause resets the velocity.
+            t += std::chrono::seconds(1);
+            policy->timeUpdate(otime::RationalTime(0.0, 24.0), t);
+            TLRENDER_ASSERT(0.0 == policy->getVelocity());
+        }
+
+        void PlayerPrefetchTest::_structure()
+        {
+            const otime::TimeRange range(
+                otime::RationalTime(0.0, 24.0),
+                otime::RationalTime(240.0, 24.0));
+            auto policy = StructurePrefetchPolicy::create();
+            policy->setTimeline(nullptr);
+            TLRENDER_ASSERT(policy->getTargets().empty());
+
+            // Without a timeline the in/out points are used.
+            auto times = policy->getPrefetch(otime::RationalTime(200.0, 24.0), range, 4);
+            TLRENDER_ASSERT(2 == times.size());
+            TLRENDER_ASSERT(range.end_time_inclusive() == times[0]);
+            TLRENDER_ASSERT(range.start_time() == times[1]);
+            times = policy->getPrefetch(range.start_time(), range, 4);
+            TLRENDER_ASSERT(1 == times.size());
+            TLRENDER_ASSERT(range.end_time_inclusive() == times[0]);
+        }
+    }
+}
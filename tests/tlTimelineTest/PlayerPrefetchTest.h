@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTestLib/ITest.h>
+
+namespace tl
+{
+    namespace timeline_tests
+    {
+        class PlayerPrefetchTest : public tests::ITest
+        {
+        protected:
+            PlayerPrefetchTest(const std::shared_ptr<system::Context>&);
+
+        public:
+            static std::shared_ptr<PlayerPrefetchTest> create(const std::shared_ptr<system::Context>&);
+
+            void run() override;
+
+        private:
+            void _stats();
+            void _scrub();
+            void _structure();
+        };
+    }
+}
@@ -413,6 +413,11 @@ namespace tl
                             ss << "Video/audio cached frames: " << value.videoFrames.size() << "/" << value.audioFrames.size();
                             _print(ss.str());
                         }
+                        {
+                            std::stringstream ss;
+                            ss << "Video/audio cached bytes: " << value.videoByteCount << "/" << value.audioByteCount;
+                            _print(ss.str());
+                        }
                     });
 
                 for (const auto& loop : getLoopEnums())
@@ -465,6 +470,46 @@ namespace tl
                 }
                 player->setPlayback(Playback::Stop);
                 player->clearCache();
+
+                // Test the video cache size.
+                cacheOptions.videoByteCount = memory::megabyte;
+                player->setCacheOptions(cacheOptions);
+                TLRENDER_ASSERT(cacheOptions == player->getCacheOptions());
+                player->seek(timeRange.start_time());
+                player->setPlayback(Playback::Forward);
+                auto t = std::chrono::steady_clock::now();
+                std::chrono::duration<float> diff;
+                do
+                {
+                    player->tick();
+                    time::sleep(std::chrono::milliseconds(10));
+                    const auto t2 = std::chrono::steady_clock::now();
+                    diff = t2 - t;
+                } while (diff.count() < 1.F);
+
+                // The prefetched frames are included in the cache size,
+                // which stays within the budget.
+                player->setPlayback(Playback::Stop);
+                t = std::chrono::steady_clock::now();
+                do
+                {
+                    player->tick();
+                    time::sleep(std::chrono::milliseconds(10));
+                    const auto t2 = std::chrono::steady_clock::now();
+                    diff = t2 - t;
+                } while (diff.count() < 1.F);
+                {
+                    const io::Info& ioInfo = player->getIOInfo();
+                    const size_t frameByteCount = !ioInfo.video.empty() ?
+                        image::getDataByteCount(ioInfo.video[0]) :
+                        0;
+                    TLRENDER_ASSERT(
+                        player->observeCacheInfo()->get().videoByteCount <=
+                        cacheOptions.videoByteCount + frameByteCount);
+                }
+                player->clearCache();
+                cacheOptions.videoByteCount = 0;
+                player->setCacheOptions(cacheOptions);
             }
         }
     }
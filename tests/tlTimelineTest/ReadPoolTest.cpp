@@ -0,0 +1,225 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlTimelineTest/ReadPoolTest.h>
+
+#include <tlTimeline/ReadPool.h>
+
+#include <tlCore/Assert.h>
+
+using namespace tl::timeline;
+
+namespace tl
+{
+    namespace timeline_tests
+    {
+        ReadPoolTest::ReadPoolTest(const std::shared_ptr<system::Context>& context) :
+            ITest("timeline_tests::ReadPoolTest", context)
+        {}
+
+        std::shared_ptr<ReadPoolTest> ReadPoolTest::create(const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<ReadPoolTest>(new ReadPoolTest(context));
+        }
+
+        void ReadPoolTest::run()
+        {
+            _options();
+            _pool();
+            _limits();
+            _idle();
+        }
+
+        namespace
+        {
+            class DummyRead : public io::IRead
+            {
+            public:
+                DummyRead(size_t fileCount, size_t byteCount) :
+                    _fileCount(fileCount),
+                    _byteCount(byteCount)
+                {}
+
+                std::future<io::Info> getInfo() override
+                {
+                    std::promise<io::Info> promise;
+                    promise.set_value(io::Info());
+                    return promise.get_future();
+                }
+
+                void cancelRequests() override
+                {}
+
+                size_t getOpenFileCount() const override
+                {
+                    return _fileCount;
+                }
+
+                size_t getByteCount() const override
+                {
+                    return _byteCount;
+                }
+
+            private:
+                size_t _fileCount = 0;
+                size_t _byteCount = 0;
+            };
+
+            std::function<std::shared_ptr<io::IRead>(void)> open(
+                size_t fileCount = 1,
+                size_t byteCount = 0)
+            {
+                return [fileCount, byteCount]
+                {
+                    return std::make_shared<DummyRead>(fileCount, byteCount);
+                };
+            }
+        }
+
+        void ReadPoolTest::_options()
+        {
+            ReadPoolOptions a;
+            ReadPoolOptions b;
+            TLRENDER_ASSERT(a == b);
+            b.readerCount = 1;
+            TLRENDER_ASSERT(a != b);
+
+            ReadPoolStats c;
+            ReadPoolStats d;
+            TLRENDER_ASSERT(c == d);
+            d.hitCount = 1;
+            TLRENDER_ASSERT(c != d);
+        }
+
+        void ReadPoolTest::_pool()
+        {
+            auto pool = ReadPool::create();
+            TLRENDER_ASSERT(ReadPoolStats() == pool->getStats());
+
+            // Open a reader, then reuse it.
+            auto a = pool->get("a", open());
+            TLRENDER_ASSERT(a);
+            TLRENDER_ASSERT(a == pool->get("a", open()));
+            TLRENDER_ASSERT(a == pool->peek("a"));
+            TLRENDER_ASSERT(pool->contains("a"));
+            TLRENDER_ASSERT(!pool->contains("b"));
+            TLRENDER_ASSERT(!pool->peek("b"));
+            auto stats = pool->getStats();
+            TLRENDER_ASSERT(1 == stats.openCount);
+            TLRENDER_ASSERT(1 == stats.hitCount);
+            TLRENDER_ASSERT(1 == stats.readerCount);
+            TLRENDER_ASSERT(1 == stats.fileCount);
+
+            // Readers that fail to open are kept so they are not opened
+            // again.
+            TLRENDER_ASSERT(!pool->get("b", nullptr));
+            TLRENDER_ASSERT(pool->contains("b"));
+            TLRENDER_ASSERT(!pool->get("b", open()));
+            stats = pool->getStats();
+            TLRENDER_ASSERT(2 == stats.openCount);
+            TLRENDER_ASSERT(2 == stats.hitCount);
+            TLRENDER_ASSERT(2 == stats.readerCount);
+
+            pool->clear();
+            TLRENDER_ASSERT(!pool->contains("a"));
+            TLRENDER_ASSERT(0 == pool->getStats().readerCount);
+        }
+
+        void ReadPoolTest::_limits()
+        {
+            {
+                ReadPoolOptions options;
+                options.readerCount = 2;
+                auto pool = ReadPool::create(options);
+                TLRENDER_ASSERT(options == pool->getOptions());
+                pool->get("a", open());
+                pool->get("b", open());
+                pool->get("a", open());
+                pool->get("c", open());
+                TLRENDER_ASSERT(pool->contains("a"));
+                TLRENDER_ASSERT(!pool->contains("b"));
+                TLRENDER_ASSERT(pool->contains("c"));
+                TLRENDER_ASSERT(1 == pool->getStats().evictCount);
+
+                options.readerCount = 1;
+                pool->setOptions(options);
+                TLRENDER_ASSERT(!pool->contains("a"));
+                TLRENDER_ASSERT(pool->contains("c"));
+                TLRENDER_ASSERT(2 == pool->getStats().evictCount);
+            }
+            {
+                ReadPoolOptions options;
+                options.readerCount = 2;
+                auto pool = ReadPool::create(options);
+                TLRENDER_ASSERT(2 == pool->getFreeCount());
+                auto a = pool->get("a", open());
+                TLRENDER_ASSERT(1 == pool->getFreeCount());
+                pool->get("b", open());
+                TLRENDER_ASSERT(0 == pool->getFreeCount());
+
+                // Readers that are in use are not evicted.
+                pool->get("c", open());
+                TLRENDER_ASSERT(pool->contains("a"));
+                TLRENDER_ASSERT(!pool->contains("b"));
+                TLRENDER_ASSERT(pool->contains("c"));
+                pool->get("d", open());
+                TLRENDER_ASSERT(pool->contains("a"));
+                TLRENDER_ASSERT(!pool->contains("c"));
+                TLRENDER_ASSERT(pool->contains("d"));
+                pool->evictIdle(std::chrono::steady_clock::now() + std::chrono::minutes(1));
+                TLRENDER_ASSERT(pool->contains("a"));
+                TLRENDER_ASSERT(!pool->contains("d"));
+
+                // The reader is evicted when it is no longer in use.
+                a.reset();
+                pool->get("e", open());
+                pool->get("f", open());
+                TLRENDER_ASSERT(!pool->contains("a"));
+                TLRENDER_ASSERT(0 == pool->getFreeCount());
+            }
+            {
+                ReadPoolOptions options;
+                options.fileCount = 4;
+                auto pool = ReadPool::create(options);
+                pool->get("a", open(2));
+                pool->get("b", open(2));
+                TLRENDER_ASSERT(4 == pool->getStats().fileCount);
+                pool->get("c", open(2));
+                TLRENDER_ASSERT(!pool->contains("a"));
+                TLRENDER_ASSERT(4 == pool->getStats().fileCount);
+
+                // The most recently used reader is kept even if it is over
+                // the maximum.
+                pool->get("d", open(8));
+                TLRENDER_ASSERT(pool->contains("d"));
+                TLRENDER_ASSERT(1 == pool->getStats().readerCount);
+            }
+            {
+                ReadPoolOptions options;
+                options.byteCount = 100;
+                auto pool = ReadPool::create(options);
+                pool->get("a", open(0, 50));
+                pool->get("b", open(0, 50));
+                TLRENDER_ASSERT(100 == pool->getStats().byteCount);
+                pool->get("c", open(0, 1));
+                TLRENDER_ASSERT(!pool->contains("a"));
+                TLRENDER_ASSERT(51 == pool->getStats().byteCount);
+            }
+        }
+
+        void ReadPoolTest::_idle()
+        {
+            ReadPoolOptions options;
+            options.idleTimeout = std::chrono::seconds(1);
+            auto pool = ReadPool::create(options);
+            pool->get("a", open());
+            auto t = std::chrono::steady_clock::now();
+            pool->evictIdle(t);
+            TLRENDER_ASSERT(pool->contains("a"));
+            pool->evictIdle(t + std::chrono::seconds(2));
+            TLRENDER_ASSERT(!pool->contains("a"));
+            TLRENDER_ASSERT(1 == pool->getStats().evictCount);
+        }
+    }
+}
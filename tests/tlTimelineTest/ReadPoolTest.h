@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTestLib/ITest.h>
+
+namespace tl
+{
+    namespace timeline_tests
+    {
+        class ReadPoolTest : public tests::ITest
+        {
+        protected:
+            ReadPoolTest(const std::shared_ptr<system::Context>&);
+
+        public:
+            static std::shared_ptr<ReadPoolTest> create(const std::shared_ptr<system::Context>&);
+
+            void run() override;
+
+        private:
+            void _options();
+            void _pool();
+            void _limits();
+            void _idle();
+        };
+    }
+}
@@ -0,0 +1,204 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlTimelineTest/TimelineIndexTest.h>
+
+#include <tlTimeline/TimelineIndex.h>
+
+#include <tlCore/Assert.h>
+
+#include <opentimelineio/gap.h>
+
+using namespace tl::timeline;
+
+namespace tl
+{
+    namespace timeline_tests
+    {
+        TimelineIndexTest::TimelineIndexTest(const std::shared_ptr<system::Context>& context) :
+            ITest("timeline_tests::TimelineIndexTest", context)
+        {}
+
+        std::shared_ptr<TimelineIndexTest> TimelineIndexTest::create(const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<TimelineIndexTest>(new TimelineIndexTest(context));
+        }
+
+        void TimelineIndexTest::run()
+        {
+            _track();
+            _transitions();
+            _timeline();
+        }
+
+        void TimelineIndexTest::_track()
+        {
+            {
+                const TrackIndex index;
+                TLRENDER_ASSERT(!index.getTrack());
+                TLRENDER_ASSERT(index.getItems().empty());
+                TLRENDER_ASSERT(!index.getItem(otime::RationalTime(0.0, 24.0)));
+            }
+            {
+                otio::SerializableObject::Retainer<otio::Track> otioTrack(new otio::Track);
+                auto clip0 = new otio::Clip(
+                    "Video 0",
+                    nullptr,
+                    otime::TimeRange(
+                        otime::RationalTime(0.0, 24.0),
+                        otime::RationalTime(24.0, 24.0)));
+                otioTrack->append_child(clip0);
+                otioTrack->append_child(new otio::Gap(
+                    otime::TimeRange(
+                        otime::RationalTime(0.0, 24.0),
+                        otime::RationalTime(12.0, 24.0))));
+                auto clip1 = new otio::Clip(
+                    "Video 1",
+                    nullptr,
+                    otime::TimeRange(
+                        otime::RationalTime(100.0, 24.0),
+                        otime::RationalTime(24.0, 24.0)));
+                otioTrack->append_child(clip1);
+
+                const TrackIndex index(otioTrack.value);
+                TLRENDER_ASSERT(otioTrack.value == index.getTrack());
+                TLRENDER_ASSERT(3 == index.getItems().size());
+                TLRENDER_ASSERT(otime::TimeRange(
+                    otime::RationalTime(36.0, 24.0),
+                    otime::RationalTime(24.0, 24.0)) == index.getItems()[2].range);
+
+                auto item = index.getItem(otime::RationalTime(0.0, 24.0));
+                TLRENDER_ASSERT(item && clip0 == item->clip);
+                item = index.getItem(otime::RationalTime(23.0, 24.0));
+                TLRENDER_ASSERT(item && clip0 == item->clip);
+                item = index.getItem(otime::RationalTime(24.0, 24.0));
+                TLRENDER_ASSERT(item && !item->clip);
+                item = index.getItem(otime::RationalTime(36.0, 24.0));
+                TLRENDER_ASSERT(item && clip1 == item->clip);
+                TLRENDER_ASSERT(!index.getItem(otime::RationalTime(-1.0, 24.0)));
+                TLRENDER_ASSERT(!index.getItem(otime::RationalTime(60.0, 24.0)));
+
+                // The items that touch the range are included.
+                auto items = index.getItems(otime::TimeRange(
+                    otime::RationalTime(0.5, 1.0),
+                    otime::RationalTime(1.0, 1.0)));
+                TLRENDER_ASSERT(3 == items.size());
+                items = index.getItems(otime::TimeRange(
+                    otime::RationalTime(2.0, 1.0),
+                    otime::RationalTime(1.0, 1.0)));
+                TLRENDER_ASSERT(1 == items.size());
+                TLRENDER_ASSERT(clip1 == items[0]->clip);
+                items = index.getItems(otime::TimeRange(
+                    otime::RationalTime(10.0, 1.0),
+                    otime::RationalTime(1.0, 1.0)));
+                TLRENDER_ASSERT(items.empty());
+            }
+            {
+                // The items are trimmed by the track source range.
+                otio::SerializableObject::Retainer<otio::Track> otioTrack(new otio::Track(
+                    "Video",
+                    otime::TimeRange(
+                        otime::RationalTime(12.0, 24.0),
+                        otime::RationalTime(24.0, 24.0))));
+                for (size_t i = 0; i < 3; ++i)
+                {
+                    otioTrack->append_child(new otio::Clip(
+                        "Video",
+                        nullptr,
+                        otime::TimeRange(
+                            otime::RationalTime(0.0, 24.0),
+                            otime::RationalTime(24.0, 24.0))));
+                }
+                const TrackIndex index(otioTrack.value);
+                TLRENDER_ASSERT(2 == index.getItems().size());
+                TLRENDER_ASSERT(otime::TimeRange(
+                    otime::RationalTime(12.0, 24.0),
+                    otime::RationalTime(12.0, 24.0)) == index.getItems()[0].range);
+                TLRENDER_ASSERT(otime::TimeRange(
+                    otime::RationalTime(24.0, 24.0),
+                    otime::RationalTime(12.0, 24.0)) == index.getItems()[1].range);
+            }
+        }
+
+        void TimelineIndexTest::_transitions()
+        {
+            otio::SerializableObject::Retainer<otio::Track> otioTrack(new otio::Track);
+            auto clip0 = new otio::Clip(
+                "Video 0",
+                nullptr,
+                otime::TimeRange(
+                    otime::RationalTime(0.0, 24.0),
+                    otime::RationalTime(24.0, 24.0)));
+            otioTrack->append_child(clip0);
+            auto transition = new otio::Transition(
+                "Transition",
+                otio::Transition::Type::SMPTE_Dissolve,
+                otime::RationalTime(6.0, 24.0),
+                otime::RationalTime(6.0, 24.0));
+            otioTrack->append_child(transition);
+            auto clip1 = new otio::Clip(
+                "Video 1",
+                nullptr,
+                otime::TimeRange(
+                    otime::RationalTime(0.0, 24.0),
+                    otime::RationalTime(24.0, 24.0)));
+            otioTrack->append_child(clip1);
+
+            const TrackIndex index(otioTrack.value);
+            TLRENDER_ASSERT(2 == index.getItems().size());
+            const auto& item0 = index.getItems()[0];
+            TLRENDER_ASSERT(clip0 == item0.clip);
+            TLRENDER_ASSERT(!item0.inTransition);
+            TLRENDER_ASSERT(!item0.inClip);
+            TLRENDER_ASSERT(transition == item0.outTransition);
+            TLRENDER_ASSERT(clip1 == item0.outClip);
+            const auto& item1 = index.getItems()[1];
+            TLRENDER_ASSERT(clip1 == item1.clip);
+            TLRENDER_ASSERT(transition == item1.inTransition);
+            TLRENDER_ASSERT(clip0 == item1.inClip);
+            TLRENDER_ASSERT(!item1.outTransition);
+            TLRENDER_ASSERT(!item1.outClip);
+            TLRENDER_ASSERT(otime::TimeRange(
+                otime::RationalTime(24.0, 24.0),
+                otime::RationalTime(24.0, 24.0)) == item1.range);
+        }
+
+        void TimelineIndexTest::_timeline()
+        {
+            {
+                const TimelineIndex index;
+                TLRENDER_ASSERT(index.getVideoTracks().empty());
+                TLRENDER_ASSERT(index.getAudioTracks().empty());
+            }
+            {
+                otio::SerializableObject::Retainer<otio::Timeline> otioTimeline(new otio::Timeline);
+                for (size_t i = 0; i < 2; ++i)
+                {
+                    auto otioTrack = new otio::Track("Video", std::nullopt, otio::Track::Kind::video);
+                    otioTimeline->tracks()->append_child(otioTrack);
+                    otioTrack->append_child(new otio::Clip(
+                        "Video",
+                        nullptr,
+                        otime::TimeRange(
+                            otime::RationalTime(0.0, 24.0),
+                            otime::RationalTime(24.0, 24.0))));
+                }
+                auto otioTrack = new otio::Track("Audio", std::nullopt, otio::Track::Kind::audio);
+                otioTimeline->tracks()->append_child(otioTrack);
+                otioTrack->append_child(new otio::Clip(
+                    "Audio",
+                    nullptr,
+                    otime::TimeRange(
+                        otime::RationalTime(0.0, 24.0),
+                        otime::RationalTime(24.0, 24.0))));
+
+                const TimelineIndex index(otioTimeline.value);
+                TLRENDER_ASSERT(2 == index.getVideoTracks().size());
+                TLRENDER_ASSERT(1 == index.getAudioTracks().size());
+                TLRENDER_ASSERT(otioTrack == index.getAudioTracks()[0].getTrack());
+                TLRENDER_ASSERT(1 == index.getAudioTracks()[0].getItems().size());
+            }
+        }
+    }
+}
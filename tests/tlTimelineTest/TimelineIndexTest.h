@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTestLib/ITest.h>
+
+namespace tl
+{
+    namespace timeline_tests
+    {
+        class TimelineIndexTest : public tests::ITest
+        {
+        protected:
+            TimelineIndexTest(const std::shared_ptr<system::Context>&);
+
+        public:
+            static std::shared_ptr<TimelineIndexTest> create(const std::shared_ptr<system::Context>&);
+
+            void run() override;
+
+        private:
+            void _track();
+            void _transitions();
+            void _timeline();
+        };
+    }
+}
@@ -84,6 +84,9 @@ namespace tl
                 TLRENDER_ASSERT(a == b);
                 a.time = otime::RationalTime(1.0, 24.0);
                 TLRENDER_ASSERT(a != b);
+                a.time = b.time;
+                a.canceled = true;
+                TLRENDER_ASSERT(a != b);
             }
         }
 
@@ -26,7 +26,10 @@
 #include <tlTimelineTest/MemoryReferenceTest.h>
 #include <tlTimelineTest/OCIOOptionsTest.h>
 #include <tlTimelineTest/PlayerOptionsTest.h>
+#include <tlTimelineTest/PlayerPrefetchTest.h>
 #include <tlTimelineTest/PlayerTest.h>
+#include <tlTimelineTest/ReadPoolTest.h>
+#include <tlTimelineTest/TimelineIndexTest.h>
 #include <tlTimelineTest/TimelineTest.h>
 #include <tlTimelineTest/UtilTest.h>
 
@@ -56,6 +59,7 @@
 
 #include <tlCoreTest/AudioTest.h>
 #include <tlCoreTest/BoxTest.h>
+#include <tlCoreTest/BufferPoolTest.h>
 #include <tlCoreTest/ColorTest.h>
 #include <tlCoreTest/ContextTest.h>
 #include <tlCoreTest/ErrorTest.h>
@@ -75,6 +79,7 @@
 #include <tlCoreTest/MeshTest.h>
 #include <tlCoreTest/OSTest.h>
 #include <tlCoreTest/PathTest.h>
+#include <tlCoreTest/RangeSetTest.h>
 #include <tlCoreTest/RangeTest.h>
 #include <tlCoreTest/SizeTest.h>
 #include <tlCoreTest/StringTest.h>
@@ -99,6 +104,7 @@ void coreTests(
 {
     tests.push_back(core_tests::AudioTest::create(context));
     tests.push_back(core_tests::BoxTest::create(context));
+    tests.push_back(core_tests::BufferPoolTest::create(context));
     tests.push_back(core_tests::ColorTest::create(context));
     tests.push_back(core_tests::ContextTest::create(context));
     tests.push_back(core_tests::ErrorTest::create(context));
@@ -118,6 +124,7 @@ void coreTests(
     tests.push_back(core_tests::MeshTest::create(context));
     tests.push_back(core_tests::OSTest::create(context));
     tests.push_back(core_tests::PathTest::create(context));
+    tests.push_back(core_tests::RangeSetTest::create(context));
     tests.push_back(core_tests::RangeTest::create(context));
     tests.push_back(core_tests::SizeTest::create(context));
     tests.push_back(core_tests::StringTest::create(context));
@@ -182,7 +189,10 @@ void timelineTests(
     tests.push_back(timeline_tests::MemoryReferenceTest::create(context));
     tests.push_back(timeline_tests::OCIOOptionsTest::create(context));
     tests.push_back(timeline_tests::PlayerOptionsTest::create(context));
+    tests.push_back(timeline_tests::PlayerPrefetchTest::create(context));
     tests.push_back(timeline_tests::PlayerTest::create(context));
+    tests.push_back(timeline_tests::ReadPoolTest::create(context));
+    tests.push_back(timeline_tests::TimelineIndexTest::create(context));
     tests.push_back(timeline_tests::TimelineTest::create(context));
     tests.push_back(timeline_tests::UtilTest::create(context));
 }